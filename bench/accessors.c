@@ -0,0 +1,173 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+//! Benchmarks object accessor overhead in lookup and traversal loops.
+//! The walk benchmark calls the accessors from this file, and is also built
+//! as bench_accessors_inline with GG_INLINE_ACCESSORS defined. The map_get,
+//! obj_visit, and json_encode benchmarks measure the library's internal use
+//! of the accessors; compare builds configured with GG_INLINE_ACCESSORS on
+//! and off.
+
+#include "bench.h"
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/json_decode.h>
+#include <gg/json_encode.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <gg/vector.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef GG_INLINE_ACCESSORS
+#define VARIANT "inline"
+#else
+#define VARIANT "call"
+#endif
+
+/// Keys in each map of the document.
+#define MAP_WIDTH 32
+
+/// Maps in the document.
+#define MAP_COUNT 64
+
+typedef struct {
+    GgObject obj;
+    GgMap first_map;
+    GgBuffer keys[MAP_WIDTH];
+    GgBuffer encode_mem;
+} AccessorsCtx;
+
+// NOLINTNEXTLINE(misc-no-recursion)
+static size_t walk(GgObject obj) {
+    switch (gg_obj_type(obj)) {
+    case GG_TYPE_I64:
+        return (size_t) gg_obj_into_i64(obj);
+    case GG_TYPE_BUF:
+        return gg_obj_into_buf(obj).len;
+    case GG_TYPE_LIST: {
+        GgList list = gg_obj_into_list(obj);
+        size_t sum = 0;
+        for (size_t i = 0; i < list.len; i++) {
+            sum += walk(list.items[i]);
+        }
+        return sum;
+    }
+    case GG_TYPE_MAP: {
+        size_t sum = 0;
+        GG_MAP_FOREACH (pair, gg_obj_into_map(obj)) {
+            sum += gg_kv_key(*pair).len + walk(*gg_kv_val(pair));
+        }
+        return sum;
+    }
+    default:
+        return 0;
+    }
+}
+
+static GgError bench_walk(void *ctx) {
+    AccessorsCtx *args = ctx;
+    volatile size_t sum = walk(args->obj);
+    (void) sum;
+    return GG_ERR_OK;
+}
+
+static GgError bench_map_get(void *ctx) {
+    AccessorsCtx *args = ctx;
+    for (size_t i = 0; i < MAP_WIDTH; i++) {
+        if (!gg_map_get(args->first_map, args->keys[i], NULL)) {
+            return GG_ERR_NOENTRY;
+        }
+    }
+    return GG_ERR_OK;
+}
+
+static GgError bench_visit(void *ctx) {
+    AccessorsCtx *args = ctx;
+    size_t size;
+    return gg_obj_mem_usage(args->obj, &size);
+}
+
+static GgError bench_encode(void *ctx) {
+    AccessorsCtx *args = ctx;
+    GgByteVec vec = gg_byte_vec_init(args->encode_mem);
+    return gg_json_encode(args->obj, gg_byte_vec_writer(&vec));
+}
+
+static GgBuffer gen_doc(void) {
+    size_t cap = 2 + (MAP_COUNT * (3 + (MAP_WIDTH * 32)));
+    uint8_t *mem = malloc(cap);
+    if (mem == NULL) {
+        return (GgBuffer) { 0 };
+    }
+    size_t len = 0;
+    mem[len++] = '[';
+    for (size_t i = 0; i < MAP_COUNT; i++) {
+        if (i != 0) {
+            mem[len++] = ',';
+        }
+        mem[len++] = '{';
+        for (size_t j = 0; j < MAP_WIDTH; j++) {
+            len += (size_t) snprintf(
+                (char *) &mem[len],
+                cap - len,
+                (j == 0) ? "\"field%zu\":%zu" : ",\"field%zu\":\"val%zu\"",
+                j,
+                i
+            );
+        }
+        mem[len++] = '}';
+    }
+    mem[len++] = ']';
+    return (GgBuffer) { .data = mem, .len = len };
+}
+
+int main(void) {
+    GgError ret = gg_obj_set_limits((GgObjectLimits) {
+        .max_depth = GG_MAX_OBJECT_DEPTH,
+        .max_subobjects = SIZE_MAX,
+    });
+    if (ret != GG_ERR_OK) {
+        return 1;
+    }
+
+    GgBuffer json = gen_doc();
+    size_t nodes = MAP_COUNT * (1 + (MAP_WIDTH * 2));
+    size_t decode_len = nodes * sizeof(GgKV);
+    AccessorsCtx ctx = {
+        .encode_mem = { .data = malloc(json.len), .len = json.len },
+    };
+    GgBuffer decode_mem = { .data = malloc(decode_len), .len = decode_len };
+
+    ret = GG_ERR_NOMEM;
+    if ((json.data != NULL) && (ctx.encode_mem.data != NULL)
+        && (decode_mem.data != NULL)) {
+        GgArena arena = gg_arena_init(decode_mem);
+        ret = gg_json_decode_destructive(json, &arena, &ctx.obj);
+    }
+
+    if (ret == GG_ERR_OK) {
+        ctx.first_map = gg_obj_into_map(gg_obj_into_list(ctx.obj).items[0]);
+        for (size_t i = 0; i < MAP_WIDTH; i++) {
+            ctx.keys[i] = gg_kv_key(ctx.first_map.pairs[i]);
+        }
+        ret = gg_bench_run("accessors/walk/" VARIANT, nodes, bench_walk, &ctx);
+    }
+    if (ret == GG_ERR_OK) {
+        ret = gg_bench_run("accessors/map_get", MAP_WIDTH, bench_map_get, &ctx);
+    }
+    if (ret == GG_ERR_OK) {
+        ret = gg_bench_run("accessors/obj_visit", nodes, bench_visit, &ctx);
+    }
+    if (ret == GG_ERR_OK) {
+        ret = gg_bench_run("accessors/json_encode", nodes, bench_encode, &ctx);
+    }
+
+    free(decode_mem.data);
+    free(ctx.encode_mem.data);
+    free(json.data);
+    return (ret == GG_ERR_OK) ? 0 : 1;
+}
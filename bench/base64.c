@@ -0,0 +1,87 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+//! Benchmarks base64 encode and decode throughput.
+
+#include "bench.h"
+#include <gg/arena.h>
+#include <gg/base64.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+    GgBuffer raw;
+    GgBuffer encoded;
+    GgBuffer encode_mem;
+    GgBuffer decode_mem;
+} Base64Ctx;
+
+static GgError bench_encode(void *ctx) {
+    Base64Ctx *args = ctx;
+    GgArena arena = gg_arena_init(args->encode_mem);
+    GgBuffer result;
+    return gg_base64_encode(args->raw, &arena, &result);
+}
+
+static GgError bench_decode(void *ctx) {
+    Base64Ctx *args = ctx;
+    GgBuffer target = args->decode_mem;
+    return gg_base64_decode(args->encoded, &target) ? GG_ERR_OK
+                                                    : GG_ERR_PARSE;
+}
+
+static GgError run_size(size_t len) {
+    size_t encoded_len = ((len + 2) / 3) * 4;
+    // Decode target must fit whole segments, including padding
+    size_t decoded_cap = (encoded_len / 4) * 3;
+    Base64Ctx ctx = {
+        .raw = { .data = malloc(len), .len = len },
+        .encode_mem = { .data = malloc(encoded_len), .len = encoded_len },
+        .decode_mem = { .data = malloc(decoded_cap), .len = decoded_cap },
+    };
+
+    GgError ret = GG_ERR_NOMEM;
+    if ((ctx.raw.data != NULL) && (ctx.encode_mem.data != NULL)
+        && (ctx.decode_mem.data != NULL)) {
+        uint32_t state = 1;
+        for (size_t i = 0; i < len; i++) {
+            state = (state * 1103515245U) + 12345U;
+            ctx.raw.data[i] = (uint8_t) (state >> 16);
+        }
+        GgArena arena = gg_arena_init(ctx.encode_mem);
+        ret = gg_base64_encode(ctx.raw, &arena, &ctx.encoded);
+    }
+
+    char name[64];
+    if (ret == GG_ERR_OK) {
+        snprintf(name, sizeof(name), "base64_encode/bytes=%zu", len);
+        ret = gg_bench_run(name, len, bench_encode, &ctx);
+    }
+    if (ret == GG_ERR_OK) {
+        snprintf(name, sizeof(name), "base64_decode/bytes=%zu", len);
+        ret = gg_bench_run(name, len, bench_decode, &ctx);
+    }
+
+    free(ctx.decode_mem.data);
+    free(ctx.encode_mem.data);
+    free(ctx.raw.data);
+    return ret;
+}
+
+int main(void) {
+    static const size_t SIZES[] = { 48, 1024, 10000, 65536 };
+
+    for (size_t i = 0; i < sizeof(SIZES) / sizeof(SIZES[0]); i++) {
+        GgError ret = run_size(SIZES[i]);
+        if (ret != GG_ERR_OK) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
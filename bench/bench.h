@@ -0,0 +1,78 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GG_BENCH_H
+#define GG_BENCH_H
+
+//! Benchmark harness
+//!
+//! Results are printed to stdout as one JSON object per line:
+//! {"bench":"<name>","units":<n>,"iterations":<i>,"ns_per_iter":<t>,
+//!  "ns_per_unit":<t / n>}
+
+#include <gg/error.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/// Minimum measured time for each benchmark.
+#ifndef GG_BENCH_MIN_NS
+#define GG_BENCH_MIN_NS (200000000U)
+#endif
+
+typedef GgError GgBenchFn(void *ctx);
+
+static inline uint64_t gg_bench_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t) now.tv_sec * 1000000000U) + (uint64_t) now.tv_nsec;
+}
+
+/// Run `fn` repeatedly for at least GG_BENCH_MIN_NS and report the result.
+/// `units` is the amount of work done per call (bytes, nodes, etc.).
+static inline GgError gg_bench_run(
+    const char *name, size_t units, GgBenchFn *fn, void *ctx
+) {
+    // Warm up caches and catch errors before timing
+    GgError ret = fn(ctx);
+    if (ret != GG_ERR_OK) {
+        fprintf(stderr, "Benchmark %s failed (%d).\n", name, (int) ret);
+        return ret;
+    }
+
+    uint64_t iterations = 1;
+    uint64_t elapsed;
+    while (true) {
+        uint64_t start = gg_bench_now_ns();
+        for (uint64_t i = 0; i < iterations; i++) {
+            ret = fn(ctx);
+            if (ret != GG_ERR_OK) {
+                fprintf(stderr, "Benchmark %s failed (%d).\n", name, (int) ret);
+                return ret;
+            }
+        }
+        elapsed = gg_bench_now_ns() - start;
+        if (elapsed >= GG_BENCH_MIN_NS) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    double ns_per_iter = (double) elapsed / (double) iterations;
+    printf(
+        "{\"bench\":\"%s\",\"units\":%zu,\"iterations\":%" PRIu64
+        ",\"ns_per_iter\":%.3f,\"ns_per_unit\":%.3f}\n",
+        name,
+        units,
+        iterations,
+        ns_per_iter,
+        (units == 0) ? ns_per_iter : ns_per_iter / (double) units
+    );
+    return GG_ERR_OK;
+}
+
+#endif
@@ -0,0 +1,206 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+//! Benchmarks CBOR encode/decode against JSON for the same objects.
+
+#include "bench.h"
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/cbor_decode.h>
+#include <gg/cbor_encode.h>
+#include <gg/error.h>
+#include <gg/json_decode.h>
+#include <gg/json_encode.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <gg/vector.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// Nodes in each telemetry record, including the record map.
+#define RECORD_NODES 13
+
+typedef struct {
+    GgObject obj;
+    GgBuffer json;
+    GgBuffer cbor;
+    GgBuffer decode_mem;
+    GgBuffer encode_mem;
+} CodecCtx;
+
+static const GgBuffer SENSOR_NAMES[]
+    = { GG_STR("boiler"), GG_STR("intake"), GG_STR("exhaust") };
+
+/// Builds a list of telemetry records in `arena`.
+static GgError gen_records(size_t count, GgArena *arena, GgObject *obj) {
+    GgObject *records = GG_ARENA_ALLOCN(arena, GgObject, count);
+    if (records == NULL) {
+        return GG_ERR_NOMEM;
+    }
+    for (size_t i = 0; i < count; i++) {
+        GgKV *pairs = GG_ARENA_ALLOCN(arena, GgKV, 5);
+        GgObject *tags = GG_ARENA_ALLOCN(arena, GgObject, 2);
+        if ((pairs == NULL) || (tags == NULL)) {
+            return GG_ERR_NOMEM;
+        }
+        tags[0] = gg_obj_buf(GG_STR("site-a"));
+        tags[1] = gg_obj_buf(SENSOR_NAMES[i % 3]);
+        pairs[0] = gg_kv(
+            GG_STR("timestamp"), gg_obj_i64(1700000000000 + (int64_t) i)
+        );
+        pairs[1] = gg_kv(
+            GG_STR("temperature"), gg_obj_f64(20.0 + ((double) i * 0.37))
+        );
+        pairs[2] = gg_kv(GG_STR("ok"), gg_obj_bool((i % 7) != 0));
+        pairs[3] = gg_kv(GG_STR("sensor"), gg_obj_buf(SENSOR_NAMES[i % 3]));
+        pairs[4] = gg_kv(
+            GG_STR("tags"), gg_obj_list((GgList) { .items = tags, .len = 2 })
+        );
+        records[i] = gg_obj_map((GgMap) { .pairs = pairs, .len = 5 });
+    }
+    *obj = gg_obj_list((GgList) { .items = records, .len = count });
+    return GG_ERR_OK;
+}
+
+static GgError bench_json_encode(void *ctx) {
+    CodecCtx *args = ctx;
+    GgByteVec vec = gg_byte_vec_init(args->encode_mem);
+    return gg_json_encode(args->obj, gg_byte_vec_writer(&vec));
+}
+
+static GgError bench_json_decode(void *ctx) {
+    CodecCtx *args = ctx;
+    GgArena arena = gg_arena_init(args->decode_mem);
+    GgObject obj;
+    // Input has no escapes, so destructive decode leaves it unchanged
+    return gg_json_decode_destructive(args->json, &arena, &obj);
+}
+
+static GgError bench_cbor_encode(void *ctx) {
+    CodecCtx *args = ctx;
+    GgByteVec vec = gg_byte_vec_init(args->encode_mem);
+    return gg_cbor_encode(args->obj, gg_byte_vec_writer(&vec));
+}
+
+static GgError bench_cbor_decode(void *ctx) {
+    CodecCtx *args = ctx;
+    GgArena arena = gg_arena_init(args->decode_mem);
+    GgObject obj;
+    return gg_cbor_decode(args->cbor, &arena, &obj);
+}
+
+static GgError encode_to(
+    GgObject obj,
+    GgError (*encode)(GgObject obj, GgWriter writer),
+    size_t len,
+    GgBuffer *out
+) {
+    uint8_t *mem = malloc(len);
+    if (mem == NULL) {
+        return GG_ERR_NOMEM;
+    }
+    GgByteVec vec = gg_byte_vec_init((GgBuffer) { .data = mem, .len = len });
+    GgError ret = encode(obj, gg_byte_vec_writer(&vec));
+    if (ret != GG_ERR_OK) {
+        free(mem);
+        return ret;
+    }
+    *out = vec.buf;
+    return GG_ERR_OK;
+}
+
+static GgError run_records(size_t count) {
+    size_t nodes = count * RECORD_NODES;
+    size_t mem_len = nodes * sizeof(GgKV);
+    CodecCtx ctx = { 0 };
+    uint8_t *obj_mem = malloc(mem_len);
+    ctx.decode_mem = (GgBuffer) { .data = malloc(mem_len), .len = mem_len };
+
+    GgError ret = GG_ERR_NOMEM;
+    if ((obj_mem != NULL) && (ctx.decode_mem.data != NULL)) {
+        GgArena arena
+            = gg_arena_init((GgBuffer) { .data = obj_mem, .len = mem_len });
+        ret = gen_records(count, &arena, &ctx.obj);
+    }
+
+    size_t json_len = 0;
+    size_t cbor_len = 0;
+    if (ret == GG_ERR_OK) {
+        ret = gg_json_encoded_len(ctx.obj, &json_len);
+    }
+    if (ret == GG_ERR_OK) {
+        ret = gg_cbor_encoded_len(ctx.obj, &cbor_len);
+    }
+    if (ret == GG_ERR_OK) {
+        ret = encode_to(ctx.obj, gg_json_encode, json_len, &ctx.json);
+    }
+    if (ret == GG_ERR_OK) {
+        ret = encode_to(ctx.obj, gg_cbor_encode, cbor_len, &ctx.cbor);
+    }
+    if (ret == GG_ERR_OK) {
+        ctx.encode_mem
+            = (GgBuffer) { .data = malloc(json_len), .len = json_len };
+        if (ctx.encode_mem.data == NULL) {
+            ret = GG_ERR_NOMEM;
+        }
+    }
+
+    typedef struct {
+        const char *codec;
+        const char *op;
+        GgBenchFn *fn;
+        size_t bytes;
+    } CodecBench;
+
+    const CodecBench BENCHES[] = {
+        { "json", "encode", bench_json_encode, json_len },
+        { "cbor", "encode", bench_cbor_encode, cbor_len },
+        { "json", "decode", bench_json_decode, json_len },
+        { "cbor", "decode", bench_cbor_decode, cbor_len },
+    };
+
+    size_t bench_count = sizeof(BENCHES) / sizeof(BENCHES[0]);
+    for (size_t i = 0; (ret == GG_ERR_OK) && (i < bench_count); i++) {
+        char name[64];
+        snprintf(
+            name,
+            sizeof(name),
+            "%s_%s/records=%zu/bytes=%zu",
+            BENCHES[i].codec,
+            BENCHES[i].op,
+            count,
+            BENCHES[i].bytes
+        );
+        ret = gg_bench_run(name, nodes, BENCHES[i].fn, &ctx);
+    }
+
+    free(ctx.encode_mem.data);
+    free(ctx.cbor.data);
+    free(ctx.json.data);
+    free(ctx.decode_mem.data);
+    free(obj_mem);
+    return ret;
+}
+
+int main(void) {
+    GgError ret = gg_obj_set_limits((GgObjectLimits) {
+        .max_depth = GG_MAX_OBJECT_DEPTH,
+        .max_subobjects = SIZE_MAX,
+    });
+    if (ret != GG_ERR_OK) {
+        return 1;
+    }
+
+    static const size_t SIZES[] = { 1, 16, 256, 4096 };
+
+    for (size_t i = 0; i < sizeof(SIZES) / sizeof(SIZES[0]); i++) {
+        ret = run_records(SIZES[i]);
+        if (ret != GG_ERR_OK) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+//! Benchmarks CRC32 throughput, as used for eventstream packet checksums.
+
+#include "../src/crc32.h"
+#include "bench.h"
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+    GgBuffer data;
+} CrcCtx;
+
+static GgError bench_crc(void *ctx) {
+    CrcCtx *args = ctx;
+    volatile uint32_t crc = gg_update_crc(0, args->data);
+    (void) crc;
+    return GG_ERR_OK;
+}
+
+static GgError run_size(size_t len) {
+    CrcCtx ctx = { .data = { .data = malloc(len), .len = len } };
+    if (ctx.data.data == NULL) {
+        return GG_ERR_NOMEM;
+    }
+
+    uint32_t state = 1;
+    for (size_t i = 0; i < len; i++) {
+        state = (state * 1103515245U) + 12345U;
+        ctx.data.data[i] = (uint8_t) (state >> 16);
+    }
+
+    char name[64];
+    snprintf(name, sizeof(name), "crc32/bytes=%zu", len);
+    GgError ret = gg_bench_run(name, len, bench_crc, &ctx);
+
+    free(ctx.data.data);
+    return ret;
+}
+
+int main(void) {
+    static const size_t SIZES[] = { 12, 256, 10000, 65536 };
+
+    for (size_t i = 0; i < sizeof(SIZES) / sizeof(SIZES[0]); i++) {
+        GgError ret = run_size(SIZES[i]);
+        if (ret != GG_ERR_OK) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+//! Benchmarks eventstream packet encode and decode, with the headers of an
+//! IPC request.
+
+#include "bench.h"
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/eventstream/decode.h>
+#include <gg/eventstream/encode.h>
+#include <gg/eventstream/rpc.h>
+#include <gg/eventstream/types.h>
+#include <gg/io.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Size of eventstream prelude.
+#define PRELUDE_LEN 12
+
+static const EventStreamHeader HEADERS[] = {
+    { GG_STR(":message-type"),
+      { EVENTSTREAM_INT32, .int32 = EVENTSTREAM_APPLICATION_MESSAGE } },
+    { GG_STR(":message-flags"), { EVENTSTREAM_INT32, .int32 = 0 } },
+    { GG_STR(":stream-id"), { EVENTSTREAM_INT32, .int32 = 1 } },
+    { GG_STR("operation"),
+      { EVENTSTREAM_STRING,
+        .string = GG_STR("aws.greengrass#PublishToTopic") } },
+    { GG_STR("service-model-type"),
+      { EVENTSTREAM_STRING,
+        .string = GG_STR("aws.greengrass#PublishToTopicRequest") } },
+};
+
+typedef struct {
+    GgBuffer payload;
+    GgBuffer packet_mem;
+    GgBuffer packet;
+} EventStreamCtx;
+
+static GgError payload_read(void *ctx, GgBuffer *buf) {
+    const GgBuffer *payload = ctx;
+    if (payload->len > buf->len) {
+        return GG_ERR_NOMEM;
+    }
+    if (payload->len != 0) {
+        memcpy(buf->data, payload->data, payload->len);
+    }
+    buf->len = payload->len;
+    return GG_ERR_OK;
+}
+
+static GgError encode(EventStreamCtx *args, GgBuffer *packet) {
+    *packet = args->packet_mem;
+    return eventstream_encode(
+        packet,
+        HEADERS,
+        sizeof(HEADERS) / sizeof(HEADERS[0]),
+        (GgReader) { .read = payload_read, .ctx = &args->payload }
+    );
+}
+
+static GgError bench_encode(void *ctx) {
+    GgBuffer packet;
+    return encode(ctx, &packet);
+}
+
+static GgError bench_decode(void *ctx) {
+    EventStreamCtx *args = ctx;
+    EventStreamPrelude prelude;
+    GgError ret = eventstream_decode_prelude(
+        gg_buffer_substr(args->packet, 0, PRELUDE_LEN), &prelude
+    );
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    EventStreamMessage msg;
+    return eventstream_decode(
+        &prelude,
+        gg_buffer_substr(args->packet, PRELUDE_LEN, SIZE_MAX),
+        &msg
+    );
+}
+
+static GgError run_size(size_t len) {
+    size_t packet_cap = len + 1024;
+    EventStreamCtx ctx = {
+        .payload = { .data = malloc(len), .len = len },
+        .packet_mem = { .data = malloc(packet_cap), .len = packet_cap },
+    };
+
+    GgError ret = GG_ERR_NOMEM;
+    if ((ctx.payload.data != NULL) && (ctx.packet_mem.data != NULL)) {
+        for (size_t i = 0; i < len; i++) {
+            ctx.payload.data[i] = (uint8_t) ('a' + (i % 26));
+        }
+        ret = encode(&ctx, &ctx.packet);
+    }
+
+    char name[64];
+    if (ret == GG_ERR_OK) {
+        snprintf(name, sizeof(name), "eventstream_encode/bytes=%zu", len);
+        ret = gg_bench_run(name, ctx.packet.len, bench_encode, &ctx);
+    }
+    if (ret == GG_ERR_OK) {
+        snprintf(name, sizeof(name), "eventstream_decode/bytes=%zu", len);
+        ret = gg_bench_run(name, ctx.packet.len, bench_decode, &ctx);
+    }
+
+    free(ctx.packet_mem.data);
+    free(ctx.payload.data);
+    return ret;
+}
+
+int main(void) {
+    static const size_t SIZES[] = { 0, 128, 1024, 8192 };
+
+    for (size_t i = 0; i < sizeof(SIZES) / sizeof(SIZES[0]); i++) {
+        GgError ret = run_size(SIZES[i]);
+        if (ret != GG_ERR_OK) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,820 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+//! End-to-end IPC load generator.
+//!
+//! Forks a nucleus stand-in serving IPC on a local Unix socket, then drives
+//! workloads against it through the SDK. Each workload prints one JSON object
+//! with its throughput and latency percentiles:
+//! {"bench":"ipc_load/<workload>","threads":<n>,"topics":<m>,
+//!  "payload_bytes":<b>,"ops":<o>,"errors":<e>,"seconds":<s>,
+//!  "ops_per_sec":<r>,"p50_us":<t>,"p99_us":<t>,"p999_us":<t>,"max_us":<t>,
+//!  "server_busy":<fraction of the run the stand-in was handling requests>}
+//!
+//! Usage: bench_ipc_load [-w workload] [-t threads] [-m topics]
+//!                       [-n requests per thread] [-s payload bytes]
+//!
+//! Workloads:
+//! - publish: each thread publishes round-robin over the topics.
+//! - fan_in: as publish, with every topic subscribed to; latency is from
+//!   publish to the subscription callback.
+//! - get_config: each thread reads a configuration value.
+//! - mixed: publishes to subscribed topics, with every fourth request a
+//!   get_config call.
+//! - all: each of the above in turn (default).
+
+#include "bench.h"
+#include <errno.h>
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/cleanup.h>
+#include <gg/error.h>
+#include <gg/eventstream/decode.h>
+#include <gg/eventstream/encode.h>
+#include <gg/eventstream/rpc.h>
+#include <gg/eventstream/types.h>
+#include <gg/file.h>
+#include <gg/io.h>
+#include <gg/ipc/client.h>
+#include <gg/ipc/limits.h>
+#include <gg/json_decode.h>
+#include <gg/json_encode.h>
+#include <gg/log_priv.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <gg/sdk.h>
+#include <gg/socket.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// Topics and subscriptions each need a stream slot.
+#define MAX_TOPICS GG_IPC_MAX_STREAMS
+#define TOPIC_NAME_LEN 32
+
+#define CONFIG_KEY "setting"
+#define CONFIG_VALUE "value"
+
+/// Time to wait for subscription messages after the last publish.
+#define DELIVERY_TIMEOUT_NS (5000000000U)
+
+typedef enum {
+    WORKLOAD_PUBLISH,
+    WORKLOAD_FAN_IN,
+    WORKLOAD_GET_CONFIG,
+    WORKLOAD_MIXED,
+    WORKLOAD_COUNT,
+} Workload;
+
+static const char *const WORKLOAD_NAMES[WORKLOAD_COUNT] = {
+    [WORKLOAD_PUBLISH] = "publish",
+    [WORKLOAD_FAN_IN] = "fan_in",
+    [WORKLOAD_GET_CONFIG] = "get_config",
+    [WORKLOAD_MIXED] = "mixed",
+};
+
+static size_t thread_count = 8;
+static size_t topic_count = 4;
+static size_t request_count = 10000;
+static size_t payload_len = 64;
+
+static GgBuffer topics[MAX_TOPICS];
+static uint8_t topic_mem[MAX_TOPICS][TOPIC_NAME_LEN];
+
+//
+// Nucleus stand-in
+//
+
+typedef struct {
+    int32_t stream_id;
+    GgBuffer topic;
+    uint8_t topic_mem[TOPIC_NAME_LEN];
+} Subscription;
+
+static Subscription subscriptions[GG_IPC_MAX_STREAMS];
+static size_t subscription_count = 0;
+
+/// Time the stand-in spends handling requests, shared with the client so
+/// results show when the stand-in rather than the SDK is the bottleneck.
+static atomic_uint_fast64_t *server_busy_ns;
+
+static GgError server_send(
+    int fd,
+    int32_t message_type,
+    int32_t flags,
+    int32_t stream_id,
+    GgBuffer service_model_type,
+    const GgObject *payload
+) {
+    static uint8_t mem[GG_IPC_MAX_MSG_LEN];
+    GgBuffer packet = GG_BUF(mem);
+
+    EventStreamHeader headers[] = {
+        { GG_STR(":message-type"),
+          { EVENTSTREAM_INT32, .int32 = message_type } },
+        { GG_STR(":message-flags"), { EVENTSTREAM_INT32, .int32 = flags } },
+        { GG_STR(":stream-id"), { EVENTSTREAM_INT32, .int32 = stream_id } },
+        { GG_STR(":content-type"),
+          { EVENTSTREAM_STRING, .string = GG_STR("application/json") } },
+        { GG_STR("service-model-type"),
+          { EVENTSTREAM_STRING, .string = service_model_type } },
+    };
+    size_t headers_len = sizeof(headers) / sizeof(headers[0]);
+
+    GgError ret = eventstream_encode(
+        &packet,
+        headers,
+        (payload == NULL) ? 3 : headers_len,
+        (payload == NULL) ? GG_NULL_READER : gg_json_reader(payload)
+    );
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    return gg_socket_write(fd, packet);
+}
+
+static GgError server_respond(
+    int fd, int32_t stream_id, GgBuffer service_model_type, GgObject payload
+) {
+    return server_send(
+        fd,
+        EVENTSTREAM_APPLICATION_MESSAGE,
+        EVENTSTREAM_TERMINATE_STREAM,
+        stream_id,
+        service_model_type,
+        &payload
+    );
+}
+
+static GgError server_publish(int fd, int32_t stream_id, GgMap args) {
+    GgObject *topic;
+    GgObject *publish_message;
+    GgError ret = gg_map_validate(
+        args,
+        GG_MAP_SCHEMA(
+            { GG_STR("topic"), GG_REQUIRED, GG_TYPE_BUF, &topic },
+            { GG_STR("publishMessage"),
+              GG_REQUIRED,
+              GG_TYPE_MAP,
+              &publish_message },
+        )
+    );
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    GgObject *binary_message;
+    ret = gg_map_validate(
+        gg_obj_into_map(*publish_message),
+        GG_MAP_SCHEMA({ GG_STR("binaryMessage"),
+                        GG_REQUIRED,
+                        GG_TYPE_MAP,
+                        &binary_message })
+    );
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    GgObject *message;
+    ret = gg_map_validate(
+        gg_obj_into_map(*binary_message),
+        GG_MAP_SCHEMA(
+            { GG_STR("message"), GG_REQUIRED, GG_TYPE_BUF, &message }
+        )
+    );
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    ret = server_respond(
+        fd,
+        stream_id,
+        GG_STR("aws.greengrass#PublishToTopicResponse"),
+        gg_obj_map((GgMap) { 0 })
+    );
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    GgObject delivery = gg_obj_map(GG_MAP(gg_kv(
+        GG_STR("binaryMessage"),
+        gg_obj_map(GG_MAP(
+            gg_kv(GG_STR("message"), *message),
+            gg_kv(
+                GG_STR("context"),
+                gg_obj_map(GG_MAP(gg_kv(GG_STR("topic"), *topic)))
+            )
+        ))
+    )));
+
+    for (size_t i = 0; i < subscription_count; i++) {
+        if (!gg_buffer_eq(subscriptions[i].topic, gg_obj_into_buf(*topic))) {
+            continue;
+        }
+        ret = server_send(
+            fd,
+            EVENTSTREAM_APPLICATION_MESSAGE,
+            0,
+            subscriptions[i].stream_id,
+            GG_STR("aws.greengrass#SubscriptionResponseMessage"),
+            &delivery
+        );
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+    }
+    return GG_ERR_OK;
+}
+
+static GgError server_subscribe(int fd, int32_t stream_id, GgMap args) {
+    GgObject *topic;
+    GgError ret = gg_map_validate(
+        args,
+        GG_MAP_SCHEMA({ GG_STR("topic"), GG_REQUIRED, GG_TYPE_BUF, &topic })
+    );
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    GgBuffer topic_buf = gg_obj_into_buf(*topic);
+    if ((subscription_count >= GG_IPC_MAX_STREAMS)
+        || (topic_buf.len > TOPIC_NAME_LEN)) {
+        return GG_ERR_NOMEM;
+    }
+    Subscription *sub = &subscriptions[subscription_count];
+    memcpy(sub->topic_mem, topic_buf.data, topic_buf.len);
+    sub->topic = (GgBuffer) { .data = sub->topic_mem, .len = topic_buf.len };
+    sub->stream_id = stream_id;
+    subscription_count += 1;
+
+    GgObject empty = gg_obj_map((GgMap) { 0 });
+    return server_send(
+        fd,
+        EVENTSTREAM_APPLICATION_MESSAGE,
+        0,
+        stream_id,
+        GG_STR("aws.greengrass#SubscribeToTopicResponse"),
+        &empty
+    );
+}
+
+static void server_unsubscribe(int32_t stream_id) {
+    for (size_t i = 0; i < subscription_count; i++) {
+        if (subscriptions[i].stream_id == stream_id) {
+            subscription_count -= 1;
+            subscriptions[i] = subscriptions[subscription_count];
+            subscriptions[i].topic.data = subscriptions[i].topic_mem;
+            return;
+        }
+    }
+}
+
+static GgError server_handle(int fd, EventStreamMessage *msg) {
+    EventStreamCommonHeaders common;
+    GgError ret = eventstream_get_common_headers(msg, &common);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    // Sent by the client to close a subscription
+    if ((common.message_flags & EVENTSTREAM_TERMINATE_STREAM) != 0) {
+        server_unsubscribe(common.stream_id);
+        return GG_ERR_OK;
+    }
+
+    GgBuffer operation = GG_STR("");
+    EventStreamHeaderIter iter = msg->headers;
+    EventStreamHeader header;
+    while (eventstream_header_next(&iter, &header) == GG_ERR_OK) {
+        if (gg_buffer_eq(header.name, GG_STR("operation"))
+            && (header.value.type == EVENTSTREAM_STRING)) {
+            operation = header.value.string;
+        }
+    }
+
+    static uint8_t decode_mem[GG_IPC_MAX_MSG_LEN];
+    GgArena arena = gg_arena_init(GG_BUF(decode_mem));
+    GgObject request;
+    ret = gg_json_decode_destructive(msg->payload, &arena, &request);
+    if ((ret != GG_ERR_OK) || (gg_obj_type(request) != GG_TYPE_MAP)) {
+        return GG_ERR_PARSE;
+    }
+    GgMap args = gg_obj_into_map(request);
+
+    if (gg_buffer_eq(operation, GG_STR("aws.greengrass#PublishToTopic"))) {
+        return server_publish(fd, common.stream_id, args);
+    }
+    if (gg_buffer_eq(operation, GG_STR("aws.greengrass#SubscribeToTopic"))) {
+        return server_subscribe(fd, common.stream_id, args);
+    }
+    if (gg_buffer_eq(operation, GG_STR("aws.greengrass#GetConfiguration"))) {
+        return server_respond(
+            fd,
+            common.stream_id,
+            GG_STR("aws.greengrass#GetConfigurationResponse"),
+            gg_obj_map(GG_MAP(
+                gg_kv(GG_STR("componentName"), gg_obj_buf(GG_STR("bench"))),
+                gg_kv(
+                    GG_STR("value"),
+                    gg_obj_map(GG_MAP(gg_kv(
+                        GG_STR(CONFIG_KEY), gg_obj_buf(GG_STR(CONFIG_VALUE))
+                    )))
+                )
+            ))
+        );
+    }
+
+    GgObject error = gg_obj_map(GG_MAP(gg_kv(
+        GG_STR("_errorCode"), gg_obj_buf(GG_STR("UnsupportedOperation"))
+    )));
+    return server_send(
+        fd,
+        EVENTSTREAM_APPLICATION_ERROR,
+        EVENTSTREAM_TERMINATE_STREAM,
+        common.stream_id,
+        GG_STR("aws.greengrass#UnsupportedOperation"),
+        &error
+    );
+}
+
+/// Serve one client connection until it disconnects.
+static GgError server_run(int listen_fd) {
+    int fd;
+    do {
+        fd = accept(listen_fd, NULL, NULL);
+    } while ((fd < 0) && (errno == EINTR));
+    if (fd < 0) {
+        return GG_ERR_FAILURE;
+    }
+    GG_CLEANUP(cleanup_close, fd);
+
+    static uint8_t recv_mem[GG_IPC_MAX_MSG_LEN];
+    EventStreamMessage msg;
+    GgError ret
+        = eventsteam_get_packet(gg_socket_reader(&fd), &msg, GG_BUF(recv_mem));
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    ret = server_send(
+        fd,
+        EVENTSTREAM_CONNECT_ACK,
+        EVENTSTREAM_CONNECTION_ACCEPTED,
+        0,
+        GG_STR(""),
+        NULL
+    );
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    while (eventsteam_get_packet(
+               gg_socket_reader(&fd), &msg, GG_BUF(recv_mem)
+           )
+           == GG_ERR_OK) {
+        uint64_t start = gg_bench_now_ns();
+        ret = server_handle(fd, &msg);
+        atomic_fetch_add_explicit(
+            server_busy_ns, gg_bench_now_ns() - start, memory_order_relaxed
+        );
+        if (ret != GG_ERR_OK) {
+            fprintf(stderr, "Nucleus stand-in failed (%d).\n", (int) ret);
+            return ret;
+        }
+    }
+    return GG_ERR_OK;
+}
+
+//
+// Load generator
+//
+
+typedef struct {
+    Workload workload;
+    size_t index;
+    uint64_t *samples;
+    size_t sample_count;
+    size_t errors;
+} Worker;
+
+/// Publish-to-callback latencies, written only by the receive thread.
+static uint64_t *delivery_samples;
+static size_t delivery_capacity;
+static atomic_size_t delivery_count;
+
+static void on_message(
+    void *ctx, GgBuffer topic, GgObject payload, GgIpcSubscriptionHandle handle
+) {
+    (void) ctx;
+    (void) topic;
+    (void) handle;
+    uint64_t now = gg_bench_now_ns();
+
+    if (gg_obj_type(payload) != GG_TYPE_BUF) {
+        return;
+    }
+    GgBuffer buf = gg_obj_into_buf(payload);
+    uint64_t sent;
+    if (buf.len < sizeof(sent)) {
+        return;
+    }
+    memcpy(&sent, buf.data, sizeof(sent));
+
+    size_t count = atomic_load_explicit(&delivery_count, memory_order_relaxed);
+    if (count < delivery_capacity) {
+        delivery_samples[count] = now - sent;
+        atomic_store_explicit(&delivery_count, count + 1, memory_order_release);
+    }
+}
+
+static void *worker_run(void *ctx) {
+    Worker *worker = ctx;
+    uint8_t *payload_mem = calloc(payload_len, 1);
+    if (payload_mem == NULL) {
+        worker->errors = request_count;
+        return NULL;
+    }
+    GgBuffer payload = { .data = payload_mem, .len = payload_len };
+
+    for (size_t i = 0; i < request_count; i++) {
+        bool get_config = (worker->workload == WORKLOAD_GET_CONFIG)
+            || ((worker->workload == WORKLOAD_MIXED) && (i % 4 == 3));
+
+        uint64_t start = gg_bench_now_ns();
+        GgError ret;
+        if (get_config) {
+            uint8_t value_mem[sizeof(CONFIG_VALUE)];
+            GgBuffer value = GG_BUF(value_mem);
+            ret = ggipc_get_config_str(
+                GG_BUF_LIST(GG_STR(CONFIG_KEY)), NULL, &value
+            );
+        } else {
+            memcpy(payload.data, &start, sizeof(start));
+            ret = ggipc_publish_to_topic_binary(
+                topics[(worker->index + i) % topic_count], payload
+            );
+        }
+        uint64_t end = gg_bench_now_ns();
+
+        if (ret != GG_ERR_OK) {
+            worker->errors += 1;
+        } else {
+            worker->samples[worker->sample_count] = end - start;
+            worker->sample_count += 1;
+        }
+    }
+
+    free(payload_mem);
+    return NULL;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+/// Nearest-rank percentile of sorted samples, in microseconds.
+static double percentile_us(
+    const uint64_t *sorted, size_t count, size_t per_mille
+) {
+    if (count == 0) {
+        return 0.0;
+    }
+    size_t rank = ((count * per_mille) + 999) / 1000;
+    return (double) sorted[(rank == 0) ? 0 : rank - 1] / 1000.0;
+}
+
+static void report(
+    Workload workload,
+    uint64_t *samples,
+    size_t count,
+    size_t errors,
+    uint64_t elapsed_ns,
+    uint64_t server_ns
+) {
+    qsort(samples, count, sizeof(samples[0]), compare_u64);
+    double seconds = (double) elapsed_ns / 1e9;
+    double server_busy
+        = (elapsed_ns == 0) ? 0.0 : (double) server_ns / (double) elapsed_ns;
+
+    printf(
+        "{\"bench\":\"ipc_load/%s\",\"threads\":%zu,\"topics\":%zu,"
+        "\"payload_bytes\":%zu,\"ops\":%zu,\"errors\":%zu,\"seconds\":%.3f,"
+        "\"ops_per_sec\":%.1f,\"p50_us\":%.1f,\"p99_us\":%.1f,"
+        "\"p999_us\":%.1f,\"max_us\":%.1f,\"server_busy\":%.3f}\n",
+        WORKLOAD_NAMES[workload],
+        thread_count,
+        topic_count,
+        payload_len,
+        count,
+        errors,
+        seconds,
+        (seconds > 0.0) ? (double) count / seconds : 0.0,
+        percentile_us(samples, count, 500),
+        percentile_us(samples, count, 990),
+        percentile_us(samples, count, 999),
+        percentile_us(samples, count, 1000),
+        server_busy
+    );
+    fflush(stdout);
+}
+
+static void close_subscriptions(GgIpcSubscriptionHandle *handles, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        ggipc_close_subscription(handles[i]);
+    }
+}
+
+static GgError run_workload(Workload workload) {
+    bool subscribe
+        = (workload == WORKLOAD_FAN_IN) || (workload == WORKLOAD_MIXED);
+    size_t total = thread_count * request_count;
+
+    GgIpcSubscriptionHandle handles[MAX_TOPICS];
+    size_t handle_count = 0;
+    atomic_store_explicit(&delivery_count, 0, memory_order_relaxed);
+
+    GgError ret = GG_ERR_OK;
+    if (subscribe) {
+        for (; handle_count < topic_count; handle_count++) {
+            ret = ggipc_subscribe_to_topic(
+                topics[handle_count], on_message, NULL, &handles[handle_count]
+            );
+            if (ret != GG_ERR_OK) {
+                close_subscriptions(handles, handle_count);
+                return ret;
+            }
+        }
+    }
+
+    Worker *workers = calloc(thread_count, sizeof(Worker));
+    uint64_t *samples = calloc(total, sizeof(uint64_t));
+    pthread_t *threads = calloc(thread_count, sizeof(pthread_t));
+    if ((workers == NULL) || (samples == NULL) || (threads == NULL)) {
+        ret = GG_ERR_NOMEM;
+    }
+
+    size_t started = 0;
+    uint64_t server_start
+        = atomic_load_explicit(server_busy_ns, memory_order_relaxed);
+    uint64_t start = gg_bench_now_ns();
+    for (; (ret == GG_ERR_OK) && (started < thread_count); started++) {
+        workers[started] = (Worker) {
+            .workload = workload,
+            .index = started,
+            .samples = &samples[started * request_count],
+        };
+        if (pthread_create(
+                &threads[started], NULL, worker_run, &workers[started]
+            )
+            != 0) {
+            ret = GG_ERR_FAILURE;
+            break;
+        }
+    }
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    size_t count = 0;
+    size_t errors = 0;
+    for (size_t i = 0; i < started; i++) {
+        // Compact each worker's samples into one array
+        memmove(
+            &samples[count],
+            workers[i].samples,
+            workers[i].sample_count * sizeof(uint64_t)
+        );
+        count += workers[i].sample_count;
+        errors += workers[i].errors;
+    }
+
+    if ((ret == GG_ERR_OK) && (workload == WORKLOAD_FAN_IN)) {
+        // Each successful publish is delivered to one subscription
+        uint64_t deadline = gg_bench_now_ns() + DELIVERY_TIMEOUT_NS;
+        while ((atomic_load_explicit(&delivery_count, memory_order_acquire)
+                < count)
+               && (gg_bench_now_ns() < deadline)) {
+            sched_yield();
+        }
+        size_t delivered
+            = atomic_load_explicit(&delivery_count, memory_order_acquire);
+        errors += count - delivered;
+        memcpy(samples, delivery_samples, delivered * sizeof(uint64_t));
+        count = delivered;
+    }
+    uint64_t elapsed = gg_bench_now_ns() - start;
+    uint64_t server_ns
+        = atomic_load_explicit(server_busy_ns, memory_order_relaxed)
+        - server_start;
+
+    close_subscriptions(handles, handle_count);
+
+    if (ret == GG_ERR_OK) {
+        report(workload, samples, count, errors, elapsed, server_ns);
+    }
+
+    free(threads);
+    free(samples);
+    free(workers);
+    return ret;
+}
+
+static bool parse_size(const char *arg, size_t min, size_t max, size_t *out) {
+    char *end;
+    errno = 0;
+    unsigned long long val = strtoull(arg, &end, 10);
+    if ((errno != 0) || (end == arg) || (*end != '\0') || (val < min)
+        || (val > max)) {
+        return false;
+    }
+    *out = (size_t) val;
+    return true;
+}
+
+static void usage(const char *name) {
+    fprintf(
+        stderr,
+        "Usage: %s [-w publish|fan_in|get_config|mixed|all] [-t threads]\n"
+        "       [-m topics] [-n requests per thread] [-s payload bytes]\n",
+        name
+    );
+}
+
+static GgError parse_args(int argc, char **argv, bool run[WORKLOAD_COUNT]) {
+    bool all = true;
+    int opt;
+    while ((opt = getopt(argc, argv, "hw:t:m:n:s:")) != -1) {
+        bool ok = true;
+        switch (opt) {
+        case 'w':
+            ok = strcmp(optarg, "all") == 0;
+            for (size_t i = 0; !ok && (i < WORKLOAD_COUNT); i++) {
+                if (strcmp(optarg, WORKLOAD_NAMES[i]) == 0) {
+                    run[i] = true;
+                    all = false;
+                    ok = true;
+                }
+            }
+            break;
+        case 't':
+            ok = parse_size(optarg, 1, GG_IPC_MAX_STREAMS, &thread_count);
+            break;
+        case 'm':
+            ok = parse_size(optarg, 1, MAX_TOPICS, &topic_count);
+            break;
+        case 'n':
+            ok = parse_size(optarg, 1, SIZE_MAX / 1024, &request_count);
+            break;
+        case 's':
+            ok = parse_size(optarg, sizeof(uint64_t), 4096, &payload_len);
+            break;
+        default:
+            ok = false;
+            break;
+        }
+        if (!ok) {
+            usage(argv[0]);
+            return GG_ERR_INVALID;
+        }
+    }
+    if (optind != argc) {
+        usage(argv[0]);
+        return GG_ERR_INVALID;
+    }
+
+    for (size_t i = 0; i < WORKLOAD_COUNT; i++) {
+        run[i] = run[i] || all;
+    }
+
+    // Requests and subscriptions share the client's stream slots
+    if ((run[WORKLOAD_FAN_IN] || run[WORKLOAD_MIXED])
+        && (thread_count + topic_count > GG_IPC_MAX_STREAMS)) {
+        fprintf(
+            stderr,
+            "Subscribing workloads need threads + topics <= %d.\n",
+            GG_IPC_MAX_STREAMS
+        );
+        return GG_ERR_INVALID;
+    }
+    return GG_ERR_OK;
+}
+
+static GgError listen_socket(const char *path, int *fd) {
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        return GG_ERR_RANGE;
+    }
+    strcpy(addr.sun_path, path);
+
+    int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (sock < 0) {
+        return GG_ERR_FAILURE;
+    }
+    if ((bind(sock, (struct sockaddr *) &addr, sizeof(addr)) != 0)
+        || (listen(sock, 1) != 0)) {
+        (void) close(sock);
+        return GG_ERR_FAILURE;
+    }
+    *fd = sock;
+    return GG_ERR_OK;
+}
+
+static GgError run_client(const char *socket_path, bool run[WORKLOAD_COUNT]) {
+    // Per-message debug logs would dominate the measurements
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    if (getenv("GG_LOG_LEVELS") == NULL) {
+        gg_log_set_level(NULL, GG_LOG_WARN);
+    }
+
+    gg_sdk_init();
+
+    GgError ret = ggipc_connect_with_token(
+        gg_buffer_from_null_term((char *) socket_path), GG_STR("bench")
+    );
+    if (ret != GG_ERR_OK) {
+        fprintf(stderr, "Failed to connect to nucleus stand-in.\n");
+        return ret;
+    }
+
+    for (size_t i = 0; i < topic_count; i++) {
+        int len = snprintf(
+            (char *) topic_mem[i], TOPIC_NAME_LEN, "bench/topic/%zu", i
+        );
+        topics[i] = (GgBuffer) { .data = topic_mem[i], .len = (size_t) len };
+    }
+
+    delivery_capacity = thread_count * request_count;
+    delivery_samples = calloc(delivery_capacity, sizeof(uint64_t));
+    if (delivery_samples == NULL) {
+        return GG_ERR_NOMEM;
+    }
+
+    for (size_t i = 0; (ret == GG_ERR_OK) && (i < WORKLOAD_COUNT); i++) {
+        if (run[i]) {
+            ret = run_workload((Workload) i);
+        }
+    }
+    if (ret != GG_ERR_OK) {
+        fprintf(stderr, "Benchmark ipc_load failed (%d).\n", (int) ret);
+    }
+    return ret;
+}
+
+int main(int argc, char **argv) {
+    bool run[WORKLOAD_COUNT] = { 0 };
+    if (parse_args(argc, argv, run) != GG_ERR_OK) {
+        return 2;
+    }
+
+    server_busy_ns = mmap(
+        NULL,
+        sizeof(*server_busy_ns),
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_ANONYMOUS,
+        -1,
+        0
+    );
+    if (server_busy_ns == MAP_FAILED) {
+        return 1;
+    }
+
+    char dir[] = "/tmp/gg-ipc-load-XXXXXX";
+    if (mkdtemp(dir) == NULL) {
+        return 1;
+    }
+    char socket_path[sizeof(dir) + sizeof("/ipc.socket")];
+    snprintf(socket_path, sizeof(socket_path), "%s/ipc.socket", dir);
+
+    int listen_fd;
+    GgError ret = listen_socket(socket_path, &listen_fd);
+    if (ret != GG_ERR_OK) {
+        (void) rmdir(dir);
+        return 1;
+    }
+
+    // The client exits the process if its connection is closed, so the
+    // stand-in runs until this process exits and closes its end
+    pid_t server = fork();
+    if (server == 0) {
+        // Reading end of stream on client exit is expected
+        gg_log_set_level(NULL, GG_LOG_NONE);
+        _exit((server_run(listen_fd) == GG_ERR_OK) ? 0 : 1);
+    }
+    (void) close(listen_fd);
+    ret = (server < 0) ? GG_ERR_FAILURE : run_client(socket_path, run);
+
+    (void) unlink(socket_path);
+    (void) rmdir(dir);
+    return (ret == GG_ERR_OK) ? 0 : 1;
+}
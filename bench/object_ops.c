@@ -0,0 +1,217 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+//! Benchmarks object traversal, lookup, schema validation, and arena copies
+//! on a document shaped like an IPC response.
+
+#include "bench.h"
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/json_decode.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <gg/object_visit.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char DOC[]
+    = "{\"componentName\":\"com.example.Sensor\","
+      "\"version\":\"1.2.3\","
+      "\"topic\":\"sensors/temperature/room-1\","
+      "\"qos\":1,"
+      "\"retain\":false,"
+      "\"timestamp\":1712345678901,"
+      "\"ratio\":0.75,"
+      "\"tags\":[\"indoor\",\"floor-2\",\"calibrated\"],"
+      "\"limits\":{\"min\":-40,\"max\":125,\"unit\":\"C\"},"
+      "\"readings\":[21.5,21.6,21.4,21.7,21.5,21.6,21.8,21.5],"
+      "\"status\":\"OK\","
+      "\"message\":\"Nominal operation\","
+      "\"region\":\"us-west-2\","
+      "\"thingName\":\"sensor-gateway-01\","
+      "\"sequence\":4096,"
+      "\"enabled\":true}";
+
+/// Top-level keys in DOC.
+#define DOC_KEYS 16
+
+/// Objects in DOC, including the root.
+#define DOC_NODES 31
+
+typedef struct {
+    GgMap map;
+    GgBuffer keys[DOC_KEYS];
+    GgMapCompiledSchema compiled;
+    GgBuffer arena_mem;
+} ObjectOpsCtx;
+
+static GgObject *validated[8];
+
+static const GgMapSchemaEntry SCHEMA[] = {
+    { GG_STR("componentName"), GG_REQUIRED, GG_TYPE_BUF, &validated[0] },
+    { GG_STR("topic"), GG_REQUIRED, GG_TYPE_BUF, &validated[1] },
+    { GG_STR("qos"), GG_REQUIRED, GG_TYPE_I64, &validated[2] },
+    { GG_STR("retain"), GG_OPTIONAL, GG_TYPE_BOOLEAN, &validated[3] },
+    { GG_STR("tags"), GG_OPTIONAL, GG_TYPE_LIST, &validated[4] },
+    { GG_STR("limits"), GG_OPTIONAL, GG_TYPE_MAP, &validated[5] },
+    { GG_STR("sequence"), GG_OPTIONAL, GG_TYPE_I64, &validated[6] },
+    { GG_STR("correlationId"), GG_OPTIONAL, GG_TYPE_BUF, &validated[7] },
+};
+
+#define SCHEMA_LEN (sizeof(SCHEMA) / sizeof(SCHEMA[0]))
+
+static GgError count_node(void *ctx) {
+    *(size_t *) ctx += 1;
+    return GG_ERR_OK;
+}
+
+static GgError count_bool(void *ctx, bool val) {
+    (void) val;
+    return count_node(ctx);
+}
+
+static GgError count_i64(void *ctx, int64_t val) {
+    (void) val;
+    return count_node(ctx);
+}
+
+static GgError count_f64(void *ctx, double val) {
+    (void) val;
+    return count_node(ctx);
+}
+
+static GgError count_buf(void *ctx, GgBuffer val, GgObject obj[static 1]) {
+    (void) val;
+    (void) obj;
+    return count_node(ctx);
+}
+
+static GgError count_list(void *ctx, GgList val, GgObject obj[static 1]) {
+    (void) val;
+    (void) obj;
+    return count_node(ctx);
+}
+
+static GgError count_map(void *ctx, GgMap val, GgObject obj[static 1]) {
+    (void) val;
+    (void) obj;
+    return count_node(ctx);
+}
+
+static const GgObjectVisitHandlers COUNT_HANDLERS = {
+    .on_null = count_node,
+    .on_bool = count_bool,
+    .on_i64 = count_i64,
+    .on_f64 = count_f64,
+    .on_buf = count_buf,
+    .on_list = count_list,
+    .on_map = count_map,
+};
+
+static GgError bench_visit(void *ctx) {
+    ObjectOpsCtx *args = ctx;
+    GgObject obj = gg_obj_map(args->map);
+    size_t count = 0;
+    GgError ret = gg_obj_visit(&COUNT_HANDLERS, &count, &obj);
+    if ((ret == GG_ERR_OK) && (count != DOC_NODES)) {
+        return GG_ERR_FAILURE;
+    }
+    return ret;
+}
+
+static GgError bench_map_get(void *ctx) {
+    ObjectOpsCtx *args = ctx;
+    for (size_t i = 0; i < DOC_KEYS; i++) {
+        if (!gg_map_get(args->map, args->keys[i], NULL)) {
+            return GG_ERR_NOENTRY;
+        }
+    }
+    return GG_ERR_OK;
+}
+
+static GgError bench_validate(void *ctx) {
+    ObjectOpsCtx *args = ctx;
+    GgMapSchema schema = { .entries = SCHEMA, .entry_count = SCHEMA_LEN };
+    return gg_map_validate(args->map, schema);
+}
+
+static GgError bench_validate_cached(void *ctx) {
+    ObjectOpsCtx *args = ctx;
+    static GgMapSchemaCache cache = { 0 };
+    GgMapSchema schema = { .entries = SCHEMA, .entry_count = SCHEMA_LEN };
+    return gg_map_validate_cached(&cache, args->map, schema);
+}
+
+static GgError bench_validate_compiled(void *ctx) {
+    ObjectOpsCtx *args = ctx;
+    GgObject *values[SCHEMA_LEN];
+    return gg_map_validate_compiled(args->map, &args->compiled, values);
+}
+
+static GgError bench_claim(void *ctx) {
+    ObjectOpsCtx *args = ctx;
+    GgArena arena = gg_arena_init(args->arena_mem);
+    GgObject obj = gg_obj_map(args->map);
+    return gg_arena_claim_obj(&obj, &arena);
+}
+
+int main(void) {
+    static uint8_t json_mem[sizeof(DOC)];
+    static uint8_t decode_mem[DOC_NODES * sizeof(GgKV)];
+    static uint8_t arena_mem[sizeof(DOC) + (DOC_NODES * sizeof(GgKV))];
+
+    memcpy(json_mem, DOC, sizeof(DOC));
+    GgArena arena = gg_arena_init(GG_BUF(decode_mem));
+    GgObject obj;
+    GgError ret = gg_json_decode_destructive(
+        (GgBuffer) { .data = json_mem, .len = sizeof(DOC) - 1 }, &arena, &obj
+    );
+    if ((ret != GG_ERR_OK) || (gg_obj_type(obj) != GG_TYPE_MAP)) {
+        return 1;
+    }
+
+    ObjectOpsCtx ctx = {
+        .map = gg_obj_into_map(obj),
+        .arena_mem = GG_BUF(arena_mem),
+    };
+    if (ctx.map.len != DOC_KEYS) {
+        return 1;
+    }
+    for (size_t i = 0; i < DOC_KEYS; i++) {
+        ctx.keys[i] = gg_kv_key(ctx.map.pairs[i]);
+    }
+
+    ret = gg_map_schema_compile(
+        (GgMapSchema) { .entries = SCHEMA, .entry_count = SCHEMA_LEN },
+        &ctx.compiled
+    );
+
+    if (ret == GG_ERR_OK) {
+        ret = gg_bench_run("obj_visit", DOC_NODES, bench_visit, &ctx);
+    }
+    if (ret == GG_ERR_OK) {
+        ret = gg_bench_run("map_get", DOC_KEYS, bench_map_get, &ctx);
+    }
+    if (ret == GG_ERR_OK) {
+        ret = gg_bench_run("map_validate", SCHEMA_LEN, bench_validate, &ctx);
+    }
+    if (ret == GG_ERR_OK) {
+        ret = gg_bench_run(
+            "map_validate_cached", SCHEMA_LEN, bench_validate_cached, &ctx
+        );
+    }
+    if (ret == GG_ERR_OK) {
+        ret = gg_bench_run(
+            "map_validate_compiled", SCHEMA_LEN, bench_validate_compiled, &ctx
+        );
+    }
+    if (ret == GG_ERR_OK) {
+        ret = gg_bench_run("arena_claim_obj", DOC_NODES, bench_claim, &ctx);
+    }
+
+    return (ret == GG_ERR_OK) ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+//! Benchmarks decode/visit cost against object size.
+//! Per-node cost should stay flat as documents grow.
+
+#include "bench.h"
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/json_decode.h>
+#include <gg/json_encode.h>
+#include <gg/object.h>
+#include <gg/vector.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// Keys per map in the nested document.
+#define MAP_WIDTH 64
+
+typedef struct {
+    GgBuffer json;
+    GgBuffer decode_mem;
+    GgBuffer encode_mem;
+    GgObject obj;
+} ScalingCtx;
+
+static GgBuffer gen_flat_list(size_t count) {
+    size_t cap = 2 + (count * 12);
+    uint8_t *mem = malloc(cap);
+    if (mem == NULL) {
+        return (GgBuffer) { 0 };
+    }
+    size_t len = 0;
+    mem[len++] = '[';
+    for (size_t i = 0; i < count; i++) {
+        len += (size_t) snprintf(
+            (char *) &mem[len], cap - len, (i == 0) ? "%zu" : ",%zu", i
+        );
+    }
+    mem[len++] = ']';
+    return (GgBuffer) { .data = mem, .len = len };
+}
+
+static GgBuffer gen_nested_maps(size_t map_count) {
+    size_t cap = 2 + (map_count * (3 + (MAP_WIDTH * 24)));
+    uint8_t *mem = malloc(cap);
+    if (mem == NULL) {
+        return (GgBuffer) { 0 };
+    }
+    size_t len = 0;
+    mem[len++] = '[';
+    for (size_t i = 0; i < map_count; i++) {
+        if (i != 0) {
+            mem[len++] = ',';
+        }
+        mem[len++] = '{';
+        for (size_t j = 0; j < MAP_WIDTH; j++) {
+            len += (size_t) snprintf(
+                (char *) &mem[len],
+                cap - len,
+                (j == 0) ? "\"key%zu\":[%zu,\"v\"]" : ",\"key%zu\":[%zu,\"v\"]",
+                j,
+                i
+            );
+        }
+        mem[len++] = '}';
+    }
+    mem[len++] = ']';
+    return (GgBuffer) { .data = mem, .len = len };
+}
+
+static GgError bench_decode(void *ctx) {
+    ScalingCtx *args = ctx;
+    GgArena arena = gg_arena_init(args->decode_mem);
+    // Input has no escapes, so destructive decode leaves it unchanged
+    return gg_json_decode_destructive(args->json, &arena, &args->obj);
+}
+
+static GgError bench_visit(void *ctx) {
+    ScalingCtx *args = ctx;
+    size_t size;
+    return gg_obj_mem_usage(args->obj, &size);
+}
+
+static GgError bench_encode(void *ctx) {
+    ScalingCtx *args = ctx;
+    GgByteVec vec = gg_byte_vec_init(args->encode_mem);
+    return gg_json_encode(args->obj, gg_byte_vec_writer(&vec));
+}
+
+static GgError run_doc(const char *kind, GgBuffer json, size_t nodes) {
+    if (json.data == NULL) {
+        return GG_ERR_NOMEM;
+    }
+
+    ScalingCtx ctx = {
+        .json = json,
+        .decode_mem = { .data = malloc(nodes * sizeof(GgKV)),
+                        .len = nodes * sizeof(GgKV) },
+        .encode_mem = { .data = malloc(json.len), .len = json.len },
+    };
+
+    GgError ret = GG_ERR_NOMEM;
+    if ((ctx.decode_mem.data != NULL) && (ctx.encode_mem.data != NULL)) {
+        char name[64];
+        snprintf(name, sizeof(name), "json_decode/%s", kind);
+        ret = gg_bench_run(name, nodes, bench_decode, &ctx);
+        if (ret == GG_ERR_OK) {
+            snprintf(name, sizeof(name), "obj_visit/%s", kind);
+            ret = gg_bench_run(name, nodes, bench_visit, &ctx);
+        }
+        if (ret == GG_ERR_OK) {
+            snprintf(name, sizeof(name), "json_encode/%s", kind);
+            ret = gg_bench_run(name, nodes, bench_encode, &ctx);
+        }
+    }
+
+    free(ctx.encode_mem.data);
+    free(ctx.decode_mem.data);
+    free(json.data);
+    return ret;
+}
+
+int main(void) {
+    GgError ret = gg_obj_set_limits((GgObjectLimits) {
+        .max_depth = GG_MAX_OBJECT_DEPTH,
+        .max_subobjects = SIZE_MAX,
+    });
+    if (ret != GG_ERR_OK) {
+        return 1;
+    }
+
+    static const size_t SIZES[] = { 1000, 4000, 16000, 64000 };
+
+    for (size_t i = 0; i < sizeof(SIZES) / sizeof(SIZES[0]); i++) {
+        size_t count = SIZES[i];
+        ret = run_doc("flat_list", gen_flat_list(count), count);
+        if (ret != GG_ERR_OK) {
+            return 1;
+        }
+    }
+
+    for (size_t i = 0; i < sizeof(SIZES) / sizeof(SIZES[0]); i++) {
+        // Each map entry contributes key, value list, and two list items
+        size_t map_count = SIZES[i] / (MAP_WIDTH * 4);
+        size_t nodes = map_count * (1 + (MAP_WIDTH * 4));
+        ret = run_doc("nested_maps", gen_nested_maps(map_count), nodes);
+        if (ret != GG_ERR_OK) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -21,7 +21,9 @@ public:
     constexpr Arena(void *bytes, std::size_t size_bytes) noexcept
         : GgArena { .mem = static_cast<std::uint8_t *>(bytes),
                     .capacity = saturate_cast<std::uint32_t>(size_bytes),
-                    .index = 0 } {
+                    .index = 0,
+                    .chain = nullptr,
+                    .intern = nullptr } {
     }
 
     constexpr Arena &operator=(const Arena &) noexcept = default;
@@ -44,6 +46,18 @@ public:
     ) noexcept {
         return gg_arena_alloc(this, size, alignment);
     }
+
+    GgArenaState save() const noexcept {
+        return gg_arena_save(this);
+    }
+
+    void restore(GgArenaState state) noexcept {
+        gg_arena_restore(this, state);
+    }
+
+    void reset() noexcept {
+        gg_arena_reset(this);
+    }
 };
 
 }
@@ -90,6 +90,9 @@ public:
     ) = 0;
 };
 
+/// IPC client statistics. See `ggipc_get_stats`.
+using Stats = GgIpcStats;
+
 class Client {
 private:
     constexpr Client() noexcept = default;
@@ -179,6 +182,8 @@ public:
         ConfigurationUpdateCallback &callback,
         Subscription *handle = nullptr
     ) noexcept;
+
+    Stats get_stats() noexcept;
 };
 
 }
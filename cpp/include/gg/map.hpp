@@ -258,6 +258,16 @@ public:
             return kv.first == key;
         });
     }
+
+    /// Find using a hash index built over this map or a map containing it,
+    /// including within lists.
+    iterator find(key_type key, const GgMapIndex &index) const noexcept {
+        GgKV *found = gg_map_index_find(&index, *this, Buffer { key });
+        if (found == nullptr) {
+            return end();
+        }
+        return { static_cast<KV *>(found) };
+    }
 };
 
 } // namespace gg
@@ -30,7 +30,9 @@ using is_object_alternative = std::disjunction<
     std::is_same<T, std::span<uint8_t>>,
     std::is_same<std::string_view, T>,
     std::is_same<T, List>,
-    std::is_same<T, Map>>;
+    std::is_same<T, Map>,
+    std::is_same<T, std::span<double>>,
+    std::is_same<T, std::span<int64_t>>>;
 
 template <class T>
 constexpr bool is_object_alternative_v = is_object_alternative<T>::value;
@@ -44,7 +46,9 @@ public:
         double,
         ::std::span<uint8_t>,
         ::gg::List,
-        ::gg::Map>;
+        ::gg::Map,
+        ::std::span<double>,
+        ::std::span<int64_t>>;
 
     constexpr Object() noexcept = default;
 
@@ -80,6 +84,14 @@ public:
             return gg_obj_into_list(*this);
         case GG_TYPE_MAP:
             return gg_obj_into_map(*this);
+        case GG_TYPE_F64_ARRAY: {
+            GgF64Array arr = gg_obj_into_f64_array(*this);
+            return std::span { arr.items, arr.len };
+        }
+        case GG_TYPE_I64_ARRAY: {
+            GgI64Array arr = gg_obj_into_i64_array(*this);
+            return std::span { arr.items, arr.len };
+        }
         }
         abort();
     }
@@ -131,6 +143,14 @@ public:
         : GgObject { gg_obj_map(map) } {
     }
 
+    Object(std::span<double> items) noexcept
+        : GgObject { gg_obj_f64_array({ items.data(), items.size() }) } {
+    }
+
+    Object(std::span<int64_t> items) noexcept
+        : GgObject { gg_obj_i64_array({ items.data(), items.size() }) } {
+    }
+
     template <class T>
     Object &operator=(const T &value) noexcept
         requires(std::is_constructible_v<Object, T>)
@@ -189,6 +209,10 @@ template <ObjectType T> constexpr GgObjectType index_for_type() noexcept {
         return GG_TYPE_LIST;
     } else if constexpr (std::is_same_v<Type, Map>) {
         return GG_TYPE_MAP;
+    } else if constexpr (std::is_same_v<Type, std::span<double>>) {
+        return GG_TYPE_F64_ARRAY;
+    } else if constexpr (std::is_same_v<Type, std::span<int64_t>>) {
+        return GG_TYPE_I64_ARRAY;
     } else {
         return GG_TYPE_NULL;
     }
@@ -216,6 +240,12 @@ template <ObjectType T> std::optional<T> get_if(Object *obj) noexcept {
         return gg_obj_into_list(*obj);
     } else if constexpr (std::is_same_v<Type, Map>) {
         return gg_obj_into_map(*obj);
+    } else if constexpr (std::is_same_v<Type, std::span<double>>) {
+        GgF64Array arr = gg_obj_into_f64_array(*obj);
+        return Type { arr.items, arr.len };
+    } else if constexpr (std::is_same_v<Type, std::span<int64_t>>) {
+        GgI64Array arr = gg_obj_into_i64_array(*obj);
+        return Type { arr.items, arr.len };
     } else {
         return T {};
     }
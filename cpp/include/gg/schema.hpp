@@ -8,6 +8,9 @@
 #include <gg/error.hpp>
 #include <gg/map.hpp>
 #include <gg/object.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string_view>
 #include <system_error>
@@ -57,8 +60,38 @@ protected:
     }
 };
 
-template <MapSchemaType T> class MapSchema : MapSchemaBase<T> {
+/// FNV-1a hash of a map key
+constexpr uint32_t map_key_hash(std::string_view key) noexcept {
+    uint32_t hash = 0x811C9DC5U;
+    for (char c : key) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x01000193U;
+    }
+    return hash;
+}
+
+// Schema key with its hash precomputed, so validate_map can match each map
+// pair against all schemas in a single pass
+class MapSchemaKey {
+protected:
     std::string_view key;
+    uint32_t key_hash;
+
+    constexpr MapSchemaKey(std::string_view key) noexcept
+        : key { key }
+        , key_hash { map_key_hash(key) } {
+    }
+
+public:
+    constexpr bool matches(
+        std::string_view pair_key, uint32_t pair_hash
+    ) const noexcept {
+        return (pair_hash == key_hash) && (pair_key == key);
+    }
+};
+
+template <MapSchemaType T>
+class MapSchema : public MapSchemaKey, MapSchemaBase<T> {
     Object **object;
     T *entry;
 
@@ -66,20 +99,23 @@ public:
     constexpr MapSchema(
         std::string_view key, T &entry, Object *&object
     ) noexcept
-        : key { key }
+        : MapSchemaKey { key }
         , object { &object }
         , entry { &entry } {
     }
 
     constexpr MapSchema(std::string_view key, T &entry) noexcept
-        : key { key }
+        : MapSchemaKey { key }
         , object { nullptr }
         , entry { &entry } {
     }
 
     std::error_code validate(const Map &map) noexcept {
-        auto found = map.find(key);
+        return validate(map, map.find(key));
+    }
 
+    /// Validates the pair found for this key, or `map.end()` if none
+    std::error_code validate(const Map &map, Map::iterator found) noexcept {
         if (found == map.cend()) {
             return GG_ERR_NOENTRY;
         }
@@ -89,8 +125,7 @@ public:
 };
 
 template <MapSchemaType T>
-class MapSchema<std::optional<T>> : MapSchemaBase<T> {
-    std::string_view key;
+class MapSchema<std::optional<T>> : public MapSchemaKey, MapSchemaBase<T> {
     Object **object;
     std::optional<T> *entry;
 
@@ -98,20 +133,25 @@ public:
     constexpr MapSchema(
         std::string_view key, std::optional<T> &entry, Object *&object
     ) noexcept
-        : key { key }
+        : MapSchemaKey { key }
         , object { &object }
         , entry { &entry } {
     }
 
     constexpr MapSchema(std::string_view key, std::optional<T> &entry) noexcept
-        : key { key }
+        : MapSchemaKey { key }
         , object { nullptr }
         , entry { &entry } {
     }
 
     std::error_code validate(const Map &map) const noexcept {
-        auto found = map.find(key);
+        return validate(map, map.find(key));
+    }
 
+    /// Validates the pair found for this key, or `map.end()` if none
+    std::error_code validate(
+        const Map &map, Map::iterator found
+    ) const noexcept {
         if (found == map.cend()) {
             if (object != nullptr) {
                 *object = nullptr;
@@ -129,16 +169,20 @@ public:
     }
 };
 
-template <> class MapSchema<MissingKey> {
-    std::string_view key;
-
+template <> class MapSchema<MissingKey> : public MapSchemaKey {
 public:
     constexpr MapSchema(std::string_view key) noexcept
-        : key { key } {
+        : MapSchemaKey { key } {
     }
 
     std::error_code validate(const Map &map) const noexcept {
-        auto found = map.find(key);
+        return validate(map, map.find(key));
+    }
+
+    /// Validates the pair found for this key, or `map.end()` if none
+    std::error_code validate(
+        const Map &map, Map::iterator found
+    ) const noexcept {
         if (found == map.cend()) {
             return GG_ERR_OK;
         }
@@ -159,14 +203,33 @@ MapSchema(std::string_view, Object *&) -> MapSchema<Object>;
 
 MapSchema(std::string_view) -> MapSchema<MissingKey>;
 
+/// Validates a map against schemas in one pass over the map, matching each
+/// pair by its key hash. The first pair with a key is used, as with find.
 template <class... Ts, MapSchema<Ts>...>
 std::error_code validate_map(
     const Map &map, MapSchema<Ts> &&...schemas
 ) noexcept {
+    // Offset of the pair found for each schema, or the map length if none
+    auto len = static_cast<Map::difference_type>(map.size());
+    std::array<Map::difference_type, sizeof...(Ts)> found;
+    found.fill(len);
+
+    for (Map::difference_type pos = 0; pos < len; pos++) {
+        std::string_view key = map.begin()[pos].first;
+        uint32_t hash = map_key_hash(key);
+        size_t idx = 0;
+        (((found[idx] == len) && schemas.matches(key, hash)
+              ? (void) (found[idx] = pos)
+              : (void) 0,
+          idx++),
+         ...);
+    }
+
     std::error_code result = GG_ERR_OK;
-    (void) (((schemas.validate(map)) ? (result = schemas.validate(map), true)
-                                     : false)
-            || ...);
+    size_t idx = 0;
+    (void) ((result = schemas.validate(map, map.begin() + found[idx++]),
+             !result)
+            && ...);
     return result;
 }
 
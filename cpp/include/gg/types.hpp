@@ -38,12 +38,44 @@ typedef struct {
     size_t len;
 } GgMap;
 
+typedef struct {
+    double *items;
+    size_t len;
+} GgF64Array;
+
+typedef struct {
+    int64_t *items;
+    size_t len;
+} GgI64Array;
+
+struct GgArenaChain;
+struct GgInternTable;
+
 typedef struct {
     void *mem;
     uint32_t capacity;
     uint32_t index;
+    GgArenaChain *chain;
+    GgInternTable *intern;
 } GgArena;
 
+typedef struct {
+    void *mem;
+    uint32_t capacity;
+    uint32_t index;
+} GgArenaState;
+
+typedef struct {
+    const GgKV *pairs;
+    GgKV *kv;
+} GgMapIndexSlot;
+
+typedef struct {
+    GgMap map;
+    GgMapIndexSlot *slots;
+    size_t slot_mask;
+} GgMapIndex;
+
 /// Type tag for `GgObject`.
 // NOLINTNEXTLINE(performance-enum-size)
 typedef enum {
@@ -54,12 +86,53 @@ typedef enum {
     GG_TYPE_BUF,
     GG_TYPE_LIST,
     GG_TYPE_MAP,
+    GG_TYPE_F64_ARRAY,
+    GG_TYPE_I64_ARRAY,
 } GgObjectType;
 
 typedef struct {
     uint32_t val;
 } GgIpcSubscriptionHandle;
 
+#define GG_IPC_STATS_LATENCY_BUCKETS 26
+#define GG_IPC_STATS_MAX_OPERATIONS 16
+
+typedef struct {
+    uint64_t count;
+    uint64_t total_us;
+    uint64_t max_us;
+    uint64_t buckets[GG_IPC_STATS_LATENCY_BUCKETS];
+} GgIpcLatencyStats;
+
+typedef struct {
+    GgBuffer operation;
+    uint64_t requests;
+    uint64_t errors;
+    uint64_t timeouts;
+    GgIpcLatencyStats latency;
+} GgIpcOperationStats;
+
+typedef struct {
+    GgIpcOperationStats operations[GG_IPC_STATS_MAX_OPERATIONS];
+    size_t operation_count;
+    uint64_t requests_in_flight;
+    uint32_t streams_in_use;
+    uint32_t streams_in_use_peak;
+    uint32_t streams_max;
+    uint64_t stream_slot_failures;
+    uint64_t frames_sent;
+    uint64_t bytes_sent;
+    uint64_t frames_received;
+    uint64_t bytes_received;
+    uint64_t decode_failures;
+    uint64_t dropped_frames;
+    uint64_t timeouts;
+    uint64_t lock_acquisitions;
+    uint64_t lock_contended;
+    uint64_t lock_wait_ns;
+    GgIpcLatencyStats callbacks;
+} GgIpcStats;
+
 // NOLINTNEXTLINE(performance-enum-size)
 enum class GgComponentState {
     RUNNING,
@@ -84,6 +157,10 @@ GgBuffer gg_obj_into_buf(GgObject) noexcept;
 GgList gg_obj_into_list(GgObject) noexcept;
 [[gnu::const]]
 GgMap gg_obj_into_map(GgObject) noexcept;
+[[gnu::const]]
+GgF64Array gg_obj_into_f64_array(GgObject) noexcept;
+[[gnu::const]]
+GgI64Array gg_obj_into_i64_array(GgObject) noexcept;
 
 [[gnu::const]]
 GgObject gg_obj_bool(bool) noexcept;
@@ -97,6 +174,10 @@ GgObject gg_obj_buf(GgBuffer) noexcept;
 GgObject gg_obj_list(GgList) noexcept;
 [[gnu::const]]
 GgObject gg_obj_map(GgMap) noexcept;
+[[gnu::const]]
+GgObject gg_obj_f64_array(GgF64Array) noexcept;
+[[gnu::const]]
+GgObject gg_obj_i64_array(GgI64Array) noexcept;
 
 [[gnu::const]]
 GgKV gg_kv(GgBuffer, GgObject) noexcept;
@@ -106,10 +187,21 @@ GgObject *gg_kv_val(GgKV *) noexcept;
 GgBuffer gg_kv_key(GgKV) noexcept;
 void gg_kv_set_key(GgKV *kv, GgBuffer key) noexcept;
 
+GgError gg_map_index_build(
+    GgMap map, GgArena *arena, GgMapIndex *index
+) noexcept;
+GgKV *gg_map_index_find(
+    const GgMapIndex *index, GgMap map, GgBuffer key
+) noexcept;
+
 [[gnu::pure]]
 GgError gg_list_type_check(GgList list, GgObjectType type) noexcept;
 
 void *gg_arena_alloc(GgArena *arena, size_t size, size_t alignment) noexcept;
+[[gnu::pure]]
+GgArenaState gg_arena_save(const GgArena *arena) noexcept;
+void gg_arena_restore(GgArena *arena, GgArenaState state) noexcept;
+void gg_arena_reset(GgArena *arena) noexcept;
 
 GgError gg_obj_mem_usage(GgObject obj, size_t *size) noexcept;
 }
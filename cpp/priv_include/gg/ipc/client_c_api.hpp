@@ -75,6 +75,8 @@ GgError ggipc_update_state(GgComponentState state) noexcept;
 
 GgError ggipc_restart_component(GgBuffer component_name);
 
+void ggipc_get_stats(GgIpcStats *stats) noexcept;
+
 typedef void GgIpcSubscribeToConfigurationUpdateCallback(
     void *ctx,
     GgBuffer component_name,
@@ -43,6 +43,12 @@ int main() {
             ) << '\n';
         },
         [](const gg::List &list) { std::cout << list.size() << " items\n"; },
+        [](std::span<double> samples) {
+            std::cout << samples.size() << " floats\n";
+        },
+        [](std::span<int64_t> samples) {
+            std::cout << samples.size() << " integers\n";
+        },
         [](const gg::Map &pair_list) {
             std::cout << get<bool>(*pair_list["key"]) << '\n';
             std::cout << get<std::string_view>(*pair_list["another key"])
@@ -85,6 +85,12 @@ std::error_code Client::restart_component(
     return ggipc_restart_component(Buffer { component_name });
 }
 
+Stats Client::get_stats() noexcept {
+    Stats stats;
+    ggipc_get_stats(&stats);
+    return stats;
+}
+
 // NOLINTEND(readability-convert-member-functions-to-static)
 
 }
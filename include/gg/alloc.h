@@ -17,6 +17,7 @@ typedef struct {
     void (*const FREE)(void *ctx, void *ptr);
 } DESIGNATED_INIT GgAllocVtable;
 
+/// Generic allocator.
 typedef struct {
     const GgAllocVtable *const VTABLE;
     void *ctx;
@@ -32,11 +33,9 @@ typedef struct {
 
 /// Allocate memory from an allocator.
 /// Prefer `GG_ALLOC` or `GG_ALLOCN`.
-VISIBILITY(hidden)
 void *gg_alloc(GgAlloc alloc, size_t size, size_t alignment);
 
 /// Free memory allocated from an allocator.
-VISIBILITY(hidden)
 void gg_free(GgAlloc alloc, void *ptr);
 
 #endif
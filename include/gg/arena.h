@@ -7,6 +7,7 @@
 
 //! Arena allocation
 
+#include <gg/alloc.h>
 #include <gg/attr.h>
 #include <gg/buffer.h>
 #include <gg/error.h>
@@ -16,15 +17,40 @@
 #include <stddef.h>
 #include <stdint.h>
 
-/// Arena allocator backed by fixed buffer.
+/// Block of memory in a chained arena. Block memory follows the header.
+typedef struct GgArenaBlock {
+    struct GgArenaBlock *next;
+    uint32_t capacity;
+} GgArenaBlock;
+
+/// Blocks backing a chained arena.
+/// Blocks are retained for reuse when the arena is reset or restored, until
+/// freed with gg_arena_chain_free.
+typedef struct GgArenaChain {
+    GgAlloc alloc;
+    GgArenaBlock *first;
+    uint32_t block_size;
+} GgArenaChain;
+
+struct GgInternTable;
+
+/// Arena allocator backed by a fixed buffer, or by a chain of blocks.
+/// `mem`, `capacity`, and `index` describe the current buffer or block.
 typedef struct {
     uint8_t *mem;
     uint32_t capacity;
     uint32_t index;
+    /// Chain to grow into when the current block is full, or NULL.
+    GgArenaChain *chain;
+    /// Table to intern map keys stored into this arena by JSON decoding and
+    /// claiming, or NULL. See gg/intern.h.
+    struct GgInternTable *intern;
 } GgArena;
 
 /// Saved state of an arena allocator.
 typedef struct {
+    uint8_t *mem;
+    uint32_t capacity;
     uint32_t index;
 } GgArenaState;
 
@@ -35,6 +61,38 @@ inline GgArena gg_arena_init(GgBuffer buf) {
                                                          : UINT32_MAX };
 }
 
+/// Create an empty block chain allocating from `alloc`.
+/// Blocks are at least `block_size` bytes; larger allocations get a block of
+/// their own size.
+inline GgArenaChain gg_arena_chain_init(GgAlloc alloc, uint32_t block_size) {
+    return (GgArenaChain) { .alloc = alloc, .block_size = block_size };
+}
+
+/// Obtain an arena that grows block by block from `chain`.
+/// Chained arenas may be used with all arena APIs.
+inline GgArena gg_arena_init_chained(GgArenaChain *chain) {
+    return (GgArena) { .chain = chain };
+}
+
+/// Free all blocks of a chain.
+/// Arenas using the chain must be reinitialized before further use.
+ACCESS(read_write, 1)
+void gg_arena_chain_free(GgArenaChain *chain);
+
+/// Save the allocation state of an arena.
+PURE ACCESS(read_only, 1)
+GgArenaState gg_arena_save(const GgArena *arena);
+
+/// Restore an arena to a saved state, releasing all later allocations.
+/// States saved after `state` are invalidated. Chain blocks are kept for reuse.
+ACCESS(read_write, 1)
+void gg_arena_restore(GgArena *arena, GgArenaState state);
+
+/// Release all allocations from an arena.
+/// Chain blocks are kept for reuse.
+ACCESS(read_write, 1)
+void gg_arena_reset(GgArena *arena);
+
 /// Allocate a `type` from an arena.
 #define GG_ARENA_ALLOC(arena, type) \
     (typeof(type) *) gg_arena_alloc(arena, sizeof(type), alignof(type))
@@ -43,12 +101,13 @@ inline GgArena gg_arena_init(GgBuffer buf) {
     (typeof(type) *) gg_arena_alloc(arena, (n) * sizeof(type), alignof(type))
 
 /// Allocate `size` bytes with given alignment from an arena.
+/// Chained arenas move to a new block if the current one is full.
 /// Returns pointer to allocated memory, or NULL if insufficient space.
 /// Alignment must be a power of 2.
 ACCESS(read_write, 1)
 void *gg_arena_alloc(GgArena *arena, size_t size, size_t alignment);
 
-/// Resize the last allocated ptr.
+/// Resize the last allocated ptr in place.
 /// `ptr` must be the most recent allocation from `arena`.
 /// `old_size` must match the original allocation size.
 /// Returns GG_ERR_OK on success, GG_ERR_NOMEM if insufficient space,
@@ -59,17 +118,20 @@ GgError gg_arena_resize_last(
 );
 
 /// Check if arena's memory region contains ptr.
-/// Returns true if `ptr` is within the arena's memory range.
+/// Returns true if `ptr` is within the arena's memory range, or within a
+/// used block of a chained arena.
 PURE ACCESS(read_only, 1) ACCESS(none, 2)
 bool gg_arena_owns(const GgArena *arena, const void *ptr);
 
 /// Allocate all remaining space in the arena as a buffer.
-/// Returns a buffer containing all unallocated space.
+/// Returns a buffer containing all unallocated space in the current buffer or
+/// block.
 ACCESS(read_write, 1)
 GgBuffer gg_arena_alloc_rest(GgArena *arena);
 
 /// Modify an object's references to point into an arena.
 /// Copies buffers, lists, and maps that are not already in `arena`.
+/// If `arena` has an intern table, map keys use the interned copy instead.
 /// Updates `obj` in place to reference the copied data.
 /// Returns GG_ERR_OK on success, GG_ERR_NOMEM if insufficient space.
 ACCESS(read_write, 1) ACCESS(read_write, 2)
@@ -84,6 +146,7 @@ GgError gg_arena_claim_buf(GgBuffer buf[static 1], GgArena *arena);
 
 /// Modify buffer references in an object to point into an arena.
 /// Copies buffers and map keys that are not already in `arena`.
+/// If `arena` has an intern table, map keys use the interned copy instead.
 /// Does not copy list or map memory.
 /// Updates buffer pointers in place throughout the object tree.
 /// Returns GG_ERR_OK on success, GG_ERR_NOMEM if insufficient space.
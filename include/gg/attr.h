@@ -186,4 +186,14 @@
 #define ENUM_EXTENSIBILITY(type)
 #endif
 
+/// Marks hot-path accessors that are defined inline in headers when
+/// GG_INLINE_ACCESSORS is defined before including them. The SDK still
+/// exports these functions, so code built either way links against the same
+/// library.
+#ifdef GG_INLINE_ACCESSORS
+#define GG_ACCESSOR inline
+#else
+#define GG_ACCESSOR
+#endif
+
 #endif
@@ -14,6 +14,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#ifdef GG_INLINE_ACCESSORS
+#include <string.h>
+#endif
+
 #if defined __COVERITY__ || defined __CPROVER__
 #define GG_DISABLE_MACRO_TYPE_CHECKING
 #endif
@@ -73,7 +77,7 @@ PURE NULL_TERMINATED_STRING_ARG(1)
 GgBuffer gg_buffer_from_null_term(char str[static 1]);
 
 /// Returns whether two buffers have identical content.
-PURE
+PURE GG_ACCESSOR
 bool gg_buffer_eq(GgBuffer buf1, GgBuffer buf2);
 
 /// Returns whether the buffer has the given prefix.
@@ -135,4 +139,18 @@ GgError gg_str_to_int64(GgBuffer str, int64_t value[static 1]) CBMC_CONTRACT(
 /// On success, updates `target->len` to source.len and returns GG_ERR_OK.
 GgError gg_buf_copy(GgBuffer source, GgBuffer *target);
 
+#ifdef GG_INLINE_ACCESSORS
+
+GG_ACCESSOR bool gg_buffer_eq(GgBuffer buf1, GgBuffer buf2) {
+    if (buf1.len == buf2.len) {
+        if (buf1.len == 0) {
+            return true;
+        }
+        return memcmp(buf1.data, buf2.data, buf1.len) == 0;
+    }
+    return false;
+}
+
+#endif
+
 #endif
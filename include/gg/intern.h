@@ -0,0 +1,45 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GG_INTERN_H
+#define GG_INTERN_H
+
+//! String interning
+
+#include <gg/arena.h>
+#include <gg/attr.h>
+#include <gg/buffer.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/// Table of interned strings.
+/// Each distinct string is stored once in `storage`, so interned buffers with
+/// equal contents have the same data pointer. Not thread-safe.
+/// Setting an arena's `intern` field to a table makes JSON decoding and
+/// claiming into that arena intern map keys. Other strings are only interned
+/// where requested, such as topic names with ggipc_set_intern_table, so that
+/// one-off values do not fill the table.
+typedef struct GgInternTable {
+    GgArena *storage;
+    GgBuffer *slots;
+    size_t slot_mask;
+    size_t count;
+    size_t max_len;
+} GgInternTable;
+
+/// Create an intern table storing strings in `storage`.
+/// `slots` is the hash table, and `slot_count` must be a power of 2. Strings
+/// longer than `max_len` are not interned.
+ACCESS(read_write, 1) ACCESS(write_only, 2, 3)
+GgInternTable gg_intern_table_init(
+    GgArena *storage, GgBuffer *slots, size_t slot_count, size_t max_len
+);
+
+/// Replace `buf` with the interned copy of its contents.
+/// Returns false, leaving `buf` unchanged, if the string is empty or too long,
+/// or if the table or its storage is full.
+ACCESS(read_write, 1) ACCESS(read_write, 2)
+bool gg_intern(GgInternTable *table, GgBuffer *buf);
+
+#endif
@@ -10,8 +10,10 @@
 #include <gg/buffer.h>
 #include <gg/error.h>
 #include <gg/object.h>
+#include <stddef.h>
 #include <stdint.h>
 
+struct GgInternTable;
 struct timespec;
 
 /// Maximum number of eventstream streams. Limits active calls/subscriptions.
@@ -37,6 +39,22 @@ GgError ggipc_connect(void);
 /// Thread-safe alternative to ggipc_connect that does not call getenv.
 GgError ggipc_connect_with_token(GgBuffer socket_path, GgBuffer auth_token);
 
+/// Set the memory used for decoding received IPC payloads.
+/// Received objects are bounded by the size of this memory rather than by the
+/// runtime object limits; by default a static buffer of GG_IPC_DECODE_MEM_LEN
+/// bytes is used. `mem` must remain valid for the lifetime of the connection.
+/// Returns GG_ERR_INVALID if already connected.
+GgError ggipc_set_decode_mem(GgBuffer mem);
+
+/// Set an intern table for received IPC messages, or NULL to stop interning.
+/// Map keys and topic names in received messages then point into the table's
+/// storage, so they remain valid after callbacks return and can be compared
+/// by pointer. Claiming messages into an arena using the same table does not
+/// copy them again. The table is used on the IPC receive thread, so other
+/// threads must not use it concurrently; subscription callbacks may.
+/// Returns GG_ERR_INVALID if already connected.
+GgError ggipc_set_intern_table(struct GgInternTable *table);
+
 // Subscription management
 
 /// Handle for referring to a subscripion created by an IPC call.
@@ -47,6 +65,74 @@ typedef struct {
 /// Close a subscription returned by an IPC call.
 void ggipc_close_subscription(GgIpcSubscriptionHandle handle);
 
+// Statistics
+
+/// Number of buckets in a latency histogram.
+#define GG_IPC_STATS_LATENCY_BUCKETS 26
+
+/// Number of entries for per-operation statistics.
+/// Operations beyond this share the last entry, which has an empty name.
+#define GG_IPC_STATS_MAX_OPERATIONS 16
+
+/// Histogram of durations in microseconds.
+/// Bucket 0 counts durations under 1 us, and bucket `i` counts durations
+/// from 2^(i-1) us up to 2^i us. The last bucket also counts longer ones.
+typedef struct {
+    uint64_t count;
+    uint64_t total_us;
+    uint64_t max_us;
+    uint64_t buckets[GG_IPC_STATS_LATENCY_BUCKETS];
+} GgIpcLatencyStats;
+
+/// Statistics for requests of one IPC operation.
+typedef struct {
+    /// Operation name. Valid for the lifetime of the process.
+    GgBuffer operation;
+    uint64_t requests;
+    /// Requests that failed, including timeouts and remote errors.
+    uint64_t errors;
+    uint64_t timeouts;
+    /// Time from sending each request until it completes.
+    GgIpcLatencyStats latency;
+} GgIpcOperationStats;
+
+/// Statistics for the IPC client since process start.
+typedef struct {
+    GgIpcOperationStats operations[GG_IPC_STATS_MAX_OPERATIONS];
+    size_t operation_count;
+    /// Requests waiting for a response.
+    uint64_t requests_in_flight;
+    /// Stream slots in use by requests and subscriptions.
+    uint32_t streams_in_use;
+    uint32_t streams_in_use_peak;
+    /// Total stream slots (`GG_IPC_MAX_STREAMS`).
+    uint32_t streams_max;
+    /// Requests that failed because no stream slot was available.
+    uint64_t stream_slot_failures;
+    uint64_t frames_sent;
+    uint64_t bytes_sent;
+    uint64_t frames_received;
+    uint64_t bytes_received;
+    /// Received frames or payloads that could not be decoded.
+    uint64_t decode_failures;
+    /// Received frames dropped without reaching a handler.
+    uint64_t dropped_frames;
+    /// Timeouts waiting for responses or to send.
+    uint64_t timeouts;
+    /// Acquisitions of the client state lock.
+    uint64_t lock_acquisitions;
+    /// Acquisitions that had to wait for another thread.
+    uint64_t lock_contended;
+    uint64_t lock_wait_ns;
+    /// Time spent in response and subscription callbacks.
+    GgIpcLatencyStats callbacks;
+} GgIpcStats;
+
+/// Get a snapshot of IPC client statistics.
+/// Counters are read individually, so counters updated concurrently with
+/// this call may not be consistent with each other.
+void ggipc_get_stats(GgIpcStats *stats);
+
 // IPC calls
 
 /// Publish a JSON message to a local pub/sub topic.
@@ -59,7 +145,7 @@ GgError ggipc_publish_to_topic_json(GgBuffer topic, GgMap payload);
 /// Publish a binary message to a local pub/sub topic.
 /// Sends messages to other Greengrass components subscribed to the topic.
 /// Requires aws.greengrass#PublishToTopic authorization.
-/// Usage may incur memory overhead over using `ggipc_publish_to_topic_b64`
+/// The payload is base64 encoded directly into the request.
 /// See:
 /// <https://docs.aws.amazon.com/greengrass/v2/developerguide/ipc-publish-subscribe.html#ipc-operation-publishtotopic>
 GgError ggipc_publish_to_topic_binary(GgBuffer topic, GgBuffer payload);
@@ -71,6 +157,21 @@ GgError ggipc_publish_to_topic_binary(GgBuffer topic, GgBuffer payload);
 /// <https://docs.aws.amazon.com/greengrass/v2/developerguide/ipc-publish-subscribe.html#ipc-operation-publishtotopic>
 GgError ggipc_publish_to_topic_binary_b64(GgBuffer topic, GgBuffer b64_payload);
 
+/// Publish a pre-encoded JSON message to a local pub/sub topic.
+/// `json_payload` must be the JSON text of an object, and is sent verbatim.
+/// Requires aws.greengrass#PublishToTopic authorization.
+/// See:
+/// <https://docs.aws.amazon.com/greengrass/v2/developerguide/ipc-publish-subscribe.html#ipc-operation-publishtotopic>
+GgError ggipc_publish_to_topic_raw_json(GgBuffer topic, GgBuffer json_payload);
+
+/// Publish an object to a local pub/sub topic as a CBOR binary message.
+/// The payload is CBOR (RFC 8949) encoded and sent as a binary message,
+/// streamed through base64 directly into the request.
+/// Requires aws.greengrass#PublishToTopic authorization.
+/// See:
+/// <https://docs.aws.amazon.com/greengrass/v2/developerguide/ipc-publish-subscribe.html#ipc-operation-publishtotopic>
+GgError ggipc_publish_to_topic_cbor(GgBuffer topic, GgObject payload);
+
 typedef void GgIpcSubscribeToTopicCallback(
     void *ctx, GgBuffer topic, GgObject payload, GgIpcSubscriptionHandle handle
 );
@@ -89,10 +190,49 @@ GgError ggipc_subscribe_to_topic(
     GgIpcSubscriptionHandle *handle
 );
 
+typedef void GgIpcSubscribeToTopicRawJsonCallback(
+    void *ctx,
+    GgBuffer topic,
+    GgBuffer json_payload,
+    GgIpcSubscriptionHandle handle
+);
+
+/// Subscribe to JSON messages on a local pub/sub topic without decoding them.
+/// `json_payload` is the JSON text of the message, and is only valid for the
+/// duration of the callback.
+/// Binary messages received on the subscription are dropped.
+/// Requires aws.greengrass#SubscribeToTopic authorization.
+/// See:
+/// <https://docs.aws.amazon.com/greengrass/v2/developerguide/ipc-publish-subscribe.html#ipc-operation-subscribetotopic>
+NONNULL(2)
+GgError ggipc_subscribe_to_topic_raw_json(
+    GgBuffer topic,
+    GgIpcSubscribeToTopicRawJsonCallback *callback,
+    void *ctx,
+    GgIpcSubscriptionHandle *handle
+);
+
+/// Subscribe to messages on a local pub/sub topic, decoding binary messages
+/// as CBOR.
+/// Payload will be a map for json messages and the decoded object for binary
+/// messages. Binary messages that are not valid CBOR are dropped.
+/// Payload is only valid for the duration of the callback.
+/// Requires aws.greengrass#SubscribeToTopic authorization.
+/// See:
+/// <https://docs.aws.amazon.com/greengrass/v2/developerguide/ipc-publish-subscribe.html#ipc-operation-subscribetotopic>
+NONNULL(2)
+GgError ggipc_subscribe_to_topic_cbor(
+    GgBuffer topic,
+    GgIpcSubscribeToTopicCallback *callback,
+    void *ctx,
+    GgIpcSubscriptionHandle *handle
+);
+
 /// Publish an MQTT message to AWS IoT Core.
 /// Sends messages to AWS IoT Core MQTT broker with specified QoS.
 /// Requires aws.greengrass#PublishToIoTCore authorization.
-/// Usage may incur memory overhead over using `ggipc_publish_to_iot_core_b64`
+/// The payload is base64 encoded directly into the request.
+/// Returns GG_ERR_INVALID if qos is greater than 2.
 /// See:
 /// <https://docs.aws.amazon.com/greengrass/v2/developerguide/ipc-iot-core-mqtt.html#ipc-operation-publishtoiotcore>
 GgError ggipc_publish_to_iot_core(
@@ -101,6 +241,7 @@ GgError ggipc_publish_to_iot_core(
 
 /// Publish an MQTT message to AWS IoT Core.
 /// Payload must be already base64 encoded.
+/// Returns GG_ERR_INVALID if qos is greater than 2.
 /// Requires aws.greengrass#PublishToIoTCore authorization.
 /// See:
 /// <https://docs.aws.amazon.com/greengrass/v2/developerguide/ipc-iot-core-mqtt.html#ipc-operation-publishtoiotcore>
@@ -163,6 +304,21 @@ GgError ggipc_update_config(
     GgObject value_to_merge
 );
 
+/// Update component configuration with only the changes from a previous value.
+/// Sends the subtrees of `new_value` that differ from `old_value` (see
+/// gg_obj_diff), and skips the request if nothing changed. `alloc` is used for
+/// the diff, needing at most one GgKV per pair in `new_value`'s maps.
+/// Keys removed since `old_value` are not removed from the configuration.
+/// Requires aws.greengrass#UpdateConfiguration authorization.
+ACCESS(read_only, 2) ACCESS(read_write, 5)
+GgError ggipc_update_config_diff(
+    GgBufList key_path,
+    const struct timespec *timestamp,
+    GgObject old_value,
+    GgObject new_value,
+    GgArena *alloc
+);
+
 /// Component state values for UpdateState
 typedef enum ENUM_EXTENSIBILITY(closed) {
     GG_COMPONENT_STATE_RUNNING,
@@ -19,8 +19,9 @@ typedef GgError GgIpcErrorCallback(
 
 /// Make a raw IPC call to Greengrass Nucleus.
 /// Invokes `result_callback` on success or `error_callback` on error.
-/// Returns GG_ERR_NOCONN if not connected, GG_ERR_NOMEM if insufficient
-/// resources, or GG_ERR_OK on success.
+/// Returns GG_ERR_NOCONN if not connected, GG_ERR_RANGE if the request
+/// exceeds GG_IPC_MAX_MSG_LEN, GG_ERR_NOMEM if insufficient resources, or
+/// GG_ERR_OK on success.
 GgError ggipc_call(
     GgBuffer operation,
     GgBuffer service_model_type,
@@ -43,9 +44,10 @@ typedef GgError GgIpcSubscribeCallback(
 /// Invokes `result_callback` on success or `error_callback` on error.
 /// Invokes `sub_callback` for each subscription event.
 /// If `sub_handle` is not NULL, sets it to the subscription handle on success.
-/// Returns GG_ERR_NOCONN if not connected, GG_ERR_NOMEM if insufficient
-/// resources, GG_ERR_INVALID if called from subscription callback,
-/// or GG_ERR_OK on success.
+/// Returns GG_ERR_NOCONN if not connected, GG_ERR_RANGE if the request
+/// exceeds GG_IPC_MAX_MSG_LEN, GG_ERR_NOMEM if insufficient resources,
+/// GG_ERR_INVALID if called from subscription callback, or GG_ERR_OK on
+/// success.
 GgError ggipc_subscribe(
     GgBuffer operation,
     GgBuffer service_model_type,
@@ -59,4 +61,31 @@ GgError ggipc_subscribe(
     GgIpcSubscriptionHandle *sub_handle
 );
 
+/// Callback invoked for each subscription event with the undecoded payload.
+/// `payload` is the JSON text of the event, and is only valid for the duration
+/// of the callback.
+typedef GgError GgIpcSubscribeRawCallback(
+    void *ctx,
+    void *aux_ctx,
+    GgIpcSubscriptionHandle handle,
+    GgBuffer service_model_type,
+    GgBuffer payload
+);
+
+/// Make a raw IPC subscription call to Greengrass Nucleus.
+/// Same as `ggipc_subscribe`, but subscription events are not decoded before
+/// invoking `sub_callback`.
+GgError ggipc_subscribe_raw(
+    GgBuffer operation,
+    GgBuffer service_model_type,
+    GgMap params,
+    GgIpcResultCallback *result_callback,
+    GgIpcErrorCallback *error_callback,
+    void *response_ctx,
+    GgIpcSubscribeRawCallback *sub_callback,
+    void *sub_callback_ctx,
+    void *sub_callback_aux_ctx,
+    GgIpcSubscriptionHandle *sub_handle
+);
+
 #endif
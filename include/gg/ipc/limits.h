@@ -5,6 +5,8 @@
 #ifndef GG_IPC_LIMITS_H
 #define GG_IPC_LIMITS_H
 
+#include <gg/object.h>
+
 #define GG_IPC_SVCUID_STR_LEN (16)
 
 /// Maximum size of eventstream packet.
@@ -13,4 +15,14 @@
 #define GG_IPC_MAX_MSG_LEN 10000
 #endif
 
+/// Size of the default memory used for decoding received IPC payloads.
+/// Received payloads are bounded by GG_IPC_MAX_MSG_LEN on the wire and by the
+/// decode memory once decoded; raising the runtime subobject limit does not
+/// enlarge it. The default fits GG_MAX_OBJECT_SUBOBJECTS objects; use
+/// ggipc_set_decode_mem to provide a larger buffer at runtime.
+/// Can be configured with `-D GG_IPC_DECODE_MEM_LEN=<N>`.
+#ifndef GG_IPC_DECODE_MEM_LEN
+#define GG_IPC_DECODE_MEM_LEN (sizeof(GgObject[GG_MAX_OBJECT_SUBOBJECTS]))
+#endif
+
 #endif
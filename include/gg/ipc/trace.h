@@ -0,0 +1,53 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GG_IPC_TRACE_H
+#define GG_IPC_TRACE_H
+
+//! IPC client tracing hooks
+
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <stdint.h>
+
+/// Points in the IPC client at which trace events fire.
+/// Each is also a static probe `gg_ipc:<name>` when the SDK is built with
+/// <sys/sdt.h> available, with the stream id, operation name pointer, and
+/// operation name length as arguments.
+typedef enum {
+    /// Frame encoded for sending (`frame_encode`).
+    GG_IPC_TRACE_FRAME_ENCODE,
+    /// Frame written to the socket or queued for writing (`socket_write`).
+    GG_IPC_TRACE_SOCKET_WRITE,
+    /// Frame read from the socket and its headers parsed (`frame_read`).
+    GG_IPC_TRACE_FRAME_READ,
+    /// Stream for a received frame looked up (`stream_lookup`).
+    GG_IPC_TRACE_STREAM_LOOKUP,
+    /// Received payload decoded (`payload_decode`).
+    GG_IPC_TRACE_PAYLOAD_DECODE,
+    /// Entering a result, error, or subscription callback
+    /// (`callback_enter`).
+    GG_IPC_TRACE_CALLBACK_ENTER,
+    /// Returned from a callback (`callback_exit`).
+    GG_IPC_TRACE_CALLBACK_EXIT,
+} GgIpcTraceEvent;
+
+/// Called for each trace event.
+/// `operation` is empty for the connection handshake and for frames on
+/// unknown streams. Called with IPC client state locked, except for
+/// `frame_read` events and events for the connection handshake, which may
+/// run concurrently with other events. Must not make IPC calls or block.
+typedef void GgIpcTraceCallback(
+    void *ctx, GgIpcTraceEvent event, int32_t stream_id, GgBuffer operation
+);
+
+/// Maximum number of registered trace callbacks.
+#define GG_IPC_TRACE_MAX_CALLBACKS 4
+
+/// Register a callback for IPC trace events.
+/// Callbacks cannot be unregistered. Returns GG_ERR_UNSUPPORTED if the SDK
+/// was built with tracing disabled.
+GgError ggipc_trace_register(GgIpcTraceCallback *callback, void *ctx);
+
+#endif
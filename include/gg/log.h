@@ -0,0 +1,32 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GG_LOG_H
+#define GG_LOG_H
+
+//! Runtime control of SDK logging
+
+#include <stdint.h>
+
+#define GG_LOG_NONE 0
+#define GG_LOG_ERROR 1
+#define GG_LOG_WARN 2
+#define GG_LOG_INFO 3
+#define GG_LOG_DEBUG 4
+#define GG_LOG_TRACE 5
+
+/// Set the runtime level of a log module.
+/// If `module` is NULL, sets the level of all modules, including ones that
+/// have not logged yet. Levels above the level the SDK was compiled with
+/// have no effect, as those log statements are compiled out.
+/// Initial levels can be set with the GG_LOG_LEVELS environment variable, a
+/// comma separated list of `level` or `module=level` entries.
+void gg_log_set_level(const char *module, uint32_t level);
+
+/// Get the runtime level of a log module.
+/// If `module` is NULL, gets the level used for modules that have not logged
+/// yet.
+uint32_t gg_log_get_level(const char *module);
+
+#endif
@@ -7,6 +7,7 @@
 
 //! Map utilities
 
+#include <gg/arena.h>
 #include <gg/attr.h>
 #include <gg/buffer.h>
 #include <gg/error.h>
@@ -14,6 +15,11 @@
 #include <gg/object.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+
+#ifdef GG_INLINE_ACCESSORS
+#include <string.h>
+#endif
 
 // NOLINTBEGIN(bugprone-macro-parentheses)
 /// Loop over the KV pairs in a map.
@@ -40,7 +46,7 @@ CONST
 GgKV gg_kv(GgBuffer key, GgObject val);
 
 /// Get a GgKV's key.
-CONST
+CONST GG_ACCESSOR
 GgBuffer gg_kv_key(GgKV kv);
 
 /// Set a GgKV's key.
@@ -48,9 +54,66 @@ ACCESS(write_only, 1)
 void gg_kv_set_key(GgKV *kv, GgBuffer key);
 
 /// Get a GgKV's value.
-CONST ACCESS(none, 1)
+CONST ACCESS(none, 1) GG_ACCESSOR
 GgObject *gg_kv_val(GgKV *kv);
 
+/// Slot in a GgMapIndex hash table.
+typedef struct {
+    const GgKV *pairs;
+    GgKV *kv;
+} GgMapIndexSlot;
+
+/// Hash index over the keys of a map and the maps nested in it, including
+/// maps within lists.
+/// Only valid while the indexed maps' pairs and keys are unchanged.
+typedef struct {
+    GgMap map;
+    GgMapIndexSlot *slots;
+    size_t slot_mask;
+} GgMapIndex;
+
+/// Build a hash index for repeated lookups in `map` and its nested maps.
+/// The index is allocated from `arena`.
+/// Returns GG_ERR_NOMEM if the arena is too small, or GG_ERR_RANGE if maps
+/// and lists are nested deeper than the object depth limit.
+ACCESS(read_write, 2) ACCESS(write_only, 3)
+GgError gg_map_index_build(GgMap map, GgArena *arena, GgMapIndex *index);
+
+/// Find the pair for `key` in `map` using an index.
+/// `map` must be the indexed map or a map nested in it, at any depth and
+/// including within lists.
+/// Returns NULL if the key is not in `map`.
+ACCESS(read_only, 1)
+GgKV *gg_map_index_find(const GgMapIndex *index, GgMap map, GgBuffer key);
+
+/// Get the value corresponding with a key from an indexed map.
+/// Equivalent to gg_map_get on the indexed map.
+ACCESS(read_only, 1) ACCESS(write_only, 3)
+bool gg_map_index_get(
+    const GgMapIndex *index, GgBuffer key, GgObject **result
+);
+
+/// Get the value from an indexed nested map corresponding with a key path.
+/// Equivalent to gg_map_get_path on the indexed map.
+ACCESS(read_only, 1) ACCESS(write_only, 3)
+bool gg_map_index_get_path(
+    const GgMapIndex *index, GgBufList path, GgObject **result
+);
+
+/// Compute the minimal map to merge into `old_obj` to produce `new_obj`.
+/// Follows UpdateConfiguration merge semantics: nested maps are merged and
+/// other values replaced, so only changed keys and subtrees are included.
+/// Keys absent from `new_obj` are not represented, as merges cannot remove
+/// them. If `old_obj` is not a map, the diff contains all of `new_obj`.
+/// `diff` is set to a map, empty if nothing changed, whose pairs are
+/// allocated from `arena` and reference keys and values in `new_obj`.
+/// Returns GG_ERR_INVALID if `new_obj` is not a map, GG_ERR_NOMEM if the arena
+/// is too small, or GG_ERR_RANGE if maps exceed the object depth limit.
+ACCESS(read_write, 3) ACCESS(write_only, 4)
+GgError gg_obj_diff(
+    GgObject old_obj, GgObject new_obj, GgArena *arena, GgObject *diff
+);
+
 /// Entry in a map validation schema.
 typedef struct {
     GgBuffer key;
@@ -75,8 +138,82 @@ typedef struct {
 /// Validate a map against a schema.
 /// Checks for required keys, validates types, and extracts values.
 /// Sets `entry->value` pointers for found keys (or NULL if not found).
+/// For duplicate map keys, the first pair is used.
+/// The schema is compiled on each call; use GG_MAP_VALIDATE at fixed call
+/// sites to compile it once.
 /// Returns GG_ERR_OK on success, GG_ERR_NOENTRY if required key missing,
 /// or GG_ERR_PARSE if type mismatch or MISSING key is present.
 GgError gg_map_validate(GgMap map, GgMapSchema schema);
 
+/// Maximum number of entries in a compiled map schema.
+#define GG_MAP_SCHEMA_MAX_ENTRIES 32
+
+/// Map schema with precomputed key hashes, for single-pass validation.
+/// May be compiled once and reused; its entries' `value` pointers are unused.
+typedef struct {
+    GgMapSchema schema;
+    uint32_t key_hashes[GG_MAP_SCHEMA_MAX_ENTRIES];
+    /// Open-addressed table of entry index + 1, with 0 marking empty slots.
+    uint8_t slots[GG_MAP_SCHEMA_MAX_ENTRIES * 2];
+} GgMapCompiledSchema;
+
+/// Compile a schema for repeated validation.
+/// `schema.entries` must outlive the compiled schema.
+/// Returns GG_ERR_RANGE if the schema has more than GG_MAP_SCHEMA_MAX_ENTRIES
+/// entries.
+ACCESS(write_only, 2)
+GgError gg_map_schema_compile(
+    GgMapSchema schema, GgMapCompiledSchema *compiled
+);
+
+/// Validate a map against a compiled schema in one pass over the map.
+/// Performs the same checks as gg_map_validate, but sets `values[i]` to the
+/// value found for entry `i` (or NULL if not found).
+/// `values` must have an element for each schema entry.
+ACCESS(read_only, 2) ACCESS(write_only, 3)
+GgError gg_map_validate_compiled(
+    GgMap map, const GgMapCompiledSchema *compiled, GgObject **values
+);
+
+/// Compiled schema cached by a call site. Zero-initialize before first use.
+typedef struct {
+    GgMapCompiledSchema compiled;
+    uint32_t state;
+} GgMapSchemaCache;
+
+/// Validate a map against a schema as gg_map_validate does, compiling the
+/// schema into `cache` on first use.
+/// Every call with the same cache must pass a schema with the same keys.
+/// Thread-safe.
+ACCESS(read_write, 1)
+GgError gg_map_validate_cached(
+    GgMapSchemaCache *cache, GgMap map, GgMapSchema schema
+);
+
+/// Validate a map against GG_MAP_SCHEMA entries, setting `ret` to the result.
+/// The schema is compiled once per call site and reused by later calls.
+#define GG_MAP_VALIDATE(ret, map, ...) \
+    do { \
+        static GgMapSchemaCache gg_map_schema_cache = { 0 }; \
+        (ret) = gg_map_validate_cached( \
+            &gg_map_schema_cache, (map), GG_MAP_SCHEMA(__VA_ARGS__) \
+        ); \
+    } while (0)
+
+#ifdef GG_INLINE_ACCESSORS
+
+GG_ACCESSOR GgBuffer gg_kv_key(GgKV kv) {
+    void *ptr;
+    uint16_t len;
+    memcpy(&ptr, kv._private, sizeof(void *));
+    memcpy(&len, &kv._private[sizeof(void *)], 2);
+    return (GgBuffer) { .data = ptr, .len = len };
+}
+
+GG_ACCESSOR GgObject *gg_kv_val(GgKV *kv) {
+    return (GgObject *) &kv->_private[sizeof(void *) + 2];
+}
+
+#endif
+
 #endif
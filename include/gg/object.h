@@ -14,16 +14,29 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#ifdef GG_INLINE_ACCESSORS
+#include <assert.h>
+#include <string.h>
+#endif
+
 /// Maximum depth of an object.
 /// i.e. `5` has depth 1, `{"a":5}` is depth 2, and `[{"a":5}]` is 3.
+/// Runtime depth limit may be lowered but not raised past this value.
+/// Can be configured with `-D GG_MAX_OBJECT_DEPTH=<N>`.
+#ifndef GG_MAX_OBJECT_DEPTH
 #define GG_MAX_OBJECT_DEPTH (15U)
+#endif
 
-/// Maximum subobject count for an object.
+/// Default maximum subobject count for an object.
 /// Subobject count calculation:
 ///   subobject_count(non-list/map object) = 0
 ///   subobject_count(list) = len + sum({item: subobject_count(item)})
 ///   subobject_count(map) = 2 * len + sum({pair: subobject_count(pair.value))})
+/// Can be changed at runtime with `gg_obj_set_limits`.
+/// Can be configured with `-D GG_MAX_OBJECT_SUBOBJECTS=<N>`.
+#ifndef GG_MAX_OBJECT_SUBOBJECTS
 #define GG_MAX_OBJECT_SUBOBJECTS (255U)
+#endif
 
 /// A generic object.
 typedef struct {
@@ -40,6 +53,8 @@ typedef enum {
     GG_TYPE_BUF,
     GG_TYPE_LIST,
     GG_TYPE_MAP,
+    GG_TYPE_F64_ARRAY,
+    GG_TYPE_I64_ARRAY,
 } GgObjectType;
 
 /// An array of `GgObject`.
@@ -48,6 +63,18 @@ typedef struct {
     size_t len;
 } GgList;
 
+/// A packed array of doubles.
+typedef struct {
+    double *items;
+    size_t len;
+} GgF64Array;
+
+/// A packed array of 64-bit integers.
+typedef struct {
+    int64_t *items;
+    size_t len;
+} GgI64Array;
+
 /// A key-value pair used for `GgMap`.
 /// `key` must be an UTF-8 encoded string.
 typedef struct {
@@ -76,7 +103,7 @@ typedef struct {
     }
 
 /// Get type of an GgObject.
-CONST
+CONST GG_ACCESSOR
 GgObjectType gg_obj_type(GgObject obj);
 
 #define GG_OBJ_NULL (GgObject) { 0 }
@@ -87,7 +114,7 @@ GgObject gg_obj_bool(bool value);
 
 /// Get the bool represented by an object.
 /// The GgObject must be of type GG_TYPE_BOOLEAN.
-CONST
+CONST GG_ACCESSOR
 bool gg_obj_into_bool(GgObject boolean);
 
 /// Create signed integer object.
@@ -96,7 +123,7 @@ GgObject gg_obj_i64(int64_t value);
 
 /// Get the i64 represented by an object.
 /// The GgObject must be of type GG_TYPE_I64.
-CONST
+CONST GG_ACCESSOR
 int64_t gg_obj_into_i64(GgObject i64);
 
 /// Create floating point object.
@@ -105,7 +132,7 @@ GgObject gg_obj_f64(double value);
 
 /// Get the f64 represented by an object.
 /// The GgObject must be of type GG_TYPE_F64.
-CONST
+CONST GG_ACCESSOR
 double gg_obj_into_f64(GgObject f64);
 
 /// Create buffer object.
@@ -114,7 +141,7 @@ GgObject gg_obj_buf(GgBuffer value);
 
 /// Get the buffer represented by an object.
 /// The GgObject must be of type GG_TYPE_BUF.
-CONST
+CONST GG_ACCESSOR
 GgBuffer gg_obj_into_buf(GgObject buf);
 
 /// Create map object.
@@ -123,7 +150,7 @@ GgObject gg_obj_map(GgMap value);
 
 /// Get the map represented by an object.
 /// The GgObject must be of type GG_TYPE_MAP.
-CONST
+CONST GG_ACCESSOR
 GgMap gg_obj_into_map(GgObject map);
 
 /// Create list object.
@@ -132,9 +159,55 @@ GgObject gg_obj_list(GgList value);
 
 /// Get the list represented by an object.
 /// The GgObject must be of type GG_TYPE_LIST.
-CONST
+CONST GG_ACCESSOR
 GgList gg_obj_into_list(GgObject list);
 
+/// Create an object from a packed f64 array.
+/// The array is a single subobject regardless of its length.
+CONST
+GgObject gg_obj_f64_array(GgF64Array value);
+
+/// Get the packed f64 array represented by an object.
+/// The GgObject must be of type GG_TYPE_F64_ARRAY.
+CONST GG_ACCESSOR
+GgF64Array gg_obj_into_f64_array(GgObject f64_array);
+
+/// Create an object from a packed i64 array.
+/// The array is a single subobject regardless of its length.
+CONST
+GgObject gg_obj_i64_array(GgI64Array value);
+
+/// Get the packed i64 array represented by an object.
+/// The GgObject must be of type GG_TYPE_I64_ARRAY.
+CONST GG_ACCESSOR
+GgI64Array gg_obj_into_i64_array(GgObject i64_array);
+
+/// Compare two objects for equality.
+/// Maps are equal if they have the same keys with equal values, in any order.
+/// F64 values, including packed array elements, are compared by
+/// representation. Objects nested deeper than the depth limit compare unequal.
+PURE
+bool gg_obj_eq(GgObject a, GgObject b);
+
+/// Limits on objects enforced when visiting (encoding, claiming, measuring).
+typedef struct {
+    /// Maximum object depth; may not exceed GG_MAX_OBJECT_DEPTH.
+    uint16_t max_depth;
+    /// Maximum subobject count.
+    /// Objects decoded from JSON are additionally bounded by arena size; for
+    /// received IPC payloads see ggipc_set_decode_mem.
+    size_t max_subobjects;
+} GgObjectLimits;
+
+/// Get the current object limits.
+PURE
+GgObjectLimits gg_obj_get_limits(void);
+
+/// Set the object limits.
+/// Should be called before objects are used by other threads.
+/// Returns GG_ERR_RANGE if max_depth is 0 or exceeds GG_MAX_OBJECT_DEPTH.
+GgError gg_obj_set_limits(GgObjectLimits limits);
+
 /// Calculate max memory needed to claim an object.
 /// This is the max memory used by gg_arena_claim_obj on this object.
 /// On success, sets `size` to the calculated memory requirement.
@@ -142,4 +215,81 @@ GgList gg_obj_into_list(GgObject list);
 ACCESS(write_only, 2) REPRODUCIBLE
 GgError gg_obj_mem_usage(GgObject obj, size_t *size);
 
+#ifdef GG_INLINE_ACCESSORS
+
+GG_ACCESSOR GgObjectType gg_obj_type(GgObject obj) {
+    // Last byte is tag
+    uint8_t result = obj._private[sizeof(obj._private) - 1];
+    assert(result <= GG_TYPE_I64_ARRAY);
+    return (GgObjectType) result;
+}
+
+GG_ACCESSOR bool gg_obj_into_bool(GgObject boolean) {
+    assert(gg_obj_type(boolean) == GG_TYPE_BOOLEAN);
+    bool result;
+    memcpy(&result, boolean._private, sizeof(result));
+    return result;
+}
+
+GG_ACCESSOR int64_t gg_obj_into_i64(GgObject i64) {
+    assert(gg_obj_type(i64) == GG_TYPE_I64);
+    int64_t result;
+    memcpy(&result, i64._private, sizeof(result));
+    return result;
+}
+
+GG_ACCESSOR double gg_obj_into_f64(GgObject f64) {
+    assert(gg_obj_type(f64) == GG_TYPE_F64);
+    double result;
+    memcpy(&result, f64._private, sizeof(result));
+    return result;
+}
+
+GG_ACCESSOR GgBuffer gg_obj_into_buf(GgObject buf) {
+    assert(gg_obj_type(buf) == GG_TYPE_BUF);
+    void *ptr;
+    uint16_t len;
+    memcpy(&ptr, buf._private, sizeof(void *));
+    memcpy(&len, &buf._private[sizeof(void *)], 2);
+    return (GgBuffer) { .data = ptr, .len = len };
+}
+
+GG_ACCESSOR GgMap gg_obj_into_map(GgObject map) {
+    assert(gg_obj_type(map) == GG_TYPE_MAP);
+    void *ptr;
+    uint16_t len;
+    memcpy(&ptr, map._private, sizeof(void *));
+    memcpy(&len, &map._private[sizeof(void *)], 2);
+    return (GgMap) { .pairs = ptr, .len = len };
+}
+
+GG_ACCESSOR GgList gg_obj_into_list(GgObject list) {
+    assert(gg_obj_type(list) == GG_TYPE_LIST);
+    void *ptr;
+    uint16_t len;
+    memcpy(&ptr, list._private, sizeof(void *));
+    memcpy(&len, &list._private[sizeof(void *)], 2);
+    return (GgList) { .items = ptr, .len = len };
+}
+
+GG_ACCESSOR GgF64Array gg_obj_into_f64_array(GgObject f64_array) {
+    assert(gg_obj_type(f64_array) == GG_TYPE_F64_ARRAY);
+    void *ptr;
+    uint16_t len;
+    memcpy(&ptr, f64_array._private, sizeof(void *));
+    memcpy(&len, &f64_array._private[sizeof(void *)], 2);
+    return (GgF64Array) { .items = ptr, .len = len };
+}
+
+GG_ACCESSOR GgI64Array gg_obj_into_i64_array(GgObject i64_array) {
+    assert(gg_obj_type(i64_array) == GG_TYPE_I64_ARRAY);
+    void *ptr;
+    uint16_t len;
+    memcpy(&ptr, i64_array._private, sizeof(void *));
+    memcpy(&len, &i64_array._private[sizeof(void *)], 2);
+    return (GgI64Array) { .items = ptr, .len = len };
+}
+
+#endif
+
 #endif
@@ -26,4 +26,9 @@ GgipcPacketSequence gg_test_mqtt_subscribe_accepted_sequence(
     size_t messages
 );
 
+/// GetConfiguration request followed by a response with `value`
+GgipcPacketSequence gg_test_config_get_accepted_sequence(
+    int32_t stream_id, GgList key_path, GgMap value
+);
+
 #endif
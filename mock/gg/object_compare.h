@@ -4,6 +4,6 @@
 #include <gg/object.h>
 #include <stdbool.h>
 
-bool gg_obj_eq(GgObject lhs, GgObject rhs);
+bool gg_test_obj_eq(GgObject lhs, GgObject rhs);
 
 #endif
@@ -16,7 +16,7 @@
 #include <gg/ipc/limits.h>
 #include <gg/json_decode.h>
 #include <gg/json_encode.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <gg/object_visit.h>
@@ -34,7 +34,7 @@
 #include <stdlib.h>
 
 static uint8_t ipc_recv_mem[GG_IPC_MAX_MSG_LEN];
-static uint8_t ipc_recv_decode_mem[sizeof(GgObject[GG_MAX_OBJECT_SUBOBJECTS])];
+static uint8_t ipc_recv_decode_mem[GG_IPC_DECODE_MEM_LEN];
 
 static uint8_t ipc_socket_path[PATH_MAX];
 static GgBuffer ipc_socket_path_buf;
@@ -199,7 +199,7 @@ GgError gg_test_setup_ipc(
         return ret;
     }
     GG_CLEANUP_ID(cleanup_epollfd, cleanup_close, epoll_fd);
-    ret = gg_socket_epoll_add(epoll_fd, socket_fd, UINT64_MAX);
+    ret = gg_socket_epoll_add(epoll_fd, socket_fd, EPOLLIN, UINT64_MAX);
     if (ret != GG_ERR_OK) {
         return ret;
     }
@@ -423,7 +423,7 @@ static GgError gg_test_recv_packet(const GgipcPacket *packet, int client) {
         return GG_ERR_FAILURE;
     }
 
-    if (!gg_obj_eq(packet->payload, payload_obj)) {
+    if (!gg_test_obj_eq(packet->payload, payload_obj)) {
         int stderr_fd = STDERR_FILENO;
 
         GG_LOGE("Expected payload mismatch");
@@ -1,7 +1,7 @@
 #include "gg/object_compare.h"
 #include <float.h>
 #include <gg/buffer.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <gg/object_iter.h>
@@ -10,7 +10,7 @@
 
 /// Prints info about all parents of the current subobject.
 static void print_state(const IterLevels state[static 1]) {
-    for (uint8_t i = state->index; i > 0; --i) {
+    for (uint16_t i = state->index; i > 0; --i) {
         switch (state->state[i - 1]) {
         case LEVEL_LIST: {
             GG_LOGE("In list (idx = %d).", (int) state->elem_index[i - 1]);
@@ -79,7 +79,7 @@ static bool buf_eq(GgBuffer lhs, GgBuffer rhs) {
 }
 
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
-bool gg_obj_eq(GgObject lhs, GgObject rhs) {
+bool gg_test_obj_eq(GgObject lhs, GgObject rhs) {
     IterLevels lhs_state;
     IterLevels rhs_state;
 
@@ -93,15 +93,16 @@ bool gg_obj_eq(GgObject lhs, GgObject rhs) {
     // lhs state array is used for both iter levels
     rhs_state.elem_index[0] = 0;
 
-    uint8_t subobjects = 0;
+    GgObjectLimits limits = gg_obj_get_limits();
+    size_t subobjects = 0;
 
     while (true) {
         GgObject *lhs_obj = lhs_state.obj[lhs_state.index];
         GgObject *rhs_obj = rhs_state.obj[rhs_state.index];
 
         IterLevelState cur_state = lhs_state.state[lhs_state.index];
-        uint8_t lhs_index = lhs_state.elem_index[lhs_state.index];
-        uint8_t rhs_index = rhs_state.elem_index[rhs_state.index];
+        size_t lhs_index = lhs_state.elem_index[lhs_state.index];
+        size_t rhs_index = rhs_state.elem_index[rhs_state.index];
 
         switch (cur_state) {
         case LEVEL_DEFAULT: {
@@ -144,14 +145,46 @@ bool gg_obj_eq(GgObject lhs, GgObject rhs) {
                     return false;
                 }
                 break;
+            case GG_TYPE_F64_ARRAY: {
+                GgF64Array lhs_arr = gg_obj_into_f64_array(*lhs_obj);
+                GgF64Array rhs_arr = gg_obj_into_f64_array(*rhs_obj);
+                if (lhs_arr.len != rhs_arr.len) {
+                    GG_LOGE("Array length mismatch.");
+                    print_state(&lhs_state);
+                    return false;
+                }
+                for (size_t i = 0; i < lhs_arr.len; i++) {
+                    if (!float_eq(lhs_arr.items[i], rhs_arr.items[i])) {
+                        print_state(&lhs_state);
+                        return false;
+                    }
+                }
+                break;
+            }
+            case GG_TYPE_I64_ARRAY: {
+                GgI64Array lhs_arr = gg_obj_into_i64_array(*lhs_obj);
+                GgI64Array rhs_arr = gg_obj_into_i64_array(*rhs_obj);
+                if (lhs_arr.len != rhs_arr.len) {
+                    GG_LOGE("Array length mismatch.");
+                    print_state(&lhs_state);
+                    return false;
+                }
+                for (size_t i = 0; i < lhs_arr.len; i++) {
+                    if (!int_eq(lhs_arr.items[i], rhs_arr.items[i])) {
+                        print_state(&lhs_state);
+                        return false;
+                    }
+                }
+                break;
+            }
             case GG_TYPE_LIST: {
                 GgList lhs_list = gg_obj_into_list(*lhs_obj);
-                if (lhs_list.len > GG_MAX_OBJECT_SUBOBJECTS - subobjects) {
+                if (lhs_list.len > limits.max_subobjects - subobjects) {
                     GG_LOGE("Visited object's subobjects exceeds maximum.");
                     print_state(&lhs_state);
                     return false;
                 }
-                subobjects += (uint8_t) lhs_list.len;
+                subobjects += lhs_list.len;
                 GgList rhs_list = gg_obj_into_list(*rhs_obj);
                 if (lhs_list.len != rhs_list.len) {
                     GG_LOGE("List length mismatch.");
@@ -164,12 +197,12 @@ bool gg_obj_eq(GgObject lhs, GgObject rhs) {
             }
             case GG_TYPE_MAP: {
                 GgMap lhs_map = gg_obj_into_map(*lhs_obj);
-                if (lhs_map.len > (GG_MAX_OBJECT_SUBOBJECTS - subobjects) / 2) {
+                if (lhs_map.len > (limits.max_subobjects - subobjects) / 2) {
                     GG_LOGE("Visited object's subobjects exceeds maximum.");
                     print_state(&lhs_state);
                     return false;
                 }
-                subobjects += (uint8_t) (lhs_map.len * 2);
+                subobjects += lhs_map.len * 2;
 
                 GgMap rhs_map = gg_obj_into_map(*rhs_obj);
                 if (lhs_map.len != rhs_map.len) {
@@ -190,7 +223,7 @@ bool gg_obj_eq(GgObject lhs, GgObject rhs) {
             }
             GgList rhs_list = gg_obj_into_list(*rhs_obj);
 
-            if (lhs_state.index >= GG_MAX_OBJECT_DEPTH - 1) {
+            if (lhs_state.index >= limits.max_depth - 1) {
                 GG_LOGE("Visited object's depth exceeds maximum.");
                 print_state(&lhs_state);
                 return false;
@@ -228,7 +261,7 @@ bool gg_obj_eq(GgObject lhs, GgObject rhs) {
                 return false;
             }
 
-            if (lhs_state.index >= GG_MAX_OBJECT_DEPTH - 1) {
+            if (lhs_state.index >= limits.max_depth - 1) {
                 GG_LOGE("Visited object's depth exceeds maximum.");
                 print_state(&lhs_state);
                 return false;
@@ -246,7 +279,7 @@ bool gg_obj_eq(GgObject lhs, GgObject rhs) {
             rhs_state.elem_index[rhs_state.index] = 0;
 
             rhs_state.elem_index[rhs_state.index - 1]
-                = (uint8_t) (kv - rhs_map.pairs);
+                = (size_t) (kv - rhs_map.pairs);
 
             continue;
         }
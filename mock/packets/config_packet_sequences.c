@@ -0,0 +1,51 @@
+#include "gg/ipc/packet_sequences.h"
+#include "packets.h"
+#include <gg/buffer.h>
+#include <gg/ipc/mock.h>
+#include <gg/map.h>
+#include <gg/object.h>
+
+GgipcPacket gg_test_config_get_request_packet(
+    int32_t stream_id, GgList key_path
+) {
+    static GgKV pairs[1];
+    pairs[0] = gg_kv(GG_STR("keyPath"), gg_obj_list(key_path));
+    size_t pairs_len = sizeof(pairs) / sizeof(pairs[0]);
+
+    return (GgipcPacket) { .direction = CLIENT_TO_SERVER,
+                           .has_payload = true,
+                           .payload = gg_obj_map((GgMap) { .pairs = pairs,
+                                                           .len = pairs_len }),
+                           .headers = GG_IPC_REQUEST_HEADERS(
+                               stream_id, "aws.greengrass#GetConfiguration"
+                           ),
+                           .header_count = GG_IPC_REQUEST_HEADERS_COUNT };
+}
+
+GgipcPacket gg_test_config_get_accepted_packet(
+    int32_t stream_id, GgMap value
+) {
+    static GgKV pairs[1];
+    pairs[0] = gg_kv(GG_STR("value"), gg_obj_map(value));
+    size_t pairs_len = sizeof(pairs) / sizeof(pairs[0]);
+
+    return (GgipcPacket) { .direction = SERVER_TO_CLIENT,
+                           .has_payload = true,
+                           .payload = gg_obj_map((GgMap) { .pairs = pairs,
+                                                           .len = pairs_len }),
+                           .headers = GG_IPC_ACCEPTED_HEADERS(
+                               stream_id, "aws.greengrass#GetConfiguration"
+                           ),
+                           .header_count = GG_IPC_ACCEPTED_HEADERS_COUNT };
+}
+
+GgipcPacketSequence gg_test_config_get_accepted_sequence(
+    int32_t stream_id, GgList key_path, GgMap value
+) {
+    return (GgipcPacketSequence) {
+        .packets
+        = { gg_test_config_get_request_packet(stream_id, key_path),
+            gg_test_config_get_accepted_packet(stream_id, value) },
+        .len = 2
+    };
+}
@@ -6,7 +6,7 @@
 #include <gg/buffer.h>
 #include <gg/error.h>
 #include <gg/ipc/mock.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 
@@ -4,7 +4,7 @@
 #include <gg/arena.h>
 #include <gg/error.h>
 #include <gg/ipc/mock.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <stdlib.h>
 
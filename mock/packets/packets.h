@@ -5,7 +5,7 @@
 #include <gg/buffer.h>
 #include <gg/error.h>
 #include <gg/ipc/mock.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <stdlib.h>
 
 #define GG_IPC_REQUEST_HEADERS(stream_id, operation) \
@@ -115,4 +115,12 @@ GgipcPacket gg_test_mqtt_message_packet(
     int32_t stream_id, GgBuffer topic, GgBuffer payload_base64
 );
 
+/// client->server GetConfiguration request
+GgipcPacket gg_test_config_get_request_packet(
+    int32_t stream_id, GgList key_path
+);
+
+/// server->client successful GetConfiguration response
+GgipcPacket gg_test_config_get_accepted_packet(int32_t stream_id, GgMap value);
+
 #endif
@@ -1,7 +1,7 @@
 #include "gg/process_wait.h"
 #include <errno.h>
 #include <gg/error.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <stdbool.h>
@@ -0,0 +1,40 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GG_BASE64_DECODE_H
+#define GG_BASE64_DECODE_H
+
+//! Incremental base64 decoding
+
+#include <gg/attr.h>
+#include <gg/buffer.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/// Incremental decoder for padded base64 split across several inputs.
+/// Validation matches gg_base64_decode on the concatenated input.
+typedef struct {
+    uint8_t pending[4];
+    uint8_t pending_len;
+} GgBase64Decoder;
+
+/// Creates a decoder for a new base64 string.
+VISIBILITY(hidden)
+GgBase64Decoder gg_base64_decoder_init(void);
+
+/// Decodes the next `chars` of input, advancing `out` past decoded bytes.
+/// Decodes in place: `*out` must point into the same buffer as `chars`, at
+/// or before `chars.data`, and bytes of `chars` may be overwritten.
+/// Returns false if the input is invalid base64.
+VISIBILITY(hidden) ACCESS(read_write, 3)
+bool gg_base64_decoder_update(
+    GgBase64Decoder *decoder, GgBuffer chars, uint8_t **out
+);
+
+/// Decodes the final segment, including padding, advancing `out`.
+/// Returns false if the total input was not valid padded base64.
+VISIBILITY(hidden) ACCESS(read_write, 2)
+bool gg_base64_decoder_finish(GgBase64Decoder *decoder, uint8_t **out);
+
+#endif
@@ -0,0 +1,42 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GG_BASE64_ENCODE_H
+#define GG_BASE64_ENCODE_H
+
+//! Streaming base64 encoding
+
+#include <gg/attr.h>
+#include <gg/error.h>
+#include <gg/io.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// Base64 encoding stage.
+/// Bytes written to its writer are encoded and passed on to `out` in chunks,
+/// without buffering the whole input or output.
+typedef struct {
+    GgWriter out;
+    uint8_t pending[2];
+    uint8_t pending_len;
+} GgBase64Encoder;
+
+/// Length of the padded base64 encoding of `len` bytes.
+VISIBILITY(hidden)
+size_t gg_base64_encoded_len(size_t len);
+
+/// Creates an encoder writing base64 output to `out`.
+VISIBILITY(hidden)
+GgBase64Encoder gg_base64_encoder_init(GgWriter out);
+
+/// Returns a writer whose input is base64 encoded into the encoder's output.
+VISIBILITY(hidden)
+GgWriter gg_base64_encoder_writer(GgBase64Encoder *encoder);
+
+/// Writes the final partial group, with padding, to the encoder's output.
+/// Must be called once after all input has been written.
+VISIBILITY(hidden)
+GgError gg_base64_encoder_finish(GgBase64Encoder *encoder);
+
+#endif
@@ -0,0 +1,26 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GG_CBOR_DECODE_H
+#define GG_CBOR_DECODE_H
+
+//! CBOR (RFC 8949) decoding
+
+#include <gg/arena.h>
+#include <gg/attr.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/object.h>
+
+/// Reads a CBOR data item from a buffer as a GgObject.
+/// Result obj may contain references into buf, and allocations from arena.
+/// Input buffer is not modified.
+/// Byte and text strings both decode to buffers; map keys must be strings.
+/// Indefinite-length items, tags, and simple values other than booleans, null
+/// and undefined (decoded as null) are not supported.
+/// If obj is NULL, only validates the input.
+VISIBILITY(hidden)
+GgError gg_cbor_decode(GgBuffer buf, GgArena *arena, GgObject *obj);
+
+#endif
@@ -0,0 +1,33 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GG_CBOR_ENCODE_H
+#define GG_CBOR_ENCODE_H
+
+//! CBOR (RFC 8949) encoding
+
+#include <gg/attr.h>
+#include <gg/error.h>
+#include <gg/io.h>
+#include <gg/object.h>
+#include <stddef.h>
+
+/// Serializes a GgObject into a buffer in CBOR encoding.
+/// Lists and maps use definite lengths, buffers are encoded as byte strings,
+/// and map keys as text strings. Floats use the shortest of single or double
+/// precision that represents the value exactly.
+VISIBILITY(hidden)
+GgError gg_cbor_encode(GgObject obj, GgWriter writer);
+
+/// Calculate the exact length of the CBOR encoding of a GgObject.
+/// On success, sets `len` to the number of bytes gg_cbor_encode would write.
+VISIBILITY(hidden) ACCESS(write_only, 2)
+GgError gg_cbor_encoded_len(GgObject obj, size_t *len);
+
+/// Reader from which a CBOR-serialized object can be read.
+/// Errors if buffer is not large enough for entire object.
+VISIBILITY(hidden)
+GgReader gg_cbor_reader(const GgObject *obj);
+
+#endif
@@ -0,0 +1,71 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GG_DURABLE_WRITER_H
+#define GG_DURABLE_WRITER_H
+
+//! Group-commit durable append writer
+
+#include <gg/attr.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/// Append-only file shared by many writer threads.
+/// Threads waiting for their data to be durable are batched, so that one
+/// fdatasync call covers every record appended before it starts.
+typedef struct {
+    int fd;
+    /// Time the syncing thread waits for more records before each sync.
+    int64_t window_ms;
+    pthread_mutex_t mtx;
+    pthread_cond_t synced_cond;
+    /// File offset at the end of the last appended record.
+    uint64_t written;
+    /// File offset up to which contents are durable.
+    uint64_t synced;
+    /// Whether a thread is currently syncing on behalf of the waiters.
+    bool syncing;
+    /// Set on a failed write or sync; later calls fail with this error.
+    GgError err;
+} GgDurableWriter;
+
+/// Open `path` under `dirfd` for durable appends, creating it if missing.
+/// The file and its directory entry are durable when this returns.
+/// Each sync waits `window_ms` first to collect more records; with 0,
+/// batching only covers records appended while a sync is in progress.
+VISIBILITY(hidden)
+GgError gg_durable_writer_open(
+    int dirfd,
+    GgBuffer path,
+    mode_t mode,
+    int64_t window_ms,
+    GgDurableWriter *writer
+);
+
+/// Append `data` to the file as one contiguous record, without waiting for
+/// it to be durable. `offset` is set to the end of the record.
+VISIBILITY(hidden)
+GgError gg_durable_writer_append(
+    GgDurableWriter *writer, GgBuffer data, uint64_t *offset
+);
+
+/// Wait until file contents up to `offset` are durable.
+VISIBILITY(hidden)
+GgError gg_durable_writer_wait(GgDurableWriter *writer, uint64_t offset);
+
+/// Append `data` as one record and wait until it is durable.
+VISIBILITY(hidden)
+GgError gg_durable_writer_write(GgDurableWriter *writer, GgBuffer data);
+
+/// Close the writer.
+/// Records that were not waited on may not be durable.
+/// No other calls may be in progress.
+VISIBILITY(hidden)
+void gg_durable_writer_close(GgDurableWriter *writer);
+
+#endif
@@ -24,4 +24,14 @@ GgError eventstream_encode(
     GgReader payload
 );
 
+/// Calculate the encoded size of an EventStream packet.
+/// On success, sets `len` to the packet size for a payload of `payload_len`.
+VISIBILITY(hidden) NONNULL_IF_NONZERO(1, 2)
+GgError eventstream_encoded_len(
+    const EventStreamHeader *headers,
+    size_t header_count,
+    size_t payload_len,
+    size_t len[static 1]
+);
+
 #endif
@@ -92,6 +92,40 @@ GgError gg_file_read_path(GgBuffer path, GgBuffer *content);
 VISIBILITY(hidden)
 GgError gg_file_read_path_at(int dirfd, GgBuffer path, GgBuffer *content);
 
+/// Options for mapping a file into memory.
+typedef struct {
+    /// Map copy-on-write with write access, so the contents can be modified
+    /// in place (for example by destructive decoders). Changes are never
+    /// written back to the file.
+    bool writable;
+    /// Hint that the mapping will be read sequentially.
+    bool sequential;
+    /// Hint that the whole file will be needed soon, starting readahead.
+    bool willneed;
+} GgFileMapOptions;
+
+/// Map file contents from path into memory.
+/// The mapping must be released with gg_file_unmap. An empty file results in
+/// an empty buffer. Truncating the file while mapped faults on access.
+VISIBILITY(hidden)
+GgError gg_file_map(GgBuffer path, GgFileMapOptions opts, GgBuffer *content);
+
+/// Map file contents from path under dirfd into memory.
+/// See gg_file_map.
+VISIBILITY(hidden)
+GgError gg_file_map_at(
+    int dirfd, GgBuffer path, GgFileMapOptions opts, GgBuffer *content
+);
+
+/// Release a mapping from gg_file_map.
+VISIBILITY(hidden)
+void gg_file_unmap(GgBuffer content);
+
+/// Cleanup function for file mappings.
+static inline void cleanup_file_unmap(const GgBuffer *content) {
+    gg_file_unmap(*content);
+}
+
 static inline void cleanup_closedir(DIR **dirp) {
     if (*dirp != NULL) {
         closedir(*dirp);
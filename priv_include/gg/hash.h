@@ -0,0 +1,25 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GG_HASH_H
+#define GG_HASH_H
+
+//! Non-cryptographic hashing for lookup tables
+
+#include <gg/buffer.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// 64-bit FNV-1a hash of `buf`. A non-zero `seed` is mixed into the offset
+/// basis, giving an independent hash for each seed.
+static inline uint64_t gg_fnv1a(GgBuffer buf, uint64_t seed) {
+    uint64_t hash = 0xCBF29CE484222325U ^ seed;
+    for (size_t i = 0; i < buf.len; i++) {
+        hash ^= buf.data[i];
+        hash *= 0x100000001B3U;
+    }
+    return hash;
+}
+
+#endif
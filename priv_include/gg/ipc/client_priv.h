@@ -5,11 +5,15 @@
 #ifndef GG_IPC_CLIENT_PRIV_H
 #define GG_IPC_CLIENT_PRIV_H
 
+#include <gg/arena.h>
 #include <gg/attr.h>
 #include <gg/buffer.h>
 #include <gg/error.h>
 #include <gg/eventstream/decode.h>
+#include <gg/io.h>
+#include <gg/ipc/client_raw.h>
 #include <gg/object.h>
+#include <stddef.h>
 
 VISIBILITY(hidden)
 GgError ggipc_connect_with_payload(GgBuffer socket_path, GgObject payload);
@@ -17,4 +21,57 @@ GgError ggipc_connect_with_payload(GgBuffer socket_path, GgObject payload);
 VISIBILITY(hidden)
 GgError ggipc_connect_extra_header_handler(EventStreamHeaderIter headers);
 
+/// Make an IPC call with a pre-encoded JSON params payload.
+/// `params_json` must produce exactly `params_json_len` bytes.
+VISIBILITY(hidden)
+GgError ggipc_call_with_payload(
+    GgBuffer operation,
+    GgBuffer service_model_type,
+    GgReader params_json,
+    size_t params_json_len,
+    GgIpcResultCallback *result_callback,
+    GgIpcErrorCallback *error_callback,
+    void *response_ctx
+);
+
+/// Writes the message of a publish request to `writer`.
+typedef GgError GgIpcPublishWriteFn(const void *ctx, GgWriter writer);
+
+/// Publish request params, written directly into the request frame as
+/// `prefix`, the JSON encoded `topic`, `message_prefix`, the output of
+/// `write_message`, and `suffix`.
+typedef struct {
+    GgBuffer prefix;
+    GgBuffer topic;
+    GgBuffer message_prefix;
+    GgIpcPublishWriteFn *write_message;
+    const void *message_ctx;
+    /// Length of the output of `write_message`.
+    size_t message_len;
+    GgBuffer suffix;
+} GgIpcPublishRequest;
+
+/// Make a publish IPC call with params streamed from `request`.
+VISIBILITY(hidden)
+GgError ggipc_call_publish(
+    GgBuffer operation,
+    GgBuffer service_model_type,
+    const GgIpcPublishRequest *request,
+    GgIpcErrorCallback *error_callback
+);
+
+/// GgIpcPublishWriteFn that base64 encodes the GgBuffer at `ctx`.
+VISIBILITY(hidden)
+GgError ggipc_publish_write_b64(const void *ctx, GgWriter writer);
+
+/// Arena for decoding subscription payloads in raw subscription callbacks.
+/// Only valid for use within a subscription callback.
+VISIBILITY(hidden)
+GgArena ggipc_sub_decode_arena(void);
+
+/// Intern a received topic name with the table set by ggipc_set_intern_table.
+/// Only valid for use within a subscription callback.
+VISIBILITY(hidden)
+void ggipc_intern_topic(GgBuffer *topic);
+
 #endif
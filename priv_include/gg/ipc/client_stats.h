@@ -0,0 +1,103 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GG_IPC_CLIENT_STATS_H
+#define GG_IPC_CLIENT_STATS_H
+
+//! IPC client statistics collection
+
+#include <gg/attr.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/ipc/client.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// Counters in GgIpcStats, updated with relaxed atomics.
+/// All only increase except GGIPC_STAT_REQUESTS_IN_FLIGHT, a gauge that is
+/// also decremented with ggipc_stat_sub.
+typedef enum {
+    GGIPC_STAT_REQUESTS_IN_FLIGHT,
+    GGIPC_STAT_STREAM_SLOT_FAILURES,
+    GGIPC_STAT_FRAMES_SENT,
+    GGIPC_STAT_BYTES_SENT,
+    GGIPC_STAT_FRAMES_RECEIVED,
+    GGIPC_STAT_BYTES_RECEIVED,
+    GGIPC_STAT_DECODE_FAILURES,
+    GGIPC_STAT_DROPPED_FRAMES,
+    GGIPC_STAT_TIMEOUTS,
+    GGIPC_STAT_LOCK_ACQUISITIONS,
+    GGIPC_STAT_LOCK_CONTENDED,
+    GGIPC_STAT_LOCK_WAIT_NS,
+    GGIPC_STAT_COUNTER_COUNT,
+} GgIpcStatCounter;
+
+/// Counter values, indexed by GgIpcStatCounter.
+VISIBILITY(hidden)
+extern atomic_uint_fast64_t ggipc_stat_counters[GGIPC_STAT_COUNTER_COUNT];
+
+/// Add to a counter. Relaxed, so concurrent updates do not serialize.
+static inline void ggipc_stat_add(GgIpcStatCounter counter, uint64_t n) {
+    atomic_fetch_add_explicit(
+        &ggipc_stat_counters[counter], n, memory_order_relaxed
+    );
+}
+
+/// Subtract from a counter.
+static inline void ggipc_stat_sub(GgIpcStatCounter counter, uint64_t n) {
+    atomic_fetch_sub_explicit(
+        &ggipc_stat_counters[counter], n, memory_order_relaxed
+    );
+}
+
+/// Latency histogram bucket for a duration; see GgIpcLatencyStats.
+static inline size_t ggipc_stats_latency_bucket(uint64_t us) {
+    size_t bucket = 0;
+    if (us != 0) {
+        bucket = 64 - (size_t) __builtin_clzll(us);
+    }
+    if (bucket >= GG_IPC_STATS_LATENCY_BUCKETS) {
+        bucket = GG_IPC_STATS_LATENCY_BUCKETS - 1;
+    }
+    return bucket;
+}
+
+/// Per-operation statistics entry.
+typedef struct GgIpcOperationStatsEntry GgIpcOperationStatsEntry;
+
+/// Get the statistics entry for an operation, adding it if new.
+VISIBILITY(hidden)
+GgIpcOperationStatsEntry *ggipc_stats_operation(GgBuffer operation);
+
+/// Get the operation name of a statistics entry.
+/// Valid for the lifetime of the process.
+VISIBILITY(hidden)
+GgBuffer ggipc_stats_operation_name(GgIpcOperationStatsEntry *operation);
+
+/// Monotonic timestamp in nanoseconds for measuring durations.
+VISIBILITY(hidden)
+uint64_t ggipc_stats_now_ns(void);
+
+/// Record a completed request started at `start_ns`.
+VISIBILITY(hidden)
+void ggipc_stats_request_done(
+    GgIpcOperationStatsEntry *operation, GgError ret, uint64_t start_ns
+);
+
+/// Record a user callback call started at `start_ns`.
+VISIBILITY(hidden)
+void ggipc_stats_callback_done(uint64_t start_ns);
+
+/// Record the number of stream slots in use.
+VISIBILITY(hidden)
+void ggipc_stats_set_streams_in_use(uint32_t count);
+
+/// Lock `mtx`, recording the time spent waiting for it.
+/// Returns `mtx`, for use with GG_CLEANUP and cleanup_pthread_mtx_unlock.
+VISIBILITY(hidden)
+pthread_mutex_t *ggipc_stats_lock(pthread_mutex_t *mtx);
+
+#endif
@@ -0,0 +1,69 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GG_IPC_CLIENT_TRACE_H
+#define GG_IPC_CLIENT_TRACE_H
+
+//! IPC client trace points
+
+#include <gg/attr.h>
+#include <gg/buffer.h>
+#include <gg/ipc/trace.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef GG_IPC_TRACE
+
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define GG_IPC_TRACE_PROBE(name, stream_id, operation) \
+    STAP_PROBE3(gg_ipc, name, stream_id, (operation).data, (operation).len)
+#else
+#define GG_IPC_TRACE_PROBE(name, stream_id, operation) ((void) 0)
+#endif
+
+#define GG_IPC_TRACE_EVENT_frame_encode GG_IPC_TRACE_FRAME_ENCODE
+#define GG_IPC_TRACE_EVENT_socket_write GG_IPC_TRACE_SOCKET_WRITE
+#define GG_IPC_TRACE_EVENT_frame_read GG_IPC_TRACE_FRAME_READ
+#define GG_IPC_TRACE_EVENT_stream_lookup GG_IPC_TRACE_STREAM_LOOKUP
+#define GG_IPC_TRACE_EVENT_payload_decode GG_IPC_TRACE_PAYLOAD_DECODE
+#define GG_IPC_TRACE_EVENT_callback_enter GG_IPC_TRACE_CALLBACK_ENTER
+#define GG_IPC_TRACE_EVENT_callback_exit GG_IPC_TRACE_CALLBACK_EXIT
+
+/// Number of registered trace callbacks.
+VISIBILITY(hidden)
+extern atomic_size_t ggipc_trace_callback_count;
+
+/// Call registered trace callbacks.
+VISIBILITY(hidden)
+void ggipc_trace_call(
+    GgIpcTraceEvent event, int32_t stream_id, GgBuffer operation
+);
+
+/// Fire trace point `name`, one of the probe names in GgIpcTraceEvent.
+#define GG_IPC_TRACE_POINT(name, stream_id, operation) \
+    do { \
+        GG_IPC_TRACE_PROBE(name, stream_id, operation); \
+        if (atomic_load_explicit( \
+                &ggipc_trace_callback_count, memory_order_relaxed \
+            ) \
+            != 0) { \
+            ggipc_trace_call( \
+                GG_IPC_TRACE_EVENT_##name, stream_id, operation \
+            ); \
+        } \
+    } while (0)
+
+#else
+
+#define GG_IPC_TRACE_POINT(name, stream_id, operation) \
+    do { \
+        (void) (stream_id); \
+        (void) (operation); \
+    } while (0)
+
+#endif
+
+#endif
@@ -11,12 +11,100 @@
 #include <gg/attr.h>
 #include <gg/buffer.h>
 #include <gg/error.h>
+#include <gg/flags.h>
 #include <gg/object.h>
+#include <stddef.h>
+#include <stdint.h>
 
 /// Reads a JSON doc from a buffer as a GgObject.
 /// Result obj may contain references into buf, and allocations from alloc.
+/// If the arena has an intern table, map keys are interned.
 /// Input buffer will be modified.
 VISIBILITY(hidden)
 GgError gg_json_decode_destructive(GgBuffer buf, GgArena *arena, GgObject *obj);
 
+/// Finds the value at a key path in a JSON doc without decoding it.
+/// On success, sets `value` to the JSON text of the value (a slice of buf).
+/// Keys are compared against their JSON text without unescaping.
+/// The input buffer is not modified.
+/// Returns GG_ERR_NOENTRY if a key in the path is not present.
+VISIBILITY(hidden)
+GgError gg_json_get_raw(GgBuffer buf, GgBufList path, GgBuffer *value);
+
+/// Type of a struct member filled by gg_json_decode_struct_destructive.
+typedef enum {
+    /// `GgBuffer` from a JSON string.
+    GG_JSON_FIELD_BUF,
+    /// `int64_t` from a JSON integer.
+    GG_JSON_FIELD_I64,
+    /// `double` from a JSON number.
+    GG_JSON_FIELD_F64,
+    /// `bool` from a JSON boolean.
+    GG_JSON_FIELD_BOOL,
+    /// `GgList` from a JSON array, decoded generically.
+    GG_JSON_FIELD_LIST,
+    /// `GgMap` from a JSON object, decoded generically.
+    GG_JSON_FIELD_MAP,
+    /// `GgObject` from any JSON value, decoded generically.
+    GG_JSON_FIELD_OBJ,
+    /// Nested struct from a JSON object, decoded with `schema`.
+    GG_JSON_FIELD_STRUCT,
+    /// `GgBuffer` from a base64 JSON string, unescaped and decoded in place
+    /// in a single pass.
+    GG_JSON_FIELD_BASE64,
+    /// `GgF64Array` from a JSON array of numbers, stored contiguously.
+    GG_JSON_FIELD_F64_ARRAY,
+    /// `GgI64Array` from a JSON array of integers, stored contiguously.
+    GG_JSON_FIELD_I64_ARRAY,
+} GgJsonFieldType;
+
+typedef struct GgJsonSchema GgJsonSchema;
+
+/// Member of a struct filled by gg_json_decode_struct_destructive.
+typedef struct {
+    GgBuffer key;
+    GgPresence required;
+    GgJsonFieldType type;
+    /// Offset of the member in the struct.
+    size_t offset;
+    /// Schema for GG_JSON_FIELD_STRUCT members.
+    const GgJsonSchema *schema;
+} GgJsonField;
+
+/// Maximum fields in a GgJsonSchema.
+#define GG_JSON_SCHEMA_MAX_FIELDS 32
+
+/// Value for GgJsonSchema's `present_offset` when presence is not tracked.
+#define GG_JSON_NO_PRESENCE SIZE_MAX
+
+/// Description of a struct to decode a JSON object into.
+struct GgJsonSchema {
+    const GgJsonField *fields;
+    size_t field_count;
+    /// Offset of a uint32_t member set to a bitmask of the fields found (bit
+    /// `i` for `fields[i]`), or GG_JSON_NO_PRESENCE.
+    size_t present_offset;
+};
+
+/// Schema for a struct from a static array of its fields.
+#define GG_JSON_SCHEMA(field_array, present) \
+    (GgJsonSchema) { \
+        .fields = (field_array), \
+        .field_count = sizeof(field_array) / sizeof((field_array)[0]), \
+        .present_offset = (present), \
+    }
+
+/// Decodes a JSON object directly into a struct described by `schema`.
+/// Strings are unescaped in place and reference buf; generically decoded
+/// members are allocated from arena. Unknown keys are skipped, members for
+/// absent or null optional keys are left unmodified, and present GG_MISSING
+/// keys are an error.
+/// Input buffer will be modified.
+/// Returns GG_ERR_NOENTRY if a required key is missing, or GG_ERR_PARSE on
+/// malformed JSON or a type mismatch.
+VISIBILITY(hidden)
+GgError gg_json_decode_struct_destructive(
+    GgBuffer buf, const GgJsonSchema *schema, GgArena *arena, void *out
+);
+
 #endif
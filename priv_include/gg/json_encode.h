@@ -11,11 +11,17 @@
 #include <gg/error.h>
 #include <gg/io.h>
 #include <gg/object.h>
+#include <stddef.h>
 
 /// Serializes a GgObject into a buffer in JSON encoding.
 VISIBILITY(hidden)
 GgError gg_json_encode(GgObject obj, GgWriter writer);
 
+/// Calculate the exact length of the JSON encoding of a GgObject.
+/// On success, sets `len` to the number of bytes gg_json_encode would write.
+VISIBILITY(hidden) ACCESS(write_only, 2)
+GgError gg_json_encoded_len(GgObject obj, size_t *len);
+
 /// Reader from which a JSON-serialized object can be read.
 /// Errors if buffer is not large enough for entire object.
 VISIBILITY(hidden)
@@ -0,0 +1,167 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GG_LOG_PRIV_H
+#define GG_LOG_PRIV_H
+
+//! Logging interface
+
+#include <gg/attr.h>
+#include <gg/cbmc.h>
+#include <gg/log.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// Logging interface implementation.
+/// Do not call directly; use one of the macro wrappers.
+/// Default implementation prints to stderr.
+VISIBILITY(hidden) FORMAT(printf, 5, 6)
+void gg_log(
+    uint32_t level,
+    const char *file,
+    int line,
+    const char *tag,
+    const char *format,
+    ...
+) CBMC_CONTRACT(requires(cbmc_restrict(format)));
+
+/// No-op logging fn for enabling type checking disabled logging macros.
+ALWAYS_INLINE FORMAT(printf, 1, 2)
+static inline void gg_log_disabled(const char *format, ...) {
+    (void) format;
+}
+
+/// Get the runtime level of a log module, registering it if new.
+/// The returned pointer is valid for the life of the process; its value is
+/// only accessed atomically. Do not call directly; use the macro wrappers.
+VISIBILITY(hidden)
+const uint32_t *gg_log_module_level(const char *module);
+
+/// Per call site state for rate-limited logging.
+typedef struct GgLogRateLimit {
+    uint64_t interval_start_ms;
+    uint32_t count;
+    /// Fields below are guarded by the log module's rate limit mutex.
+    uint32_t suppressed;
+    bool pending;
+    /// Call site details for reporting suppressed lines.
+    uint32_t level;
+    const char *file;
+    int line;
+    const char *tag;
+    /// Next call site with suppressed lines not yet reported.
+    struct GgLogRateLimit *next_pending;
+} GgLogRateLimit;
+
+/// Whether a rate-limited call site may log now.
+/// A count of suppressed lines is logged when the interval they were
+/// suppressed in ends.
+/// Do not call directly; use the macro wrappers.
+VISIBILITY(hidden)
+bool gg_log_ratelimit(
+    GgLogRateLimit *state,
+    uint32_t level,
+    const char *file,
+    int line,
+    const char *tag
+);
+
+/// Check a call site's level against its module's runtime level.
+/// `site` caches the module's level pointer, so the module is looked up only
+/// on the first call.
+ALWAYS_INLINE
+static inline bool gg_log_enabled(
+    const uint32_t **site, const char *module, uint32_t level
+) {
+    const uint32_t *module_level = __atomic_load_n(site, __ATOMIC_RELAXED);
+    if (module_level == NULL) {
+        module_level = gg_log_module_level(module);
+        __atomic_store_n(site, module_level, __ATOMIC_RELAXED);
+    }
+    return level <= __atomic_load_n(module_level, __ATOMIC_RELAXED);
+}
+
+/// Minimum log level to print.
+/// Can be overridden from make using command line or environment.
+#ifndef GG_LOG_LEVEL
+#define GG_LOG_LEVEL GG_LOG_INFO
+#endif
+
+#ifndef __FILE_NAME__
+#define __FILE_NAME__ __FILE__
+#endif
+
+#define GG_LOG(level, ...) \
+    do { \
+        static const uint32_t *gg_log_site_level = NULL; \
+        if (gg_log_enabled(&gg_log_site_level, GG_MODULE, level)) { \
+            gg_log(level, __FILE_NAME__, __LINE__, GG_MODULE, __VA_ARGS__); \
+        } \
+    } while (0)
+
+/// Log a limited burst of lines per interval from this call site.
+/// Use for lines that a peer can trigger for every message.
+#define GG_LOG_RATELIMITED(level, ...) \
+    do { \
+        static const uint32_t *gg_log_site_level = NULL; \
+        static GgLogRateLimit gg_log_site_ratelimit = { 0 }; \
+        if (gg_log_enabled(&gg_log_site_level, GG_MODULE, level) \
+            && gg_log_ratelimit( \
+                &gg_log_site_ratelimit, \
+                level, \
+                __FILE_NAME__, \
+                __LINE__, \
+                GG_MODULE \
+            )) { \
+            gg_log(level, __FILE_NAME__, __LINE__, GG_MODULE, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#if GG_LOG_LEVEL >= GG_LOG_ERROR
+#define GG_LOGE(...) GG_LOG(GG_LOG_ERROR, __VA_ARGS__)
+#define GG_LOGE_RATELIMITED(...) \
+    GG_LOG_RATELIMITED(GG_LOG_ERROR, __VA_ARGS__)
+#else
+#define GG_LOGE(...) gg_log_disabled(__VA_ARGS__)
+#define GG_LOGE_RATELIMITED(...) gg_log_disabled(__VA_ARGS__)
+#endif
+
+#if GG_LOG_LEVEL >= GG_LOG_WARN
+#define GG_LOGW(...) GG_LOG(GG_LOG_WARN, __VA_ARGS__)
+#define GG_LOGW_RATELIMITED(...) \
+    GG_LOG_RATELIMITED(GG_LOG_WARN, __VA_ARGS__)
+#else
+#define GG_LOGW(...) gg_log_disabled(__VA_ARGS__)
+#define GG_LOGW_RATELIMITED(...) gg_log_disabled(__VA_ARGS__)
+#endif
+
+#if GG_LOG_LEVEL >= GG_LOG_INFO
+#define GG_LOGI(...) GG_LOG(GG_LOG_INFO, __VA_ARGS__)
+#define GG_LOGI_RATELIMITED(...) \
+    GG_LOG_RATELIMITED(GG_LOG_INFO, __VA_ARGS__)
+#else
+#define GG_LOGI(...) gg_log_disabled(__VA_ARGS__)
+#define GG_LOGI_RATELIMITED(...) gg_log_disabled(__VA_ARGS__)
+#endif
+
+#if GG_LOG_LEVEL >= GG_LOG_DEBUG
+#define GG_LOGD(...) GG_LOG(GG_LOG_DEBUG, __VA_ARGS__)
+#define GG_LOGD_RATELIMITED(...) \
+    GG_LOG_RATELIMITED(GG_LOG_DEBUG, __VA_ARGS__)
+#else
+#define GG_LOGD(...) gg_log_disabled(__VA_ARGS__)
+#define GG_LOGD_RATELIMITED(...) gg_log_disabled(__VA_ARGS__)
+#endif
+
+#if GG_LOG_LEVEL >= GG_LOG_TRACE
+#define GG_LOGT(...) GG_LOG(GG_LOG_TRACE, __VA_ARGS__)
+#define GG_LOGT_RATELIMITED(...) \
+    GG_LOG_RATELIMITED(GG_LOG_TRACE, __VA_ARGS__)
+#else
+#define GG_LOGT(...) gg_log_disabled(__VA_ARGS__)
+#define GG_LOGT_RATELIMITED(...) gg_log_disabled(__VA_ARGS__)
+#endif
+
+#endif
@@ -2,6 +2,7 @@
 #define GG_OBJECT_ITER_H
 
 #include <gg/object.h>
+#include <stddef.h>
 #include <stdint.h>
 
 typedef enum {
@@ -13,8 +14,8 @@ typedef enum {
 typedef struct {
     GgObject *obj[GG_MAX_OBJECT_DEPTH];
     uint8_t state[GG_MAX_OBJECT_DEPTH];
-    uint8_t elem_index[GG_MAX_OBJECT_DEPTH];
-    uint8_t index;
+    size_t elem_index[GG_MAX_OBJECT_DEPTH];
+    uint16_t index;
 } IterLevels;
 
 #endif
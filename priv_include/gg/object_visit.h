@@ -27,6 +27,8 @@ typedef struct {
     GgError (*on_map_key)(void *ctx, GgBuffer key, GgKV kv[static 1]);
     GgError (*cont_map)(void *ctx);
     GgError (*end_map)(void *ctx);
+    GgError (*on_f64_array)(void *ctx, GgF64Array val, GgObject obj[static 1]);
+    GgError (*on_i64_array)(void *ctx, GgI64Array val, GgObject obj[static 1]);
 } GgObjectVisitHandlers;
 
 VISIBILITY(hidden)
@@ -13,14 +13,22 @@
 #include <gg/io.h>
 
 /// Wrapper for reading full buffer from socket.
+/// Waits for data if the socket is non-blocking.
 VISIBILITY(hidden)
 GgError gg_socket_read(int fd, GgBuffer buf);
 
 /// Wrapper for writing full buffer to socket.
+/// Waits for buffer space if the socket is non-blocking.
 VISIBILITY(hidden)
 GgError gg_socket_write(int fd, GgBuffer buf);
 
-/// Connect to a socket and return the fd
+/// Write as much of `buf` as a non-blocking socket accepts without waiting.
+/// On success, `buf` is set to the unsent remainder.
+VISIBILITY(hidden)
+GgError gg_socket_write_partial(int fd, GgBuffer *buf);
+
+/// Connect to a socket and return the fd.
+/// The socket is non-blocking; the other functions here wait as needed.
 VISIBILITY(hidden)
 GgError gg_connect(GgBuffer path, int *fd);
 
@@ -16,15 +16,26 @@
 VISIBILITY(hidden)
 GgError gg_socket_epoll_create(int *epoll_fd);
 
-/// Add an epoll watch.
+/// Add an epoll watch for `events` (EPOLLIN, EPOLLOUT, etc.).
 VISIBILITY(hidden)
-GgError gg_socket_epoll_add(int epoll_fd, int target_fd, uint64_t data);
+GgError gg_socket_epoll_add(
+    int epoll_fd, int target_fd, uint32_t events, uint64_t data
+);
+
+/// Change the events of an existing epoll watch.
+VISIBILITY(hidden)
+GgError gg_socket_epoll_mod(
+    int epoll_fd, int target_fd, uint32_t events, uint64_t data
+);
 
-/// Continuously wait on epoll, calling callback when data is ready.
+/// Continuously wait on epoll, calling callback when an fd is ready.
+/// The callback receives the ready events for the watch.
 /// Exits only on error waiting or error from callback.
 VISIBILITY(hidden)
 GgError gg_socket_epoll_run(
-    int epoll_fd, GgError (*fd_ready)(void *ctx, uint64_t data), void *ctx
+    int epoll_fd,
+    GgError (*fd_ready)(void *ctx, uint64_t data, uint32_t events),
+    void *ctx
 );
 
 #endif
@@ -40,6 +40,10 @@ pub enum UnpackedObject<'a> {
     List(List<'a>) = 5,
     /// Map of key-value pairs.
     Map(Map<'a>) = 6,
+    /// Packed array of 64-bit floating point values.
+    F64Array(&'a [f64]) = 7,
+    /// Packed array of signed 64-bit integers.
+    I64Array(&'a [i64]) = 8,
 }
 
 impl<'a> Object<'a> {
@@ -137,6 +141,48 @@ impl<'a> Object<'a> {
         }
     }
 
+    /// Create a packed floating point array reference.
+    ///
+    /// # Examples
+    ///
+    /// ```
+    /// use gg_sdk::{Object, UnpackedObject};
+    ///
+    /// let samples = [1.5, 2.5];
+    /// let obj = Object::f64_array(&samples[..]);
+    /// if let UnpackedObject::F64Array(items) = obj.unpack() {
+    ///     assert_eq!(items, &[1.5, 2.5]);
+    /// }
+    /// ```
+    #[must_use]
+    pub fn f64_array(items: impl Into<&'a [f64]>) -> Self {
+        let slice = items.into();
+        Self {
+            c: unsafe {
+                c::gg_obj_f64_array(c::GgF64Array {
+                    items: slice.as_ptr().cast_mut(),
+                    len: slice.len(),
+                })
+            },
+            phantom: PhantomData,
+        }
+    }
+
+    /// Create a packed signed integer array reference.
+    #[must_use]
+    pub fn i64_array(items: impl Into<&'a [i64]>) -> Self {
+        let slice = items.into();
+        Self {
+            c: unsafe {
+                c::gg_obj_i64_array(c::GgI64Array {
+                    items: slice.as_ptr().cast_mut(),
+                    len: slice.len(),
+                })
+            },
+            phantom: PhantomData,
+        }
+    }
+
     /// Create a map reference.
     ///
     /// # Examples
@@ -190,6 +236,8 @@ impl<'a> Object<'a> {
     ///     UnpackedObject::Buf(s) => println!("string: {}", s),
     ///     UnpackedObject::List(items) => println!("list of {} items", items.len()),
     ///     UnpackedObject::Map(pairs) => println!("map with {} pairs", pairs.len()),
+    ///     UnpackedObject::F64Array(items) => println!("{} floats", items.len()),
+    ///     UnpackedObject::I64Array(items) => println!("{} ints", items.len()),
     /// }
     ///
     /// let items = [Object::i64(1), Object::buf("two")];
@@ -235,6 +283,14 @@ impl<'a> Object<'a> {
                         map.len,
                     )))
                 }
+                GG_TYPE_F64_ARRAY => {
+                    let arr = c::gg_obj_into_f64_array(self.c);
+                    UnpackedObject::F64Array(slice_from_c(arr.items, arr.len))
+                }
+                GG_TYPE_I64_ARRAY => {
+                    let arr = c::gg_obj_into_i64_array(self.c);
+                    UnpackedObject::I64Array(slice_from_c(arr.items, arr.len))
+                }
             }
         }
     }
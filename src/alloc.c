@@ -3,7 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <gg/alloc.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <stddef.h>
 
 void *gg_alloc(GgAlloc alloc, size_t size, size_t alignment) {
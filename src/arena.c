@@ -3,20 +3,98 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <assert.h>
+#include <gg/alloc.h>
 #include <gg/arena.h>
+#include <gg/attr.h>
 #include <gg/buffer.h>
 #include <gg/error.h>
-#include <gg/log.h>
+#include <gg/intern.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <gg/object_visit.h>
 #include <inttypes.h>
+#include <stdalign.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdbool.h>
 #include <stdint.h>
 
 // NOLINTNEXTLINE(readability-redundant-declaration)
 extern inline typeof(gg_arena_init) gg_arena_init;
+// NOLINTNEXTLINE(readability-redundant-declaration)
+extern inline typeof(gg_arena_chain_init) gg_arena_chain_init;
+// NOLINTNEXTLINE(readability-redundant-declaration)
+extern inline typeof(gg_arena_init_chained) gg_arena_init_chained;
+
+// Block memory is aligned as for any type, like buffers from malloc
+#define BLOCK_ALIGN alignof(max_align_t)
+#define BLOCK_HEADER_SIZE \
+    ((sizeof(GgArenaBlock) + BLOCK_ALIGN - 1) & ~(BLOCK_ALIGN - 1))
+
+static uint8_t *block_mem(GgArenaBlock *block) {
+    return &((uint8_t *) block)[BLOCK_HEADER_SIZE];
+}
+
+static GgArenaBlock *mem_block(uint8_t *mem) {
+    return (GgArenaBlock *) (void *) &mem[-(ptrdiff_t) BLOCK_HEADER_SIZE];
+}
+
+/// Offset of an allocation in the current block, or UINT32_MAX if it does
+/// not fit.
+static uint32_t arena_fit(
+    const GgArena *arena, size_t size, uint32_t align, uint32_t *pad
+) {
+    // Pad by address so alignment holds regardless of buffer alignment
+    uintptr_t addr = (uintptr_t) arena->mem + arena->index;
+    *pad = (uint32_t) ((align - (addr & (align - 1))) & (align - 1));
+    if (*pad > arena->capacity - arena->index) {
+        return UINT32_MAX;
+    }
+    uint32_t idx = arena->index + *pad;
+    if (size > arena->capacity - idx) {
+        return UINT32_MAX;
+    }
+    return idx;
+}
+
+/// Move a chained arena to the next block with room for an allocation,
+/// allocating a new block if needed.
+static bool arena_grow(GgArena *arena, size_t size, size_t alignment) {
+    GgArenaChain *chain = arena->chain;
+    GgArenaBlock *current = (arena->mem == NULL) ? NULL : mem_block(arena->mem);
+    GgArenaBlock **link = (current == NULL) ? &chain->first : &current->next;
+
+    // Block memory is aligned to BLOCK_ALIGN, so only larger alignments
+    // need padding
+    size_t needed = size + ((alignment > BLOCK_ALIGN) ? alignment - 1 : 0);
+    if ((size > UINT32_MAX) || (needed > UINT32_MAX - BLOCK_HEADER_SIZE)) {
+        return false;
+    }
+
+    GgArenaBlock *block = *link;
+    if ((block == NULL) || (block->capacity < needed)) {
+        uint32_t capacity = chain->block_size;
+        if (needed > capacity) {
+            capacity = (uint32_t) needed;
+        }
+        block = gg_alloc(
+            chain->alloc, BLOCK_HEADER_SIZE + capacity, BLOCK_ALIGN
+        );
+        if (block == NULL) {
+            return false;
+        }
+        // Keep any following unused blocks for later reuse
+        *block = (GgArenaBlock) { .next = *link, .capacity = capacity };
+        *link = block;
+        GG_LOGT("[%p] Added block %p of %" PRIu32 ".", arena, block, capacity);
+    }
+
+    arena->mem = block_mem(block);
+    arena->capacity = block->capacity;
+    arena->index = 0;
+    return true;
+}
 
 void *gg_arena_alloc(GgArena *arena, size_t size, size_t alignment) {
     if (arena == NULL) {
@@ -31,20 +109,15 @@ void *gg_arena_alloc(GgArena *arena, size_t size, size_t alignment) {
     assert(size <= PTRDIFF_MAX);
 
     uint32_t align = (uint32_t) alignment;
-    uint32_t pad = (align - (arena->index & (align - 1))) & (align - 1);
-
-    if (pad > 0) {
-        GG_LOGD("[%p] Need %" PRIu32 " padding.", arena, pad);
-    }
+    uint32_t pad;
+    uint32_t idx = arena_fit(arena, size, align, &pad);
 
-    if (pad > arena->capacity - arena->index) {
-        GG_LOGD("[%p] Insufficient memory for padding; returning NULL.", arena);
-        return NULL;
+    if ((idx == UINT32_MAX) && (arena->chain != NULL)
+        && arena_grow(arena, size, alignment)) {
+        idx = arena_fit(arena, size, align, &pad);
     }
 
-    uint32_t idx = arena->index + pad;
-
-    if (size > arena->capacity - idx) {
+    if (idx == UINT32_MAX) {
         GG_LOGD(
             "[%p] Insufficient memory to alloc %zu; returning NULL.",
             arena,
@@ -53,10 +126,53 @@ void *gg_arena_alloc(GgArena *arena, size_t size, size_t alignment) {
         return NULL;
     }
 
+    if (pad > 0) {
+        GG_LOGD("[%p] Need %" PRIu32 " padding.", arena, pad);
+    }
+
     arena->index = idx + (uint32_t) size;
     return &arena->mem[idx];
 }
 
+void gg_arena_chain_free(GgArenaChain *chain) {
+    GgArenaBlock *block = chain->first;
+    while (block != NULL) {
+        GgArenaBlock *next = block->next;
+        gg_free(chain->alloc, block);
+        block = next;
+    }
+    chain->first = NULL;
+}
+
+GgArenaState gg_arena_save(const GgArena *arena) {
+    return (GgArenaState) { .mem = arena->mem,
+                            .capacity = arena->capacity,
+                            .index = arena->index };
+}
+
+void gg_arena_restore(GgArena *arena, GgArenaState state) {
+    assert(state.index <= state.capacity);
+    arena->mem = state.mem;
+    arena->capacity = state.capacity;
+    arena->index = state.index;
+}
+
+void gg_arena_reset(GgArena *arena) {
+    if ((arena->chain != NULL) && (arena->chain->first != NULL)) {
+        arena->mem = block_mem(arena->chain->first);
+        arena->capacity = arena->chain->first->capacity;
+    }
+    arena->index = 0;
+}
+
+ACCESS(read_only, 1) ACCESS(none, 2)
+static bool arena_block_owns(const GgArena *arena, const void *ptr) {
+    uintptr_t mem_int = (uintptr_t) arena->mem;
+    uintptr_t ptr_int = (uintptr_t) ptr;
+    return (arena->mem != NULL) && (ptr_int >= mem_int)
+        && (ptr_int < mem_int + arena->capacity);
+}
+
 GgError gg_arena_resize_last(
     GgArena arena[static 1], const void *ptr, size_t old_size, size_t size
 ) {
@@ -66,7 +182,7 @@ GgError gg_arena_resize_last(
     assert(old_size <= PTRDIFF_MAX);
     assert(size <= PTRDIFF_MAX);
 
-    if (!gg_arena_owns(arena, ptr)) {
+    if (!arena_block_owns(arena, ptr)) {
         GG_LOGE("[%p] Resize ptr %p not owned.", arena, ptr);
         assert(false);
         return GG_ERR_INVALID;
@@ -105,9 +221,24 @@ bool gg_arena_owns(const GgArena *arena, const void *ptr) {
     if (arena == NULL) {
         return false;
     }
-    uintptr_t mem_int = (uintptr_t) arena->mem;
+    if (arena_block_owns(arena, ptr)) {
+        return true;
+    }
+    if ((arena->chain == NULL) || (arena->mem == NULL)) {
+        return false;
+    }
+
+    // Check blocks preceding the current one
     uintptr_t ptr_int = (uintptr_t) ptr;
-    return (ptr_int >= mem_int) && (ptr_int < mem_int + arena->capacity);
+    GgArenaBlock *current = mem_block(arena->mem);
+    for (GgArenaBlock *block = arena->chain->first; block != current;
+         block = block->next) {
+        uintptr_t mem_int = (uintptr_t) block_mem(block);
+        if ((ptr_int >= mem_int) && (ptr_int < mem_int + block->capacity)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 GgBuffer gg_arena_alloc_rest(GgArena *arena) {
@@ -190,8 +321,55 @@ static GgError claim_map(void *ctx, GgMap val, GgObject obj[static 1]) {
     return GG_ERR_OK;
 }
 
+static GgError claim_f64_array(
+    void *ctx, GgF64Array val, GgObject obj[static 1]
+) {
+    GgArena *arena = ctx;
+    if (gg_arena_owns(arena, val.items)) {
+        return GG_ERR_OK;
+    }
+    if (val.len == 0) {
+        *obj = gg_obj_f64_array((GgF64Array) { 0 });
+        return GG_ERR_OK;
+    }
+    double *new_mem = GG_ARENA_ALLOCN(arena, double, val.len);
+    if (new_mem == NULL) {
+        GG_LOGE("Insufficient memory when cloning array into %p.", arena);
+        return GG_ERR_NOMEM;
+    }
+    memcpy(new_mem, val.items, val.len * sizeof(double));
+    *obj = gg_obj_f64_array((GgF64Array) { .items = new_mem, .len = val.len });
+    return GG_ERR_OK;
+}
+
+static GgError claim_i64_array(
+    void *ctx, GgI64Array val, GgObject obj[static 1]
+) {
+    GgArena *arena = ctx;
+    if (gg_arena_owns(arena, val.items)) {
+        return GG_ERR_OK;
+    }
+    if (val.len == 0) {
+        *obj = gg_obj_i64_array((GgI64Array) { 0 });
+        return GG_ERR_OK;
+    }
+    int64_t *new_mem = GG_ARENA_ALLOCN(arena, int64_t, val.len);
+    if (new_mem == NULL) {
+        GG_LOGE("Insufficient memory when cloning array into %p.", arena);
+        return GG_ERR_NOMEM;
+    }
+    memcpy(new_mem, val.items, val.len * sizeof(int64_t));
+    *obj = gg_obj_i64_array((GgI64Array) { .items = new_mem, .len = val.len });
+    return GG_ERR_OK;
+}
+
 static GgError claim_map_key(void *ctx, GgBuffer key, GgKV kv[static 1]) {
     GgArena *arena = ctx;
+    if ((arena != NULL) && (arena->intern != NULL)
+        && !gg_arena_owns(arena, key.data) && gg_intern(arena->intern, &key)) {
+        gg_kv_set_key(kv, key);
+        return GG_ERR_OK;
+    }
     GgError ret = gg_arena_claim_buf(&key, arena);
     gg_kv_set_key(kv, key);
     return ret;
@@ -203,6 +381,8 @@ GgError gg_arena_claim_obj(GgObject obj[static 1], GgArena *arena) {
         .on_list = claim_list,
         .on_map = claim_map,
         .on_map_key = claim_map_key,
+        .on_f64_array = claim_f64_array,
+        .on_i64_array = claim_i64_array,
     };
     return gg_obj_visit(&VISIT_HANDLERS, arena, obj);
 }
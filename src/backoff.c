@@ -6,7 +6,7 @@
 #include <gg/backoff.h>
 #include <gg/buffer.h>
 #include <gg/error.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/rand.h>
 #include <gg/utils.h>
 #include <stdbool.h>
@@ -4,85 +4,229 @@
 
 #include <gg/arena.h>
 #include <gg/base64.h>
+#include <gg/base64_decode.h>
+#include <gg/base64_encode.h>
 #include <gg/buffer.h>
 #include <gg/error.h>
+#include <gg/io.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
-static bool base64_char_to_byte(char digit, uint8_t *value) {
-    if ((digit >= 'A') && (digit <= 'Z')) {
-        *value = (uint8_t) (digit - 'A');
-    } else if ((digit >= 'a') && (digit <= 'z')) {
-        *value = (uint8_t) (digit - 'a' + ('Z' - 'A' + 1));
-    } else if ((digit >= '0') && (digit <= '9')) {
-        *value = (uint8_t) (digit - '0' + ('Z' - 'A' + 1) + ('z' - 'a' + 1));
-    } else if (digit == '+') {
-        *value = 62;
-    } else if (digit == '/') {
-        *value = 63;
-    } else {
-        return false;
-    }
+// SSSE3 paths are built with a function target attribute and selected at
+// runtime, so the library stays compatible with baseline x86-64 CPUs.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BASE64_SSSE3 1
+#include <tmmintrin.h>
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+
+/// Marks bytes outside the base64 alphabet in BASE64_DECODE_TABLE.
+#define BASE64_INVALID 0x80U
+
+/// Maps each input byte to its 6-bit value, or 0xFF if not in the alphabet.
+static const uint8_t BASE64_DECODE_TABLE[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B,
+    0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+    0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,
+    0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20,
+    0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30,
+    0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+static const uint8_t BASE64_TABLE[]
+    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+#ifdef BASE64_SSSE3
+
+static bool base64_have_ssse3(void) {
+#ifdef __SSSE3__
     return true;
+#else
+    return __builtin_cpu_supports("ssse3");
+#endif
 }
 
-static bool base64_decode_segment(
-    const uint8_t segment[4U], GgBuffer *target, bool *padding
+/// Decodes 16-character blocks while at least `min_rest` characters remain
+/// after the block, writing 16 bytes per block of which the first 12 are
+/// output. Stops at the first block containing a non-alphabet character.
+/// Returns the number of characters consumed.
+TARGET_SSSE3
+static size_t base64_decode_ssse3(
+    const uint8_t *in, size_t len, uint8_t *out, size_t min_rest
 ) {
-    uint8_t value[3U] = { 0 };
-    size_t len = 0U;
+    // Nibble classes: a character is valid iff its lo and hi classes share
+    // no bits.
+    const __m128i lut_lo = _mm_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+    );
+    const __m128i lut_hi = _mm_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+    );
+    // Offset from character to value, indexed by high nibble ('/' uses 1)
+    const __m128i lut_roll = _mm_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+    );
+    // Also the '/' character; bit 5 is ignored by pshufb
+    const __m128i mask_2f = _mm_set1_epi8(0x2F);
+    const __m128i pack = _mm_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+    );
 
-    uint8_t decoded = 0U;
-    bool ret = base64_char_to_byte((char) segment[0U], &decoded);
-    if (!ret) {
-        return false;
+    size_t i = 0;
+    while (len - i >= 16 + min_rest) {
+        __m128i str = _mm_loadu_si128((const __m128i *) &in[i]);
+
+        __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(str, 4), mask_2f);
+        __m128i lo_nibbles = _mm_and_si128(str, mask_2f);
+        __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+        __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+        __m128i invalid
+            = _mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128());
+        if (_mm_movemask_epi8(invalid) != 0) {
+            break;
+        }
+
+        __m128i eq_2f = _mm_cmpeq_epi8(str, mask_2f);
+        __m128i roll
+            = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles));
+        str = _mm_add_epi8(str, roll);
+
+        // Merge 6-bit values: 4x6 bits -> 24 bits per 32-bit lane
+        str = _mm_maddubs_epi16(str, _mm_set1_epi32(0x01400140));
+        str = _mm_madd_epi16(str, _mm_set1_epi32(0x00011000));
+        str = _mm_shuffle_epi8(str, pack);
+
+        _mm_storeu_si128((__m128i *) &out[(i / 4) * 3], str);
+        i += 16;
     }
+    return i;
+}
 
-    value[0U] = (uint8_t) (decoded << 2U);
+/// Encodes 12-byte blocks while at least 16 input bytes can be loaded,
+/// writing 16 characters per block. Returns the number of bytes consumed.
+TARGET_SSSE3
+static size_t base64_encode_ssse3(const uint8_t *in, size_t len, uint8_t *out) {
+    const __m128i spread = _mm_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10
+    );
+    // Offset from value to character, indexed by alphabet range
+    const __m128i lut = _mm_setr_epi8(
+        65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0
+    );
 
-    ret = base64_char_to_byte((char) segment[1U], &decoded);
-    if (!ret) {
-        return false;
+    size_t i = 0;
+    while (len - i >= 16) {
+        __m128i str = _mm_loadu_si128((const __m128i *) &in[i]);
+
+        // Split each 3 byte group into four 6-bit values
+        str = _mm_shuffle_epi8(str, spread);
+        __m128i t0 = _mm_and_si128(str, _mm_set1_epi32(0x0FC0FC00));
+        __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        __m128i t2 = _mm_and_si128(str, _mm_set1_epi32(0x003F03F0));
+        __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        str = _mm_or_si128(t1, t3);
+
+        // Range 0 (A-Z) maps to index 0; others to 1 (a-z), 2-11 (0-9),
+        // 12 ('+') and 13 ('/')
+        __m128i indices = _mm_subs_epu8(str, _mm_set1_epi8(51));
+        __m128i above_z = _mm_cmpgt_epi8(str, _mm_set1_epi8(25));
+        indices = _mm_sub_epi8(indices, above_z);
+        str = _mm_add_epi8(str, _mm_shuffle_epi8(lut, indices));
+
+        _mm_storeu_si128((__m128i *) &out[(i / 3) * 4], str);
+        i += 12;
     }
+    return i;
+}
 
-    value[0U] |= (uint8_t) (decoded >> 4U);
-    value[1U] = (uint8_t) (decoded << 4U);
+#endif
+
+/// Decodes padding-free segments of 4 characters.
+static bool base64_decode_segments(
+    const uint8_t *in, size_t len, uint8_t *out
+) {
+    for (size_t i = 0; i < len; i += 4) {
+        uint32_t a = BASE64_DECODE_TABLE[in[i]];
+        uint32_t b = BASE64_DECODE_TABLE[in[i + 1]];
+        uint32_t c = BASE64_DECODE_TABLE[in[i + 2]];
+        uint32_t d = BASE64_DECODE_TABLE[in[i + 3]];
+        if (((a | b | c | d) & BASE64_INVALID) != 0) {
+            return false;
+        }
+        uint32_t chunk = (a << 18) | (b << 12) | (c << 6) | d;
+        out[0] = (uint8_t) (chunk >> 16);
+        out[1] = (uint8_t) (chunk >> 8);
+        out[2] = (uint8_t) chunk;
+        out = &out[3];
+    }
+    return true;
+}
+
+/// Decodes the final segment, which may contain padding.
+static bool base64_decode_last_segment(
+    const uint8_t segment[4U], GgBuffer *target
+) {
+    uint32_t a = BASE64_DECODE_TABLE[segment[0U]];
+    uint32_t b = BASE64_DECODE_TABLE[segment[1U]];
+    uint32_t c = BASE64_DECODE_TABLE[segment[2U]];
+    uint32_t d = BASE64_DECODE_TABLE[segment[3U]];
+    size_t len = 3U;
 
     if (segment[2U] == '=') {
         if (segment[3U] != '=') {
             // non-padding byte after padding
             return false;
         }
-        if (value[1U] != 0U) {
-            // bad encoding (includes unused bits)
-            return false;
-        }
+        c = 0U;
+        d = 0U;
         len = 1U;
-    } else {
-        ret = base64_char_to_byte((char) segment[2U], &decoded);
-        if (!ret) {
-            return false;
-        }
+    } else if (segment[3U] == '=') {
+        d = 0U;
+        len = 2U;
+    }
 
-        value[1U] |= (uint8_t) (decoded >> 2U);
-        value[2U] = (uint8_t) (decoded << 6U);
+    if (((a | b | c | d) & BASE64_INVALID) != 0) {
+        return false;
+    }
 
-        if (segment[3U] == '=') {
-            if (value[2U] != 0U) {
-                // bad encoding (includes unused bits)
-                return false;
-            }
-            len = 2U;
-        } else {
-            ret = base64_char_to_byte((char) segment[3U], &decoded);
-            if (!ret) {
-                return false;
-            }
+    uint32_t chunk = (a << 18) | (b << 12) | (c << 6) | d;
+    uint8_t value[3U] = { (uint8_t) (chunk >> 16),
+                          (uint8_t) (chunk >> 8),
+                          (uint8_t) chunk };
 
-            value[2U] |= decoded;
-            len = 3U;
-        }
+    if ((len < 3U) && (value[len] != 0U)) {
+        // bad encoding (includes unused bits)
+        return false;
     }
 
     if (len > target->len) {
@@ -91,7 +235,6 @@ static bool base64_decode_segment(
 
     memcpy(target->data, value, len);
     *target = gg_buffer_substr(*target, len, SIZE_MAX);
-    *padding = len != 3U;
 
     return true;
 }
@@ -103,19 +246,35 @@ bool gg_base64_decode(GgBuffer base64, GgBuffer target[static 1]) {
     if (target->len < ((base64.len / 4) * 3)) {
         return false;
     }
-    GgBuffer out = *target;
-    bool last = false;
-    for (size_t i = 0; i < base64.len; i += 4) {
-        if (last) {
-            // Data after padding
-            return false;
-        }
-        bool ret = base64_decode_segment(&base64.data[i], &out, &last);
-        if (!ret) {
-            return false;
-        }
+    if (base64.len == 0) {
+        target->len = 0;
+        return true;
+    }
+
+    // Only the last segment may contain padding
+    size_t body_len = base64.len - 4;
+    size_t done = 0;
+
+#ifdef BASE64_SSSE3
+    if (base64_have_ssse3()) {
+        // Each block stores 16 bytes for 12 decoded; the remaining input
+        // guarantees target has room for the extra 4.
+        done = base64_decode_ssse3(base64.data, body_len, target->data, 4);
     }
-    target->len = (size_t) (out.data - target->data);
+#endif
+
+    uint8_t *out = &target->data[(done / 4) * 3];
+    if (!base64_decode_segments(&base64.data[done], body_len - done, out)) {
+        return false;
+    }
+
+    GgBuffer rest
+        = gg_buffer_substr(*target, (body_len / 4) * 3, SIZE_MAX);
+    if (!base64_decode_last_segment(&base64.data[body_len], &rest)) {
+        return false;
+    }
+
+    target->len = (size_t) (rest.data - target->data);
     return true;
 }
 
@@ -123,28 +282,101 @@ bool gg_base64_decode_in_place(GgBuffer target[static 1]) {
     return gg_base64_decode(*target, target);
 }
 
-static const uint8_t BASE64_TABLE[]
-    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+GgBase64Decoder gg_base64_decoder_init(void) {
+    return (GgBase64Decoder) { .pending_len = 0 };
+}
 
-GgError gg_base64_encode(
-    GgBuffer buf, GgArena *alloc, GgBuffer result[static 1]
+bool gg_base64_decoder_update(
+    GgBase64Decoder *decoder, GgBuffer chars, uint8_t **out
 ) {
-    size_t base64_len = ((buf.len + 2) / 3) * 4;
-    uint8_t *mem = GG_ARENA_ALLOCN(alloc, uint8_t, base64_len);
-    if (mem == NULL) {
-        return GG_ERR_NOMEM;
+    GgBuffer rest = chars;
+
+    if (decoder->pending_len > 0) {
+        size_t fill = 4U - decoder->pending_len;
+        if (fill > rest.len) {
+            fill = rest.len;
+        }
+        memcpy(&decoder->pending[decoder->pending_len], rest.data, fill);
+        decoder->pending_len = (uint8_t) (decoder->pending_len + fill);
+        rest = gg_buffer_substr(rest, fill, SIZE_MAX);
+        if (rest.len == 0) {
+            // Pending segment may still be the last one
+            return true;
+        }
+        // More input follows, so the pending segment has no padding
+        if (!base64_decode_segments(decoder->pending, 4U, *out)) {
+            return false;
+        }
+        *out = &(*out)[3];
+        decoder->pending_len = 0;
+    }
+
+    if (rest.len == 0) {
+        return true;
+    }
+
+    // Hold back the last (possibly partial) segment until more input or
+    // finish shows whether it may contain padding
+    size_t body_len = ((rest.len - 1) / 4) * 4;
+    size_t done = 0;
+
+#ifdef BASE64_SSSE3
+    if (base64_have_ssse3()) {
+        // Block stores stay within already-read input when decoding in place
+        done = base64_decode_ssse3(rest.data, body_len, *out, 0);
+    }
+#endif
+
+    uint8_t *segments_out = &(*out)[(done / 4) * 3];
+    if (!base64_decode_segments(
+            &rest.data[done], body_len - done, segments_out
+        )) {
+        return false;
     }
+    *out = &(*out)[(body_len / 4) * 3];
+
+    decoder->pending_len = (uint8_t) (rest.len - body_len);
+    memcpy(decoder->pending, &rest.data[body_len], decoder->pending_len);
+    return true;
+}
+
+bool gg_base64_decoder_finish(GgBase64Decoder *decoder, uint8_t **out) {
+    if (decoder->pending_len == 0) {
+        return true;
+    }
+    if (decoder->pending_len != 4U) {
+        return false;
+    }
+    GgBuffer target = { .data = *out, .len = 3 };
+    if (!base64_decode_last_segment(decoder->pending, &target)) {
+        return false;
+    }
+    decoder->pending_len = 0;
+    *out = target.data;
+    return true;
+}
+
+/// Encodes `buf` with padding into `out`, which must have room for
+/// gg_base64_encoded_len(buf.len) bytes.
+static void base64_encode_into(GgBuffer buf, uint8_t *out) {
+    size_t done = 0;
+
+#ifdef BASE64_SSSE3
+    if (base64_have_ssse3()) {
+        done = base64_encode_ssse3(buf.data, buf.len, out);
+    }
+#endif
 
     size_t chunks = buf.len / 3;
-    for (size_t i = 0; i < chunks; i++) {
+    for (size_t i = done / 3; i < chunks; i++) {
         uint32_t chunk = (unsigned) buf.data[i * 3] << 16;
         chunk += (unsigned) buf.data[(i * 3) + 1] << 8;
         chunk += (unsigned) buf.data[(i * 3) + 2];
 
-        mem[i * 4] = BASE64_TABLE[chunk >> 18];
-        mem[(i * 4) + 1] = BASE64_TABLE[(chunk >> 12) & 0x3F];
-        mem[(i * 4) + 2] = BASE64_TABLE[(chunk >> 6) & 0x3F];
-        mem[(i * 4) + 3] = BASE64_TABLE[chunk & 0x3F];
+        out[i * 4] = BASE64_TABLE[chunk >> 18];
+        out[(i * 4) + 1] = BASE64_TABLE[(chunk >> 12) & 0x3F];
+        out[(i * 4) + 2] = BASE64_TABLE[(chunk >> 6) & 0x3F];
+        out[(i * 4) + 3] = BASE64_TABLE[chunk & 0x3F];
     }
     size_t remaining = buf.len % 3;
     if (remaining > 0) {
@@ -152,16 +384,107 @@ GgError gg_base64_encode(
         if (remaining > 1) {
             chunk += (unsigned) buf.data[(chunks * 3) + 1] << 8;
         }
-        mem[chunks * 4] = BASE64_TABLE[chunk >> 18];
-        mem[(chunks * 4) + 1] = BASE64_TABLE[(chunk >> 12) & 0x3F];
+        out[chunks * 4] = BASE64_TABLE[chunk >> 18];
+        out[(chunks * 4) + 1] = BASE64_TABLE[(chunk >> 12) & 0x3F];
         if (remaining > 1) {
-            mem[(chunks * 4) + 2] = BASE64_TABLE[(chunk >> 6) & 0x3F];
+            out[(chunks * 4) + 2] = BASE64_TABLE[(chunk >> 6) & 0x3F];
         } else {
-            mem[(chunks * 4) + 2] = '=';
+            out[(chunks * 4) + 2] = '=';
         }
-        mem[(chunks * 4) + 3] = '=';
+        out[(chunks * 4) + 3] = '=';
     }
+}
+
+size_t gg_base64_encoded_len(size_t len) {
+    return ((len + 2) / 3) * 4;
+}
+
+GgError gg_base64_encode(
+    GgBuffer buf, GgArena *alloc, GgBuffer result[static 1]
+) {
+    size_t base64_len = gg_base64_encoded_len(buf.len);
+    uint8_t *mem = GG_ARENA_ALLOCN(alloc, uint8_t, base64_len);
+    if (mem == NULL) {
+        return GG_ERR_NOMEM;
+    }
+
+    base64_encode_into(buf, mem);
 
     *result = (GgBuffer) { .data = mem, .len = base64_len };
     return GG_ERR_OK;
 }
+
+/// Input bytes encoded per write to the encoder's output.
+#define BASE64_STREAM_CHUNK 384U
+
+GgBase64Encoder gg_base64_encoder_init(GgWriter out) {
+    return (GgBase64Encoder) { .out = out, .pending_len = 0 };
+}
+
+static GgError base64_encoder_write(void *ctx, GgBuffer buf) {
+    GgBase64Encoder *encoder = ctx;
+    GgBuffer rest = buf;
+
+    if (encoder->pending_len > 0) {
+        // Complete the group left over from the previous write
+        uint8_t group[3] = { encoder->pending[0], encoder->pending[1], 0 };
+        size_t group_len = encoder->pending_len;
+        while ((group_len < 3) && (rest.len > 0)) {
+            group[group_len] = rest.data[0];
+            group_len++;
+            rest = gg_buffer_substr(rest, 1, SIZE_MAX);
+        }
+        if (group_len < 3) {
+            memcpy(encoder->pending, group, group_len);
+            encoder->pending_len = (uint8_t) group_len;
+            return GG_ERR_OK;
+        }
+        encoder->pending_len = 0;
+
+        uint8_t encoded[4];
+        base64_encode_into(GG_BUF(group), encoded);
+        GgError ret = gg_writer_call(encoder->out, GG_BUF(encoded));
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+    }
+
+    uint8_t encoded[(BASE64_STREAM_CHUNK / 3) * 4];
+    while (rest.len >= 3) {
+        size_t len = (rest.len < BASE64_STREAM_CHUNK)
+            ? (rest.len / 3) * 3
+            : BASE64_STREAM_CHUNK;
+        base64_encode_into(gg_buffer_substr(rest, 0, len), encoded);
+        GgError ret = gg_writer_call(
+            encoder->out,
+            (GgBuffer) { .data = encoded, .len = (len / 3) * 4 }
+        );
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        rest = gg_buffer_substr(rest, len, SIZE_MAX);
+    }
+
+    if (rest.len > 0) {
+        memcpy(encoder->pending, rest.data, rest.len);
+    }
+    encoder->pending_len = (uint8_t) rest.len;
+    return GG_ERR_OK;
+}
+
+GgWriter gg_base64_encoder_writer(GgBase64Encoder *encoder) {
+    return (GgWriter) { .ctx = encoder, .write = &base64_encoder_write };
+}
+
+GgError gg_base64_encoder_finish(GgBase64Encoder *encoder) {
+    if (encoder->pending_len == 0) {
+        return GG_ERR_OK;
+    }
+    uint8_t encoded[4];
+    base64_encode_into(
+        (GgBuffer) { .data = encoder->pending, .len = encoder->pending_len },
+        encoded
+    );
+    encoder->pending_len = 0;
+    return gg_writer_call(encoder->out, GG_BUF(encoded));
+}
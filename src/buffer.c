@@ -2,12 +2,18 @@
 // Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
 // SPDX-License-Identifier: Apache-2.0
 
+// Accessor definitions live in gg/buffer.h; this file emits the external
+// definitions exported by the library.
+#ifndef GG_INLINE_ACCESSORS
+#define GG_INLINE_ACCESSORS
+#endif
+
 #include <assert.h>
 #include <gg/buffer.h>
 #include <gg/cbmc.h>
 #include <gg/error.h>
 #include <gg/io.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <string.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -17,15 +23,7 @@ GgBuffer gg_buffer_from_null_term(char str[static 1]) {
     return (GgBuffer) { .data = (uint8_t *) str, .len = strlen(str) };
 }
 
-bool gg_buffer_eq(GgBuffer buf1, GgBuffer buf2) {
-    if (buf1.len == buf2.len) {
-        if (buf1.len == 0) {
-            return true;
-        }
-        return memcmp(buf1.data, buf2.data, buf1.len) == 0;
-    }
-    return false;
-}
+extern inline bool gg_buffer_eq(GgBuffer buf1, GgBuffer buf2);
 
 bool gg_buffer_has_prefix(GgBuffer buf, GgBuffer prefix) {
     if (prefix.len <= buf.len) {
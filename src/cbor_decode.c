@@ -0,0 +1,340 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <assert.h>
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/cbor_decode.h>
+#include <gg/error.h>
+#include <gg/log_priv.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define CBOR_MAJOR_UINT 0U
+#define CBOR_MAJOR_NEGINT 1U
+#define CBOR_MAJOR_BYTES 2U
+#define CBOR_MAJOR_TEXT 3U
+#define CBOR_MAJOR_ARRAY 4U
+#define CBOR_MAJOR_MAP 5U
+#define CBOR_MAJOR_TAG 6U
+#define CBOR_MAJOR_SIMPLE 7U
+
+#define CBOR_INFO_INDEFINITE 31U
+
+#define CBOR_SIMPLE_FALSE 20U
+#define CBOR_SIMPLE_TRUE 21U
+#define CBOR_SIMPLE_NULL 22U
+#define CBOR_SIMPLE_UNDEFINED 23U
+#define CBOR_SIMPLE_FLOAT16 25U
+#define CBOR_SIMPLE_FLOAT32 26U
+#define CBOR_SIMPLE_FLOAT64 27U
+
+typedef struct {
+    GgBuffer rest;
+    GgArena *arena;
+    GgObjectLimits limits;
+    size_t subobjects;
+} CborDecoder;
+
+typedef struct {
+    uint8_t major;
+    uint8_t info;
+    uint64_t arg;
+} CborHead;
+
+static uint64_t cbor_load_be(const uint8_t *data, size_t len) {
+    uint64_t val = 0;
+    for (size_t i = 0; i < len; i++) {
+        val = (val << 8) | data[i];
+    }
+    return val;
+}
+
+static GgError take_cbor_head(CborDecoder *dec, CborHead *head) {
+    if (dec->rest.len < 1) {
+        GG_LOGE("Unexpected end of CBOR input.");
+        return GG_ERR_PARSE;
+    }
+    uint8_t initial = dec->rest.data[0];
+    dec->rest = gg_buffer_substr(dec->rest, 1, SIZE_MAX);
+
+    head->major = initial >> 5;
+    head->info = initial & 0x1FU;
+
+    if (head->info < 24) {
+        head->arg = head->info;
+        return GG_ERR_OK;
+    }
+    if (head->info == CBOR_INFO_INDEFINITE) {
+        GG_LOGE("Indefinite-length CBOR items are not supported.");
+        return GG_ERR_UNSUPPORTED;
+    }
+    if (head->info > 27) {
+        GG_LOGE("Reserved CBOR additional info value.");
+        return GG_ERR_PARSE;
+    }
+
+    // 24 -> 1 byte, 25 -> 2, 26 -> 4, 27 -> 8
+    size_t arg_len = (size_t) 1 << (head->info - 24);
+    if (dec->rest.len < arg_len) {
+        GG_LOGE("Unexpected end of CBOR input.");
+        return GG_ERR_PARSE;
+    }
+    head->arg = cbor_load_be(dec->rest.data, arg_len);
+    dec->rest = gg_buffer_substr(dec->rest, arg_len, SIZE_MAX);
+    return GG_ERR_OK;
+}
+
+/// Converts IEEE 754 binary16 bits to a double.
+static double cbor_half_to_f64(uint16_t half) {
+    uint16_t exp = (half >> 10) & 0x1FU;
+    uint16_t mant = half & 0x3FFU;
+    double val;
+    if (exp == 0) {
+        val = ldexp(mant, -24);
+    } else if (exp != 31) {
+        val = ldexp(mant + 1024, exp - 25);
+    } else {
+        val = (mant == 0) ? INFINITY : NAN;
+    }
+    return ((half & 0x8000U) != 0) ? -val : val;
+}
+
+static GgError decode_cbor_simple(CborHead head, GgObject *obj) {
+    switch (head.info) {
+    case CBOR_SIMPLE_FALSE:
+    case CBOR_SIMPLE_TRUE:
+        *obj = gg_obj_bool(head.info == CBOR_SIMPLE_TRUE);
+        return GG_ERR_OK;
+    case CBOR_SIMPLE_NULL:
+    case CBOR_SIMPLE_UNDEFINED:
+        *obj = GG_OBJ_NULL;
+        return GG_ERR_OK;
+    case CBOR_SIMPLE_FLOAT16:
+        *obj = gg_obj_f64(cbor_half_to_f64((uint16_t) head.arg));
+        return GG_ERR_OK;
+    case CBOR_SIMPLE_FLOAT32: {
+        uint32_t bits = (uint32_t) head.arg;
+        float val;
+        memcpy(&val, &bits, sizeof(val));
+        *obj = gg_obj_f64(val);
+        return GG_ERR_OK;
+    }
+    case CBOR_SIMPLE_FLOAT64: {
+        double val;
+        memcpy(&val, &head.arg, sizeof(val));
+        *obj = gg_obj_f64(val);
+        return GG_ERR_OK;
+    }
+    default:
+        break;
+    }
+    GG_LOGE("Unsupported CBOR simple value.");
+    return GG_ERR_UNSUPPORTED;
+}
+
+static GgError take_cbor_val(CborDecoder *dec, uint16_t depth, GgObject *obj);
+
+static GgError take_cbor_str(CborDecoder *dec, CborHead head, GgBuffer *str) {
+    if (head.arg > dec->rest.len) {
+        GG_LOGE("CBOR string length exceeds input.");
+        return GG_ERR_PARSE;
+    }
+    *str = (GgBuffer) { .data = dec->rest.data, .len = (size_t) head.arg };
+    dec->rest = gg_buffer_substr(dec->rest, str->len, SIZE_MAX);
+    return GG_ERR_OK;
+}
+
+static GgError check_cbor_container(
+    CborDecoder *dec, uint16_t depth, uint64_t count, size_t item_objs
+) {
+    if ((count > 0) && (depth + 1U >= dec->limits.max_depth)) {
+        GG_LOGE("CBOR input exceeds maximum object depth.");
+        return GG_ERR_RANGE;
+    }
+    // Every data item takes at least one byte.
+    if (count > dec->rest.len / item_objs) {
+        GG_LOGE("CBOR container length exceeds input.");
+        return GG_ERR_PARSE;
+    }
+    size_t remaining = dec->limits.max_subobjects - dec->subobjects;
+    if (count > remaining / item_objs) {
+        GG_LOGE("CBOR input's subobjects exceeds maximum.");
+        return GG_ERR_RANGE;
+    }
+    dec->subobjects += (size_t) count * item_objs;
+    return GG_ERR_OK;
+}
+
+static GgError decode_cbor_array(
+    CborDecoder *dec, uint16_t depth, size_t count, GgObject *obj
+) {
+    GgObject *items = NULL;
+    if ((obj != NULL) && (count > 0)) {
+        items = GG_ARENA_ALLOCN(dec->arena, GgObject, count);
+        if (items == NULL) {
+            GG_LOGE("Insufficient memory to decode CBOR.");
+            return GG_ERR_NOMEM;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        GgError ret = take_cbor_val(
+            dec, (uint16_t) (depth + 1U), (items == NULL) ? NULL : &items[i]
+        );
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+    }
+
+    if (obj != NULL) {
+        *obj = gg_obj_list((GgList) { .items = items, .len = count });
+    }
+    return GG_ERR_OK;
+}
+
+static GgError decode_cbor_map(
+    CborDecoder *dec, uint16_t depth, size_t count, GgObject *obj
+) {
+    GgKV *pairs = NULL;
+    if ((obj != NULL) && (count > 0)) {
+        pairs = GG_ARENA_ALLOCN(dec->arena, GgKV, count);
+        if (pairs == NULL) {
+            GG_LOGE("Insufficient memory to decode CBOR.");
+            return GG_ERR_NOMEM;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        CborHead key_head;
+        GgError ret = take_cbor_head(dec, &key_head);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        if ((key_head.major != CBOR_MAJOR_BYTES)
+            && (key_head.major != CBOR_MAJOR_TEXT)) {
+            GG_LOGE("Non-string key type when decoding CBOR map.");
+            return GG_ERR_PARSE;
+        }
+        GgBuffer key;
+        ret = take_cbor_str(dec, key_head, &key);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+
+        GgObject *val = NULL;
+        if (pairs != NULL) {
+            gg_kv_set_key(&pairs[i], key);
+            val = gg_kv_val(&pairs[i]);
+        }
+        ret = take_cbor_val(dec, (uint16_t) (depth + 1U), val);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+    }
+
+    if (obj != NULL) {
+        *obj = gg_obj_map((GgMap) { .pairs = pairs, .len = count });
+    }
+    return GG_ERR_OK;
+}
+
+static GgError take_cbor_val(CborDecoder *dec, uint16_t depth, GgObject *obj) {
+    CborHead head;
+    GgError ret = take_cbor_head(dec, &head);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    // Decode into a scratch object when only validating
+    GgObject scratch;
+    GgObject *result = (obj == NULL) ? &scratch : obj;
+
+    switch (head.major) {
+    case CBOR_MAJOR_UINT:
+        if (head.arg > INT64_MAX) {
+            GG_LOGE("CBOR integer out of range.");
+            return GG_ERR_RANGE;
+        }
+        *result = gg_obj_i64((int64_t) head.arg);
+        return GG_ERR_OK;
+    case CBOR_MAJOR_NEGINT:
+        if (head.arg > INT64_MAX) {
+            GG_LOGE("CBOR integer out of range.");
+            return GG_ERR_RANGE;
+        }
+        *result = gg_obj_i64(-1 - (int64_t) head.arg);
+        return GG_ERR_OK;
+    case CBOR_MAJOR_BYTES:
+    case CBOR_MAJOR_TEXT: {
+        GgBuffer str;
+        ret = take_cbor_str(dec, head, &str);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        *result = gg_obj_buf(str);
+        return GG_ERR_OK;
+    }
+    case CBOR_MAJOR_ARRAY:
+        ret = check_cbor_container(dec, depth, head.arg, 1);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        return decode_cbor_array(dec, depth, (size_t) head.arg, obj);
+    case CBOR_MAJOR_MAP:
+        ret = check_cbor_container(dec, depth, head.arg, 2);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        return decode_cbor_map(dec, depth, (size_t) head.arg, obj);
+    case CBOR_MAJOR_TAG:
+        GG_LOGE("CBOR tags are not supported.");
+        return GG_ERR_UNSUPPORTED;
+    case CBOR_MAJOR_SIMPLE:
+        return decode_cbor_simple(head, result);
+    default:
+        break;
+    }
+
+    assert(false);
+    return GG_ERR_FAILURE;
+}
+
+GgError gg_cbor_decode(GgBuffer buf, GgArena *arena, GgObject *obj) {
+    // Handle NULL arena arg
+    GgArena empty_arena = { 0 };
+    GgArena *result_arena = (arena == NULL) ? &empty_arena : arena;
+
+    // Copy to avoid committing allocation on error path
+    GgArena arena_copy = *result_arena;
+
+    CborDecoder dec = {
+        .rest = buf,
+        .arena = &arena_copy,
+        .limits = gg_obj_get_limits(),
+        .subobjects = 0,
+    };
+
+    GgError ret = take_cbor_val(&dec, 0, obj);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    if (dec.rest.len > 0) {
+        GG_LOGE("Trailing buffer content when decoding.");
+        return GG_ERR_PARSE;
+    }
+
+    if (obj != NULL) {
+        // Commit allocations
+        *result_arena = arena_copy;
+    }
+
+    return GG_ERR_OK;
+}
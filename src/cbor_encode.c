@@ -0,0 +1,386 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <assert.h>
+#include <float.h>
+#include <gg/buffer.h>
+#include <gg/cbor_encode.h>
+#include <gg/error.h>
+#include <gg/io.h>
+#include <gg/object.h>
+#include <gg/object_visit.h>
+#include <gg/vector.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define CBOR_MAJOR_UINT 0U
+#define CBOR_MAJOR_NEGINT 1U
+#define CBOR_MAJOR_BYTES 2U
+#define CBOR_MAJOR_TEXT 3U
+#define CBOR_MAJOR_ARRAY 4U
+#define CBOR_MAJOR_MAP 5U
+
+#define CBOR_FALSE 0xF4U
+#define CBOR_TRUE 0xF5U
+#define CBOR_NULL 0xF6U
+#define CBOR_FLOAT32 0xFAU
+#define CBOR_FLOAT64 0xFBU
+
+/// Stores the low `len` bytes of `val` big-endian into `out`.
+static void cbor_store_be(uint8_t *out, uint64_t val, size_t len) {
+    for (size_t i = len; i > 0; i--) {
+        out[i - 1] = (uint8_t) val;
+        val >>= 8;
+    }
+}
+
+/// Formats a data item head with the shortest argument encoding.
+/// Returns the slice of `encoded` holding the result.
+static GgBuffer cbor_format_head(
+    uint8_t major, uint64_t arg, uint8_t encoded[static 9]
+) {
+    uint8_t type = (uint8_t) (major << 5);
+    size_t arg_len;
+    if (arg < 24) {
+        encoded[0] = (uint8_t) (type | arg);
+        return (GgBuffer) { .data = encoded, .len = 1 };
+    }
+    if (arg <= UINT8_MAX) {
+        encoded[0] = type | 24U;
+        arg_len = 1;
+    } else if (arg <= UINT16_MAX) {
+        encoded[0] = type | 25U;
+        arg_len = 2;
+    } else if (arg <= UINT32_MAX) {
+        encoded[0] = type | 26U;
+        arg_len = 4;
+    } else {
+        encoded[0] = type | 27U;
+        arg_len = 8;
+    }
+    cbor_store_be(&encoded[1], arg, arg_len);
+    return (GgBuffer) { .data = encoded, .len = 1 + arg_len };
+}
+
+static GgBuffer cbor_format_i64(int64_t val, uint8_t encoded[static 9]) {
+    if (val < 0) {
+        // -1 - val, computed without overflow for INT64_MIN
+        return cbor_format_head(
+            CBOR_MAJOR_NEGINT, ~(uint64_t) val, encoded
+        );
+    }
+    return cbor_format_head(CBOR_MAJOR_UINT, (uint64_t) val, encoded);
+}
+
+/// Whether a double can be converted to single precision without loss.
+static bool f64_fits_f32(double val) {
+    if (isnan(val)) {
+        // Keep NaN payload bits intact
+        return false;
+    }
+    if (fabs(val) > FLT_MAX) {
+        return isinf(val);
+    }
+    float narrowed = (float) val;
+    return memcmp(&(double) { narrowed }, &val, sizeof(double)) == 0;
+}
+
+static GgBuffer cbor_format_f64(double val, uint8_t encoded[static 9]) {
+    static_assert(sizeof(float) == 4, "float must be IEEE 754 binary32.");
+    static_assert(sizeof(double) == 8, "double must be IEEE 754 binary64.");
+
+    if (f64_fits_f32(val)) {
+        float narrowed = (float) val;
+        uint32_t bits;
+        memcpy(&bits, &narrowed, sizeof(bits));
+        encoded[0] = CBOR_FLOAT32;
+        cbor_store_be(&encoded[1], bits, 4);
+        return (GgBuffer) { .data = encoded, .len = 5 };
+    }
+
+    uint64_t bits;
+    memcpy(&bits, &val, sizeof(bits));
+    encoded[0] = CBOR_FLOAT64;
+    cbor_store_be(&encoded[1], bits, 8);
+    return (GgBuffer) { .data = encoded, .len = 9 };
+}
+
+static GgError cbor_write_head(GgWriter writer, uint8_t major, uint64_t arg) {
+    uint8_t encoded[9];
+    return gg_writer_call(writer, cbor_format_head(major, arg, encoded));
+}
+
+static GgError cbor_write_str(GgWriter writer, uint8_t major, GgBuffer val) {
+    GgError ret = cbor_write_head(writer, major, val.len);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    return gg_writer_call(writer, val);
+}
+
+static GgError cbor_encode_on_null(void *ctx) {
+    GgWriter *writer = ctx;
+    return gg_writer_call(*writer, GG_BUF((uint8_t[]) { CBOR_NULL }));
+}
+
+static GgError cbor_encode_on_bool(void *ctx, bool val) {
+    GgWriter *writer = ctx;
+    return gg_writer_call(
+        *writer, GG_BUF((uint8_t[]) { val ? CBOR_TRUE : CBOR_FALSE })
+    );
+}
+
+static GgError cbor_encode_on_i64(void *ctx, int64_t val) {
+    GgWriter *writer = ctx;
+    uint8_t encoded[9];
+    return gg_writer_call(*writer, cbor_format_i64(val, encoded));
+}
+
+static GgError cbor_encode_on_f64(void *ctx, double val) {
+    GgWriter *writer = ctx;
+    uint8_t encoded[9];
+    return gg_writer_call(*writer, cbor_format_f64(val, encoded));
+}
+
+static GgError cbor_encode_on_buf(void *ctx, GgBuffer val, GgObject *obj) {
+    GgWriter *writer = ctx;
+    (void) obj;
+    return cbor_write_str(*writer, CBOR_MAJOR_BYTES, val);
+}
+
+static GgError cbor_encode_on_list(void *ctx, GgList val, GgObject *obj) {
+    GgWriter *writer = ctx;
+    (void) obj;
+    return cbor_write_head(*writer, CBOR_MAJOR_ARRAY, val.len);
+}
+
+static GgError cbor_encode_on_map(void *ctx, GgMap val, GgObject *obj) {
+    GgWriter *writer = ctx;
+    (void) obj;
+    return cbor_write_head(*writer, CBOR_MAJOR_MAP, val.len);
+}
+
+static GgError cbor_encode_on_map_key(void *ctx, GgBuffer key, GgKV *kv) {
+    GgWriter *writer = ctx;
+    (void) kv;
+    return cbor_write_str(*writer, CBOR_MAJOR_TEXT, key);
+}
+
+/// Buffer for encoding packed numeric arrays, flushed when nearly full.
+typedef struct {
+    GgWriter writer;
+    size_t len;
+    uint8_t chunk[256];
+} CborArrayChunk;
+
+static GgError cbor_chunk_append(CborArrayChunk *chunk, GgBuffer item) {
+    if (chunk->len + item.len > sizeof(chunk->chunk)) {
+        GgError ret = gg_writer_call(
+            chunk->writer,
+            (GgBuffer) { .data = chunk->chunk, .len = chunk->len }
+        );
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        chunk->len = 0;
+    }
+    memcpy(&chunk->chunk[chunk->len], item.data, item.len);
+    chunk->len += item.len;
+    return GG_ERR_OK;
+}
+
+static GgError cbor_encode_on_f64_array(
+    void *ctx, GgF64Array val, GgObject *obj
+) {
+    GgWriter *writer = ctx;
+    (void) obj;
+    CborArrayChunk chunk = { .writer = *writer };
+    uint8_t encoded[9];
+
+    GgError ret = cbor_chunk_append(
+        &chunk, cbor_format_head(CBOR_MAJOR_ARRAY, val.len, encoded)
+    );
+    for (size_t i = 0; (ret == GG_ERR_OK) && (i < val.len); i++) {
+        ret = cbor_chunk_append(&chunk, cbor_format_f64(val.items[i], encoded));
+    }
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    return gg_writer_call(
+        *writer, (GgBuffer) { .data = chunk.chunk, .len = chunk.len }
+    );
+}
+
+static GgError cbor_encode_on_i64_array(
+    void *ctx, GgI64Array val, GgObject *obj
+) {
+    GgWriter *writer = ctx;
+    (void) obj;
+    CborArrayChunk chunk = { .writer = *writer };
+    uint8_t encoded[9];
+
+    GgError ret = cbor_chunk_append(
+        &chunk, cbor_format_head(CBOR_MAJOR_ARRAY, val.len, encoded)
+    );
+    for (size_t i = 0; (ret == GG_ERR_OK) && (i < val.len); i++) {
+        ret = cbor_chunk_append(&chunk, cbor_format_i64(val.items[i], encoded));
+    }
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    return gg_writer_call(
+        *writer, (GgBuffer) { .data = chunk.chunk, .len = chunk.len }
+    );
+}
+
+GgError gg_cbor_encode(GgObject obj, GgWriter writer) {
+    const GgObjectVisitHandlers VISIT_HANDLERS = {
+        .on_null = cbor_encode_on_null,
+        .on_bool = cbor_encode_on_bool,
+        .on_i64 = cbor_encode_on_i64,
+        .on_f64 = cbor_encode_on_f64,
+        .on_buf = cbor_encode_on_buf,
+        .on_list = cbor_encode_on_list,
+        .on_map = cbor_encode_on_map,
+        .on_map_key = cbor_encode_on_map_key,
+        .on_f64_array = cbor_encode_on_f64_array,
+        .on_i64_array = cbor_encode_on_i64_array,
+    };
+    return gg_obj_visit(&VISIT_HANDLERS, &writer, &obj);
+}
+
+static size_t cbor_head_len(uint64_t arg) {
+    uint8_t encoded[9];
+    return cbor_format_head(0, arg, encoded).len;
+}
+
+static GgError cbor_len_on_null(void *ctx) {
+    size_t *len = ctx;
+    *len += 1;
+    return GG_ERR_OK;
+}
+
+static GgError cbor_len_on_bool(void *ctx, bool val) {
+    size_t *len = ctx;
+    (void) val;
+    *len += 1;
+    return GG_ERR_OK;
+}
+
+static GgError cbor_len_on_i64(void *ctx, int64_t val) {
+    size_t *len = ctx;
+    uint8_t encoded[9];
+    *len += cbor_format_i64(val, encoded).len;
+    return GG_ERR_OK;
+}
+
+static GgError cbor_len_on_f64(void *ctx, double val) {
+    size_t *len = ctx;
+    *len += f64_fits_f32(val) ? 5 : 9;
+    return GG_ERR_OK;
+}
+
+static GgError cbor_len_on_buf(void *ctx, GgBuffer val, GgObject *obj) {
+    size_t *len = ctx;
+    (void) obj;
+    *len += cbor_head_len(val.len) + val.len;
+    return GG_ERR_OK;
+}
+
+static GgError cbor_len_on_list(void *ctx, GgList val, GgObject *obj) {
+    size_t *len = ctx;
+    (void) obj;
+    *len += cbor_head_len(val.len);
+    return GG_ERR_OK;
+}
+
+static GgError cbor_len_on_map(void *ctx, GgMap val, GgObject *obj) {
+    size_t *len = ctx;
+    (void) obj;
+    *len += cbor_head_len(val.len);
+    return GG_ERR_OK;
+}
+
+static GgError cbor_len_on_map_key(void *ctx, GgBuffer key, GgKV *kv) {
+    size_t *len = ctx;
+    (void) kv;
+    *len += cbor_head_len(key.len) + key.len;
+    return GG_ERR_OK;
+}
+
+static GgError cbor_len_on_f64_array(
+    void *ctx, GgF64Array val, GgObject *obj
+) {
+    size_t *len = ctx;
+    (void) obj;
+    size_t total = cbor_head_len(val.len);
+    for (size_t i = 0; i < val.len; i++) {
+        total += f64_fits_f32(val.items[i]) ? 5 : 9;
+    }
+    *len += total;
+    return GG_ERR_OK;
+}
+
+static GgError cbor_len_on_i64_array(
+    void *ctx, GgI64Array val, GgObject *obj
+) {
+    size_t *len = ctx;
+    (void) obj;
+    size_t total = cbor_head_len(val.len);
+    for (size_t i = 0; i < val.len; i++) {
+        uint8_t encoded[9];
+        total += cbor_format_i64(val.items[i], encoded).len;
+    }
+    *len += total;
+    return GG_ERR_OK;
+}
+
+GgError gg_cbor_encoded_len(GgObject obj, size_t *len) {
+    const GgObjectVisitHandlers VISIT_HANDLERS = {
+        .on_null = cbor_len_on_null,
+        .on_bool = cbor_len_on_bool,
+        .on_i64 = cbor_len_on_i64,
+        .on_f64 = cbor_len_on_f64,
+        .on_buf = cbor_len_on_buf,
+        .on_list = cbor_len_on_list,
+        .on_map = cbor_len_on_map,
+        .on_map_key = cbor_len_on_map_key,
+        .on_f64_array = cbor_len_on_f64_array,
+        .on_i64_array = cbor_len_on_i64_array,
+    };
+
+    size_t measured = 0;
+    GgError ret = gg_obj_visit(&VISIT_HANDLERS, &measured, &obj);
+    if ((len != NULL) && (ret == GG_ERR_OK)) {
+        *len = measured;
+    }
+    return ret;
+}
+
+static GgError obj_read(void *ctx, GgBuffer *buf) {
+    assert(buf != NULL);
+
+    const GgObject *obj = ctx;
+
+    if ((obj == NULL) || (buf == NULL)) {
+        return GG_ERR_INVALID;
+    }
+
+    GgByteVec vec = gg_byte_vec_init(*buf);
+    GgError ret = gg_cbor_encode(*obj, gg_byte_vec_writer(&vec));
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    *buf = vec.buf;
+    return GG_ERR_OK;
+}
+
+GgReader gg_cbor_reader(const GgObject *obj) {
+    assert(obj != NULL);
+    return (GgReader) { .read = obj_read, .ctx = (void *) obj };
+}
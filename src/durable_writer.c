@@ -0,0 +1,193 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <gg/buffer.h>
+#include <gg/cleanup.h>
+#include <gg/durable_writer.h>
+#include <gg/error.h>
+#include <gg/file.h>
+#include <gg/log_priv.h>
+#include <gg/utils.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/// Call fdatasync, handling EINTR
+static GgError gg_fdatasync(int fd) {
+    int ret;
+    do {
+        ret = fdatasync(fd);
+    } while ((ret != 0) && (errno == EINTR));
+    if (ret == 0) {
+        return GG_ERR_OK;
+    }
+    GG_LOGE("Err %d while calling fdatasync on fd %d.", errno, fd);
+    return GG_ERR_FAILURE;
+}
+
+GgError gg_durable_writer_open(
+    int dirfd,
+    GgBuffer path,
+    mode_t mode,
+    int64_t window_ms,
+    GgDurableWriter *writer
+) {
+    GgBuffer dir = GG_STR("");
+    GgBuffer file = path;
+    for (size_t i = path.len; i > 0; i--) {
+        if (path.data[i - 1] == '/') {
+            dir = gg_buffer_substr(path, 0, i - 1);
+            file = gg_buffer_substr(path, i, SIZE_MAX);
+            break;
+        }
+    }
+    if (file.len == 0) {
+        return GG_ERR_INVALID;
+    }
+    if (dir.len == 0) {
+        dir = GG_STR(".");
+    }
+
+    // Need a readable fd for the parent dir to sync the new dir entry
+    int parent_fd;
+    GgError ret = gg_dir_openat(dirfd, dir, O_RDONLY, true, &parent_fd);
+    if (ret != GG_ERR_OK) {
+        GG_LOGE("Failed to open dir for %.*s.", (int) path.len, path.data);
+        return ret;
+    }
+    GG_CLEANUP(cleanup_close, parent_fd);
+
+    int fd;
+    ret = gg_file_openat(
+        parent_fd, file, O_WRONLY | O_CREAT | O_APPEND, mode, &fd
+    );
+    if (ret != GG_ERR_OK) {
+        GG_LOGE("Failed to open %.*s.", (int) path.len, path.data);
+        return ret;
+    }
+    GG_CLEANUP_ID(fd_cleanup, cleanup_close, fd);
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        GG_LOGE("Err %d while calling fstat on fd %d.", errno, fd);
+        return GG_ERR_FAILURE;
+    }
+
+    // Existing contents may not be durable if a previous writer crashed
+    ret = gg_fsync(fd);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    ret = gg_fsync(parent_fd);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    *writer = (GgDurableWriter) {
+        .fd = fd,
+        .window_ms = window_ms,
+        .written = (uint64_t) info.st_size,
+        .synced = (uint64_t) info.st_size,
+        .syncing = false,
+        .err = GG_ERR_OK,
+    };
+    pthread_mutex_init(&writer->mtx, NULL);
+    pthread_cond_init(&writer->synced_cond, NULL);
+
+    fd_cleanup = -1;
+    return GG_ERR_OK;
+}
+
+GgError gg_durable_writer_append(
+    GgDurableWriter *writer, GgBuffer data, uint64_t *offset
+) {
+    GG_MTX_SCOPE_GUARD(&writer->mtx);
+
+    if (writer->err != GG_ERR_OK) {
+        return writer->err;
+    }
+
+    // Holding the lock keeps records from interleaving on partial writes
+    GgError ret = gg_file_write(writer->fd, data);
+    if (ret != GG_ERR_OK) {
+        // A partial record may have been written; later records would follow
+        // it, so the file can no longer be appended to consistently
+        writer->err = ret;
+        return ret;
+    }
+
+    writer->written += data.len;
+    if (offset != NULL) {
+        *offset = writer->written;
+    }
+    return GG_ERR_OK;
+}
+
+GgError gg_durable_writer_wait(GgDurableWriter *writer, uint64_t offset) {
+    GG_MTX_SCOPE_GUARD(&writer->mtx);
+
+    assert(offset <= writer->written);
+
+    while (writer->synced < offset) {
+        if (writer->err != GG_ERR_OK) {
+            return writer->err;
+        }
+
+        if (writer->syncing) {
+            // Sync in progress may not cover offset; recheck after it ends
+            pthread_cond_wait(&writer->synced_cond, &writer->mtx);
+            continue;
+        }
+
+        // Sync on behalf of all waiting writers
+        writer->syncing = true;
+        pthread_mutex_unlock(&writer->mtx);
+
+        if (writer->window_ms > 0) {
+            (void) gg_sleep_ms(writer->window_ms);
+        }
+
+        pthread_mutex_lock(&writer->mtx);
+        uint64_t target = writer->written;
+        pthread_mutex_unlock(&writer->mtx);
+
+        GgError ret = gg_fdatasync(writer->fd);
+
+        pthread_mutex_lock(&writer->mtx);
+        writer->syncing = false;
+        if (ret == GG_ERR_OK) {
+            writer->synced = target;
+        } else {
+            // After a failed sync, written data may have been dropped
+            writer->err = ret;
+        }
+        pthread_cond_broadcast(&writer->synced_cond);
+    }
+
+    return GG_ERR_OK;
+}
+
+GgError gg_durable_writer_write(GgDurableWriter *writer, GgBuffer data) {
+    uint64_t offset;
+    GgError ret = gg_durable_writer_append(writer, data, &offset);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    return gg_durable_writer_wait(writer, offset);
+}
+
+void gg_durable_writer_close(GgDurableWriter *writer) {
+    if (writer->fd >= 0) {
+        (void) gg_close(writer->fd);
+        writer->fd = -1;
+    }
+    pthread_cond_destroy(&writer->synced_cond);
+    pthread_mutex_destroy(&writer->mtx);
+}
@@ -8,7 +8,7 @@
 #include <gg/error.h>
 #include <gg/eventstream/decode.h>
 #include <gg/eventstream/types.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <string.h>
 #include <stdbool.h>
 #include <stdint.h>
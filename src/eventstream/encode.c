@@ -9,7 +9,7 @@
 #include <gg/eventstream/encode.h>
 #include <gg/eventstream/types.h>
 #include <gg/io.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <string.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -169,3 +169,49 @@ GgError eventstream_encode(
 
     return GG_ERR_OK;
 }
+
+GgError eventstream_encoded_len(
+    const EventStreamHeader *headers,
+    size_t header_count,
+    size_t payload_len,
+    size_t len[static 1]
+) {
+    assert((headers == NULL) ? (header_count == 0) : true);
+
+    // Prelude and message crc
+    size_t total = 12 + 4;
+
+    for (size_t i = 0; i < header_count; i++) {
+        EventStreamHeader header = headers[i];
+        if (header.name.len > UINT8_MAX) {
+            GG_LOGE("Header name field too long.");
+            return GG_ERR_RANGE;
+        }
+        // Name length, name, and value type
+        total += 1 + header.name.len + 1;
+
+        switch (header.value.type) {
+        case EVENTSTREAM_INT32:
+            total += 4;
+            break;
+        case EVENTSTREAM_STRING:
+            if (header.value.string.len > UINT16_MAX) {
+                GG_LOGE("String length exceeds eventstream limits.");
+                return GG_ERR_RANGE;
+            }
+            total += 2 + header.value.string.len;
+            break;
+        default:
+            GG_LOGE("Unhandled header value type.");
+            return GG_ERR_PARSE;
+        }
+    }
+
+    if (payload_len > UINT32_MAX - total) {
+        GG_LOGE("Payload length exceeds eventstream limits.");
+        return GG_ERR_RANGE;
+    }
+
+    *len = total + payload_len;
+    return GG_ERR_OK;
+}
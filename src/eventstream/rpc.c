@@ -9,7 +9,7 @@
 #include <gg/eventstream/rpc.h>
 #include <gg/eventstream/types.h>
 #include <gg/io.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <stdint.h>
 
 GgError eventsteam_get_packet(
@@ -9,11 +9,12 @@
 #include <gg/cleanup.h>
 #include <gg/error.h>
 #include <gg/file.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <limits.h>
 #include <pthread.h>
 #include <signal.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -551,31 +552,43 @@ GgError gg_file_read_path_at(int dirfd, GgBuffer path, GgBuffer *content) {
     return ret;
 }
 
-GgError gg_file_read_path(GgBuffer path, GgBuffer *content) {
+/// Open the directory a path is relative to, and strip any leading slash.
+static GgError open_path_base(GgBuffer path, int *base_fd, GgBuffer *rel_path) {
     if (path.len == 0) {
         return GG_ERR_INVALID;
     }
 
     bool absolute = false;
-    GgBuffer rel_path = path;
+    *rel_path = path;
 
     if (path.data[0] == '/') {
         absolute = true;
-        rel_path = gg_buffer_substr(path, 1, SIZE_MAX);
+        *rel_path = gg_buffer_substr(path, 1, SIZE_MAX);
     }
 
-    if (rel_path.len == 0) {
+    if (rel_path->len == 0) {
         return GG_ERR_INVALID;
     }
 
-    int base_fd = open(absolute ? "/" : ".", O_CLOEXEC | O_DIRECTORY | O_PATH);
-    if (base_fd < 0) {
+    int fd = open(absolute ? "/" : ".", O_CLOEXEC | O_DIRECTORY | O_PATH);
+    if (fd < 0) {
         GG_LOGE("Err %d while opening /", errno);
         return GG_ERR_FAILURE;
     }
+    *base_fd = fd;
+    return GG_ERR_OK;
+}
+
+GgError gg_file_read_path(GgBuffer path, GgBuffer *content) {
+    int base_fd;
+    GgBuffer rel_path;
+    GgError ret = open_path_base(path, &base_fd, &rel_path);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
     GG_CLEANUP(cleanup_close, base_fd);
 
-    GgError ret = gg_file_read_path_at(base_fd, rel_path, content);
+    ret = gg_file_read_path_at(base_fd, rel_path, content);
     if (ret != GG_ERR_OK) {
         GG_LOGE(
             "Err %d occurred while reading file %.*s",
@@ -588,3 +601,88 @@ GgError gg_file_read_path(GgBuffer path, GgBuffer *content) {
 
     return GG_ERR_OK;
 }
+
+GgError gg_file_map_at(
+    int dirfd, GgBuffer path, GgFileMapOptions opts, GgBuffer *content
+) {
+    int fd;
+    GgError ret = gg_file_openat(dirfd, path, O_RDONLY, 0, &fd);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    GG_CLEANUP(cleanup_close, fd);
+
+    struct stat info;
+    int sys_ret = fstat(fd, &info);
+    if (sys_ret != 0) {
+        GG_LOGE(
+            "Err %d while calling fstat on file: %.*s",
+            errno,
+            (int) path.len,
+            path.data
+        );
+        return GG_ERR_FAILURE;
+    }
+
+    if (!S_ISREG(info.st_mode)) {
+        GG_LOGE(
+            "Cannot map non-regular file %.*s.", (int) path.len, path.data
+        );
+        return GG_ERR_INVALID;
+    }
+
+    if ((uintmax_t) info.st_size > SIZE_MAX) {
+        GG_LOGE("File %.*s too large to map.", (int) path.len, path.data);
+        return GG_ERR_NOMEM;
+    }
+
+    size_t file_size = (size_t) info.st_size;
+
+    // mmap rejects zero-length mappings
+    if (file_size == 0) {
+        *content = (GgBuffer) { 0 };
+        return GG_ERR_OK;
+    }
+
+    int prot = opts.writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void *addr = mmap(NULL, file_size, prot, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+        int err = errno;
+        GG_LOGE(
+            "Err %d while mapping file %.*s.", err, (int) path.len, path.data
+        );
+        return (err == ENOMEM) ? GG_ERR_NOMEM : GG_ERR_FAILURE;
+    }
+
+    // Hints are advisory; mapping is usable if they fail
+    if (opts.sequential) {
+        (void) madvise(addr, file_size, MADV_SEQUENTIAL);
+    }
+    if (opts.willneed) {
+        (void) madvise(addr, file_size, MADV_WILLNEED);
+    }
+
+    *content = (GgBuffer) { .data = addr, .len = file_size };
+    return GG_ERR_OK;
+}
+
+GgError gg_file_map(GgBuffer path, GgFileMapOptions opts, GgBuffer *content) {
+    int base_fd;
+    GgBuffer rel_path;
+    GgError ret = open_path_base(path, &base_fd, &rel_path);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    GG_CLEANUP(cleanup_close, base_fd);
+
+    return gg_file_map_at(base_fd, rel_path, opts, content);
+}
+
+void gg_file_unmap(GgBuffer content) {
+    if (content.len == 0) {
+        return;
+    }
+    if (munmap(content.data, content.len) != 0) {
+        GG_LOGE("Err %d while unmapping file.", errno);
+    }
+}
@@ -4,7 +4,7 @@
 
 #include <gg/error.h>
 #include <gg/init.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/sdk.h>
 #include <stdlib.h>
 
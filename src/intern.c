@@ -0,0 +1,67 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <assert.h>
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/hash.h>
+#include <gg/intern.h>
+#include <gg/log_priv.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// Hash of a string for selecting its slot.
+static size_t intern_hash(GgBuffer buf) {
+    uint64_t hash = gg_fnv1a(buf, 0);
+    return (size_t) (hash ^ (hash >> 32));
+}
+
+GgInternTable gg_intern_table_init(
+    GgArena *storage, GgBuffer *slots, size_t slot_count, size_t max_len
+) {
+    assert((slot_count > 0) && ((slot_count & (slot_count - 1)) == 0));
+
+    for (size_t i = 0; i < slot_count; i++) {
+        slots[i] = (GgBuffer) { 0 };
+    }
+    return (GgInternTable) { .storage = storage,
+                             .slots = slots,
+                             .slot_mask = slot_count - 1,
+                             .max_len = max_len };
+}
+
+bool gg_intern(GgInternTable *table, GgBuffer *buf) {
+    if ((buf->len == 0) || (buf->len > table->max_len)) {
+        return false;
+    }
+
+    size_t slot = intern_hash(*buf) & table->slot_mask;
+    while (table->slots[slot].data != NULL) {
+        if (gg_buffer_eq(table->slots[slot], *buf)) {
+            *buf = table->slots[slot];
+            return true;
+        }
+        slot = (slot + 1) & table->slot_mask;
+    }
+
+    // Keep load factor at most 3/4 so probe sequences stay short
+    if ((table->count + 1) > ((table->slot_mask + 1) / 4) * 3) {
+        GG_LOGD("Intern table full; not interning string.");
+        return false;
+    }
+
+    uint8_t *mem = GG_ARENA_ALLOCN(table->storage, uint8_t, buf->len);
+    if (mem == NULL) {
+        GG_LOGD("Intern storage full; not interning string.");
+        return false;
+    }
+    memcpy(mem, buf->data, buf->len);
+
+    table->slots[slot] = (GgBuffer) { .data = mem, .len = buf->len };
+    table->count += 1;
+    *buf = table->slots[slot];
+    return true;
+}
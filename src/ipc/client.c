@@ -16,20 +16,25 @@
 #include <gg/file.h> // IWYU pragma: keep (TODO: remove after file.h refactor)
 #include <gg/flags.h>
 #include <gg/init.h>
+#include <gg/intern.h>
 #include <gg/io.h>
 #include <gg/ipc/client.h>
 #include <gg/ipc/client_priv.h>
 #include <gg/ipc/client_raw.h>
+#include <gg/ipc/client_stats.h>
+#include <gg/ipc/client_trace.h>
 #include <gg/ipc/limits.h>
 #include <gg/json_decode.h>
 #include <gg/json_encode.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <gg/socket.h>
 #include <gg/socket_epoll.h>
 #include <inttypes.h>
 #include <pthread.h>
+#include <string.h>
+#include <sys/epoll.h>
 #include <sys/types.h>
 #include <time.h>
 #include <unistd.h>
@@ -43,17 +48,25 @@ static atomic_int ipc_conn_fd = -1;
 
 // Used while connecting or by receiving thread which are mutually exclusive.
 static uint8_t ipc_recv_mem[GG_IPC_MAX_MSG_LEN];
-static uint8_t ipc_recv_decode_mem[sizeof(GgObject[GG_MAX_OBJECT_SUBOBJECTS])];
+static uint8_t ipc_recv_decode_mem[GG_IPC_DECODE_MEM_LEN];
+static GgBuffer ipc_recv_decode_buf = { .data = ipc_recv_decode_mem,
+                                        .len = sizeof(ipc_recv_decode_mem) };
+static GgInternTable *ipc_recv_intern = NULL;
 
 static int epoll_fd = -1;
 static pid_t recv_thread_id = -1;
 
 typedef struct {
     GgIpcSubscribeCallback *fn;
+    GgIpcSubscribeRawCallback *raw_fn;
     void *ctx;
     void *aux_ctx;
 } StreamHandler;
 
+static bool is_sub_handler(StreamHandler handler) {
+    return (handler.fn != NULL) || (handler.raw_fn != NULL);
+}
+
 static_assert(
     GG_IPC_MAX_STREAMS <= UINT16_MAX, "Max stream count must fit in 16 bits."
 );
@@ -61,14 +74,36 @@ static_assert(
 static int32_t stream_state_id[GG_IPC_MAX_STREAMS] = { 0 };
 static uint16_t stream_state_generation[GG_IPC_MAX_STREAMS] = { 0 };
 static StreamHandler stream_state_handler[GG_IPC_MAX_STREAMS] = { 0 };
+static GgBuffer stream_state_operation[GG_IPC_MAX_STREAMS] = { 0 };
+static uint32_t stream_state_used = 0;
 
 static pthread_mutex_t stream_state_mtx;
 
+// Encoded packets not yet accepted by the socket, in send order.
+// Protected by stream_state_mtx and flushed by receive thread on EPOLLOUT.
+static uint8_t ipc_out_mem[GG_IPC_MAX_MSG_LEN];
+static size_t ipc_out_len = 0;
+// Signaled when ipc_out_mem space is freed.
+static pthread_cond_t ipc_out_cond;
+
+// Stream of the packet being dispatched by the receive thread, for tracing.
+static int32_t recv_trace_stream_id = -1;
+static GgBuffer recv_trace_operation = { 0 };
+
+#define TRACE_RECV_POINT(name) \
+    GG_IPC_TRACE_POINT(name, recv_trace_stream_id, recv_trace_operation)
+
 __attribute__((constructor)) static void init_stream_state_mtx(void) {
     pthread_mutexattr_t attr;
     pthread_mutexattr_init(&attr);
     pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
     pthread_mutex_init(&stream_state_mtx, &attr);
+
+    pthread_condattr_t condattr;
+    pthread_condattr_init(&condattr);
+    pthread_condattr_setclock(&condattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&ipc_out_cond, &condattr);
+    pthread_condattr_destroy(&condattr);
 }
 
 static GgError init_ipc_recv_thread(void);
@@ -153,6 +188,8 @@ static bool claim_stream_index(uint16_t *index) {
             stream_state_generation[i] += 1;
             stream_state_id[i] = -1;
             *index = i;
+            stream_state_used += 1;
+            ggipc_stats_set_streams_in_use(stream_state_used);
             return true;
         }
     }
@@ -169,36 +206,221 @@ static void set_stream_index(
 
 // Requires holding stream_state_mtx
 static void clear_stream_index(uint16_t index) {
+    if (stream_state_id[index] != 0) {
+        stream_state_used -= 1;
+        ggipc_stats_set_streams_in_use(stream_state_used);
+    }
     stream_state_generation[index] += 1;
     stream_state_id[index] = 0;
     stream_state_handler[index] = (StreamHandler) { 0 };
+    stream_state_operation[index] = (GgBuffer) { 0 };
+}
+
+// Requires holding stream_state_mtx
+static GgError ipc_out_reserve(size_t len) {
+    if (len > sizeof(ipc_out_mem) - ipc_out_len) {
+        GG_LOGD("GG-IPC outbound buffer full; waiting for receive thread.");
+    }
+
+    struct timespec timeout;
+    clock_gettime(CLOCK_MONOTONIC, &timeout);
+    timeout.tv_sec += GG_IPC_RESPONSE_TIMEOUT;
+
+    while (len > sizeof(ipc_out_mem) - ipc_out_len) {
+        int cond_ret = pthread_cond_timedwait(
+            &ipc_out_cond, &stream_state_mtx, &timeout
+        );
+        if ((cond_ret != 0) && (cond_ret != EINTR)) {
+            assert(cond_ret == ETIMEDOUT);
+            GG_LOGE("Timed out waiting to send GG-IPC packet.");
+            ggipc_stat_add(GGIPC_STAT_TIMEOUTS, 1);
+            return GG_ERR_TIMEOUT;
+        }
+    }
+    return GG_ERR_OK;
+}
+
+// Requires holding stream_state_mtx
+static void ipc_out_consume(GgBuffer rest) {
+    if ((rest.len != 0) && (rest.data != ipc_out_mem)) {
+        memmove(ipc_out_mem, rest.data, rest.len);
+    }
+    ipc_out_len = rest.len;
+    pthread_cond_broadcast(&ipc_out_cond);
+}
+
+// Requires holding stream_state_mtx
+// Packet must be encoded at the end of the queued data in ipc_out_mem.
+static GgError ipc_out_push(int conn, GgBuffer packet) {
+    if (ipc_out_len != 0) {
+        // Already watching for EPOLLOUT; queue behind pending data
+        ipc_out_len += packet.len;
+        return GG_ERR_OK;
+    }
+
+    GgError ret = gg_socket_write_partial(conn, &packet);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    if (packet.len == 0) {
+        return GG_ERR_OK;
+    }
+
+    GG_LOGT("Deferring %zu bytes of GG-IPC packet on fd %d.", packet.len, conn);
+    ipc_out_consume(packet);
+    return gg_socket_epoll_mod(
+        epoll_fd, conn, EPOLLIN | EPOLLOUT, (uint64_t) conn
+    );
+}
+
+// Requires holding stream_state_mtx
+static GgError ipc_out_flush_blocking(int conn) {
+    if (ipc_out_len == 0) {
+        return GG_ERR_OK;
+    }
+    GgError ret = gg_socket_write(
+        conn, (GgBuffer) { .data = ipc_out_mem, .len = ipc_out_len }
+    );
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    // EPOLLOUT watch is removed on its next wakeup
+    ipc_out_consume((GgBuffer) { 0 });
+    return GG_ERR_OK;
+}
+
+// Called on receive thread when fd is writable
+static GgError ipc_out_flush(int conn) {
+    GG_CLEANUP(
+        cleanup_pthread_mtx_unlock, ggipc_stats_lock(&stream_state_mtx)
+    );
+
+    GgBuffer rest = { .data = ipc_out_mem, .len = ipc_out_len };
+    GgError ret = gg_socket_write_partial(conn, &rest);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    ipc_out_consume(rest);
+
+    if (ipc_out_len != 0) {
+        return GG_ERR_OK;
+    }
+    return gg_socket_epoll_mod(epoll_fd, conn, EPOLLIN, (uint64_t) conn);
 }
 
 // After connected, requires holding stream_state_mtx
 static GgError ipc_send_packet(
     int conn,
+    int32_t stream_id,
+    GgBuffer operation,
     const EventStreamHeader *headers,
     size_t headers_len,
-    GgReader payload
+    GgReader payload,
+    size_t payload_len
 ) {
-    static uint8_t ipc_send_mem[GG_IPC_MAX_MSG_LEN];
-    GgBuffer es_packet = GG_BUF(ipc_send_mem);
+    size_t packet_len = 0;
+    GgError ret = eventstream_encoded_len(
+        headers, headers_len, payload_len, &packet_len
+    );
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    if (packet_len > GG_IPC_MAX_MSG_LEN) {
+        GG_LOGE(
+            "GG-IPC packet size (%zu) exceeds max message length (%u).",
+            packet_len,
+            (unsigned) GG_IPC_MAX_MSG_LEN
+        );
+        return GG_ERR_RANGE;
+    }
+
+    // The socket is not watched for EPOLLOUT until connected, and the receive
+    // thread cannot wait on itself to flush, so these write synchronously.
+    bool blocking = (conn != ipc_conn_fd) || (gettid() == recv_thread_id);
 
-    GgError ret = eventstream_encode(&es_packet, headers, headers_len, payload);
+    ret = blocking ? ipc_out_flush_blocking(conn) : ipc_out_reserve(packet_len);
     if (ret != GG_ERR_OK) {
         return ret;
     }
 
-    return gg_socket_write(conn, es_packet);
+    GgBuffer es_packet
+        = gg_buffer_substr(GG_BUF(ipc_out_mem), ipc_out_len, SIZE_MAX);
+    ret = eventstream_encode(&es_packet, headers, headers_len, payload);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    GG_IPC_TRACE_POINT(frame_encode, stream_id, operation);
+
+    ret = blocking ? gg_socket_write(conn, es_packet)
+                   : ipc_out_push(conn, es_packet);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    GG_IPC_TRACE_POINT(socket_write, stream_id, operation);
+
+    ggipc_stat_add(GGIPC_STAT_FRAMES_SENT, 1);
+    ggipc_stat_add(GGIPC_STAT_BYTES_SENT, packet_len);
+    return GG_ERR_OK;
+}
+
+// Used for the connect packet, on stream 0
+static GgError ipc_send_json_packet(
+    int conn,
+    const EventStreamHeader *headers,
+    size_t headers_len,
+    const GgObject *payload
+) {
+    size_t payload_len = 0;
+    GgError ret = gg_json_encoded_len(*payload, &payload_len);
+    if (ret != GG_ERR_OK) {
+        GG_LOGE("Failed to calculate GG-IPC payload length.");
+        return ret;
+    }
+
+    return ipc_send_packet(
+        conn,
+        0,
+        (GgBuffer) { 0 },
+        headers,
+        headers_len,
+        gg_json_reader(payload),
+        payload_len
+    );
 }
 
 static bool connected(void) {
     return ipc_conn_fd >= 0;
 }
 
+GgError ggipc_set_decode_mem(GgBuffer mem) {
+    if (connected()) {
+        GG_LOGE("IPC decode memory must be set before connecting.");
+        return GG_ERR_INVALID;
+    }
+    ipc_recv_decode_buf = mem;
+    return GG_ERR_OK;
+}
+
+GgError ggipc_set_intern_table(GgInternTable *table) {
+    if (connected()) {
+        GG_LOGE("IPC intern table must be set before connecting.");
+        return GG_ERR_INVALID;
+    }
+    ipc_recv_intern = table;
+    return GG_ERR_OK;
+}
+
+/// Arena for decoding received payloads.
+static GgArena recv_decode_arena(void) {
+    GgArena arena = gg_arena_init(ipc_recv_decode_buf);
+    arena.intern = ipc_recv_intern;
+    return arena;
+}
+
 static GgError register_ipc_socket(int conn) {
     assert(epoll_fd >= 0);
-    return gg_socket_epoll_add(epoll_fd, conn, (uint64_t) conn);
+    return gg_socket_epoll_add(epoll_fd, conn, EPOLLIN, (uint64_t) conn);
 }
 
 __attribute__((weak)) GgError
@@ -239,7 +461,7 @@ GgError ggipc_connect_with_payload(GgBuffer socket_path, GgObject payload) {
     };
     size_t headers_len = sizeof(headers) / sizeof(headers[0]);
 
-    ret = ipc_send_packet(conn, headers, headers_len, gg_json_reader(&payload));
+    ret = ipc_send_json_packet(conn, headers, headers_len, &payload);
     if (ret != GG_ERR_OK) {
         GG_LOGE("Failed to send GG-IPC connect packet on fd %d.", conn);
         return ret;
@@ -327,6 +549,18 @@ static void cleanup_pthread_cond(pthread_cond_t **cond) {
     pthread_cond_destroy(*cond);
 }
 
+// Called on receive thread before calling a user callback
+static uint64_t callback_enter(void) {
+    TRACE_RECV_POINT(callback_enter);
+    return ggipc_stats_now_ns();
+}
+
+// Called on receive thread after a user callback returns
+static void callback_exit(uint64_t start) {
+    ggipc_stats_callback_done(start);
+    TRACE_RECV_POINT(callback_exit);
+}
+
 // Must hold stream_state_mtx
 static GgError handle_application_error(
     GgBuffer payload, GgIpcErrorCallback *error_callback, void *response_ctx
@@ -335,29 +569,31 @@ static GgError handle_application_error(
         return GG_ERR_REMOTE;
     }
 
-    GgArena error_alloc = gg_arena_init(GG_BUF(ipc_recv_decode_mem));
+    GgArena error_alloc = recv_decode_arena();
 
     GgObject err_result;
     GgError ret
         = gg_json_decode_destructive(payload, &error_alloc, &err_result);
     if (ret != GG_ERR_OK) {
         GG_LOGE("Failed to decode IPC error payload.");
+        ggipc_stat_add(GGIPC_STAT_DECODE_FAILURES, 1);
         return ret;
     }
     if (gg_obj_type(err_result) != GG_TYPE_MAP) {
         GG_LOGE("Failed to decode IPC error payload.");
+        ggipc_stat_add(GGIPC_STAT_DECODE_FAILURES, 1);
         return GG_ERR_PARSE;
     }
+    TRACE_RECV_POINT(payload_decode);
 
     GgObject *error_code_obj;
     GgObject *message_obj;
 
-    ret = gg_map_validate(
+    GG_MAP_VALIDATE(
+        ret,
         gg_obj_into_map(err_result),
-        GG_MAP_SCHEMA(
-            { GG_STR("_errorCode"), GG_REQUIRED, GG_TYPE_BUF, &error_code_obj },
-            { GG_STR("_message"), GG_OPTIONAL, GG_TYPE_BUF, &message_obj },
-        )
+        { GG_STR("_errorCode"), GG_REQUIRED, GG_TYPE_BUF, &error_code_obj },
+        { GG_STR("_message"), GG_OPTIONAL, GG_TYPE_BUF, &message_obj },
     );
     if (ret != GG_ERR_OK) {
         GG_LOGE("Error response does not match known schema.");
@@ -370,7 +606,9 @@ static GgError handle_application_error(
         message = gg_obj_into_buf(*message_obj);
     }
 
+    uint64_t callback_start = callback_enter();
     ret = error_callback(response_ctx, error_code, message);
+    callback_exit(callback_start);
     if (ret != GG_ERR_OK) {
         return ret;
     }
@@ -409,21 +647,27 @@ static GgError response_handler_inner(
         return GG_ERR_OK;
     }
 
-    GgArena alloc = gg_arena_init(GG_BUF(ipc_recv_decode_mem));
+    GgArena alloc = recv_decode_arena();
     GgObject result = GG_OBJ_NULL;
 
     GgError ret = gg_json_decode_destructive(msg.payload, &alloc, &result);
     if (ret != GG_ERR_OK) {
         GG_LOGE("Failed to decode IPC response payload.");
+        ggipc_stat_add(GGIPC_STAT_DECODE_FAILURES, 1);
         return ret;
     }
 
     if (gg_obj_type(result) != GG_TYPE_MAP) {
         GG_LOGE("IPC response payload is not a JSON object.");
+        ggipc_stat_add(GGIPC_STAT_DECODE_FAILURES, 1);
         return GG_ERR_FAILURE;
     }
+    TRACE_RECV_POINT(payload_decode);
 
-    return result_callback(response_ctx, gg_obj_into_map(result));
+    uint64_t callback_start = callback_enter();
+    ret = result_callback(response_ctx, gg_obj_into_map(result));
+    callback_exit(callback_start);
+    return ret;
 }
 
 typedef struct {
@@ -433,9 +677,7 @@ typedef struct {
     GgIpcResultCallback *result_callback;
     GgIpcErrorCallback *error_callback;
     void *response_ctx;
-    GgIpcSubscribeCallback *sub_callback;
-    void *sub_callback_ctx;
-    void *sub_callback_aux_ctx;
+    StreamHandler sub_handler;
 } ResponseHandlerCtx;
 
 // Must hold stream_state_mtx
@@ -455,7 +697,8 @@ static void response_handler(
         call_ctx->response_ctx
     );
 
-    if ((call_ctx->sub_callback == NULL) || (call_ctx->ret != GG_ERR_OK)) {
+    if (!is_sub_handler(call_ctx->sub_handler)
+        || (call_ctx->ret != GG_ERR_OK)) {
         clear_stream_index(index);
     } else {
         if ((common_headers.message_flags & EVENTSTREAM_TERMINATE_STREAM)
@@ -469,13 +712,7 @@ static void response_handler(
             call_ctx->ret = GG_ERR_FAILURE;
         } else {
             set_stream_index(
-                index,
-                common_headers.stream_id,
-                (StreamHandler) {
-                    .fn = call_ctx->sub_callback,
-                    .ctx = call_ctx->sub_callback_ctx,
-                    .aux_ctx = call_ctx->sub_callback_aux_ctx,
-                }
+                index, common_headers.stream_id, call_ctx->sub_handler
             );
         }
     }
@@ -484,39 +721,17 @@ static void response_handler(
     pthread_cond_signal(call_ctx->cond);
 }
 
-GgError ggipc_call(
-    GgBuffer operation,
-    GgBuffer service_model_type,
-    GgMap params,
-    GgIpcResultCallback *result_callback,
-    GgIpcErrorCallback *error_callback,
-    void *response_ctx
-) {
-    return ggipc_subscribe(
-        operation,
-        service_model_type,
-        params,
-        result_callback,
-        error_callback,
-        response_ctx,
-        NULL,
-        NULL,
-        NULL,
-        NULL
-    );
-}
-
-GgError ggipc_subscribe(
+static GgError ipc_request(
     GgBuffer operation,
     GgBuffer service_model_type,
-    GgMap params,
+    GgReader params,
+    size_t params_len,
     GgIpcResultCallback *result_callback,
     GgIpcErrorCallback *error_callback,
     void *response_ctx,
-    GgIpcSubscribeCallback *sub_callback,
-    void *sub_callback_ctx,
-    void *sub_callback_aux_ctx,
-    GgIpcSubscriptionHandle *sub_handle
+    StreamHandler sub_handler,
+    GgIpcSubscriptionHandle *sub_handle,
+    GgIpcOperationStatsEntry *stats
 ) {
     if (!connected()) {
         return GG_ERR_NOCONN;
@@ -544,19 +759,20 @@ GgError ggipc_subscribe(
         .result_callback = result_callback,
         .error_callback = error_callback,
         .response_ctx = response_ctx,
-        .sub_callback = sub_callback,
-        .sub_callback_ctx = sub_callback_ctx,
-        .sub_callback_aux_ctx = sub_callback_aux_ctx,
+        .sub_handler = sub_handler,
     };
 
     uint16_t stream_index;
     int32_t stream_id = -1;
 
-    GG_MTX_SCOPE_GUARD(&stream_state_mtx);
+    GG_CLEANUP(
+        cleanup_pthread_mtx_unlock, ggipc_stats_lock(&stream_state_mtx)
+    );
 
     bool index_available = claim_stream_index(&stream_index);
     if (!index_available) {
         GG_LOGE("GG-IPC request failed to get available stream slot.");
+        ggipc_stat_add(GGIPC_STAT_STREAM_SLOT_FAILURES, 1);
         return GG_ERR_NOMEM;
     }
 
@@ -567,11 +783,10 @@ GgError ggipc_subscribe(
     set_stream_index(
         stream_index,
         stream_id,
-        (StreamHandler) {
-            .fn = NULL,
-            .ctx = &response_handler_ctx,
-        }
+        (StreamHandler) { .ctx = &response_handler_ctx }
     );
+    // Stats entry name outlives the stream, unlike the caller's buffer
+    stream_state_operation[stream_index] = ggipc_stats_operation_name(stats);
 
     if (sub_handle != NULL) {
         *sub_handle = get_current_handle(stream_index);
@@ -588,9 +803,14 @@ GgError ggipc_subscribe(
     };
     size_t headers_len = sizeof(headers) / sizeof(headers[0]);
 
-    GgObject params_obj = gg_obj_map(params);
     GgError ret = ipc_send_packet(
-        ipc_conn_fd, headers, headers_len, gg_json_reader(&params_obj)
+        ipc_conn_fd,
+        stream_id,
+        stream_state_operation[stream_index],
+        headers,
+        headers_len,
+        params,
+        params_len
     );
 
     if (ret != GG_ERR_OK) {
@@ -609,6 +829,7 @@ GgError ggipc_subscribe(
         if ((cond_ret != 0) && (cond_ret != EINTR)) {
             assert(cond_ret == ETIMEDOUT);
             GG_LOGW("Timed out waiting for a response.");
+            ggipc_stat_add(GGIPC_STAT_TIMEOUTS, 1);
             clear_stream_index(stream_index);
             return GG_ERR_TIMEOUT;
         }
@@ -617,12 +838,172 @@ GgError ggipc_subscribe(
     return response_handler_ctx.ret;
 }
 
-// Must hold stream_state_mtx
-static GgError call_sub_callback(
-    GgIpcSubscriptionHandle handle,
+static GgError ipc_subscribe_common(
+    GgBuffer operation,
+    GgBuffer service_model_type,
+    GgReader params,
+    size_t params_len,
+    GgIpcResultCallback *result_callback,
+    GgIpcErrorCallback *error_callback,
+    void *response_ctx,
+    StreamHandler sub_handler,
+    GgIpcSubscriptionHandle *sub_handle
+) {
+    GgIpcOperationStatsEntry *stats = ggipc_stats_operation(operation);
+    uint64_t start = ggipc_stats_now_ns();
+    ggipc_stat_add(GGIPC_STAT_REQUESTS_IN_FLIGHT, 1);
+
+    GgError ret = ipc_request(
+        operation,
+        service_model_type,
+        params,
+        params_len,
+        result_callback,
+        error_callback,
+        response_ctx,
+        sub_handler,
+        sub_handle,
+        stats
+    );
+
+    ggipc_stat_sub(GGIPC_STAT_REQUESTS_IN_FLIGHT, 1);
+    ggipc_stats_request_done(stats, ret, start);
+    return ret;
+}
+
+static GgError ipc_subscribe_json(
+    GgBuffer operation,
+    GgBuffer service_model_type,
+    GgMap params,
+    GgIpcResultCallback *result_callback,
+    GgIpcErrorCallback *error_callback,
+    void *response_ctx,
+    StreamHandler sub_handler,
+    GgIpcSubscriptionHandle *sub_handle
+) {
+    GgObject params_obj = gg_obj_map(params);
+    size_t params_len = 0;
+    GgError ret = gg_json_encoded_len(params_obj, &params_len);
+    if (ret != GG_ERR_OK) {
+        GG_LOGE("Failed to calculate GG-IPC payload length.");
+        return ret;
+    }
+
+    return ipc_subscribe_common(
+        operation,
+        service_model_type,
+        gg_json_reader(&params_obj),
+        params_len,
+        result_callback,
+        error_callback,
+        response_ctx,
+        sub_handler,
+        sub_handle
+    );
+}
+
+GgError ggipc_call(
+    GgBuffer operation,
+    GgBuffer service_model_type,
+    GgMap params,
+    GgIpcResultCallback *result_callback,
+    GgIpcErrorCallback *error_callback,
+    void *response_ctx
+) {
+    return ipc_subscribe_json(
+        operation,
+        service_model_type,
+        params,
+        result_callback,
+        error_callback,
+        response_ctx,
+        (StreamHandler) { 0 },
+        NULL
+    );
+}
+
+GgError ggipc_call_with_payload(
+    GgBuffer operation,
+    GgBuffer service_model_type,
+    GgReader params_json,
+    size_t params_json_len,
+    GgIpcResultCallback *result_callback,
+    GgIpcErrorCallback *error_callback,
+    void *response_ctx
+) {
+    return ipc_subscribe_common(
+        operation,
+        service_model_type,
+        params_json,
+        params_json_len,
+        result_callback,
+        error_callback,
+        response_ctx,
+        (StreamHandler) { 0 },
+        NULL
+    );
+}
+
+GgError ggipc_subscribe(
+    GgBuffer operation,
+    GgBuffer service_model_type,
+    GgMap params,
+    GgIpcResultCallback *result_callback,
+    GgIpcErrorCallback *error_callback,
+    void *response_ctx,
     GgIpcSubscribeCallback *sub_callback,
     void *sub_callback_ctx,
     void *sub_callback_aux_ctx,
+    GgIpcSubscriptionHandle *sub_handle
+) {
+    return ipc_subscribe_json(
+        operation,
+        service_model_type,
+        params,
+        result_callback,
+        error_callback,
+        response_ctx,
+        (StreamHandler) {
+            .fn = sub_callback,
+            .ctx = sub_callback_ctx,
+            .aux_ctx = sub_callback_aux_ctx,
+        },
+        sub_handle
+    );
+}
+
+GgError ggipc_subscribe_raw(
+    GgBuffer operation,
+    GgBuffer service_model_type,
+    GgMap params,
+    GgIpcResultCallback *result_callback,
+    GgIpcErrorCallback *error_callback,
+    void *response_ctx,
+    GgIpcSubscribeRawCallback *sub_callback,
+    void *sub_callback_ctx,
+    void *sub_callback_aux_ctx,
+    GgIpcSubscriptionHandle *sub_handle
+) {
+    return ipc_subscribe_json(
+        operation,
+        service_model_type,
+        params,
+        result_callback,
+        error_callback,
+        response_ctx,
+        (StreamHandler) {
+            .raw_fn = sub_callback,
+            .ctx = sub_callback_ctx,
+            .aux_ctx = sub_callback_aux_ctx,
+        },
+        sub_handle
+    );
+}
+
+// Must hold stream_state_mtx
+static GgError call_sub_callback(
+    GgIpcSubscriptionHandle handle,
+    StreamHandler handler,
     EventStreamCommonHeaders common_headers,
     EventStreamMessage msg
 ) {
@@ -665,18 +1046,33 @@ static GgError call_sub_callback(
             " does not declare a JSON payload.",
             common_headers.stream_id
         );
+        ggipc_stat_add(GGIPC_STAT_DECODE_FAILURES, 1);
         return GG_ERR_INVALID;
     }
 
-    GgArena arena = gg_arena_init(GG_BUF(ipc_recv_decode_mem));
+    if (handler.raw_fn != NULL) {
+        uint64_t callback_start = callback_enter();
+        GgError ret = handler.raw_fn(
+            handler.ctx,
+            handler.aux_ctx,
+            handle,
+            service_model_type,
+            msg.payload
+        );
+        callback_exit(callback_start);
+        return ret;
+    }
+
+    GgArena arena = recv_decode_arena();
     GgObject response;
 
     GgError ret = gg_json_decode_destructive(msg.payload, &arena, &response);
     if (ret == GG_ERR_NOMEM) {
-        GG_LOGE(
+        GG_LOGE_RATELIMITED(
             "IPC response payload too large on stream %" PRId32 ". Skipping.",
             common_headers.stream_id
         );
+        ggipc_stat_add(GGIPC_STAT_DROPPED_FRAMES, 1);
         return GG_ERR_OK;
     }
     if (ret != GG_ERR_OK) {
@@ -684,21 +1080,39 @@ static GgError call_sub_callback(
             "Failed to decode IPC response payload on stream %" PRId32 ".",
             common_headers.stream_id
         );
+        ggipc_stat_add(GGIPC_STAT_DECODE_FAILURES, 1);
         return ret;
     }
 
     if (gg_obj_type(response) != GG_TYPE_MAP) {
         GG_LOGE("IPC response payload JSON is not an object.");
+        ggipc_stat_add(GGIPC_STAT_DECODE_FAILURES, 1);
         return GG_ERR_INVALID;
     }
+    TRACE_RECV_POINT(payload_decode);
 
-    return sub_callback(
-        sub_callback_ctx,
-        sub_callback_aux_ctx,
+    uint64_t callback_start = callback_enter();
+    ret = handler.fn(
+        handler.ctx,
+        handler.aux_ctx,
         handle,
         service_model_type,
         gg_obj_into_map(response)
     );
+    callback_exit(callback_start);
+    return ret;
+}
+
+GgArena ggipc_sub_decode_arena(void) {
+    assert(gettid() == recv_thread_id);
+    return recv_decode_arena();
+}
+
+void ggipc_intern_topic(GgBuffer *topic) {
+    assert(gettid() == recv_thread_id);
+    if (ipc_recv_intern != NULL) {
+        (void) gg_intern(ipc_recv_intern, topic);
+    }
 }
 
 static GgError dispatch_incoming_packet(int conn) {
@@ -708,13 +1122,24 @@ static GgError dispatch_incoming_packet(int conn) {
     );
     if (ret != GG_ERR_OK) {
         GG_LOGE("Failed to read eventstream packet.");
+        if ((ret == GG_ERR_PARSE) || (ret == GG_ERR_NOMEM)) {
+            ggipc_stat_add(GGIPC_STAT_DECODE_FAILURES, 1);
+        }
         return ret;
     }
 
+    // Prelude and message CRC surround the headers and payload
+    ggipc_stat_add(GGIPC_STAT_FRAMES_RECEIVED, 1);
+    ggipc_stat_add(
+        GGIPC_STAT_BYTES_RECEIVED,
+        12 + (size_t) (&msg.payload.data[msg.payload.len] - ipc_recv_mem) + 4
+    );
+
     EventStreamCommonHeaders common_headers;
     ret = eventstream_get_common_headers(&msg, &common_headers);
     if (ret != GG_ERR_OK) {
         GG_LOGE("Eventstream packet missing required headers.");
+        ggipc_stat_add(GGIPC_STAT_DECODE_FAILURES, 1);
         return ret;
     }
 
@@ -722,23 +1147,33 @@ static GgError dispatch_incoming_packet(int conn) {
 
     if (stream_id < 0) {
         GG_LOGE("Eventstream packet has negative stream id.");
+        ggipc_stat_add(GGIPC_STAT_DECODE_FAILURES, 1);
         return GG_ERR_FAILURE;
     }
+    GG_IPC_TRACE_POINT(frame_read, stream_id, (GgBuffer) { 0 });
 
-    GG_MTX_SCOPE_GUARD(&stream_state_mtx);
+    GG_CLEANUP(
+        cleanup_pthread_mtx_unlock, ggipc_stats_lock(&stream_state_mtx)
+    );
 
     uint16_t index;
     bool found = get_stream_index_from_id(stream_id, &index);
 
+    recv_trace_stream_id = stream_id;
+    recv_trace_operation
+        = found ? stream_state_operation[index] : (GgBuffer) { 0 };
+    GG_IPC_TRACE_POINT(stream_lookup, stream_id, recv_trace_operation);
+
     if (!found) {
-        GG_LOGE(
+        GG_LOGE_RATELIMITED(
             "Unhandled eventstream packet with stream id %" PRId32 " dropped.",
             stream_id
         );
+        ggipc_stat_add(GGIPC_STAT_DROPPED_FRAMES, 1);
         return GG_ERR_OK;
     }
 
-    if (stream_state_handler[index].fn == NULL) {
+    if (!is_sub_handler(stream_state_handler[index])) {
         // Must hold stream_state_mtx through handler call.
         response_handler(
             index, stream_state_handler[index].ctx, common_headers, msg
@@ -748,9 +1183,7 @@ static GgError dispatch_incoming_packet(int conn) {
 
     GgError sub_ret = call_sub_callback(
         get_current_handle(index),
-        stream_state_handler[index].fn,
-        stream_state_handler[index].ctx,
-        stream_state_handler[index].aux_ctx,
+        stream_state_handler[index],
         common_headers,
         msg
     );
@@ -765,11 +1198,17 @@ static GgError dispatch_incoming_packet(int conn) {
 }
 
 ACCESS(none, 1)
-static GgError data_ready_callback(void *ctx, uint64_t data) {
+static GgError data_ready_callback(void *ctx, uint64_t data, uint32_t events) {
     (void) ctx;
     (void) data;
 
-    GgError ret = dispatch_incoming_packet(ipc_conn_fd);
+    GgError ret = GG_ERR_OK;
+    if ((events & EPOLLOUT) != 0) {
+        ret = ipc_out_flush(ipc_conn_fd);
+    }
+    if ((ret == GG_ERR_OK) && ((events & ~(uint32_t) EPOLLOUT) != 0)) {
+        ret = dispatch_incoming_packet(ipc_conn_fd);
+    }
 
     if (ret != GG_ERR_OK) {
         GG_LOGE(
@@ -796,7 +1235,9 @@ noreturn static void *recv_thread(void *args) {
 }
 
 void ggipc_close_subscription(GgIpcSubscriptionHandle handle) {
-    GG_MTX_SCOPE_GUARD(&stream_state_mtx);
+    GG_CLEANUP(
+        cleanup_pthread_mtx_unlock, ggipc_stats_lock(&stream_state_mtx)
+    );
 
     uint16_t index;
     GgError ret = validate_handle(handle, &index, __func__);
@@ -817,7 +1258,15 @@ void ggipc_close_subscription(GgIpcSubscriptionHandle handle) {
     GG_LOGD(
         "Sending subscription termination for stream id %" PRIi32 ".", stream_id
     );
-    (void) ipc_send_packet(ipc_conn_fd, headers, headers_len, GG_NULL_READER);
+    (void) ipc_send_packet(
+        ipc_conn_fd,
+        stream_id,
+        stream_state_operation[index],
+        headers,
+        headers_len,
+        GG_NULL_READER,
+        0
+    );
 
     clear_stream_index(index);
 }
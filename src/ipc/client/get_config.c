@@ -9,7 +9,7 @@
 #include <gg/flags.h>
 #include <gg/ipc/client.h>
 #include <gg/ipc/client_raw.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <gg/vector.h>
@@ -78,9 +78,9 @@ static GgError ggipc_get_config_common(
 static GgError get_resp_value(
     GgMap resp, GgObject **value, GgBuffer *final_key
 ) {
-    GgError ret = gg_map_validate(
-        resp,
-        GG_MAP_SCHEMA({ GG_STR("value"), GG_REQUIRED, GG_TYPE_MAP, value })
+    GgError ret;
+    GG_MAP_VALIDATE(
+        ret, resp, { GG_STR("value"), GG_REQUIRED, GG_TYPE_MAP, value }
     );
     if (ret != GG_ERR_OK) {
         GG_LOGE("Failed validating server response.");
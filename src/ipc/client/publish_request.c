@@ -0,0 +1,82 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gg/base64_encode.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/io.h>
+#include <gg/ipc/client_priv.h>
+#include <gg/ipc/client_raw.h>
+#include <gg/json_encode.h>
+#include <gg/object.h>
+#include <gg/vector.h>
+#include <stddef.h>
+
+static GgError publish_request_read(void *ctx, GgBuffer *buf) {
+    const GgIpcPublishRequest *request = ctx;
+    GgByteVec vec = gg_byte_vec_init(*buf);
+    GgWriter writer = gg_byte_vec_writer(&vec);
+
+    GgError ret = gg_writer_call(writer, request->prefix);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    ret = gg_json_encode(gg_obj_buf(request->topic), writer);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    ret = gg_writer_call(writer, request->message_prefix);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    ret = request->write_message(request->message_ctx, writer);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    ret = gg_writer_call(writer, request->suffix);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    *buf = vec.buf;
+    return GG_ERR_OK;
+}
+
+GgError ggipc_call_publish(
+    GgBuffer operation,
+    GgBuffer service_model_type,
+    const GgIpcPublishRequest *request,
+    GgIpcErrorCallback *error_callback
+) {
+    size_t topic_len = 0;
+    GgError ret = gg_json_encoded_len(gg_obj_buf(request->topic), &topic_len);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    size_t params_len = request->prefix.len + topic_len
+        + request->message_prefix.len + request->message_len
+        + request->suffix.len;
+
+    return ggipc_call_with_payload(
+        operation,
+        service_model_type,
+        (GgReader) { .read = publish_request_read, .ctx = (void *) request },
+        params_len,
+        NULL,
+        error_callback,
+        NULL
+    );
+}
+
+GgError ggipc_publish_write_b64(const void *ctx, GgWriter writer) {
+    const GgBuffer *payload = ctx;
+    GgBase64Encoder encoder = gg_base64_encoder_init(writer);
+    GgError ret
+        = gg_writer_call(gg_base64_encoder_writer(&encoder), *payload);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    return gg_base64_encoder_finish(&encoder);
+}
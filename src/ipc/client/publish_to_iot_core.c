@@ -2,14 +2,16 @@
 // Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <gg/base64_encode.h>
 #include <gg/buffer.h>
 #include <gg/error.h>
 #include <gg/ipc/client.h>
+#include <gg/ipc/client_priv.h>
 #include <gg/ipc/client_raw.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
-#include <string.h>
+#include <inttypes.h>
 #include <stdint.h>
 
 static GgError error_handler(void *ctx, GgBuffer error_code, GgBuffer message) {
@@ -32,6 +34,10 @@ static GgError error_handler(void *ctx, GgBuffer error_code, GgBuffer message) {
 GgError ggipc_publish_to_iot_core_b64(
     GgBuffer topic_name, GgBuffer b64_payload, uint8_t qos
 ) {
+    if (qos > 2) {
+        GG_LOGE("Invalid QoS \"%" PRIu8 "\" provided. QoS must be <= 2", qos);
+        return GG_ERR_INVALID;
+    }
     GgBuffer qos_buffer = GG_BUF((uint8_t[1]) { qos + (uint8_t) '0' });
     GgMap args = GG_MAP(
         gg_kv(GG_STR("topicName"), gg_obj_buf(topic_name)),
@@ -48,3 +54,36 @@ GgError ggipc_publish_to_iot_core_b64(
         NULL
     );
 }
+
+/// Request params after the payload, indexed by qos.
+static const GgBuffer QOS_SUFFIXES[] = {
+    GG_STR("\",\"qos\":\"0\"}"),
+    GG_STR("\",\"qos\":\"1\"}"),
+    GG_STR("\",\"qos\":\"2\"}"),
+};
+
+GgError ggipc_publish_to_iot_core(
+    GgBuffer topic_name, GgBuffer payload, uint8_t qos
+) {
+    if (qos > 2) {
+        GG_LOGE("Invalid QoS \"%" PRIu8 "\" provided. QoS must be <= 2", qos);
+        return GG_ERR_INVALID;
+    }
+
+    // Payload is base64 encoded straight into the request frame
+    GgIpcPublishRequest request = {
+        .prefix = GG_STR("{\"topicName\":"),
+        .topic = topic_name,
+        .message_prefix = GG_STR(",\"payload\":\""),
+        .write_message = ggipc_publish_write_b64,
+        .message_ctx = &payload,
+        .message_len = gg_base64_encoded_len(payload.len),
+        .suffix = QOS_SUFFIXES[qos],
+    };
+    return ggipc_call_publish(
+        GG_STR("aws.greengrass#PublishToIoTCore"),
+        GG_STR("aws.greengrass#PublishToIoTCoreRequest"),
+        &request,
+        &error_handler
+    );
+}
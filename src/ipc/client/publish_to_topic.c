@@ -2,14 +2,19 @@
 // Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <gg/base64_encode.h>
 #include <gg/buffer.h>
+#include <gg/cbor_encode.h>
 #include <gg/error.h>
+#include <gg/io.h>
 #include <gg/ipc/client.h>
+#include <gg/ipc/client_priv.h>
 #include <gg/ipc/client_raw.h>
-#include <gg/log.h>
+#include <gg/json_decode.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
-#include <string.h>
+#include <stddef.h>
 
 static GgError error_handler(void *ctx, GgBuffer error_code, GgBuffer message) {
     (void) ctx;
@@ -62,3 +67,86 @@ GgError ggipc_publish_to_topic_binary_b64(
 
     return publish_to_topic_common(topic, publish_message);
 }
+
+#define PUBLISH_JSON_PREFIX "{\"topic\":"
+
+#define JSON_MESSAGE_PREFIX ",\"publishMessage\":{\"jsonMessage\":{\"message\":"
+#define BINARY_MESSAGE_PREFIX \
+    ",\"publishMessage\":{\"binaryMessage\":{\"message\":\""
+
+/// Publishes with the message written directly into the request frame.
+static GgError publish_message(GgIpcPublishRequest *request) {
+    request->prefix = GG_STR(PUBLISH_JSON_PREFIX);
+    return ggipc_call_publish(
+        GG_STR("aws.greengrass#PublishToTopic"),
+        GG_STR("aws.greengrass#PublishToTopicRequest"),
+        request,
+        &error_handler
+    );
+}
+
+static GgError write_raw_json(const void *ctx, GgWriter writer) {
+    const GgBuffer *json_payload = ctx;
+    return gg_writer_call(writer, *json_payload);
+}
+
+GgError ggipc_publish_to_topic_raw_json(GgBuffer topic, GgBuffer json_payload) {
+    GgBuffer json_obj;
+    GgError ret = gg_json_get_raw(json_payload, (GgBufList) { 0 }, &json_obj);
+    if ((ret != GG_ERR_OK) || (json_obj.data[0] != '{')) {
+        GG_LOGE("Raw JSON payload is not a valid JSON object.");
+        return GG_ERR_INVALID;
+    }
+
+    GgIpcPublishRequest request = {
+        .topic = topic,
+        .message_prefix = GG_STR(JSON_MESSAGE_PREFIX),
+        .write_message = write_raw_json,
+        .message_ctx = &json_payload,
+        .message_len = json_payload.len,
+        .suffix = GG_STR("}}}"),
+    };
+    return publish_message(&request);
+}
+
+GgError ggipc_publish_to_topic_binary(GgBuffer topic, GgBuffer payload) {
+    GgIpcPublishRequest request = {
+        .topic = topic,
+        .message_prefix = GG_STR(BINARY_MESSAGE_PREFIX),
+        .write_message = ggipc_publish_write_b64,
+        .message_ctx = &payload,
+        .message_len = gg_base64_encoded_len(payload.len),
+        .suffix = GG_STR("\"}}}"),
+    };
+    return publish_message(&request);
+}
+
+static GgError write_cbor_b64(const void *ctx, GgWriter writer) {
+    const GgObject *payload = ctx;
+    GgBase64Encoder encoder = gg_base64_encoder_init(writer);
+    GgError ret
+        = gg_cbor_encode(*payload, gg_base64_encoder_writer(&encoder));
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    return gg_base64_encoder_finish(&encoder);
+}
+
+GgError ggipc_publish_to_topic_cbor(GgBuffer topic, GgObject payload) {
+    size_t cbor_len = 0;
+    GgError ret = gg_cbor_encoded_len(payload, &cbor_len);
+    if (ret != GG_ERR_OK) {
+        GG_LOGE("Failed to encode PublishToTopic payload as CBOR.");
+        return ret;
+    }
+
+    GgIpcPublishRequest request = {
+        .topic = topic,
+        .message_prefix = GG_STR(BINARY_MESSAGE_PREFIX),
+        .write_message = write_cbor_b64,
+        .message_ctx = &payload,
+        .message_len = gg_base64_encoded_len(cbor_len),
+        .suffix = GG_STR("\"}}}"),
+    };
+    return publish_message(&request);
+}
@@ -7,7 +7,7 @@
 #include <gg/flags.h>
 #include <gg/ipc/client.h>
 #include <gg/ipc/client_raw.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <stddef.h>
@@ -30,14 +30,14 @@ static GgError response_handler(void *ctx, GgMap response) {
     (void) ctx;
 
     GgObject *restart_status_obj;
-    GgError ret = gg_map_validate(
+    GgError ret;
+    GG_MAP_VALIDATE(
+        ret,
         response,
-        GG_MAP_SCHEMA(
-            { GG_STR("restartStatus"),
-              GG_REQUIRED,
-              GG_TYPE_BUF,
-              &restart_status_obj }
-        )
+        { GG_STR("restartStatus"),
+          GG_REQUIRED,
+          GG_TYPE_BUF,
+          &restart_status_obj }
     );
     if (ret != GG_ERR_OK) {
         GG_LOGE("RestartComponent response missing restartStatus.");
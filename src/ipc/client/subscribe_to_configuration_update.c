@@ -2,24 +2,63 @@
 // Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <gg/arena.h>
 #include <gg/buffer.h>
 #include <gg/error.h>
 #include <gg/flags.h>
 #include <gg/ipc/client.h>
+#include <gg/ipc/client_priv.h>
 #include <gg/ipc/client_raw.h>
+#include <gg/json_decode.h>
 #include <gg/list.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <gg/vector.h>
 #include <stddef.h>
 
+typedef struct {
+    GgBuffer component_name;
+    GgList key_path;
+} ConfigurationUpdateEvent;
+
+static const GgJsonField CONFIGURATION_UPDATE_EVENT_FIELDS[] = {
+    { .key = GG_STR("componentName"),
+      .required = GG_REQUIRED,
+      .type = GG_JSON_FIELD_BUF,
+      .offset = offsetof(ConfigurationUpdateEvent, component_name) },
+    { .key = GG_STR("keyPath"),
+      .required = GG_REQUIRED,
+      .type = GG_JSON_FIELD_LIST,
+      .offset = offsetof(ConfigurationUpdateEvent, key_path) },
+};
+
+static const GgJsonSchema CONFIGURATION_UPDATE_EVENT_SCHEMA = GG_JSON_SCHEMA(
+    CONFIGURATION_UPDATE_EVENT_FIELDS, GG_JSON_NO_PRESENCE
+);
+
+typedef struct {
+    ConfigurationUpdateEvent event;
+} ConfigurationUpdateEvents;
+
+static const GgJsonField CONFIGURATION_UPDATE_EVENTS_FIELDS[] = {
+    { .key = GG_STR("configurationUpdateEvent"),
+      .required = GG_REQUIRED,
+      .type = GG_JSON_FIELD_STRUCT,
+      .offset = offsetof(ConfigurationUpdateEvents, event),
+      .schema = &CONFIGURATION_UPDATE_EVENT_SCHEMA },
+};
+
+static const GgJsonSchema CONFIGURATION_UPDATE_EVENTS_SCHEMA = GG_JSON_SCHEMA(
+    CONFIGURATION_UPDATE_EVENTS_FIELDS, GG_JSON_NO_PRESENCE
+);
+
 static GgError subscribe_to_configuration_update_resp_handler(
     void *ctx,
     void *aux_ctx,
     GgIpcSubscriptionHandle handle,
     GgBuffer service_model_type,
-    GgMap data
+    GgBuffer data
 ) {
     GgIpcSubscribeToConfigurationUpdateCallback *callback = ctx;
 
@@ -31,40 +70,22 @@ static GgError subscribe_to_configuration_update_resp_handler(
         return GG_ERR_INVALID;
     }
 
-    GgObject *config_update_event_obj;
-    GgError ret = gg_map_validate(
-        data,
-        GG_MAP_SCHEMA(
-            { GG_STR("configurationUpdateEvent"),
-              GG_REQUIRED,
-              GG_TYPE_MAP,
-              &config_update_event_obj },
-        )
+    GgArena arena = ggipc_sub_decode_arena();
+    ConfigurationUpdateEvents resp = { 0 };
+    GgError ret = gg_json_decode_struct_destructive(
+        data, &CONFIGURATION_UPDATE_EVENTS_SCHEMA, &arena, &resp
     );
-    if (ret != GG_ERR_OK) {
-        GG_LOGE("Received invalid configuration update response.");
-        return GG_ERR_INVALID;
+    if (ret == GG_ERR_NOMEM) {
+        GG_LOGE("Configuration update response too large. Skipping.");
+        return GG_ERR_OK;
     }
-
-    GgObject *component_name_obj;
-    GgObject *key_path_obj;
-    ret = gg_map_validate(
-        gg_obj_into_map(*config_update_event_obj),
-        GG_MAP_SCHEMA(
-            { GG_STR("componentName"),
-              GG_REQUIRED,
-              GG_TYPE_BUF,
-              &component_name_obj },
-            { GG_STR("keyPath"), GG_REQUIRED, GG_TYPE_LIST, &key_path_obj },
-        )
-    );
     if (ret != GG_ERR_OK) {
-        GG_LOGE("Received invalid configuration update event.");
+        GG_LOGE("Received invalid configuration update response.");
         return GG_ERR_INVALID;
     }
 
-    GgBuffer component_name = gg_obj_into_buf(*component_name_obj);
-    GgList key_path = gg_obj_into_list(*key_path_obj);
+    GgBuffer component_name = resp.event.component_name;
+    GgList key_path = resp.event.key_path;
 
     ret = gg_list_type_check(key_path, GG_TYPE_BUF);
     if (ret != GG_ERR_OK) {
@@ -125,7 +146,7 @@ GgError ggipc_subscribe_to_configuration_update(
         &args, gg_kv(GG_STR("keyPath"), gg_obj_list(path_vec.list))
     );
 
-    return ggipc_subscribe(
+    return ggipc_subscribe_raw(
         GG_STR("aws.greengrass#SubscribeToConfigurationUpdate"),
         GG_STR("aws.greengrass#SubscribeToConfigurationUpdateRequest"),
         args.map,
@@ -2,24 +2,60 @@
 // Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
 // SPDX-License-Identifier: Apache-2.0
 
-#include <gg/base64.h>
 #include <gg/buffer.h>
 #include <gg/error.h>
 #include <gg/flags.h>
 #include <gg/ipc/client.h>
+#include <gg/ipc/client_priv.h>
 #include <gg/ipc/client_raw.h>
-#include <gg/log.h>
+#include <gg/json_decode.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <inttypes.h>
+#include <stddef.h>
 #include <string.h>
 
+typedef struct {
+    GgBuffer topic_name;
+    GgBuffer payload;
+} MqttMessage;
+
+static const GgJsonField MQTT_MESSAGE_FIELDS[] = {
+    { .key = GG_STR("topicName"),
+      .required = GG_REQUIRED,
+      .type = GG_JSON_FIELD_BUF,
+      .offset = offsetof(MqttMessage, topic_name) },
+    { .key = GG_STR("payload"),
+      .required = GG_REQUIRED,
+      .type = GG_JSON_FIELD_BASE64,
+      .offset = offsetof(MqttMessage, payload) },
+};
+
+static const GgJsonSchema MQTT_MESSAGE_SCHEMA
+    = GG_JSON_SCHEMA(MQTT_MESSAGE_FIELDS, GG_JSON_NO_PRESENCE);
+
+typedef struct {
+    MqttMessage message;
+} IotCoreMessage;
+
+static const GgJsonField IOT_CORE_MESSAGE_FIELDS[] = {
+    { .key = GG_STR("message"),
+      .required = GG_REQUIRED,
+      .type = GG_JSON_FIELD_STRUCT,
+      .offset = offsetof(IotCoreMessage, message),
+      .schema = &MQTT_MESSAGE_SCHEMA },
+};
+
+static const GgJsonSchema IOT_CORE_MESSAGE_SCHEMA
+    = GG_JSON_SCHEMA(IOT_CORE_MESSAGE_FIELDS, GG_JSON_NO_PRESENCE);
+
 static GgError subscribe_to_iot_core_resp_handler(
     void *ctx,
     void *aux_ctx,
     GgIpcSubscriptionHandle handle,
     GgBuffer service_model_type,
-    GgMap data
+    GgBuffer data
 ) {
     GgIpcSubscribeToIotCoreCallback *callback = ctx;
 
@@ -30,41 +66,18 @@ static GgError subscribe_to_iot_core_resp_handler(
         return GG_ERR_INVALID;
     }
 
-    GgObject *message_obj;
-    GgError ret = gg_map_validate(
-        data,
-        GG_MAP_SCHEMA(
-            { GG_STR("message"), GG_REQUIRED, GG_TYPE_MAP, &message_obj }
-        )
-    );
-    if (ret != GG_ERR_OK) {
-        GG_LOGE("Received invalid IoT Core subscription response.");
-        return GG_ERR_INVALID;
-    }
-    GgMap message = gg_obj_into_map(*message_obj);
-
-    GgObject *topic_obj;
-    GgObject *payload_obj;
-    ret = gg_map_validate(
-        message,
-        GG_MAP_SCHEMA(
-            { GG_STR("topicName"), GG_REQUIRED, GG_TYPE_BUF, &topic_obj },
-            { GG_STR("payload"), GG_REQUIRED, GG_TYPE_BUF, &payload_obj },
-        )
+    // No generically decoded members, so no arena is needed.
+    IotCoreMessage resp = { 0 };
+    GgError ret = gg_json_decode_struct_destructive(
+        data, &IOT_CORE_MESSAGE_SCHEMA, NULL, &resp
     );
     if (ret != GG_ERR_OK) {
         GG_LOGE("Received invalid IoT Core subscription response.");
         return GG_ERR_INVALID;
     }
-    GgBuffer topic = gg_obj_into_buf(*topic_obj);
-    GgBuffer payload = gg_obj_into_buf(*payload_obj);
-
-    if (!gg_base64_decode_in_place(&payload)) {
-        GG_LOGE("Failed to decode IoT Core subscription response payload.");
-        return GG_ERR_INVALID;
-    }
 
-    callback(aux_ctx, topic, payload, handle);
+    ggipc_intern_topic(&resp.message.topic_name);
+    callback(aux_ctx, resp.message.topic_name, resp.message.payload, handle);
     return GG_ERR_OK;
 }
 
@@ -102,7 +115,7 @@ GgError ggipc_subscribe_to_iot_core(
         gg_kv(GG_STR("qos"), gg_obj_buf(qos_buffer))
     );
 
-    return ggipc_subscribe(
+    return ggipc_subscribe_raw(
         GG_STR("aws.greengrass#SubscribeToIoTCore"),
         GG_STR("aws.greengrass#SubscribeToIoTCoreRequest"),
         args,
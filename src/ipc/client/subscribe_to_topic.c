@@ -2,27 +2,114 @@
 // Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
 // SPDX-License-Identifier: Apache-2.0
 
-#include <gg/base64.h>
+#include <gg/arena.h>
 #include <gg/buffer.h>
+#include <gg/cbor_decode.h>
 #include <gg/error.h>
 #include <gg/flags.h>
 #include <gg/ipc/client.h>
+#include <gg/ipc/client_priv.h>
 #include <gg/ipc/client_raw.h>
-#include <gg/log.h>
+#include <gg/json_decode.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
-static GgError subscribe_to_topic_resp_handler(
-    void *ctx,
-    void *aux_ctx,
-    GgIpcSubscriptionHandle handle,
+typedef struct {
+    GgBuffer topic;
+} MessageContext;
+
+static const GgJsonField MESSAGE_CONTEXT_FIELDS[] = {
+    { .key = GG_STR("topic"),
+      .required = GG_REQUIRED,
+      .type = GG_JSON_FIELD_BUF,
+      .offset = offsetof(MessageContext, topic) },
+};
+
+static const GgJsonSchema MESSAGE_CONTEXT_SCHEMA
+    = GG_JSON_SCHEMA(MESSAGE_CONTEXT_FIELDS, GG_JSON_NO_PRESENCE);
+
+typedef struct {
+    GgMap message;
+    MessageContext context;
+} JsonMessage;
+
+static const GgJsonField JSON_MESSAGE_FIELDS[] = {
+    { .key = GG_STR("message"),
+      .required = GG_REQUIRED,
+      .type = GG_JSON_FIELD_MAP,
+      .offset = offsetof(JsonMessage, message) },
+    { .key = GG_STR("context"),
+      .required = GG_REQUIRED,
+      .type = GG_JSON_FIELD_STRUCT,
+      .offset = offsetof(JsonMessage, context),
+      .schema = &MESSAGE_CONTEXT_SCHEMA },
+};
+
+static const GgJsonSchema JSON_MESSAGE_SCHEMA
+    = GG_JSON_SCHEMA(JSON_MESSAGE_FIELDS, GG_JSON_NO_PRESENCE);
+
+typedef struct {
+    GgBuffer message;
+    MessageContext context;
+} BinaryMessage;
+
+static const GgJsonField BINARY_MESSAGE_FIELDS[] = {
+    { .key = GG_STR("message"),
+      .required = GG_REQUIRED,
+      .type = GG_JSON_FIELD_BASE64,
+      .offset = offsetof(BinaryMessage, message) },
+    { .key = GG_STR("context"),
+      .required = GG_REQUIRED,
+      .type = GG_JSON_FIELD_STRUCT,
+      .offset = offsetof(BinaryMessage, context),
+      .schema = &MESSAGE_CONTEXT_SCHEMA },
+};
+
+static const GgJsonSchema BINARY_MESSAGE_SCHEMA
+    = GG_JSON_SCHEMA(BINARY_MESSAGE_FIELDS, GG_JSON_NO_PRESENCE);
+
+typedef struct {
+    uint32_t present;
+    JsonMessage json_message;
+    BinaryMessage binary_message;
+} SubscriptionResponseMessage;
+
+#define JSON_MESSAGE_PRESENT (1U << 0)
+#define BINARY_MESSAGE_PRESENT (1U << 1)
+
+static const GgJsonField SUBSCRIPTION_RESPONSE_FIELDS[] = {
+    { .key = GG_STR("jsonMessage"),
+      .required = GG_OPTIONAL,
+      .type = GG_JSON_FIELD_STRUCT,
+      .offset = offsetof(SubscriptionResponseMessage, json_message),
+      .schema = &JSON_MESSAGE_SCHEMA },
+    { .key = GG_STR("binaryMessage"),
+      .required = GG_OPTIONAL,
+      .type = GG_JSON_FIELD_STRUCT,
+      .offset = offsetof(SubscriptionResponseMessage, binary_message),
+      .schema = &BINARY_MESSAGE_SCHEMA },
+};
+
+static const GgJsonSchema SUBSCRIPTION_RESPONSE_SCHEMA = GG_JSON_SCHEMA(
+    SUBSCRIPTION_RESPONSE_FIELDS,
+    offsetof(SubscriptionResponseMessage, present)
+);
+
+/// Extracts the topic and payload from a subscription response.
+/// Binary payloads are base64 decoded in place while parsing.
+static GgError parse_subscription_message(
     GgBuffer service_model_type,
-    GgMap data
+    GgBuffer data,
+    GgArena *arena,
+    GgBuffer *topic,
+    GgObject *payload,
+    bool *is_json
 ) {
-    GgIpcSubscribeToTopicCallback *callback = ctx;
-
     if (!gg_buffer_eq(
             service_model_type,
             GG_STR("aws.greengrass#SubscriptionResponseMessage")
@@ -31,73 +118,59 @@ static GgError subscribe_to_topic_resp_handler(
         return GG_ERR_INVALID;
     }
 
-    GgObject *json_message_obj;
-    GgObject *binary_message_obj;
-    GgError ret = gg_map_validate(
-        data,
-        GG_MAP_SCHEMA(
-            { GG_STR("jsonMessage"),
-              GG_OPTIONAL,
-              GG_TYPE_MAP,
-              &json_message_obj },
-            { GG_STR("binaryMessage"),
-              GG_OPTIONAL,
-              GG_TYPE_MAP,
-              &binary_message_obj },
-        )
+    SubscriptionResponseMessage resp = { 0 };
+    GgError ret = gg_json_decode_struct_destructive(
+        data, &SUBSCRIPTION_RESPONSE_SCHEMA, arena, &resp
     );
+    if (ret == GG_ERR_NOMEM) {
+        GG_LOGE("Pubsub subscription response too large. Skipping.");
+        return GG_ERR_NOMEM;
+    }
     if (ret != GG_ERR_OK) {
         GG_LOGE("Received invalid pubsub subscription response.");
         return GG_ERR_INVALID;
     }
 
-    if ((json_message_obj == NULL) == (binary_message_obj == NULL)) {
+    if ((resp.present != JSON_MESSAGE_PRESENT)
+        && (resp.present != BINARY_MESSAGE_PRESENT)) {
         GG_LOGE("Received invalid pubsub subscription response.");
         return GG_ERR_INVALID;
     }
 
-    bool is_json = json_message_obj != NULL;
+    *is_json = resp.present == JSON_MESSAGE_PRESENT;
 
-    GgObject *message_obj;
-    GgObject *context_obj;
-    ret = gg_map_validate(
-        gg_obj_into_map(is_json ? *json_message_obj : *binary_message_obj),
-        GG_MAP_SCHEMA(
-            { GG_STR("message"),
-              GG_REQUIRED,
-              is_json ? GG_TYPE_MAP : GG_TYPE_BUF,
-              &message_obj },
-            { GG_STR("context"), GG_REQUIRED, GG_TYPE_MAP, &context_obj },
-        )
-    );
-    if (ret != GG_ERR_OK) {
-        GG_LOGE("Received invalid pubsub subscription response.");
-        return GG_ERR_INVALID;
+    if (*is_json) {
+        *topic = resp.json_message.context.topic;
+        *payload = gg_obj_map(resp.json_message.message);
+    } else {
+        *topic = resp.binary_message.context.topic;
+        *payload = gg_obj_buf(resp.binary_message.message);
     }
+    ggipc_intern_topic(topic);
+    return GG_ERR_OK;
+}
+
+static GgError subscribe_to_topic_resp_handler(
+    void *ctx,
+    void *aux_ctx,
+    GgIpcSubscriptionHandle handle,
+    GgBuffer service_model_type,
+    GgBuffer data
+) {
+    GgIpcSubscribeToTopicCallback *callback = ctx;
 
-    GgObject *topic_obj;
-    ret = gg_map_validate(
-        gg_obj_into_map(*context_obj),
-        GG_MAP_SCHEMA(
-            { GG_STR("topic"), GG_REQUIRED, GG_TYPE_BUF, &topic_obj },
-        )
+    GgArena arena = ggipc_sub_decode_arena();
+    GgBuffer topic;
+    GgObject payload;
+    bool is_json;
+    GgError ret = parse_subscription_message(
+        service_model_type, data, &arena, &topic, &payload, &is_json
     );
-    if (ret != GG_ERR_OK) {
-        GG_LOGE("Received invalid pubsub subscription response.");
-        return GG_ERR_INVALID;
+    if (ret == GG_ERR_NOMEM) {
+        return GG_ERR_OK;
     }
-
-    GgBuffer topic = gg_obj_into_buf(*topic_obj);
-
-    GgObject payload = *message_obj;
-
-    if (!is_json) {
-        GgBuffer payload_buf = gg_obj_into_buf(*message_obj);
-        if (!gg_base64_decode_in_place(&payload_buf)) {
-            GG_LOGE("Failed to decode pubsub subscription response payload.");
-            return GG_ERR_INVALID;
-        }
-        payload = gg_obj_buf(payload_buf);
+    if (ret != GG_ERR_OK) {
+        return ret;
     }
 
     callback(aux_ctx, topic, payload, handle);
@@ -129,7 +202,7 @@ GgError ggipc_subscribe_to_topic(
 ) {
     GgMap args = GG_MAP(gg_kv(GG_STR("topic"), gg_obj_buf(topic)), );
 
-    return ggipc_subscribe(
+    return ggipc_subscribe_raw(
         GG_STR("aws.greengrass#SubscribeToTopic"),
         GG_STR("aws.greengrass#SubscribeToTopicRequest"),
         args,
@@ -142,3 +215,144 @@ GgError ggipc_subscribe_to_topic(
         handle
     );
 }
+
+static GgError subscribe_to_topic_raw_json_resp_handler(
+    void *ctx,
+    void *aux_ctx,
+    GgIpcSubscriptionHandle handle,
+    GgBuffer service_model_type,
+    GgBuffer payload
+) {
+    GgIpcSubscribeToTopicRawJsonCallback *callback = ctx;
+
+    if (!gg_buffer_eq(
+            service_model_type,
+            GG_STR("aws.greengrass#SubscriptionResponseMessage")
+        )) {
+        GG_LOGE("Unexpected service-model-type received.");
+        return GG_ERR_INVALID;
+    }
+
+    GgBuffer message;
+    GgError ret = gg_json_get_raw(
+        payload,
+        GG_BUF_LIST(GG_STR("jsonMessage"), GG_STR("message")),
+        &message
+    );
+    if (ret == GG_ERR_NOENTRY) {
+        GG_LOGW_RATELIMITED(
+            "Dropping non-JSON message on raw JSON subscription."
+        );
+        return GG_ERR_OK;
+    }
+    if ((ret != GG_ERR_OK) || (message.data[0] != '{')) {
+        GG_LOGE("Received invalid pubsub subscription response.");
+        return GG_ERR_INVALID;
+    }
+
+    GgBuffer topic_json;
+    ret = gg_json_get_raw(
+        payload,
+        GG_BUF_LIST(GG_STR("jsonMessage"), GG_STR("context"), GG_STR("topic")),
+        &topic_json
+    );
+    if (ret != GG_ERR_OK) {
+        GG_LOGE("Received invalid pubsub subscription response.");
+        return GG_ERR_INVALID;
+    }
+
+    // Topic is outside of message, so decoding it in place leaves message
+    // untouched.
+    GgObject topic_obj;
+    ret = gg_json_decode_destructive(topic_json, NULL, &topic_obj);
+    if ((ret != GG_ERR_OK) || (gg_obj_type(topic_obj) != GG_TYPE_BUF)) {
+        GG_LOGE("Received invalid pubsub subscription response.");
+        return GG_ERR_INVALID;
+    }
+
+    GgBuffer topic = gg_obj_into_buf(topic_obj);
+    ggipc_intern_topic(&topic);
+    callback(aux_ctx, topic, message, handle);
+    return GG_ERR_OK;
+}
+
+GgError ggipc_subscribe_to_topic_raw_json(
+    GgBuffer topic,
+    GgIpcSubscribeToTopicRawJsonCallback *callback,
+    void *ctx,
+    GgIpcSubscriptionHandle *handle
+) {
+    GgMap args = GG_MAP(gg_kv(GG_STR("topic"), gg_obj_buf(topic)), );
+
+    return ggipc_subscribe_raw(
+        GG_STR("aws.greengrass#SubscribeToTopic"),
+        GG_STR("aws.greengrass#SubscribeToTopicRequest"),
+        args,
+        NULL,
+        &error_handler,
+        NULL,
+        &subscribe_to_topic_raw_json_resp_handler,
+        callback,
+        ctx,
+        handle
+    );
+}
+
+static GgError subscribe_to_topic_cbor_resp_handler(
+    void *ctx,
+    void *aux_ctx,
+    GgIpcSubscriptionHandle handle,
+    GgBuffer service_model_type,
+    GgBuffer data
+) {
+    GgIpcSubscribeToTopicCallback *callback = ctx;
+
+    GgArena arena = ggipc_sub_decode_arena();
+    GgBuffer topic;
+    GgObject payload;
+    bool is_json;
+    GgError ret = parse_subscription_message(
+        service_model_type, data, &arena, &topic, &payload, &is_json
+    );
+    if (ret == GG_ERR_NOMEM) {
+        return GG_ERR_OK;
+    }
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    if (!is_json) {
+        ret = gg_cbor_decode(gg_obj_into_buf(payload), &arena, &payload);
+        if (ret != GG_ERR_OK) {
+            GG_LOGW_RATELIMITED(
+                "Dropping non-CBOR message on CBOR subscription."
+            );
+            return GG_ERR_OK;
+        }
+    }
+
+    callback(aux_ctx, topic, payload, handle);
+    return GG_ERR_OK;
+}
+
+GgError ggipc_subscribe_to_topic_cbor(
+    GgBuffer topic,
+    GgIpcSubscribeToTopicCallback *callback,
+    void *ctx,
+    GgIpcSubscriptionHandle *handle
+) {
+    GgMap args = GG_MAP(gg_kv(GG_STR("topic"), gg_obj_buf(topic)), );
+
+    return ggipc_subscribe_raw(
+        GG_STR("aws.greengrass#SubscribeToTopic"),
+        GG_STR("aws.greengrass#SubscribeToTopicRequest"),
+        args,
+        NULL,
+        &error_handler,
+        NULL,
+        &subscribe_to_topic_cbor_resp_handler,
+        callback,
+        ctx,
+        handle
+    );
+}
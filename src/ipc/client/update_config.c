@@ -2,11 +2,12 @@
 // Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <gg/arena.h>
 #include <gg/buffer.h>
 #include <gg/error.h>
 #include <gg/ipc/client.h>
 #include <gg/ipc/client_raw.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <gg/vector.h>
@@ -87,3 +88,32 @@ GgError ggipc_update_config(
         NULL
     );
 }
+
+GgError ggipc_update_config_diff(
+    GgBufList key_path,
+    const struct timespec *timestamp,
+    GgObject old_value,
+    GgObject new_value,
+    GgArena *alloc
+) {
+    if (gg_obj_type(new_value) != GG_TYPE_MAP) {
+        if (gg_obj_eq(old_value, new_value)) {
+            GG_LOGD("Configuration value unchanged, skipping update.");
+            return GG_ERR_OK;
+        }
+        return ggipc_update_config(key_path, timestamp, new_value);
+    }
+
+    GgObject diff;
+    GgError ret = gg_obj_diff(old_value, new_value, alloc, &diff);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    if (gg_obj_into_map(diff).len == 0) {
+        GG_LOGD("Configuration value unchanged, skipping update.");
+        return GG_ERR_OK;
+    }
+
+    return ggipc_update_config(key_path, timestamp, diff);
+}
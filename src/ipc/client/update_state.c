@@ -6,7 +6,7 @@
 #include <gg/error.h>
 #include <gg/ipc/client.h>
 #include <gg/ipc/client_raw.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <stddef.h>
@@ -0,0 +1,248 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gg/buffer.h>
+#include <gg/cleanup.h>
+#include <gg/error.h>
+#include <gg/ipc/client.h>
+#include <gg/ipc/client_stats.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// Maximum length of an operation name with its own statistics entry.
+#define OPERATION_NAME_LEN 64
+
+typedef struct {
+    atomic_uint_fast64_t count;
+    atomic_uint_fast64_t total_us;
+    atomic_uint_fast64_t max_us;
+    atomic_uint_fast64_t buckets[GG_IPC_STATS_LATENCY_BUCKETS];
+} LatencyStats;
+
+struct GgIpcOperationStatsEntry {
+    uint8_t name[OPERATION_NAME_LEN];
+    size_t name_len;
+    atomic_uint_fast64_t requests;
+    atomic_uint_fast64_t errors;
+    atomic_uint_fast64_t timeouts;
+    LatencyStats latency;
+};
+
+atomic_uint_fast64_t ggipc_stat_counters[GGIPC_STAT_COUNTER_COUNT];
+
+/// The last entry is shared by operations that do not fit in the table.
+/// Entries below `operation_count` are never removed, and their names are
+/// immutable once published.
+static GgIpcOperationStatsEntry operations[GG_IPC_STATS_MAX_OPERATIONS];
+static atomic_size_t operation_count = 0;
+static pthread_mutex_t operations_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+static atomic_uint_fast32_t streams_in_use = 0;
+static atomic_uint_fast32_t streams_in_use_peak = 0;
+
+static LatencyStats callbacks;
+
+static GgIpcOperationStatsEntry *find_operation(
+    GgBuffer operation, size_t count
+) {
+    for (size_t i = 0; i < count; i++) {
+        if (gg_buffer_eq(
+                operation,
+                (GgBuffer) { .data = operations[i].name,
+                             .len = operations[i].name_len }
+            )) {
+            return &operations[i];
+        }
+    }
+    return NULL;
+}
+
+GgIpcOperationStatsEntry *ggipc_stats_operation(GgBuffer operation) {
+    GgIpcOperationStatsEntry *other
+        = &operations[GG_IPC_STATS_MAX_OPERATIONS - 1];
+    if (operation.len > OPERATION_NAME_LEN) {
+        return other;
+    }
+
+    GgIpcOperationStatsEntry *entry = find_operation(
+        operation, atomic_load_explicit(&operation_count, memory_order_acquire)
+    );
+    if (entry != NULL) {
+        return entry;
+    }
+
+    GG_MTX_SCOPE_GUARD(&operations_mtx);
+
+    size_t count
+        = atomic_load_explicit(&operation_count, memory_order_relaxed);
+    entry = find_operation(operation, count);
+    if (entry != NULL) {
+        return entry;
+    }
+    if (count >= GG_IPC_STATS_MAX_OPERATIONS - 1) {
+        return other;
+    }
+
+    entry = &operations[count];
+    if (operation.len != 0) {
+        memcpy(entry->name, operation.data, operation.len);
+    }
+    entry->name_len = operation.len;
+    atomic_store_explicit(&operation_count, count + 1, memory_order_release);
+    return entry;
+}
+
+GgBuffer ggipc_stats_operation_name(GgIpcOperationStatsEntry *operation) {
+    return (GgBuffer) { .data = operation->name, .len = operation->name_len };
+}
+
+uint64_t ggipc_stats_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t) now.tv_sec * 1000000000) + (uint64_t) now.tv_nsec;
+}
+
+static void record_latency(LatencyStats *stats, uint64_t start_ns) {
+    uint64_t us = (ggipc_stats_now_ns() - start_ns) / 1000;
+    size_t bucket = ggipc_stats_latency_bucket(us);
+
+    atomic_fetch_add_explicit(&stats->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->total_us, us, memory_order_relaxed);
+    atomic_fetch_add_explicit(
+        &stats->buckets[bucket], 1, memory_order_relaxed
+    );
+
+    uint_fast64_t max
+        = atomic_load_explicit(&stats->max_us, memory_order_relaxed);
+    while ((us > max)
+           && !atomic_compare_exchange_weak_explicit(
+               &stats->max_us,
+               &max,
+               us,
+               memory_order_relaxed,
+               memory_order_relaxed
+           )) { }
+}
+
+void ggipc_stats_request_done(
+    GgIpcOperationStatsEntry *operation, GgError ret, uint64_t start_ns
+) {
+    atomic_fetch_add_explicit(&operation->requests, 1, memory_order_relaxed);
+    if (ret != GG_ERR_OK) {
+        atomic_fetch_add_explicit(&operation->errors, 1, memory_order_relaxed);
+    }
+    if (ret == GG_ERR_TIMEOUT) {
+        atomic_fetch_add_explicit(
+            &operation->timeouts, 1, memory_order_relaxed
+        );
+    }
+    record_latency(&operation->latency, start_ns);
+}
+
+void ggipc_stats_callback_done(uint64_t start_ns) {
+    record_latency(&callbacks, start_ns);
+}
+
+void ggipc_stats_set_streams_in_use(uint32_t count) {
+    atomic_store_explicit(&streams_in_use, count, memory_order_relaxed);
+    uint_fast32_t peak
+        = atomic_load_explicit(&streams_in_use_peak, memory_order_relaxed);
+    while ((count > peak)
+           && !atomic_compare_exchange_weak_explicit(
+               &streams_in_use_peak,
+               &peak,
+               count,
+               memory_order_relaxed,
+               memory_order_relaxed
+           )) { }
+}
+
+pthread_mutex_t *ggipc_stats_lock(pthread_mutex_t *mtx) {
+    ggipc_stat_add(GGIPC_STAT_LOCK_ACQUISITIONS, 1);
+    if (pthread_mutex_trylock(mtx) == 0) {
+        return mtx;
+    }
+
+    uint64_t start = ggipc_stats_now_ns();
+    pthread_mutex_lock(mtx);
+    ggipc_stat_add(GGIPC_STAT_LOCK_CONTENDED, 1);
+    ggipc_stat_add(GGIPC_STAT_LOCK_WAIT_NS, ggipc_stats_now_ns() - start);
+    return mtx;
+}
+
+static uint64_t load_counter(GgIpcStatCounter counter) {
+    return atomic_load_explicit(
+        &ggipc_stat_counters[counter], memory_order_relaxed
+    );
+}
+
+static GgIpcLatencyStats load_latency(LatencyStats *stats) {
+    GgIpcLatencyStats result = {
+        .count = atomic_load_explicit(&stats->count, memory_order_relaxed),
+        .total_us
+        = atomic_load_explicit(&stats->total_us, memory_order_relaxed),
+        .max_us = atomic_load_explicit(&stats->max_us, memory_order_relaxed),
+    };
+    for (size_t i = 0; i < GG_IPC_STATS_LATENCY_BUCKETS; i++) {
+        result.buckets[i]
+            = atomic_load_explicit(&stats->buckets[i], memory_order_relaxed);
+    }
+    return result;
+}
+
+static GgIpcOperationStats load_operation(GgIpcOperationStatsEntry *entry) {
+    return (GgIpcOperationStats) {
+        .operation = { .data = entry->name, .len = entry->name_len },
+        .requests
+        = atomic_load_explicit(&entry->requests, memory_order_relaxed),
+        .errors = atomic_load_explicit(&entry->errors, memory_order_relaxed),
+        .timeouts
+        = atomic_load_explicit(&entry->timeouts, memory_order_relaxed),
+        .latency = load_latency(&entry->latency),
+    };
+}
+
+void ggipc_get_stats(GgIpcStats *stats) {
+    uint_fast32_t streams
+        = atomic_load_explicit(&streams_in_use, memory_order_relaxed);
+    uint_fast32_t streams_peak
+        = atomic_load_explicit(&streams_in_use_peak, memory_order_relaxed);
+
+    *stats = (GgIpcStats) {
+        .requests_in_flight = load_counter(GGIPC_STAT_REQUESTS_IN_FLIGHT),
+        .streams_in_use = (uint32_t) streams,
+        .streams_in_use_peak = (uint32_t) streams_peak,
+        .streams_max = GG_IPC_MAX_STREAMS,
+        .stream_slot_failures = load_counter(GGIPC_STAT_STREAM_SLOT_FAILURES),
+        .frames_sent = load_counter(GGIPC_STAT_FRAMES_SENT),
+        .bytes_sent = load_counter(GGIPC_STAT_BYTES_SENT),
+        .frames_received = load_counter(GGIPC_STAT_FRAMES_RECEIVED),
+        .bytes_received = load_counter(GGIPC_STAT_BYTES_RECEIVED),
+        .decode_failures = load_counter(GGIPC_STAT_DECODE_FAILURES),
+        .dropped_frames = load_counter(GGIPC_STAT_DROPPED_FRAMES),
+        .timeouts = load_counter(GGIPC_STAT_TIMEOUTS),
+        .lock_acquisitions = load_counter(GGIPC_STAT_LOCK_ACQUISITIONS),
+        .lock_contended = load_counter(GGIPC_STAT_LOCK_CONTENDED),
+        .lock_wait_ns = load_counter(GGIPC_STAT_LOCK_WAIT_NS),
+        .callbacks = load_latency(&callbacks),
+    };
+
+    size_t count
+        = atomic_load_explicit(&operation_count, memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        stats->operations[i] = load_operation(&operations[i]);
+    }
+
+    GgIpcOperationStats other
+        = load_operation(&operations[GG_IPC_STATS_MAX_OPERATIONS - 1]);
+    if (other.requests != 0) {
+        stats->operations[count] = other;
+        count += 1;
+    }
+    stats->operation_count = count;
+}
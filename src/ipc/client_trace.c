@@ -0,0 +1,68 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gg/buffer.h>
+#include <gg/cleanup.h>
+#include <gg/error.h>
+#include <gg/ipc/client_trace.h>
+#include <gg/ipc/trace.h>
+#include <gg/log_priv.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef GG_IPC_TRACE
+
+typedef struct {
+    GgIpcTraceCallback *fn;
+    void *ctx;
+} TraceCallback;
+
+/// Entries below `ggipc_trace_callback_count` are immutable once published.
+static TraceCallback trace_callbacks[GG_IPC_TRACE_MAX_CALLBACKS];
+atomic_size_t ggipc_trace_callback_count = 0;
+static pthread_mutex_t trace_callbacks_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+GgError ggipc_trace_register(GgIpcTraceCallback *callback, void *ctx) {
+    GG_MTX_SCOPE_GUARD(&trace_callbacks_mtx);
+
+    size_t count = atomic_load_explicit(
+        &ggipc_trace_callback_count, memory_order_relaxed
+    );
+    if (count >= GG_IPC_TRACE_MAX_CALLBACKS) {
+        GG_LOGE("Too many IPC trace callbacks registered.");
+        return GG_ERR_NOMEM;
+    }
+
+    trace_callbacks[count] = (TraceCallback) { .fn = callback, .ctx = ctx };
+    atomic_store_explicit(
+        &ggipc_trace_callback_count, count + 1, memory_order_release
+    );
+    return GG_ERR_OK;
+}
+
+void ggipc_trace_call(
+    GgIpcTraceEvent event, int32_t stream_id, GgBuffer operation
+) {
+    size_t count = atomic_load_explicit(
+        &ggipc_trace_callback_count, memory_order_acquire
+    );
+    for (size_t i = 0; i < count; i++) {
+        trace_callbacks[i].fn(
+            trace_callbacks[i].ctx, event, stream_id, operation
+        );
+    }
+}
+
+#else
+
+GgError ggipc_trace_register(GgIpcTraceCallback *callback, void *ctx) {
+    (void) callback;
+    (void) ctx;
+    GG_LOGE("IPC tracing is disabled in this build.");
+    return GG_ERR_UNSUPPORTED;
+}
+
+#endif
@@ -5,14 +5,17 @@
 #include <assert.h>
 #include <errno.h>
 #include <gg/arena.h>
+#include <gg/base64_decode.h>
 #include <gg/buffer.h>
 #include <gg/error.h>
+#include <gg/intern.h>
 #include <gg/json_decode.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -447,18 +450,18 @@ static const Parser PARSER_JSON_FALSE
 static const Parser PARSER_JSON_NULL
     = COMB_RESULT_VAL(JSON_TYPE_NULL, &PARSER_STR("null"));
 
+static const Parser PARSER_JSON_VALUE_INNER = COMB_ONE_OF(
+    &PARSER_JSON_STR,
+    &PARSER_JSON_NUMBER,
+    &PARSER_JSON_OBJECT,
+    &PARSER_JSON_ARRAY,
+    &PARSER_JSON_TRUE,
+    &PARSER_JSON_FALSE,
+    &PARSER_JSON_NULL
+);
+
 static const Parser PARSER_JSON_VALUE = COMB_SEQUENCE(
-    &PARSER_JSON_WHITESPACE,
-    &COMB_ONE_OF(
-        &PARSER_JSON_STR,
-        &PARSER_JSON_NUMBER,
-        &PARSER_JSON_OBJECT,
-        &PARSER_JSON_ARRAY,
-        &PARSER_JSON_TRUE,
-        &PARSER_JSON_FALSE,
-        &PARSER_JSON_NULL
-    ),
-    &PARSER_JSON_WHITESPACE
+    &PARSER_JSON_WHITESPACE, &PARSER_JSON_VALUE_INNER, &PARSER_JSON_WHITESPACE
 );
 
 static bool hex_char_to_byte(uint8_t *c) {
@@ -641,6 +644,59 @@ static GgError decode_json_str(GgBuffer content, GgObject *obj) {
     return GG_ERR_OK;
 }
 
+/// Unescapes and base64 decodes a JSON string's content in a single pass.
+/// Decoded bytes are written in place over `content`.
+static GgError decode_json_base64(GgBuffer content, GgBuffer *out) {
+    GgBase64Decoder decoder = gg_base64_decoder_init();
+    uint8_t *write_ptr = content.data;
+    GgBuffer rest = content;
+
+    while (rest.len > 0) {
+        const uint8_t *escape = memchr(rest.data, '\\', rest.len);
+        size_t run_len
+            = (escape == NULL) ? rest.len : (size_t) (escape - rest.data);
+        if (!gg_base64_decoder_update(
+                &decoder, gg_buffer_substr(rest, 0, run_len), &write_ptr
+            )) {
+            GG_LOGE("Invalid base64 in JSON string.");
+            return GG_ERR_PARSE;
+        }
+        rest = gg_buffer_substr(rest, run_len, SIZE_MAX);
+        if (rest.len == 0) {
+            break;
+        }
+
+        // Unescaped text is never longer than its escape sequence, so it is
+        // moved to the end of the sequence and decoded in place from there.
+        uint8_t unescaped[4];
+        uint8_t *unescaped_end = unescaped;
+        if (!str_conv_handle_escape(&rest, &unescaped_end)) {
+            GG_LOGE("Error decoding JSON string.");
+            return GG_ERR_PARSE;
+        }
+        size_t unescaped_len = (size_t) (unescaped_end - unescaped);
+        uint8_t *chars = rest.data - unescaped_len;
+        memmove(chars, unescaped, unescaped_len);
+        if (!gg_base64_decoder_update(
+                &decoder,
+                (GgBuffer) { .data = chars, .len = unescaped_len },
+                &write_ptr
+            )) {
+            GG_LOGE("Invalid base64 in JSON string.");
+            return GG_ERR_PARSE;
+        }
+    }
+
+    if (!gg_base64_decoder_finish(&decoder, &write_ptr)) {
+        GG_LOGE("Invalid base64 in JSON string.");
+        return GG_ERR_PARSE;
+    }
+
+    *out = (GgBuffer) { .data = content.data,
+                        .len = (size_t) (write_ptr - content.data) };
+    return GG_ERR_OK;
+}
+
 static GgError decode_json_number(GgBuffer content, GgObject *obj) {
     GgBuffer buf = content;
 
@@ -745,7 +801,11 @@ static GgError decode_json_object(
             return GG_ERR_PARSE;
         }
         if (pairs != NULL) {
-            gg_kv_set_key(&pairs[i], gg_obj_into_buf(key_obj));
+            GgBuffer key = gg_obj_into_buf(key_obj);
+            if (arena->intern != NULL) {
+                (void) gg_intern(arena->intern, &key);
+            }
+            gg_kv_set_key(&pairs[i], key);
         }
 
         bool matches = parser_call(&PARSER_CHAR(':'), &buf_copy, NULL);
@@ -776,17 +836,9 @@ static GgError decode_json_object(
 }
 
 // NOLINTNEXTLINE(misc-no-recursion)
-static GgError take_json_val(GgBuffer *buf, GgArena *arena, GgObject *obj) {
-    assert(buf != NULL);
-    assert(arena != NULL);
-
-    ParseResult output = PARSE_RESULT_INIT;
-    bool matches = parser_call(&PARSER_JSON_VALUE, buf, &output);
-    if (!matches) {
-        GG_LOGE("Failed to parse buffer.");
-        return GG_ERR_PARSE;
-    }
-
+static GgError decode_json_val(
+    ParseResult output, GgArena *arena, GgObject *obj
+) {
     switch (output.json_type) {
     case JSON_TYPE_STR:
         return decode_json_str(output.content, obj);
@@ -817,6 +869,21 @@ static GgError take_json_val(GgBuffer *buf, GgArena *arena, GgObject *obj) {
     return GG_ERR_FAILURE;
 }
 
+// NOLINTNEXTLINE(misc-no-recursion)
+static GgError take_json_val(GgBuffer *buf, GgArena *arena, GgObject *obj) {
+    assert(buf != NULL);
+    assert(arena != NULL);
+
+    ParseResult output = PARSE_RESULT_INIT;
+    bool matches = parser_call(&PARSER_JSON_VALUE, buf, &output);
+    if (!matches) {
+        GG_LOGE("Failed to parse buffer.");
+        return GG_ERR_PARSE;
+    }
+
+    return decode_json_val(output, arena, obj);
+}
+
 GgError gg_json_decode_destructive(
     GgBuffer buf, GgArena *arena, GgObject *obj
 ) {
@@ -847,3 +914,471 @@ GgError gg_json_decode_destructive(
 
     return GG_ERR_OK;
 }
+
+static bool json_is_whitespace(uint8_t c) {
+    return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r');
+}
+
+static bool json_is_number_char(uint8_t c) {
+    return ((c >= '0') && (c <= '9')) || (c == '-') || (c == '+') || (c == '.')
+        || (c == 'e') || (c == 'E');
+}
+
+/// Splits the next element of an already validated array of numbers.
+/// Sets `token` to its text and advances `buf` past its trailing comma.
+static GgError take_json_number_token(GgBuffer *buf, GgBuffer *token) {
+    size_t start = 0;
+    while ((start < buf->len) && json_is_whitespace(buf->data[start])) {
+        start++;
+    }
+    size_t end = start;
+    while ((end < buf->len) && json_is_number_char(buf->data[end])) {
+        end++;
+    }
+    if (end == start) {
+        GG_LOGE("Non-numeric element in JSON numeric array.");
+        return GG_ERR_PARSE;
+    }
+    *token = gg_buffer_substr(*buf, start, end);
+
+    while ((end < buf->len) && json_is_whitespace(buf->data[end])) {
+        end++;
+    }
+    if ((end < buf->len) && (buf->data[end] == ',')) {
+        end++;
+    }
+    *buf = gg_buffer_substr(*buf, end, buf->len);
+    return GG_ERR_OK;
+}
+
+/// Decodes a JSON array of numbers into contiguous doubles, without building
+/// a GgObject per element. Integers are converted to double.
+static GgError decode_json_f64_array(
+    ParseResult output, GgArena *arena, GgF64Array *out
+) {
+    if (output.json_type != JSON_TYPE_ARRAY) {
+        GG_LOGE("Expected JSON array when decoding numeric array.");
+        return GG_ERR_PARSE;
+    }
+
+    double *items = NULL;
+    if (output.count > 0) {
+        items = GG_ARENA_ALLOCN(arena, double, output.count);
+        if (items == NULL) {
+            GG_LOGE("Insufficent memory to decode JSON.");
+            return GG_ERR_NOMEM;
+        }
+    }
+
+    GgBuffer buf = output.content;
+    for (size_t i = 0; i < output.count; i++) {
+        GgBuffer token;
+        GgError ret = take_json_number_token(&buf, &token);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        // Token is followed by a non-numeric byte, so strtod stops at its end
+        errno = 0;
+        items[i] = strtod((char *) token.data, NULL);
+        if (errno == ERANGE) {
+            GG_LOGE("JSON float out of range of double.");
+            return GG_ERR_RANGE;
+        }
+    }
+
+    *out = (GgF64Array) { .items = items, .len = output.count };
+    return GG_ERR_OK;
+}
+
+/// Decodes a JSON array of integers into contiguous int64_t values, without
+/// building a GgObject per element.
+static GgError decode_json_i64_array(
+    ParseResult output, GgArena *arena, GgI64Array *out
+) {
+    if (output.json_type != JSON_TYPE_ARRAY) {
+        GG_LOGE("Expected JSON array when decoding numeric array.");
+        return GG_ERR_PARSE;
+    }
+
+    int64_t *items = NULL;
+    if (output.count > 0) {
+        items = GG_ARENA_ALLOCN(arena, int64_t, output.count);
+        if (items == NULL) {
+            GG_LOGE("Insufficent memory to decode JSON.");
+            return GG_ERR_NOMEM;
+        }
+    }
+
+    GgBuffer buf = output.content;
+    for (size_t i = 0; i < output.count; i++) {
+        GgBuffer token;
+        GgError ret = take_json_number_token(&buf, &token);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        ret = gg_str_to_int64(token, &items[i]);
+        if (ret == GG_ERR_RANGE) {
+            GG_LOGE("JSON integer out of range of int64_t.");
+            return ret;
+        }
+        if (ret != GG_ERR_OK) {
+            GG_LOGE("Non-integer element in JSON integer array.");
+            return GG_ERR_PARSE;
+        }
+    }
+
+    *out = (GgI64Array) { .items = items, .len = output.count };
+    return GG_ERR_OK;
+}
+
+static GgError decode_json_struct(
+    ParseResult output, const GgJsonSchema *schema, GgArena *arena, void *out
+);
+
+// NOLINTNEXTLINE(misc-no-recursion)
+static GgError decode_json_field(
+    const GgJsonField *field, ParseResult output, GgArena *arena, void *out
+) {
+    void *member = &((uint8_t *) out)[field->offset];
+
+    if (field->type == GG_JSON_FIELD_STRUCT) {
+        return decode_json_struct(output, field->schema, arena, member);
+    }
+
+    if (field->type == GG_JSON_FIELD_BASE64) {
+        if (output.json_type != JSON_TYPE_STR) {
+            GG_LOGE(
+                "Unexpected type for JSON key %.*s.",
+                (int) field->key.len,
+                field->key.data
+            );
+            return GG_ERR_PARSE;
+        }
+        return decode_json_base64(output.content, (GgBuffer *) member);
+    }
+
+    if (field->type == GG_JSON_FIELD_F64_ARRAY) {
+        return decode_json_f64_array(output, arena, (GgF64Array *) member);
+    }
+
+    if (field->type == GG_JSON_FIELD_I64_ARRAY) {
+        return decode_json_i64_array(output, arena, (GgI64Array *) member);
+    }
+
+    GgObject val;
+    GgError ret = decode_json_val(output, arena, &val);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    GgObjectType type = gg_obj_type(val);
+
+    switch (field->type) {
+    case GG_JSON_FIELD_BUF:
+        if (type != GG_TYPE_BUF) {
+            break;
+        }
+        *(GgBuffer *) member = gg_obj_into_buf(val);
+        return GG_ERR_OK;
+    case GG_JSON_FIELD_I64:
+        if (type != GG_TYPE_I64) {
+            break;
+        }
+        *(int64_t *) member = gg_obj_into_i64(val);
+        return GG_ERR_OK;
+    case GG_JSON_FIELD_F64:
+        if (type == GG_TYPE_I64) {
+            *(double *) member = (double) gg_obj_into_i64(val);
+            return GG_ERR_OK;
+        }
+        if (type != GG_TYPE_F64) {
+            break;
+        }
+        *(double *) member = gg_obj_into_f64(val);
+        return GG_ERR_OK;
+    case GG_JSON_FIELD_BOOL:
+        if (type != GG_TYPE_BOOLEAN) {
+            break;
+        }
+        *(bool *) member = gg_obj_into_bool(val);
+        return GG_ERR_OK;
+    case GG_JSON_FIELD_LIST:
+        if (type != GG_TYPE_LIST) {
+            break;
+        }
+        *(GgList *) member = gg_obj_into_list(val);
+        return GG_ERR_OK;
+    case GG_JSON_FIELD_MAP:
+        if (type != GG_TYPE_MAP) {
+            break;
+        }
+        *(GgMap *) member = gg_obj_into_map(val);
+        return GG_ERR_OK;
+    case GG_JSON_FIELD_OBJ:
+        *(GgObject *) member = val;
+        return GG_ERR_OK;
+    case GG_JSON_FIELD_STRUCT:
+    case GG_JSON_FIELD_BASE64:
+    case GG_JSON_FIELD_F64_ARRAY:
+    case GG_JSON_FIELD_I64_ARRAY:
+        assert(false);
+        break;
+    }
+
+    GG_LOGE(
+        "Unexpected type for JSON key %.*s.",
+        (int) field->key.len,
+        field->key.data
+    );
+    return GG_ERR_PARSE;
+}
+
+/// Finds the index of the schema field for `key`.
+static bool find_json_field(
+    const GgJsonSchema *schema, GgBuffer key, size_t *index
+) {
+    for (size_t i = 0; i < schema->field_count; i++) {
+        if (gg_buffer_eq(schema->fields[i].key, key)) {
+            *index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+static GgError decode_json_struct(
+    ParseResult output, const GgJsonSchema *schema, GgArena *arena, void *out
+) {
+    assert(schema->field_count <= GG_JSON_SCHEMA_MAX_FIELDS);
+
+    if (output.json_type != JSON_TYPE_OBJECT) {
+        GG_LOGE("Expected JSON object when decoding struct.");
+        return GG_ERR_PARSE;
+    }
+
+    uint32_t present = 0;
+    GgBuffer buf_copy = output.content;
+
+    for (size_t i = 0; i < output.count; i++) {
+        ParseResult key_output = PARSE_RESULT_INIT;
+        bool matches = parser_call(&PARSER_JSON_VALUE, &buf_copy, &key_output);
+        if (!matches || (key_output.json_type != JSON_TYPE_STR)) {
+            GG_LOGE("Non-string key type when decoding object.");
+            return GG_ERR_PARSE;
+        }
+        GgObject key;
+        GgError ret = decode_json_str(key_output.content, &key);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+
+        matches = parser_call(&PARSER_CHAR(':'), &buf_copy, NULL);
+        if (!matches) {
+            GG_LOGE("Failed to match colon while decoding object.");
+            return GG_ERR_PARSE;
+        }
+
+        ParseResult val_output = PARSE_RESULT_INIT;
+        matches = parser_call(&PARSER_JSON_VALUE, &buf_copy, &val_output);
+        if (!matches) {
+            GG_LOGE("Failed to parse buffer.");
+            return GG_ERR_PARSE;
+        }
+
+        size_t index;
+        bool known = find_json_field(schema, gg_obj_into_buf(key), &index);
+        const GgJsonField *field = known ? &schema->fields[index] : NULL;
+
+        // Null values are treated as absent, unless any type is accepted.
+        if ((field != NULL) && (val_output.json_type == JSON_TYPE_NULL)
+            && (field->type != GG_JSON_FIELD_OBJ)) {
+            field = NULL;
+        }
+
+        if (field != NULL) {
+            if (field->required.val == GG_PRESENCE_MISSING) {
+                GG_LOGE(
+                    "Unexpected JSON key %.*s present.",
+                    (int) field->key.len,
+                    field->key.data
+                );
+                return GG_ERR_PARSE;
+            }
+            ret = decode_json_field(field, val_output, arena, out);
+            if (ret != GG_ERR_OK) {
+                return ret;
+            }
+            present |= (uint32_t) 1 << index;
+        }
+
+        if (i != output.count - 1) {
+            matches = parser_call(&PARSER_CHAR(','), &buf_copy, NULL);
+            if (!matches) {
+                GG_LOGE("Failed to match comma while decoding object.");
+                return GG_ERR_PARSE;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < schema->field_count; i++) {
+        const GgJsonField *field = &schema->fields[i];
+        if ((field->required.val == GG_PRESENCE_REQUIRED)
+            && ((present & ((uint32_t) 1 << i)) == 0)) {
+            GG_LOGE(
+                "Missing required JSON key %.*s.",
+                (int) field->key.len,
+                field->key.data
+            );
+            return GG_ERR_NOENTRY;
+        }
+    }
+
+    if (schema->present_offset != GG_JSON_NO_PRESENCE) {
+        *(uint32_t *) &((uint8_t *) out)[schema->present_offset] = present;
+    }
+
+    return GG_ERR_OK;
+}
+
+GgError gg_json_decode_struct_destructive(
+    GgBuffer buf, const GgJsonSchema *schema, GgArena *arena, void *out
+) {
+    assert(schema != NULL);
+    assert(out != NULL);
+
+    // Handle NULL arena arg
+    GgArena empty_arena = { 0 };
+    GgArena *result_arena = (arena == NULL) ? &empty_arena : arena;
+
+    // Copy to avoid committing allocation on error path
+    GgArena arena_copy = *result_arena;
+
+    GgBuffer buf_copy = buf;
+    ParseResult output = PARSE_RESULT_INIT;
+    bool matches = parser_call(&PARSER_JSON_VALUE, &buf_copy, &output);
+    if (!matches) {
+        GG_LOGE("Failed to parse buffer.");
+        return GG_ERR_PARSE;
+    }
+
+    if (buf_copy.len > 0) {
+        GG_LOGE("Trailing buffer content when decoding.");
+        return GG_ERR_PARSE;
+    }
+
+    GgError ret = decode_json_struct(output, schema, &arena_copy, out);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    // Commit allocations
+    *result_arena = arena_copy;
+    return GG_ERR_OK;
+}
+
+/// Parses a JSON value, setting `raw` to its text without surrounding
+/// whitespace.
+static GgError take_json_raw_val(
+    GgBuffer *buf, GgBuffer *raw, ParseResult *output
+) {
+    (void) parser_call(&PARSER_JSON_WHITESPACE, buf, NULL);
+    GgBuffer start = *buf;
+    bool matches = parser_call(&PARSER_JSON_VALUE_INNER, buf, output);
+    if (!matches) {
+        GG_LOGE("Failed to parse buffer.");
+        return GG_ERR_PARSE;
+    }
+    *raw = (GgBuffer) { .data = start.data,
+                        .len = (size_t) (buf->data - start.data) };
+    (void) parser_call(&PARSER_JSON_WHITESPACE, buf, NULL);
+    return GG_ERR_OK;
+}
+
+/// Parses a JSON value, descending into objects along `path` in the same
+/// pass. Sets `raw` to the text of the value at `path` if found.
+static GgError take_json_path_val(
+    GgBuffer *buf, GgBufList path, GgBuffer *raw, bool *found
+) {
+    if (path.len == 0) {
+        ParseResult output = PARSE_RESULT_INIT;
+        GgError ret = take_json_raw_val(buf, raw, &output);
+        if (ret == GG_ERR_OK) {
+            *found = true;
+        }
+        return ret;
+    }
+
+    (void) parser_call(&PARSER_JSON_WHITESPACE, buf, NULL);
+    if (!parser_call(&PARSER_CHAR('{'), buf, NULL)) {
+        GG_LOGE("Non-object value in JSON key path.");
+        return GG_ERR_PARSE;
+    }
+    (void) parser_call(&PARSER_JSON_WHITESPACE, buf, NULL);
+
+    GgBufList rest = { .bufs = &path.bufs[1], .len = path.len - 1 };
+    bool first = true;
+    while (!parser_call(&PARSER_CHAR('}'), buf, NULL)) {
+        if (!first && !parser_call(&PARSER_CHAR(','), buf, NULL)) {
+            GG_LOGE("Failed to match comma while decoding object.");
+            return GG_ERR_PARSE;
+        }
+        first = false;
+
+        ParseResult key_output = PARSE_RESULT_INIT;
+        GgBuffer raw_key;
+        GgError ret = take_json_raw_val(buf, &raw_key, &key_output);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        if (key_output.json_type != JSON_TYPE_STR) {
+            GG_LOGE("Non-string key type when decoding object.");
+            return GG_ERR_PARSE;
+        }
+
+        if (!parser_call(&PARSER_CHAR(':'), buf, NULL)) {
+            GG_LOGE("Failed to match colon while decoding object.");
+            return GG_ERR_PARSE;
+        }
+
+        // First matching key wins; later values are only validated
+        if (!*found && gg_buffer_eq(key_output.content, path.bufs[0])) {
+            ret = take_json_path_val(buf, rest, raw, found);
+        } else {
+            ParseResult val_output = PARSE_RESULT_INIT;
+            GgBuffer raw_val;
+            ret = take_json_raw_val(buf, &raw_val, &val_output);
+        }
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+    }
+
+    (void) parser_call(&PARSER_JSON_WHITESPACE, buf, NULL);
+    return GG_ERR_OK;
+}
+
+GgError gg_json_get_raw(GgBuffer buf, GgBufList path, GgBuffer *value) {
+    GgBuffer buf_copy = buf;
+    GgBuffer raw = { 0 };
+    bool found = false;
+
+    GgError ret = take_json_path_val(&buf_copy, path, &raw, &found);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    if (buf_copy.len > 0) {
+        GG_LOGE("Trailing buffer content when decoding.");
+        return GG_ERR_PARSE;
+    }
+
+    if (!found) {
+        return GG_ERR_NOENTRY;
+    }
+
+    if (value != NULL) {
+        *value = raw;
+    }
+    return GG_ERR_OK;
+}
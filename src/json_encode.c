@@ -8,13 +8,17 @@
 #include <gg/error.h>
 #include <gg/io.h>
 #include <gg/json_encode.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/object.h>
 #include <gg/object_visit.h>
 #include <gg/vector.h>
-#include <inttypes.h>
+#include <math.h>
 #include <stdbool.h>
-#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+static const char HEX_DIGITS[] = "0123456789ABCDEF";
 
 static GgError json_encode_on_null(void *ctx) {
     GgWriter *writer = ctx;
@@ -26,82 +30,426 @@ static GgError json_encode_on_bool(void *ctx, bool val) {
     return gg_writer_call(*writer, val ? GG_STR("true") : GG_STR("false"));
 }
 
+/// Writes the decimal digits of `val` ending at `end`.
+/// Returns pointer to first digit.
+static char *write_u64_digits(char *end, uint64_t val) {
+    char *pos = end;
+    do {
+        pos--;
+        *pos = (char) ('0' + (val % 10));
+        val /= 10;
+    } while (val != 0);
+    return pos;
+}
+
+/// Formats an integer as JSON into `encoded`.
+/// Returns the slice of `encoded` holding the result.
+static GgBuffer json_format_i64(int64_t val, char encoded[static 20]) {
+    // "-9223372036854775808"
+    char *end = &encoded[20];
+
+    // Negate in unsigned to handle INT64_MIN
+    uint64_t magnitude = (val < 0) ? -(uint64_t) val : (uint64_t) val;
+    char *start = write_u64_digits(end, magnitude);
+    if (val < 0) {
+        start--;
+        *start = '-';
+    }
+
+    return (GgBuffer) { .data = (uint8_t *) start,
+                        .len = (size_t) (end - start) };
+}
+
 static GgError json_encode_on_i64(void *ctx, int64_t val) {
     GgWriter *writer = ctx;
-    // (size_t) (  ( CHAR_BITS * sizeof(int64_t) - 1 )  * log10( 2.0 ) ) + 1U
-    char encoded[19];
-    int ret_len = snprintf(encoded, sizeof(encoded), "%" PRId64, val);
-    if (ret_len < 0) {
-        GG_LOGE("Error encoding json.");
-        return GG_ERR_FAILURE;
-    }
-    if ((size_t) ret_len > sizeof(encoded)) {
-        assert((size_t) ret_len <= sizeof(encoded));
-        return GG_ERR_NOMEM;
-    }
-    return gg_writer_call(
-        *writer,
-        (GgBuffer) { .data = (uint8_t *) encoded, .len = (size_t) ret_len }
-    );
+    char encoded[20];
+    return gg_writer_call(*writer, json_format_i64(val, encoded));
 }
 
-static GgError json_encode_on_f64(void *ctx, double val) {
-    GgWriter *writer = ctx;
-    char encoded[DBL_DECIMAL_DIG + 9]; // -x.<precision>E-xxx\0
-    int ret_len
-        = snprintf(encoded, sizeof(encoded), "%#.*g", DBL_DECIMAL_DIG, val);
-    if (ret_len < 0) {
-        GG_LOGE("Error encoding json.");
-        return GG_ERR_FAILURE;
-    }
-    if ((size_t) ret_len > sizeof(encoded)) {
-        assert((size_t) ret_len <= sizeof(encoded));
-        return GG_ERR_NOMEM;
-    }
-    return gg_writer_call(
-        *writer,
-        (GgBuffer) { .data = (uint8_t *) encoded, .len = (size_t) ret_len }
-    );
+// Shortest round-trip double formatting, using the Grisu2 algorithm from
+// Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with
+// Integers" (PLDI 2010). Output always parses back to the same double, and is
+// the shortest such representation for nearly all inputs.
+
+/// Floating point value `f * 2^e`.
+typedef struct {
+    uint64_t f;
+    int e;
+} DiyFp;
+
+typedef struct {
+    uint64_t f;
+    int e;
+    int k;
+} CachedPower;
+
+// Normalized approximations of 10^k, for k from -300 to 324 in steps of 8.
+static const CachedPower CACHED_POWERS[] = {
+    { 0xAB70FE17C79AC6CA, -1060, -300 }, { 0xFF77B1FCBEBCDC4F, -1034, -292 },
+    { 0xBE5691EF416BD60C, -1007, -284 }, { 0x8DD01FAD907FFC3C, -980, -276 },
+    { 0xD3515C2831559A83, -954, -268 },  { 0x9D71AC8FADA6C9B5, -927, -260 },
+    { 0xEA9C227723EE8BCB, -901, -252 },  { 0xAECC49914078536D, -874, -244 },
+    { 0x823C12795DB6CE57, -847, -236 },  { 0xC21094364DFB5637, -821, -228 },
+    { 0x9096EA6F3848984F, -794, -220 },  { 0xD77485CB25823AC7, -768, -212 },
+    { 0xA086CFCD97BF97F4, -741, -204 },  { 0xEF340A98172AACE5, -715, -196 },
+    { 0xB23867FB2A35B28E, -688, -188 },  { 0x84C8D4DFD2C63F3B, -661, -180 },
+    { 0xC5DD44271AD3CDBA, -635, -172 },  { 0x936B9FCEBB25C996, -608, -164 },
+    { 0xDBAC6C247D62A584, -582, -156 },  { 0xA3AB66580D5FDAF6, -555, -148 },
+    { 0xF3E2F893DEC3F126, -529, -140 },  { 0xB5B5ADA8AAFF80B8, -502, -132 },
+    { 0x87625F056C7C4A8B, -475, -124 },  { 0xC9BCFF6034C13053, -449, -116 },
+    { 0x964E858C91BA2655, -422, -108 },  { 0xDFF9772470297EBD, -396, -100 },
+    { 0xA6DFBD9FB8E5B88F, -369, -92 },   { 0xF8A95FCF88747D94, -343, -84 },
+    { 0xB94470938FA89BCF, -316, -76 },   { 0x8A08F0F8BF0F156B, -289, -68 },
+    { 0xCDB02555653131B6, -263, -60 },   { 0x993FE2C6D07B7FAC, -236, -52 },
+    { 0xE45C10C42A2B3B06, -210, -44 },   { 0xAA242499697392D3, -183, -36 },
+    { 0xFD87B5F28300CA0E, -157, -28 },   { 0xBCE5086492111AEB, -130, -20 },
+    { 0x8CBCCC096F5088CC, -103, -12 },   { 0xD1B71758E219652C, -77, -4 },
+    { 0x9C40000000000000, -50, 4 },      { 0xE8D4A51000000000, -24, 12 },
+    { 0xAD78EBC5AC620000, 3, 20 },       { 0x813F3978F8940984, 30, 28 },
+    { 0xC097CE7BC90715B3, 56, 36 },      { 0x8F7E32CE7BEA5C70, 83, 44 },
+    { 0xD5D238A4ABE98068, 109, 52 },     { 0x9F4F2726179A2245, 136, 60 },
+    { 0xED63A231D4C4FB27, 162, 68 },     { 0xB0DE65388CC8ADA8, 189, 76 },
+    { 0x83C7088E1AAB65DB, 216, 84 },     { 0xC45D1DF942711D9A, 242, 92 },
+    { 0x924D692CA61BE758, 269, 100 },    { 0xDA01EE641A708DEA, 295, 108 },
+    { 0xA26DA3999AEF774A, 322, 116 },    { 0xF209787BB47D6B85, 348, 124 },
+    { 0xB454E4A179DD1877, 375, 132 },    { 0x865B86925B9BC5C2, 402, 140 },
+    { 0xC83553C5C8965D3D, 428, 148 },    { 0x952AB45CFA97A0B3, 455, 156 },
+    { 0xDE469FBD99A05FE3, 481, 164 },    { 0xA59BC234DB398C25, 508, 172 },
+    { 0xF6C69A72A3989F5C, 534, 180 },    { 0xB7DCBF5354E9BECE, 561, 188 },
+    { 0x88FCF317F22241E2, 588, 196 },    { 0xCC20CE9BD35C78A5, 614, 204 },
+    { 0x98165AF37B2153DF, 641, 212 },    { 0xE2A0B5DC971F303A, 667, 220 },
+    { 0xA8D9D1535CE3B396, 694, 228 },    { 0xFB9B7CD9A4A7443C, 720, 236 },
+    { 0xBB764C4CA7A44410, 747, 244 },    { 0x8BAB8EEFB6409C1A, 774, 252 },
+    { 0xD01FEF10A657842C, 800, 260 },    { 0x9B10A4E5E9913129, 827, 268 },
+    { 0xE7109BFBA19C0C9D, 853, 276 },    { 0xAC2820D9623BF429, 880, 284 },
+    { 0x80444B5E7AA7CF85, 907, 292 },    { 0xBF21E44003ACDD2D, 933, 300 },
+    { 0x8E679C2F5E44FF8F, 960, 308 },    { 0xD433179D9C8CB841, 986, 316 },
+    { 0x9E19DB92B4E31BA9, 1013, 324 },
+};
+
+// Target range for the binary exponent of scaled values.
+#define GRISU_ALPHA (-60)
+#define GRISU_GAMMA (-32)
+
+static DiyFp diyfp_sub(DiyFp x, DiyFp y) {
+    assert((x.e == y.e) && (x.f >= y.f));
+    return (DiyFp) { .f = x.f - y.f, .e = x.e };
 }
 
-static GgError json_write_buf_byte(uint8_t byte, GgWriter writer) {
-    GgError ret = GG_ERR_OK;
-    if ((char) byte == '"') {
-        ret = gg_writer_call(writer, GG_STR("\\\""));
-        if (ret != GG_ERR_OK) {
-            return ret;
-        }
-    } else if ((char) byte == '\\') {
-        ret = gg_writer_call(writer, GG_STR("\\\\"));
-        if (ret != GG_ERR_OK) {
-            return ret;
-        }
-    } else if (byte <= 0x001F) {
-        uint8_t encoded_byte[7];
-        int ret_len = snprintf(
-            (char *) encoded_byte, sizeof(encoded_byte), "\\u00%02X", byte
-        );
-        if (ret_len < 0) {
-            GG_LOGE("Error encoding json.");
-            return GG_ERR_FAILURE;
+/// Multiplies two normalized values, rounding the 128-bit product to 64 bits.
+static DiyFp diyfp_mul(DiyFp x, DiyFp y) {
+    uint64_t x_lo = x.f & UINT32_MAX;
+    uint64_t x_hi = x.f >> 32;
+    uint64_t y_lo = y.f & UINT32_MAX;
+    uint64_t y_hi = y.f >> 32;
+
+    uint64_t p0 = x_lo * y_lo;
+    uint64_t p1 = x_lo * y_hi;
+    uint64_t p2 = x_hi * y_lo;
+    uint64_t p3 = x_hi * y_hi;
+
+    uint64_t mid = (p0 >> 32) + (p1 & UINT32_MAX) + (p2 & UINT32_MAX);
+    mid += UINT64_C(1) << 31;
+
+    return (DiyFp) {
+        .f = p3 + (p2 >> 32) + (p1 >> 32) + (mid >> 32),
+        .e = x.e + y.e + 64,
+    };
+}
+
+static DiyFp diyfp_normalize(DiyFp x) {
+    assert(x.f != 0);
+    while ((x.f >> 63) == 0) {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+/// Computes normalized `v` and its normalized boundaries `m_minus`/`m_plus`.
+/// Any value strictly between the boundaries rounds to `v`.
+static void grisu_boundaries(
+    double val, DiyFp *v, DiyFp *m_minus, DiyFp *m_plus
+) {
+    static_assert(DBL_MANT_DIG == 53, "Only IEEE 754 binary64 supported.");
+
+    const uint64_t hidden_bit = UINT64_C(1) << 52;
+    const int exp_bias = 1023 + 52;
+
+    uint64_t bits;
+    memcpy(&bits, &val, sizeof(bits));
+    uint64_t biased_exp = (bits >> 52) & 0x7FF;
+    uint64_t fraction = bits & (hidden_bit - 1);
+
+    DiyFp w;
+    if (biased_exp == 0) {
+        w = (DiyFp) { .f = fraction, .e = 1 - exp_bias };
+    } else {
+        w = (DiyFp) { .f = fraction + hidden_bit,
+                      .e = (int) biased_exp - exp_bias };
+    }
+
+    // Lower boundary is closer if val is a power of two (and not the smallest
+    // normal value).
+    bool lower_closer = (fraction == 0) && (biased_exp > 1);
+
+    DiyFp plus = diyfp_normalize((DiyFp) { .f = (2 * w.f) + 1, .e = w.e - 1 });
+    DiyFp minus = lower_closer
+        ? (DiyFp) { .f = (4 * w.f) - 1, .e = w.e - 2 }
+        : (DiyFp) { .f = (2 * w.f) - 1, .e = w.e - 1 };
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    *v = diyfp_normalize(w);
+    *m_minus = minus;
+    *m_plus = plus;
+}
+
+/// Gets cached power c such that alpha <= e + c.e + 64 <= gamma.
+static CachedPower grisu_cached_power(int e) {
+    // k = ceil((alpha - e - 1) * log10(2))
+    int f = GRISU_ALPHA - e - 1;
+    int k = (f * 78913) / (1 << 18) + (f > 0);
+    size_t index = (size_t) (300 + k + 7) / 8;
+    assert(index < sizeof(CACHED_POWERS) / sizeof(CACHED_POWERS[0]));
+    CachedPower cached = CACHED_POWERS[index];
+    assert(GRISU_ALPHA <= cached.e + e + 64);
+    assert(cached.e + e + 64 <= GRISU_GAMMA);
+    return cached;
+}
+
+/// Returns number of digits in n, and sets pow10 to 10^(digits - 1).
+static int grisu_largest_pow10(uint32_t n, uint32_t *pow10) {
+    uint32_t p = 1000000000;
+    int digits = 10;
+    while (p > n) {
+        if (p == 1) {
+            break;
         }
-        if ((size_t) ret_len > sizeof(encoded_byte)) {
-            assert((size_t) ret_len <= sizeof(encoded_byte));
-            return GG_ERR_NOMEM;
+        p /= 10;
+        digits--;
+    }
+    *pow10 = p;
+    return digits;
+}
+
+static void grisu_round(
+    char *buf, size_t len, uint64_t dist, uint64_t delta, uint64_t rest,
+    uint64_t ten_k
+) {
+    // Move the last digit down while it stays within the boundaries and brings
+    // the result closer to the exact value.
+    while ((rest < dist) && (delta - rest >= ten_k)
+           && ((rest + ten_k < dist) || (dist - rest > rest + ten_k - dist))) {
+        buf[len - 1]--;
+        rest += ten_k;
+    }
+}
+
+/// Generates shortest digits of a value within (m_minus, m_plus).
+/// Scaled values must have exponents in [alpha, gamma].
+static void grisu_digit_gen(
+    char *buf, size_t *len, int *dec_exp, DiyFp m_minus, DiyFp w, DiyFp m_plus
+) {
+    uint64_t delta = diyfp_sub(m_plus, m_minus).f;
+    uint64_t dist = diyfp_sub(m_plus, w).f;
+
+    int shift = -m_plus.e;
+    uint64_t one_f = UINT64_C(1) << shift;
+
+    uint32_t p1 = (uint32_t) (m_plus.f >> shift);
+    uint64_t p2 = m_plus.f & (one_f - 1);
+
+    uint32_t pow10;
+    int n = grisu_largest_pow10(p1, &pow10);
+
+    while (n > 0) {
+        uint32_t digit = p1 / pow10;
+        p1 %= pow10;
+        buf[*len] = (char) ('0' + digit);
+        *len += 1;
+        n--;
+
+        uint64_t rest = ((uint64_t) p1 << shift) + p2;
+        if (rest <= delta) {
+            *dec_exp += n;
+            grisu_round(
+                buf, *len, dist, delta, rest, (uint64_t) pow10 << shift
+            );
+            return;
         }
-        ret = gg_writer_call(
-            writer, (GgBuffer) { .data = encoded_byte, .len = (size_t) ret_len }
-        );
-        if (ret != GG_ERR_OK) {
-            return ret;
+
+        pow10 /= 10;
+    }
+
+    int m = 0;
+    while (true) {
+        p2 *= 10;
+        uint64_t digit = p2 >> shift;
+        p2 &= one_f - 1;
+        buf[*len] = (char) ('0' + digit);
+        *len += 1;
+        m++;
+
+        delta *= 10;
+        dist *= 10;
+        if (p2 <= delta) {
+            break;
         }
+    }
+
+    *dec_exp -= m;
+    grisu_round(buf, *len, dist, delta, p2, one_f);
+}
+
+/// Writes shortest digits of positive finite `val` into buf.
+/// Value is `buf * 10^dec_exp`.
+static void grisu2(char *buf, size_t *len, int *dec_exp, double val) {
+    DiyFp v;
+    DiyFp m_minus;
+    DiyFp m_plus;
+    grisu_boundaries(val, &v, &m_minus, &m_plus);
+
+    CachedPower cached = grisu_cached_power(m_plus.e);
+    DiyFp c_minus_k = { .f = cached.f, .e = cached.e };
+
+    DiyFp w = diyfp_mul(v, c_minus_k);
+    DiyFp w_minus = diyfp_mul(m_minus, c_minus_k);
+    DiyFp w_plus = diyfp_mul(m_plus, c_minus_k);
+
+    // Shrink the interval by one ulp to account for multiplication error.
+    w_minus.f += 1;
+    w_plus.f -= 1;
+
+    *len = 0;
+    *dec_exp = -cached.k;
+    grisu_digit_gen(buf, len, dec_exp, w_minus, w, w_plus);
+}
+
+/// Formats digits with decimal exponent into a JSON number that decodes as a
+/// float (always has a fraction or exponent part). Returns end of output.
+/// buf must have room for the output; digits are at start of buf.
+static char *format_f64_digits(char *buf, size_t len, int dec_exp) {
+    const int min_exp = -4;
+    const int max_exp = 15;
+
+    int k = (int) len;
+    // Value is 0.<digits> * 10^n
+    int n = k + dec_exp;
+
+    if ((k <= n) && (n <= max_exp)) {
+        // digits[000].0
+        memset(&buf[k], '0', (size_t) (n - k));
+        buf[n] = '.';
+        buf[n + 1] = '0';
+        return &buf[n + 2];
+    }
+
+    if ((0 < n) && (n <= max_exp)) {
+        // dig.its
+        memmove(&buf[n + 1], &buf[n], (size_t) (k - n));
+        buf[n] = '.';
+        return &buf[k + 1];
+    }
+
+    if ((min_exp < n) && (n <= 0)) {
+        // 0.[000]digits
+        memmove(&buf[2 - n], buf, (size_t) k);
+        buf[0] = '0';
+        buf[1] = '.';
+        memset(&buf[2], '0', (size_t) -n);
+        return &buf[2 - n + k];
+    }
+
+    // d[.igits]e[+-]x
+    char *pos;
+    if (k == 1) {
+        pos = &buf[1];
     } else {
-        ret = gg_writer_call(writer, (GgBuffer) { .data = &byte, .len = 1 });
-        if (ret != GG_ERR_OK) {
-            return ret;
-        }
+        memmove(&buf[2], &buf[1], (size_t) (k - 1));
+        buf[1] = '.';
+        pos = &buf[k + 1];
     }
-    return ret;
+    *pos++ = 'e';
+
+    int exp = n - 1;
+    if (exp < 0) {
+        *pos++ = '-';
+        exp = -exp;
+    } else {
+        *pos++ = '+';
+    }
+
+    char exp_digits[3];
+    char *exp_end = &exp_digits[sizeof(exp_digits)];
+    char *exp_start = write_u64_digits(exp_end, (uint64_t) exp);
+    size_t exp_len = (size_t) (exp_end - exp_start);
+    memcpy(pos, exp_start, exp_len);
+    return &pos[exp_len];
+}
+
+/// Formats a double as JSON into `encoded`.
+/// On success, sets `out` to the slice of `encoded` holding the result.
+static GgError json_format_f64(
+    double val, char encoded[static 32], GgBuffer *out
+) {
+    if (!isfinite(val)) {
+        GG_LOGE("Non-finite floating point value cannot be encoded as JSON.");
+        return GG_ERR_RANGE;
+    }
+
+    // -0.[0000]<17 digits> or -<17 digits>e-xxx or -<15 digits>.0
+    char *pos = encoded;
+
+    if (signbit(val)) {
+        *pos++ = '-';
+        val = -val;
+    }
+
+    char *end;
+    if (val == 0.0) {
+        memcpy(pos, "0.0", 3);
+        end = &pos[3];
+    } else {
+        size_t len;
+        int dec_exp;
+        grisu2(pos, &len, &dec_exp, val);
+        assert(len <= 17);
+        end = format_f64_digits(pos, len, dec_exp);
+    }
+
+    assert(end <= &encoded[32]);
+    *out = (GgBuffer) { .data = (uint8_t *) encoded,
+                        .len = (size_t) (end - encoded) };
+    return GG_ERR_OK;
+}
+
+static GgError json_encode_on_f64(void *ctx, double val) {
+    GgWriter *writer = ctx;
+    char encoded[32];
+    GgBuffer formatted;
+    GgError ret = json_format_f64(val, encoded, &formatted);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    return gg_writer_call(*writer, formatted);
+}
+
+static bool json_byte_needs_escape(uint8_t byte) {
+    return (byte == '"') || (byte == '\\') || (byte <= 0x1F);
+}
+
+static GgError json_write_escaped_byte(uint8_t byte, GgWriter writer) {
+    if (byte == '"') {
+        return gg_writer_call(writer, GG_STR("\\\""));
+    }
+    if (byte == '\\') {
+        return gg_writer_call(writer, GG_STR("\\\\"));
+    }
+    uint8_t encoded[] = { '\\', 'u', '0', '0', 0, 0 };
+    encoded[4] = (uint8_t) HEX_DIGITS[byte >> 4];
+    encoded[5] = (uint8_t) HEX_DIGITS[byte & 0xF];
+    return gg_writer_call(writer, GG_BUF(encoded));
 }
 
 static GgError json_encode_on_buf(void *ctx, GgBuffer val, GgObject *obj) {
@@ -113,18 +461,37 @@ static GgError json_encode_on_buf(void *ctx, GgBuffer val, GgObject *obj) {
         return ret;
     }
 
+    // Write runs of bytes not needing escaping with a single call.
+    size_t run_start = 0;
     for (size_t i = 0; i < val.len; i++) {
-        ret = json_write_buf_byte(val.data[i], *writer);
+        if (!json_byte_needs_escape(val.data[i])) {
+            continue;
+        }
+
+        if (i > run_start) {
+            ret = gg_writer_call(*writer, gg_buffer_substr(val, run_start, i));
+            if (ret != GG_ERR_OK) {
+                return ret;
+            }
+        }
+
+        ret = json_write_escaped_byte(val.data[i], *writer);
         if (ret != GG_ERR_OK) {
             return ret;
         }
+        run_start = i + 1;
     }
 
-    ret = gg_writer_call(*writer, GG_STR("\""));
-    if (ret != GG_ERR_OK) {
-        return ret;
+    if (val.len > run_start) {
+        ret = gg_writer_call(
+            *writer, gg_buffer_substr(val, run_start, val.len)
+        );
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
     }
-    return GG_ERR_OK;
+
+    return gg_writer_call(*writer, GG_STR("\""));
 }
 
 static GgError json_encode_on_list(void *ctx, GgList val, GgObject *obj) {
@@ -171,6 +538,90 @@ static GgError json_encode_end_map(void *ctx) {
     return gg_writer_call(*writer, GG_STR("}"));
 }
 
+/// Formatting buffer for packed numeric arrays, flushed when nearly full.
+typedef struct {
+    GgWriter writer;
+    size_t len;
+    char chunk[512];
+} JsonArrayChunk;
+
+static GgError json_chunk_flush(JsonArrayChunk *chunk) {
+    GgError ret = gg_writer_call(
+        chunk->writer,
+        (GgBuffer) { .data = (uint8_t *) chunk->chunk, .len = chunk->len }
+    );
+    chunk->len = 0;
+    return ret;
+}
+
+/// Makes room for an element of up to `max_len` bytes, its separator, and
+/// the closing bracket.
+static GgError json_chunk_reserve(JsonArrayChunk *chunk, size_t max_len) {
+    if (chunk->len + max_len + 2 > sizeof(chunk->chunk)) {
+        return json_chunk_flush(chunk);
+    }
+    return GG_ERR_OK;
+}
+
+static GgError json_encode_on_f64_array(
+    void *ctx, GgF64Array val, GgObject *obj
+) {
+    GgWriter *writer = ctx;
+    (void) obj;
+    JsonArrayChunk chunk = { .writer = *writer, .len = 1, .chunk = "[" };
+
+    for (size_t i = 0; i < val.len; i++) {
+        GgError ret = json_chunk_reserve(&chunk, 32);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        if (i > 0) {
+            chunk.chunk[chunk.len] = ',';
+            chunk.len += 1;
+        }
+        // Formats in place, so the output is already in the chunk
+        GgBuffer formatted;
+        ret = json_format_f64(
+            val.items[i], &chunk.chunk[chunk.len], &formatted
+        );
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        chunk.len += formatted.len;
+    }
+
+    chunk.chunk[chunk.len] = ']';
+    chunk.len += 1;
+    return json_chunk_flush(&chunk);
+}
+
+static GgError json_encode_on_i64_array(
+    void *ctx, GgI64Array val, GgObject *obj
+) {
+    GgWriter *writer = ctx;
+    (void) obj;
+    JsonArrayChunk chunk = { .writer = *writer, .len = 1, .chunk = "[" };
+
+    for (size_t i = 0; i < val.len; i++) {
+        GgError ret = json_chunk_reserve(&chunk, 20);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        if (i > 0) {
+            chunk.chunk[chunk.len] = ',';
+            chunk.len += 1;
+        }
+        char encoded[20];
+        GgBuffer formatted = json_format_i64(val.items[i], encoded);
+        memcpy(&chunk.chunk[chunk.len], formatted.data, formatted.len);
+        chunk.len += formatted.len;
+    }
+
+    chunk.chunk[chunk.len] = ']';
+    chunk.len += 1;
+    return json_chunk_flush(&chunk);
+}
+
 GgError gg_json_encode(GgObject obj, GgWriter writer) {
     const GgObjectVisitHandlers VISIT_HANDLERS = {
         .on_null = json_encode_on_null,
@@ -185,10 +636,146 @@ GgError gg_json_encode(GgObject obj, GgWriter writer) {
         .on_map_key = json_encode_on_map_key,
         .cont_map = json_encode_cont_map,
         .end_map = json_encode_end_map,
+        .on_f64_array = json_encode_on_f64_array,
+        .on_i64_array = json_encode_on_i64_array,
     };
     return gg_obj_visit(&VISIT_HANDLERS, &writer, &obj);
 }
 
+static GgError json_len_on_null(void *ctx) {
+    size_t *len = ctx;
+    *len += sizeof("null") - 1;
+    return GG_ERR_OK;
+}
+
+static GgError json_len_on_bool(void *ctx, bool val) {
+    size_t *len = ctx;
+    *len += val ? sizeof("true") - 1 : sizeof("false") - 1;
+    return GG_ERR_OK;
+}
+
+static GgError json_len_on_i64(void *ctx, int64_t val) {
+    size_t *len = ctx;
+    char encoded[20];
+    *len += json_format_i64(val, encoded).len;
+    return GG_ERR_OK;
+}
+
+static GgError json_len_on_f64(void *ctx, double val) {
+    size_t *len = ctx;
+    char encoded[32];
+    GgBuffer formatted;
+    GgError ret = json_format_f64(val, encoded, &formatted);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+    *len += formatted.len;
+    return GG_ERR_OK;
+}
+
+static size_t json_string_len(GgBuffer val) {
+    // Quotes
+    size_t len = 2 + val.len;
+    for (size_t i = 0; i < val.len; i++) {
+        uint8_t byte = val.data[i];
+        if ((byte == '"') || (byte == '\\')) {
+            len += 1;
+        } else if (byte <= 0x1F) {
+            // \u00XX
+            len += 5;
+        }
+    }
+    return len;
+}
+
+static GgError json_len_on_buf(void *ctx, GgBuffer val, GgObject *obj) {
+    size_t *len = ctx;
+    (void) obj;
+    *len += json_string_len(val);
+    return GG_ERR_OK;
+}
+
+static GgError json_len_on_list(void *ctx, GgList val, GgObject *obj) {
+    size_t *len = ctx;
+    (void) obj;
+    // Brackets and separating commas
+    *len += 2 + ((val.len > 0) ? val.len - 1 : 0);
+    return GG_ERR_OK;
+}
+
+static GgError json_len_on_map(void *ctx, GgMap val, GgObject *obj) {
+    size_t *len = ctx;
+    (void) obj;
+    // Braces and separating commas
+    *len += 2 + ((val.len > 0) ? val.len - 1 : 0);
+    return GG_ERR_OK;
+}
+
+static GgError json_len_on_map_key(void *ctx, GgBuffer key, GgKV *kv) {
+    size_t *len = ctx;
+    (void) kv;
+    // Key and colon
+    *len += json_string_len(key) + 1;
+    return GG_ERR_OK;
+}
+
+static GgError json_len_on_f64_array(
+    void *ctx, GgF64Array val, GgObject *obj
+) {
+    size_t *len = ctx;
+    (void) obj;
+    // Brackets and separating commas
+    size_t total = 2 + ((val.len > 0) ? val.len - 1 : 0);
+    for (size_t i = 0; i < val.len; i++) {
+        char encoded[32];
+        GgBuffer formatted;
+        GgError ret = json_format_f64(val.items[i], encoded, &formatted);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        total += formatted.len;
+    }
+    *len += total;
+    return GG_ERR_OK;
+}
+
+static GgError json_len_on_i64_array(
+    void *ctx, GgI64Array val, GgObject *obj
+) {
+    size_t *len = ctx;
+    (void) obj;
+    // Brackets and separating commas
+    size_t total = 2 + ((val.len > 0) ? val.len - 1 : 0);
+    for (size_t i = 0; i < val.len; i++) {
+        char encoded[20];
+        total += json_format_i64(val.items[i], encoded).len;
+    }
+    *len += total;
+    return GG_ERR_OK;
+}
+
+GgError gg_json_encoded_len(GgObject obj, size_t *len) {
+    const GgObjectVisitHandlers VISIT_HANDLERS = {
+        .on_null = json_len_on_null,
+        .on_bool = json_len_on_bool,
+        .on_i64 = json_len_on_i64,
+        .on_f64 = json_len_on_f64,
+        .on_buf = json_len_on_buf,
+        .on_list = json_len_on_list,
+        .on_map = json_len_on_map,
+        .on_map_key = json_len_on_map_key,
+        .on_f64_array = json_len_on_f64_array,
+        .on_i64_array = json_len_on_i64_array,
+    };
+
+    size_t measured = 0;
+    GgError ret = gg_obj_visit(&VISIT_HANDLERS, &measured, &obj);
+    if ((len != NULL) && (ret == GG_ERR_OK)) {
+        *len = measured;
+    }
+    return ret;
+}
+
 static GgError obj_read(void *ctx, GgBuffer *buf) {
     assert(buf != NULL);
 
@@ -4,7 +4,7 @@
 
 #include <gg/error.h>
 #include <gg/list.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/object.h>
 
 GgError gg_list_type_check(GgList list, GgObjectType type) {
@@ -2,20 +2,221 @@
 // Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <assert.h>
+#include <errno.h>
+#include <gg/attr.h>
 #include <gg/cleanup.h>
+#include <gg/error.h>
+#include <gg/init.h>
 #include <gg/log.h>
+#include <gg/log_priv.h>
+#include <inttypes.h>
+#include <poll.h>
 #include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/eventfd.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
+#include <time.h>
 #include <unistd.h>
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdnoreturn.h>
+
+/// Maximum length of a log line. Longer messages are truncated.
+/// Can be configured with `-D GG_LOG_MAX_LEN=<N>`.
+#ifndef GG_LOG_MAX_LEN
+#define GG_LOG_MAX_LEN 1024
+#endif
+
+/// Number of per-thread log buffers. Threads beyond this log synchronously.
+/// Can be configured with `-D GG_LOG_RING_COUNT=<N>`.
+#ifndef GG_LOG_RING_COUNT
+#define GG_LOG_RING_COUNT 8
+#endif
+
+/// Size of each per-thread log buffer. Must be a power of two.
+/// Can be configured with `-D GG_LOG_RING_SIZE=<N>`.
+#ifndef GG_LOG_RING_SIZE
+#define GG_LOG_RING_SIZE 8192
+#endif
+
+/// Number of distinct module tags with their own runtime level.
+/// Further modules share the default level.
+/// Can be configured with `-D GG_LOG_MAX_MODULES=<N>`.
+#ifndef GG_LOG_MAX_MODULES
+#define GG_LOG_MAX_MODULES 16
+#endif
+
+/// Maximum length of a module tag with its own runtime level.
+#define GG_LOG_MODULE_NAME_LEN 32
+
+/// Lines each rate-limited call site may log per interval.
+/// Can be configured with `-D GG_LOG_RATELIMIT_BURST=<N>`.
+#ifndef GG_LOG_RATELIMIT_BURST
+#define GG_LOG_RATELIMIT_BURST 10
+#endif
+
+/// Length of the rate limiting interval in milliseconds.
+/// Can be configured with `-D GG_LOG_RATELIMIT_INTERVAL_MS=<N>`.
+#ifndef GG_LOG_RATELIMIT_INTERVAL_MS
+#define GG_LOG_RATELIMIT_INTERVAL_MS 5000
+#endif
+
+static_assert(
+    (GG_LOG_RING_SIZE & (GG_LOG_RING_SIZE - 1)) == 0,
+    "Log ring size must be a power of two."
+);
+static_assert(
+    GG_LOG_RING_SIZE >= GG_LOG_MAX_LEN, "Log ring must fit a full line."
+);
 
 static bool enable_systemd_log_prefix = false;
 
-__attribute__((constructor)) static void configure_logging(void) {
+typedef struct {
+    char name[GG_LOG_MODULE_NAME_LEN];
+    uint32_t level;
+} LogModule;
+
+/// Runtime levels for module tags. Entries below `log_module_count` are
+/// never removed; their names are immutable once published.
+static LogModule log_modules[GG_LOG_MAX_MODULES];
+static atomic_size_t log_module_count = 0;
+static pthread_mutex_t log_module_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+/// Level for new modules, and for modules beyond the table size.
+static uint32_t default_level = GG_LOG_TRACE;
+
+static LogModule *find_module(const char *module, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(log_modules[i].name, module) == 0) {
+            return &log_modules[i];
+        }
+    }
+    return NULL;
+}
+
+static uint32_t *get_module_level(const char *module) {
+    if (strlen(module) >= GG_LOG_MODULE_NAME_LEN) {
+        return &default_level;
+    }
+
+    LogModule *entry = find_module(
+        module, atomic_load_explicit(&log_module_count, memory_order_acquire)
+    );
+    if (entry != NULL) {
+        return &entry->level;
+    }
+
+    GG_MTX_SCOPE_GUARD(&log_module_mtx);
+
+    size_t count
+        = atomic_load_explicit(&log_module_count, memory_order_relaxed);
+    entry = find_module(module, count);
+    if (entry != NULL) {
+        return &entry->level;
+    }
+    if (count >= GG_LOG_MAX_MODULES) {
+        return &default_level;
+    }
+
+    entry = &log_modules[count];
+    strncpy(entry->name, module, sizeof(entry->name) - 1);
+    __atomic_store_n(
+        &entry->level,
+        __atomic_load_n(&default_level, __ATOMIC_RELAXED),
+        __ATOMIC_RELAXED
+    );
+    atomic_store_explicit(&log_module_count, count + 1, memory_order_release);
+    return &entry->level;
+}
+
+const uint32_t *gg_log_module_level(const char *module) {
+    return get_module_level(module);
+}
+
+void gg_log_set_level(const char *module, uint32_t level) {
+    if (module != NULL) {
+        __atomic_store_n(get_module_level(module), level, __ATOMIC_RELAXED);
+        return;
+    }
+
+    GG_MTX_SCOPE_GUARD(&log_module_mtx);
+
+    __atomic_store_n(&default_level, level, __ATOMIC_RELAXED);
+    size_t count
+        = atomic_load_explicit(&log_module_count, memory_order_relaxed);
+    for (size_t i = 0; i < count; i++) {
+        __atomic_store_n(&log_modules[i].level, level, __ATOMIC_RELAXED);
+    }
+}
+
+uint32_t gg_log_get_level(const char *module) {
+    if (module == NULL) {
+        return __atomic_load_n(&default_level, __ATOMIC_RELAXED);
+    }
+    return __atomic_load_n(get_module_level(module), __ATOMIC_RELAXED);
+}
+
+static bool parse_level(const char *str, size_t len, uint32_t *level) {
+    static const char *const NAMES[] = {
+        [GG_LOG_NONE] = "none",   [GG_LOG_ERROR] = "error",
+        [GG_LOG_WARN] = "warn",   [GG_LOG_INFO] = "info",
+        [GG_LOG_DEBUG] = "debug", [GG_LOG_TRACE] = "trace",
+    };
+    for (uint32_t i = 0; i < sizeof(NAMES) / sizeof(NAMES[0]); i++) {
+        if ((strlen(NAMES[i]) == len) && (strncmp(NAMES[i], str, len) == 0)) {
+            *level = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Parse GG_LOG_LEVELS, a comma separated list of `level` or `module=level`
+/// entries. A bare level applies to all modules. Later entries win.
+static void configure_log_levels(void) {
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    const char *levels = getenv("GG_LOG_LEVELS");
+    if (levels == NULL) {
+        return;
+    }
+
+    const char *entry = levels;
+    while (*entry != '\0') {
+        size_t len = strcspn(entry, ",");
+        const char *eq = memchr(entry, '=', len);
+
+        uint32_t level;
+        if (eq == NULL) {
+            if (parse_level(entry, len, &level)) {
+                gg_log_set_level(NULL, level);
+            }
+        } else {
+            size_t name_len = (size_t) (eq - entry);
+            char name[GG_LOG_MODULE_NAME_LEN];
+            if ((name_len < sizeof(name))
+                && parse_level(eq + 1, len - name_len - 1, &level)) {
+                memcpy(name, entry, name_len);
+                name[name_len] = '\0';
+                gg_log_set_level(name, level);
+            }
+        }
+
+        entry += len;
+        if (*entry == ',') {
+            entry += 1;
+        }
+    }
+}
+
+static void configure_journal_prefix(void) {
     // NOLINTNEXTLINE(concurrency-mt-unsafe)
     const char *journal_stream = getenv("JOURNAL_STREAM");
     if (journal_stream == NULL) {
@@ -42,16 +243,26 @@ __attribute__((constructor)) static void configure_logging(void) {
     }
 }
 
-void gg_log(
+__attribute__((constructor)) static void configure_logging(void) {
+    configure_log_levels();
+    configure_journal_prefix();
+}
+
+/// Serializes writes to stderr, and draining of the log rings.
+static pthread_mutex_t write_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+/// Format a log line, including the trailing newline, into `buf`.
+/// Returns the line length.
+FORMAT(printf, 6, 0)
+static size_t format_line(
+    char buf[static GG_LOG_MAX_LEN],
     uint32_t level,
     const char *file,
     int line,
     const char *tag,
     const char *format,
-    ...
+    va_list args
 ) {
-    static pthread_mutex_t log_mutex = PTHREAD_MUTEX_INITIALIZER;
-
     const char *prefix = "";
 
     if (enable_systemd_log_prefix) {
@@ -95,17 +306,495 @@ void gg_log(
         level_c = '?';
     }
 
+    // Leave room for the newline
+    size_t cap = GG_LOG_MAX_LEN - 1;
+    size_t len = 0;
+
+    int ret = snprintf(
+        buf, cap, "%s%c[%s] %s:%d: ", prefix, level_c, tag, file, line
+    );
+    if (ret > 0) {
+        len = ((size_t) ret < cap) ? (size_t) ret : cap - 1;
+    }
+
+    ret = vsnprintf(&buf[len], cap - len, format, args);
+    if (ret > 0) {
+        len += ((size_t) ret < cap - len) ? (size_t) ret : cap - len - 1;
+    }
+
+    buf[len] = '\n';
+    return len + 1;
+}
+
+/// Write all of `iov` to stderr. Output that cannot be written is dropped.
+// Requires holding write_mtx
+static void write_iov(struct iovec *iov, int iovcnt) {
+    while (iovcnt > 0) {
+        ssize_t ret = writev(STDERR_FILENO, iov, iovcnt);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+
+        size_t written = (size_t) ret;
+        while ((iovcnt > 0) && (written >= iov->iov_len)) {
+            written -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = &((char *) iov->iov_base)[written];
+            iov->iov_len -= written;
+        }
+    }
+}
+
+static void write_line_sync(char *line, size_t len) {
+    GG_MTX_SCOPE_GUARD(&write_mtx);
+    struct iovec iov = { .iov_base = line, .iov_len = len };
+    write_iov(&iov, 1);
+}
+
+/// Rate-limited call sites with suppressed lines not yet reported.
+static GgLogRateLimit *ratelimit_pending = NULL;
+static pthread_mutex_t ratelimit_mtx = PTHREAD_MUTEX_INITIALIZER;
+
+typedef struct {
+    uint32_t level;
+    const char *file;
+    int line;
+    const char *tag;
+    uint32_t suppressed;
+} RateLimitReport;
+
+static uint64_t monotonic_ms(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t) now.tv_sec * 1000) + ((uint64_t) now.tv_nsec / 1000000);
+}
+
+/// Remove `state` from the pending list and take its suppressed count.
+// Requires holding ratelimit_mtx
+static RateLimitReport take_pending(GgLogRateLimit *state) {
+    GgLogRateLimit **link = &ratelimit_pending;
+    while (*link != state) {
+        link = &(*link)->next_pending;
+    }
+    __atomic_store_n(link, state->next_pending, __ATOMIC_RELAXED);
+
+    RateLimitReport report = { .level = state->level,
+                               .file = state->file,
+                               .line = state->line,
+                               .tag = state->tag,
+                               .suppressed = state->suppressed };
+    state->suppressed = 0;
+    state->pending = false;
+    state->next_pending = NULL;
+    return report;
+}
+
+static void log_report(const RateLimitReport *report) {
+    if (report->suppressed > 0) {
+        gg_log(
+            report->level,
+            report->file,
+            report->line,
+            report->tag,
+            "Suppressed %" PRIu32 " similar log messages.",
+            report->suppressed
+        );
+    }
+}
+
+/// Take the report of one call site whose interval has ended.
+/// Returns 0 if `report` was filled; otherwise the milliseconds until the
+/// next pending interval ends, or -1 if none are pending.
+static int take_expired_ratelimit(RateLimitReport *report) {
+    if (__atomic_load_n(&ratelimit_pending, __ATOMIC_RELAXED) == NULL) {
+        return -1;
+    }
+    uint64_t now_ms = monotonic_ms();
+
+    GG_MTX_SCOPE_GUARD(&ratelimit_mtx);
+
+    int wait_ms = -1;
+    for (GgLogRateLimit *state = ratelimit_pending; state != NULL;
+         state = state->next_pending) {
+        uint64_t elapsed = now_ms
+            - __atomic_load_n(&state->interval_start_ms, __ATOMIC_RELAXED);
+        if (elapsed >= GG_LOG_RATELIMIT_INTERVAL_MS) {
+            *report = take_pending(state);
+            return 0;
+        }
+        int remaining = (int) (GG_LOG_RATELIMIT_INTERVAL_MS - elapsed);
+        if ((wait_ms < 0) || (remaining < wait_ms)) {
+            wait_ms = remaining;
+        }
+    }
+    return wait_ms;
+}
+
+/// Log suppressed line counts for call sites whose interval has ended.
+/// Returns the milliseconds until the next pending interval ends, or -1.
+static int report_expired_ratelimits(void) {
+    while (true) {
+        RateLimitReport report = { 0 };
+        int wait_ms = take_expired_ratelimit(&report);
+        if (wait_ms != 0) {
+            return wait_ms;
+        }
+        log_report(&report);
+    }
+}
+
+#ifdef GG_LOG_ASYNC
+/// Single-producer single-consumer buffer of formatted log lines.
+/// Written by its owning thread and drained by the log writer thread.
+typedef struct {
+    atomic_bool in_use;
+    atomic_size_t head;
+    atomic_size_t tail;
+    /// Lines dropped since last drain due to the buffer being full.
+    atomic_size_t dropped;
+    char mem[GG_LOG_RING_SIZE];
+} LogRing;
+
+static LogRing log_rings[GG_LOG_RING_COUNT];
+static _Thread_local LogRing *thread_ring = NULL;
+static pthread_key_t thread_ring_key;
+
+/// Set once the writer thread is running; cleared in forked children.
+static atomic_bool async_enabled = false;
+static atomic_bool writer_wake_pending = false;
+static int writer_wake_fd = -1;
+
+FORMAT(printf, 6, 7)
+static size_t format_linef(
+    char buf[static GG_LOG_MAX_LEN],
+    uint32_t level,
+    const char *file,
+    int line,
+    const char *tag,
+    const char *format,
+    ...
+) {
+    va_list args;
+    va_start(args, format);
+    size_t len = format_line(buf, level, file, line, tag, format, args);
+    va_end(args);
+    return len;
+}
+
+static LogRing *get_thread_ring(void) {
+    if (thread_ring != NULL) {
+        return thread_ring;
+    }
+    for (size_t i = 0; i < GG_LOG_RING_COUNT; i++) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(
+                &log_rings[i].in_use, &expected, true
+            )) {
+            thread_ring = &log_rings[i];
+            (void) pthread_setspecific(thread_ring_key, thread_ring);
+            return thread_ring;
+        }
+    }
+    return NULL;
+}
+
+/// Called on thread exit. Unwritten lines are still drained by the writer.
+static void release_thread_ring(void *ring) {
+    atomic_store(&((LogRing *) ring)->in_use, false);
+}
+
+static bool ring_push(LogRing *ring, const char *line, size_t len) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if (len > GG_LOG_RING_SIZE - (head - tail)) {
+        return false;
+    }
+
+    size_t start = head & (GG_LOG_RING_SIZE - 1);
+    size_t first = GG_LOG_RING_SIZE - start;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(&ring->mem[start], line, first);
+    memcpy(ring->mem, &line[first], len - first);
+
+    // Sequentially consistent with the wake flag; see log_writer_thread
+    atomic_store(&ring->head, head + len);
+    return true;
+}
+
+static void wake_writer(void) {
+    if (atomic_exchange(&writer_wake_pending, true)) {
+        return;
+    }
+    uint64_t count = 1;
+    ssize_t ret;
+    do {
+        ret = write(writer_wake_fd, &count, sizeof(count));
+    } while ((ret < 0) && (errno == EINTR));
+}
+
+/// Write out all buffered lines in one writev call.
+// Requires holding write_mtx
+static void drain_rings(void) {
+    static struct iovec iov[GG_LOG_RING_COUNT * 3];
+    static char dropped_lines[GG_LOG_RING_COUNT][GG_LOG_MAX_LEN];
+    static size_t heads[GG_LOG_RING_COUNT];
+
+    int iovcnt = 0;
+
+    for (size_t i = 0; i < GG_LOG_RING_COUNT; i++) {
+        LogRing *ring = &log_rings[i];
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        heads[i] = head;
+
+        if (head != tail) {
+            size_t start = tail & (GG_LOG_RING_SIZE - 1);
+            size_t len = head - tail;
+            size_t first = GG_LOG_RING_SIZE - start;
+            if (first > len) {
+                first = len;
+            }
+            iov[iovcnt++]
+                = (struct iovec) { .iov_base = &ring->mem[start],
+                                   .iov_len = first };
+            if (len > first) {
+                iov[iovcnt++] = (struct iovec) { .iov_base = ring->mem,
+                                                 .iov_len = len - first };
+            }
+        }
+
+        size_t dropped = atomic_exchange_explicit(
+            &ring->dropped, 0, memory_order_relaxed
+        );
+        if (dropped != 0) {
+            size_t len = format_linef(
+                dropped_lines[i],
+                GG_LOG_WARN,
+                __FILE_NAME__,
+                __LINE__,
+                GG_MODULE,
+                "Dropped %zu log messages; log buffer full.",
+                dropped
+            );
+            iov[iovcnt++] = (struct iovec) { .iov_base = dropped_lines[i],
+                                             .iov_len = len };
+        }
+    }
+
+    write_iov(iov, iovcnt);
+
+    for (size_t i = 0; i < GG_LOG_RING_COUNT; i++) {
+        atomic_store_explicit(
+            &log_rings[i].tail, heads[i], memory_order_release
+        );
+    }
+}
+
+static void flush_rings(void) {
+    GG_MTX_SCOPE_GUARD(&write_mtx);
+    drain_rings();
+}
+
+noreturn static void *log_writer_thread(void *args) {
+    (void) args;
+
+    while (true) {
+        // Lines pushed after clearing the flag are either drained below or
+        // wake this thread again.
+        atomic_store(&writer_wake_pending, false);
+        atomic_thread_fence(memory_order_seq_cst);
+        int timeout_ms = report_expired_ratelimits();
+        flush_rings();
+
+        // Wake up when the next rate limit interval with suppressed lines
+        // ends, to report them even if that call site does not log again.
+        struct pollfd pfd = { .fd = writer_wake_fd, .events = POLLIN };
+        if (poll(&pfd, 1, timeout_ms) > 0) {
+            uint64_t count;
+            (void) read(writer_wake_fd, &count, sizeof(count));
+        }
+    }
+}
+
+static void flush_at_exit(void) {
+    if (atomic_load(&async_enabled)) {
+        flush_rings();
+    }
+}
+
+static void lock_write_mtx(void) {
+    pthread_mutex_lock(&write_mtx);
+}
+
+static void unlock_write_mtx(void) {
+    pthread_mutex_unlock(&write_mtx);
+}
+
+static void disable_async_in_child(void) {
+    // Writer thread does not exist in the child; parent writes pending lines
+    atomic_store(&async_enabled, false);
+    pthread_mutex_unlock(&write_mtx);
+}
+
+static GgError init_log_writer(void) {
+    // Logging stays synchronous if the writer can not be started
+    if (pthread_key_create(&thread_ring_key, &release_thread_ring) != 0) {
+        return GG_ERR_OK;
+    }
+
+    writer_wake_fd = eventfd(0, EFD_CLOEXEC);
+    if (writer_wake_fd < 0) {
+        return GG_ERR_OK;
+    }
+
+    int ret = pthread_atfork(
+        &lock_write_mtx, &unlock_write_mtx, &disable_async_in_child
+    );
+    if (ret != 0) {
+        return GG_ERR_OK;
+    }
+
+    pthread_t writer_thread;
+    if (pthread_create(&writer_thread, NULL, &log_writer_thread, NULL) != 0) {
+        return GG_ERR_OK;
+    }
+    pthread_detach(writer_thread);
+
+    (void) atexit(&flush_at_exit);
+    atomic_store(&async_enabled, true);
+    return GG_ERR_OK;
+}
+
+__attribute__((constructor)) static void register_init_log_writer(void) {
+    static GgInitEntry entry = { .fn = &init_log_writer };
+    gg_register_init_fn(&entry);
+}
+#endif
+
+void gg_log(
+    uint32_t level,
+    const char *file,
+    int line,
+    const char *tag,
+    const char *format,
+    ...
+) {
+    char buf[GG_LOG_MAX_LEN];
+
+    va_list args;
+    va_start(args, format);
+    size_t len = format_line(buf, level, file, line, tag, format, args);
+    va_end(args);
+
+#ifdef GG_LOG_ASYNC
+    LogRing *ring = atomic_load(&async_enabled) ? get_thread_ring() : NULL;
+    if (ring == NULL) {
+        (void) report_expired_ratelimits();
+        write_line_sync(buf, len);
+        return;
+    }
+
+    if (!ring_push(ring, buf, len)) {
+        // Give the writer one chance to drain before dropping the line
+        wake_writer();
+        (void) sched_yield();
+        if (!ring_push(ring, buf, len)) {
+            atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+        }
+    }
+
+    if (level <= GG_LOG_ERROR) {
+        // Errors often precede exiting; write them out immediately
+        flush_rings();
+    } else {
+        wake_writer();
+    }
+#else
+    // Without the writer thread, ended intervals are reported on any log call
+    (void) report_expired_ratelimits();
+    write_line_sync(buf, len);
+#endif
+}
+
+static void ratelimit_suppress(
+    GgLogRateLimit *state,
+    uint32_t level,
+    const char *file,
+    int line,
+    const char *tag
+) {
+    bool newly_pending = false;
     {
-        GG_MTX_SCOPE_GUARD(&log_mutex);
+        GG_MTX_SCOPE_GUARD(&ratelimit_mtx);
+        state->suppressed += 1;
+        if (!state->pending) {
+            state->pending = true;
+            state->level = level;
+            state->file = file;
+            state->line = line;
+            state->tag = tag;
+            state->next_pending = ratelimit_pending;
+            __atomic_store_n(&ratelimit_pending, state, __ATOMIC_RELAXED);
+            newly_pending = true;
+        }
+    }
+
+#ifdef GG_LOG_ASYNC
+    if (newly_pending && atomic_load(&async_enabled)) {
+        // Writer reports the count once this interval ends
+        wake_writer();
+    }
+#else
+    (void) newly_pending;
+#endif
+}
 
-        fprintf(stderr, "%s%c[%s] %s:%d: ", prefix, level_c, tag, file, line);
+bool gg_log_ratelimit(
+    GgLogRateLimit *state,
+    uint32_t level,
+    const char *file,
+    int line,
+    const char *tag
+) {
+    uint64_t now_ms = monotonic_ms();
 
-        va_list args;
-        va_start(args, format);
-        vfprintf(stderr, format, args);
-        va_end(args);
+    uint64_t start
+        = __atomic_load_n(&state->interval_start_ms, __ATOMIC_RELAXED);
+    if (((start == 0) || ((now_ms - start) >= GG_LOG_RATELIMIT_INTERVAL_MS))
+        && __atomic_compare_exchange_n(
+            &state->interval_start_ms,
+            &start,
+            now_ms,
+            false,
+            __ATOMIC_RELAXED,
+            __ATOMIC_RELAXED
+        )) {
+        // This thread starts the new interval, reporting the previous one if
+        // the log writer has not yet done so
+        __atomic_store_n(&state->count, 0, __ATOMIC_RELAXED);
+        RateLimitReport report = { 0 };
+        {
+            GG_MTX_SCOPE_GUARD(&ratelimit_mtx);
+            if (state->pending) {
+                report = take_pending(state);
+            }
+        }
+        log_report(&report);
+    }
 
-        fprintf(stderr, "\n");
-        fflush(stderr);
+    uint32_t count = __atomic_fetch_add(&state->count, 1, __ATOMIC_RELAXED);
+    if (count < GG_LOG_RATELIMIT_BURST) {
+        return true;
     }
+    ratelimit_suppress(state, level, file, line, tag);
+    return false;
 }
@@ -2,12 +2,19 @@
 // Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
 // SPDX-License-Identifier: Apache-2.0
 
+// Accessor definitions live in gg/map.h; this file emits the external
+// definitions exported by the library.
+#ifndef GG_INLINE_ACCESSORS
+#define GG_INLINE_ACCESSORS
+#endif
+
 #include <assert.h>
 #include <gg/attr.h>
 #include <gg/buffer.h>
 #include <gg/error.h>
 #include <gg/flags.h>
-#include <gg/log.h>
+#include <gg/hash.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <string.h>
@@ -20,6 +27,9 @@ static_assert(
     "GgKV must be at most the size of two GgObjects."
 );
 
+extern inline GgBuffer gg_kv_key(GgKV kv);
+extern inline GgObject *gg_kv_val(GgKV *kv);
+
 COLD
 static void length_err(size_t *len) {
     GG_LOGE(
@@ -45,14 +55,6 @@ GgKV gg_kv(GgBuffer key, GgObject val) {
     return result;
 }
 
-GgBuffer gg_kv_key(GgKV kv) {
-    void *ptr;
-    uint16_t len;
-    memcpy(&ptr, kv._private, sizeof(void *));
-    memcpy(&len, &kv._private[sizeof(void *)], 2);
-    return (GgBuffer) { .data = ptr, .len = len };
-}
-
 void gg_kv_set_key(GgKV *kv, GgBuffer key) {
     if (key.len > UINT16_MAX) {
         length_err(&key.len);
@@ -62,10 +64,6 @@ void gg_kv_set_key(GgKV *kv, GgBuffer key) {
     memcpy(&kv->_private[sizeof(void *)], &key_len, 2);
 }
 
-GgObject *gg_kv_val(GgKV *kv) {
-    return (GgObject *) &kv->_private[sizeof(void *) + 2];
-}
-
 bool gg_map_get(GgMap map, GgBuffer key, GgObject **result) {
     GG_MAP_FOREACH (pair, map) {
         if (gg_buffer_eq(key, gg_kv_key(*pair))) {
@@ -99,66 +97,219 @@ bool gg_map_get_path(GgMap map, GgBufList path, GgObject **result) {
     return gg_map_get(current, path.bufs[path.len - 1], result);
 }
 
-GgError gg_map_validate(GgMap map, GgMapSchema schema) {
+#define MAP_SCHEMA_SLOT_MASK ((GG_MAP_SCHEMA_MAX_ENTRIES * 2) - 1)
+
+/// 32-bit hash of a map key.
+static uint32_t map_key_hash(GgBuffer key) {
+    uint64_t hash = gg_fnv1a(key, 0);
+    return (uint32_t) (hash ^ (hash >> 32));
+}
+
+GgError gg_map_schema_compile(
+    GgMapSchema schema, GgMapCompiledSchema *compiled
+) {
+    if (schema.entry_count > GG_MAP_SCHEMA_MAX_ENTRIES) {
+        GG_LOGE(
+            "Map schema has too many entries to compile (%zu, max %u).",
+            schema.entry_count,
+            (unsigned int) GG_MAP_SCHEMA_MAX_ENTRIES
+        );
+        return GG_ERR_RANGE;
+    }
+
+    *compiled = (GgMapCompiledSchema) { .schema = schema };
     for (size_t i = 0; i < schema.entry_count; i++) {
-        const GgMapSchemaEntry *entry = &schema.entries[i];
-        GgObject *value;
-        bool found = gg_map_get(map, entry->key, &value);
-        if (!found) {
-            if (entry->required.val == GG_PRESENCE_REQUIRED) {
-                GG_LOGE(
-                    "Map missing required key %.*s.",
-                    (int) entry->key.len,
-                    entry->key.data
-                );
-                return GG_ERR_NOENTRY;
-            }
+        uint32_t hash = map_key_hash(schema.entries[i].key);
+        compiled->key_hashes[i] = hash;
+        size_t slot = hash & MAP_SCHEMA_SLOT_MASK;
+        while (compiled->slots[slot] != 0) {
+            slot = (slot + 1) & MAP_SCHEMA_SLOT_MASK;
+        }
+        compiled->slots[slot] = (uint8_t) (i + 1);
+    }
+    return GG_ERR_OK;
+}
 
-            if (entry->required.val == GG_PRESENCE_OPTIONAL) {
-                GG_LOGT(
-                    "Missing optional key %.*s.",
-                    (int) entry->key.len,
-                    entry->key.data
-                );
-            }
+/// Single pass over the map, setting `found[i]` to the value of the first pair
+/// matching entry i, or NULL. `schema` must have the keys `compiled` was
+/// compiled from.
+static void map_schema_match(
+    GgMap map,
+    GgMapSchema schema,
+    const GgMapCompiledSchema *compiled,
+    GgObject **found
+) {
+    for (size_t i = 0; i < schema.entry_count; i++) {
+        found[i] = NULL;
+    }
 
-            if (entry->value != NULL) {
-                *entry->value = NULL;
+    GG_MAP_FOREACH (pair, map) {
+        GgBuffer key = gg_kv_key(*pair);
+        uint32_t hash = map_key_hash(key);
+        // Continue to the end of the probe run as a schema may repeat a key
+        for (size_t slot = hash & MAP_SCHEMA_SLOT_MASK;
+             compiled->slots[slot] != 0;
+             slot = (slot + 1) & MAP_SCHEMA_SLOT_MASK) {
+            size_t idx = compiled->slots[slot] - 1U;
+            if ((found[idx] == NULL) && (compiled->key_hashes[idx] == hash)
+                && gg_buffer_eq(schema.entries[idx].key, key)) {
+                found[idx] = gg_kv_val(pair);
             }
-            continue;
         }
+    }
+}
 
-        GG_LOGT(
-            "Found key %.*s with len %zu",
-            (int) entry->key.len,
-            entry->key.data,
-            entry->key.len
-        );
-
-        if (entry->required.val == GG_PRESENCE_MISSING) {
+static GgError map_schema_check_entry(
+    const GgMapSchemaEntry *entry, GgObject *value
+) {
+    if (value == NULL) {
+        if (entry->required.val == GG_PRESENCE_REQUIRED) {
             GG_LOGE(
-                "Map has required missing key %.*s.",
+                "Map missing required key %.*s.",
                 (int) entry->key.len,
                 entry->key.data
             );
-            return GG_ERR_PARSE;
+            return GG_ERR_NOENTRY;
         }
 
-        if (entry->type != GG_TYPE_NULL) {
-            if (entry->type != gg_obj_type(*value)) {
-                GG_LOGE(
-                    "Key %.*s is of invalid type.",
-                    (int) entry->key.len,
-                    entry->key.data
-                );
-                return GG_ERR_PARSE;
-            }
+        if (entry->required.val == GG_PRESENCE_OPTIONAL) {
+            GG_LOGT(
+                "Missing optional key %.*s.",
+                (int) entry->key.len,
+                entry->key.data
+            );
         }
+        return GG_ERR_OK;
+    }
+
+    GG_LOGT(
+        "Found key %.*s with len %zu",
+        (int) entry->key.len,
+        entry->key.data,
+        entry->key.len
+    );
+
+    if (entry->required.val == GG_PRESENCE_MISSING) {
+        GG_LOGE(
+            "Map has required missing key %.*s.",
+            (int) entry->key.len,
+            entry->key.data
+        );
+        return GG_ERR_PARSE;
+    }
 
+    if ((entry->type != GG_TYPE_NULL) && (entry->type != gg_obj_type(*value))) {
+        GG_LOGE(
+            "Key %.*s is of invalid type.",
+            (int) entry->key.len,
+            entry->key.data
+        );
+        return GG_ERR_PARSE;
+    }
+
+    return GG_ERR_OK;
+}
+
+/// Checks entries in order, storing values to `values` or, if NULL, through
+/// the entries' value pointers.
+static GgError map_schema_check(
+    GgMapSchema schema, GgObject **found, GgObject **values
+) {
+    for (size_t i = 0; i < schema.entry_count; i++) {
+        const GgMapSchemaEntry *entry = &schema.entries[i];
+        GgError ret = map_schema_check_entry(entry, found[i]);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        if (values != NULL) {
+            values[i] = found[i];
+        } else if (entry->value != NULL) {
+            *entry->value = found[i];
+        }
+    }
+    return GG_ERR_OK;
+}
+
+GgError gg_map_validate_compiled(
+    GgMap map, const GgMapCompiledSchema *compiled, GgObject **values
+) {
+    GgObject *found[GG_MAP_SCHEMA_MAX_ENTRIES];
+    map_schema_match(map, compiled->schema, compiled, found);
+    return map_schema_check(compiled->schema, found, values);
+}
+
+GgError gg_map_validate(GgMap map, GgMapSchema schema) {
+    if (schema.entry_count <= GG_MAP_SCHEMA_MAX_ENTRIES) {
+        GgMapCompiledSchema compiled;
+        GgError ret = gg_map_schema_compile(schema, &compiled);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+        GgObject *found[GG_MAP_SCHEMA_MAX_ENTRIES];
+        map_schema_match(map, schema, &compiled, found);
+        return map_schema_check(schema, found, NULL);
+    }
+
+    for (size_t i = 0; i < schema.entry_count; i++) {
+        const GgMapSchemaEntry *entry = &schema.entries[i];
+        GgObject *value = NULL;
+        (void) gg_map_get(map, entry->key, &value);
+        GgError ret = map_schema_check_entry(entry, value);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
         if (entry->value != NULL) {
             *entry->value = value;
         }
     }
-
     return GG_ERR_OK;
 }
+
+#define MAP_SCHEMA_CACHE_EMPTY 0U
+#define MAP_SCHEMA_CACHE_BUSY 1U
+#define MAP_SCHEMA_CACHE_READY 2U
+
+GgError gg_map_validate_cached(
+    GgMapSchemaCache *cache, GgMap map, GgMapSchema schema
+) {
+    if (schema.entry_count > GG_MAP_SCHEMA_MAX_ENTRIES) {
+        return gg_map_validate(map, schema);
+    }
+
+    GgObject *found[GG_MAP_SCHEMA_MAX_ENTRIES];
+
+    uint32_t state = __atomic_load_n(&cache->state, __ATOMIC_ACQUIRE);
+    if (state == MAP_SCHEMA_CACHE_READY) {
+        assert(cache->compiled.schema.entry_count == schema.entry_count);
+        map_schema_match(map, schema, &cache->compiled, found);
+        return map_schema_check(schema, found, NULL);
+    }
+
+    GgMapCompiledSchema compiled;
+    GgError ret = gg_map_schema_compile(schema, &compiled);
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    // First caller publishes its compiled schema; concurrent first callers
+    // use their own copy rather than waiting.
+    uint32_t expected = MAP_SCHEMA_CACHE_EMPTY;
+    if (__atomic_compare_exchange_n(
+            &cache->state,
+            &expected,
+            MAP_SCHEMA_CACHE_BUSY,
+            false,
+            __ATOMIC_ACQUIRE,
+            __ATOMIC_RELAXED
+        )) {
+        cache->compiled = compiled;
+        // Entries belong to the first call; later calls pass their own
+        cache->compiled.schema.entries = NULL;
+        __atomic_store_n(
+            &cache->state, MAP_SCHEMA_CACHE_READY, __ATOMIC_RELEASE
+        );
+    }
+
+    map_schema_match(map, schema, &compiled, found);
+    return map_schema_check(schema, found, NULL);
+}
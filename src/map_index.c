@@ -0,0 +1,175 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <assert.h>
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/hash.h>
+#include <gg/list.h>
+#include <gg/log_priv.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// Hashes a key together with the pairs array of the map containing it, so
+/// one table can hold the keys of every nested map.
+static size_t map_index_hash(const GgKV *pairs, GgBuffer key) {
+    uint64_t seed = (uint64_t) (uintptr_t) pairs * 0x9E3779B97F4A7C15U;
+    uint64_t hash = gg_fnv1a(key, seed);
+    return (size_t) (hash ^ (hash >> 32));
+}
+
+/// Counts the keys of the maps in `obj`, including maps nested in lists.
+// NOLINTNEXTLINE(misc-no-recursion)
+static GgError map_index_count(GgObject obj, size_t depth_left, size_t *count) {
+    GgObjectType type = gg_obj_type(obj);
+    if ((type != GG_TYPE_MAP) && (type != GG_TYPE_LIST)) {
+        return GG_ERR_OK;
+    }
+    if (depth_left == 0) {
+        GG_LOGE("Map exceeds maximum object depth when building index.");
+        return GG_ERR_RANGE;
+    }
+
+    if (type == GG_TYPE_LIST) {
+        GG_LIST_FOREACH (item, gg_obj_into_list(obj)) {
+            GgError ret = map_index_count(*item, depth_left - 1, count);
+            if (ret != GG_ERR_OK) {
+                return ret;
+            }
+        }
+        return GG_ERR_OK;
+    }
+
+    GgMap map = gg_obj_into_map(obj);
+    *count += map.len;
+    GG_MAP_FOREACH (pair, map) {
+        GgError ret = map_index_count(*gg_kv_val(pair), depth_left - 1, count);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+    }
+    return GG_ERR_OK;
+}
+
+static void map_index_insert(GgMapIndex *index, const GgKV *pairs, GgKV *kv) {
+    GgBuffer key = gg_kv_key(*kv);
+    size_t slot = map_index_hash(pairs, key) & index->slot_mask;
+    while (index->slots[slot].kv != NULL) {
+        if ((index->slots[slot].pairs == pairs)
+            && gg_buffer_eq(gg_kv_key(*index->slots[slot].kv), key)) {
+            // Keep the first pair for duplicate keys, as gg_map_get does
+            return;
+        }
+        slot = (slot + 1) & index->slot_mask;
+    }
+    index->slots[slot] = (GgMapIndexSlot) { .pairs = pairs, .kv = kv };
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+static void map_index_insert_obj(GgMapIndex *index, GgObject obj) {
+    GgObjectType type = gg_obj_type(obj);
+    if (type == GG_TYPE_LIST) {
+        GG_LIST_FOREACH (item, gg_obj_into_list(obj)) {
+            map_index_insert_obj(index, *item);
+        }
+    } else if (type == GG_TYPE_MAP) {
+        GgMap map = gg_obj_into_map(obj);
+        GG_MAP_FOREACH (pair, map) {
+            map_index_insert(index, map.pairs, pair);
+            map_index_insert_obj(index, *gg_kv_val(pair));
+        }
+    }
+}
+
+GgError gg_map_index_build(GgMap map, GgArena *arena, GgMapIndex *index) {
+    size_t count = 0;
+    GgError ret = map_index_count(
+        gg_obj_map(map), gg_obj_get_limits().max_depth, &count
+    );
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    // Keep load factor at most 1/2 so probe sequences stay short
+    size_t capacity = 1;
+    while (capacity < count * 2) {
+        if (capacity > (SIZE_MAX / sizeof(GgMapIndexSlot)) / 2) {
+            return GG_ERR_NOMEM;
+        }
+        capacity *= 2;
+    }
+
+    GgMapIndexSlot *slots = GG_ARENA_ALLOCN(arena, GgMapIndexSlot, capacity);
+    if (slots == NULL) {
+        GG_LOGE("Insufficient memory to build map index.");
+        return GG_ERR_NOMEM;
+    }
+    for (size_t i = 0; i < capacity; i++) {
+        slots[i] = (GgMapIndexSlot) { 0 };
+    }
+
+    *index = (GgMapIndex) {
+        .map = map,
+        .slots = slots,
+        .slot_mask = capacity - 1,
+    };
+    map_index_insert_obj(index, gg_obj_map(map));
+    return GG_ERR_OK;
+}
+
+GgKV *gg_map_index_find(const GgMapIndex *index, GgMap map, GgBuffer key) {
+    assert(index->slots != NULL);
+
+    size_t slot = map_index_hash(map.pairs, key) & index->slot_mask;
+    while (index->slots[slot].kv != NULL) {
+        const GgMapIndexSlot *entry = &index->slots[slot];
+        // Bounds check guards against lookups in a prefix of an indexed map
+        if ((entry->pairs == map.pairs)
+            && (entry->kv < &map.pairs[map.len])
+            && gg_buffer_eq(gg_kv_key(*entry->kv), key)) {
+            return entry->kv;
+        }
+        slot = (slot + 1) & index->slot_mask;
+    }
+    return NULL;
+}
+
+bool gg_map_index_get(
+    const GgMapIndex *index, GgBuffer key, GgObject **result
+) {
+    GgKV *kv = gg_map_index_find(index, index->map, key);
+    if (result != NULL) {
+        *result = (kv == NULL) ? NULL : gg_kv_val(kv);
+    }
+    return kv != NULL;
+}
+
+bool gg_map_index_get_path(
+    const GgMapIndex *index, GgBufList path, GgObject **result
+) {
+    assert(path.len >= 1);
+
+    GgMap current = index->map;
+    for (size_t i = 0; i < path.len - 1; i++) {
+        GgKV *kv = gg_map_index_find(index, current, path.bufs[i]);
+        if (kv == NULL) {
+            return false;
+        }
+        GgObject *item = gg_kv_val(kv);
+        if (gg_obj_type(*item) != GG_TYPE_MAP) {
+            return false;
+        }
+        current = gg_obj_into_map(*item);
+    }
+
+    GgKV *kv = gg_map_index_find(index, current, path.bufs[path.len - 1]);
+    if (result != NULL) {
+        *result = (kv == NULL) ? NULL : gg_kv_val(kv);
+    }
+    return kv != NULL;
+}
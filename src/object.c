@@ -2,16 +2,24 @@
 // Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
 // SPDX-License-Identifier: Apache-2.0
 
+// Accessor definitions live in gg/object.h; this file emits the external
+// definitions exported by the library.
+#ifndef GG_INLINE_ACCESSORS
+#define GG_INLINE_ACCESSORS
+#endif
+
 #include <assert.h>
 #include <gg/attr.h>
 #include <gg/buffer.h>
 #include <gg/error.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/object.h>
 #include <gg/object_visit.h>
 #include <string.h>
 #include <stdalign.h>
+#include <stdatomic.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 static_assert(
@@ -24,12 +32,15 @@ static_assert(
     "Only 32 or 64-bit platforms are supported."
 );
 
-GgObjectType gg_obj_type(GgObject obj) {
-    // Last byte is tag
-    uint8_t result = obj._private[sizeof(obj._private) - 1];
-    assert(result <= 6);
-    return (GgObjectType) result;
-}
+extern inline GgObjectType gg_obj_type(GgObject obj);
+extern inline bool gg_obj_into_bool(GgObject boolean);
+extern inline int64_t gg_obj_into_i64(GgObject i64);
+extern inline double gg_obj_into_f64(GgObject f64);
+extern inline GgBuffer gg_obj_into_buf(GgObject buf);
+extern inline GgMap gg_obj_into_map(GgObject map);
+extern inline GgList gg_obj_into_list(GgObject list);
+extern inline GgF64Array gg_obj_into_f64_array(GgObject f64_array);
+extern inline GgI64Array gg_obj_into_i64_array(GgObject i64_array);
 
 GgObject gg_obj_bool(bool value) {
     GgObject result = { 0 };
@@ -42,13 +53,6 @@ GgObject gg_obj_bool(bool value) {
     return result;
 }
 
-bool gg_obj_into_bool(GgObject boolean) {
-    assert(gg_obj_type(boolean) == GG_TYPE_BOOLEAN);
-    bool result;
-    memcpy(&result, boolean._private, sizeof(result));
-    return result;
-}
-
 GgObject gg_obj_i64(int64_t value) {
     GgObject result = { 0 };
     static_assert(
@@ -60,13 +64,6 @@ GgObject gg_obj_i64(int64_t value) {
     return result;
 }
 
-int64_t gg_obj_into_i64(GgObject i64) {
-    assert(gg_obj_type(i64) == GG_TYPE_I64);
-    int64_t result;
-    memcpy(&result, i64._private, sizeof(result));
-    return result;
-}
-
 GgObject gg_obj_f64(double value) {
     GgObject result = { 0 };
     static_assert(
@@ -78,13 +75,6 @@ GgObject gg_obj_f64(double value) {
     return result;
 }
 
-double gg_obj_into_f64(GgObject f64) {
-    assert(gg_obj_type(f64) == GG_TYPE_F64);
-    double result;
-    memcpy(&result, f64._private, sizeof(result));
-    return result;
-}
-
 COLD
 static void length_err(const char *type, size_t *len) {
     GG_LOGE(
@@ -114,15 +104,6 @@ GgObject gg_obj_buf(GgBuffer value) {
     return result;
 }
 
-GgBuffer gg_obj_into_buf(GgObject buf) {
-    assert(gg_obj_type(buf) == GG_TYPE_BUF);
-    void *ptr;
-    uint16_t len;
-    memcpy(&ptr, buf._private, sizeof(void *));
-    memcpy(&len, &buf._private[sizeof(void *)], 2);
-    return (GgBuffer) { .data = ptr, .len = len };
-}
-
 GgObject gg_obj_map(GgMap value) {
     if (value.len > UINT16_MAX) {
         length_err("GgMap", &value.len);
@@ -140,15 +121,6 @@ GgObject gg_obj_map(GgMap value) {
     return result;
 }
 
-GgMap gg_obj_into_map(GgObject map) {
-    assert(gg_obj_type(map) == GG_TYPE_MAP);
-    void *ptr;
-    uint16_t len;
-    memcpy(&ptr, map._private, sizeof(void *));
-    memcpy(&len, &map._private[sizeof(void *)], 2);
-    return (GgMap) { .pairs = ptr, .len = len };
-}
-
 GgObject gg_obj_list(GgList value) {
     if (value.len > UINT16_MAX) {
         length_err("GgList", &value.len);
@@ -166,13 +138,61 @@ GgObject gg_obj_list(GgList value) {
     return result;
 }
 
-GgList gg_obj_into_list(GgObject list) {
-    assert(gg_obj_type(list) == GG_TYPE_LIST);
-    void *ptr;
-    uint16_t len;
-    memcpy(&ptr, list._private, sizeof(void *));
-    memcpy(&len, &list._private[sizeof(void *)], 2);
-    return (GgList) { .items = ptr, .len = len };
+GgObject gg_obj_f64_array(GgF64Array value) {
+    if (value.len > UINT16_MAX) {
+        length_err("GgF64Array", &value.len);
+    }
+    uint16_t len = (uint16_t) value.len;
+
+    GgObject result = { 0 };
+    memcpy(result._private, &value.items, sizeof(void *));
+    memcpy(&result._private[sizeof(void *)], &len, sizeof(len));
+    result._private[sizeof(result._private) - 1] = GG_TYPE_F64_ARRAY;
+    return result;
+}
+
+GgObject gg_obj_i64_array(GgI64Array value) {
+    if (value.len > UINT16_MAX) {
+        length_err("GgI64Array", &value.len);
+    }
+    uint16_t len = (uint16_t) value.len;
+
+    GgObject result = { 0 };
+    memcpy(result._private, &value.items, sizeof(void *));
+    memcpy(&result._private[sizeof(void *)], &len, sizeof(len));
+    result._private[sizeof(result._private) - 1] = GG_TYPE_I64_ARRAY;
+    return result;
+}
+
+static atomic_uint_least16_t obj_max_depth = GG_MAX_OBJECT_DEPTH;
+static atomic_size_t obj_max_subobjects = GG_MAX_OBJECT_SUBOBJECTS;
+
+GgObjectLimits gg_obj_get_limits(void) {
+    return (GgObjectLimits) {
+        .max_depth = (uint16_t) atomic_load_explicit(
+            &obj_max_depth, memory_order_relaxed
+        ),
+        .max_subobjects
+        = atomic_load_explicit(&obj_max_subobjects, memory_order_relaxed),
+    };
+}
+
+GgError gg_obj_set_limits(GgObjectLimits limits) {
+    if ((limits.max_depth == 0) || (limits.max_depth > GG_MAX_OBJECT_DEPTH)) {
+        GG_LOGE(
+            "Object depth limit must be between 1 and %u.",
+            (unsigned) GG_MAX_OBJECT_DEPTH
+        );
+        return GG_ERR_RANGE;
+    }
+
+    atomic_store_explicit(
+        &obj_max_depth, limits.max_depth, memory_order_relaxed
+    );
+    atomic_store_explicit(
+        &obj_max_subobjects, limits.max_subobjects, memory_order_relaxed
+    );
+    return GG_ERR_OK;
 }
 
 static GgError mem_usage_buf(void *ctx, GgBuffer val, GgObject obj[static 1]) {
@@ -198,6 +218,26 @@ static GgError mem_usage_map(void *ctx, GgMap val, GgObject obj[static 1]) {
     return GG_ERR_OK;
 }
 
+static GgError mem_usage_f64_array(
+    void *ctx, GgF64Array val, GgObject obj[static 1]
+) {
+    (void) obj;
+    size_t *measured = ctx;
+    // Include worst-case alignment padding
+    *measured += (val.len * sizeof(double)) + alignof(double) - 1;
+    return GG_ERR_OK;
+}
+
+static GgError mem_usage_i64_array(
+    void *ctx, GgI64Array val, GgObject obj[static 1]
+) {
+    (void) obj;
+    size_t *measured = ctx;
+    // Include worst-case alignment padding
+    *measured += (val.len * sizeof(int64_t)) + alignof(int64_t) - 1;
+    return GG_ERR_OK;
+}
+
 static GgError mem_usage_map_key(void *ctx, GgBuffer key, GgKV kv[static 1]) {
     (void) kv;
     size_t *measured = ctx;
@@ -211,6 +251,8 @@ GgError gg_obj_mem_usage(GgObject obj, size_t *size) {
         .on_map_key = mem_usage_map_key,
         .on_map = mem_usage_map,
         .on_list = mem_usage_list,
+        .on_f64_array = mem_usage_f64_array,
+        .on_i64_array = mem_usage_i64_array,
     };
 
     size_t measured = 0;
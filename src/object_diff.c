@@ -0,0 +1,220 @@
+// aws-greengrass-component-sdk - Lightweight AWS IoT Greengrass SDK
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/log_priv.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+static bool mem_eq(const void *a, const void *b, size_t len) {
+    return (len == 0) || (memcmp(a, b, len) == 0);
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+static bool obj_eq(GgObject a, GgObject b, size_t depth_left) {
+    GgObjectType type = gg_obj_type(a);
+    if (type != gg_obj_type(b)) {
+        return false;
+    }
+
+    switch (type) {
+    case GG_TYPE_NULL:
+        return true;
+    case GG_TYPE_BOOLEAN:
+        return gg_obj_into_bool(a) == gg_obj_into_bool(b);
+    case GG_TYPE_I64:
+        return gg_obj_into_i64(a) == gg_obj_into_i64(b);
+    case GG_TYPE_F64: {
+        // Compare representations so NaN values are not always changed
+        double a_val = gg_obj_into_f64(a);
+        double b_val = gg_obj_into_f64(b);
+        return memcmp(&a_val, &b_val, sizeof(double)) == 0;
+    }
+    case GG_TYPE_BUF:
+        return gg_buffer_eq(gg_obj_into_buf(a), gg_obj_into_buf(b));
+    case GG_TYPE_LIST: {
+        GgList a_list = gg_obj_into_list(a);
+        GgList b_list = gg_obj_into_list(b);
+        if ((a_list.len != b_list.len) || (depth_left == 0)) {
+            return false;
+        }
+        for (size_t i = 0; i < a_list.len; i++) {
+            if (!obj_eq(a_list.items[i], b_list.items[i], depth_left - 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    case GG_TYPE_F64_ARRAY: {
+        GgF64Array a_arr = gg_obj_into_f64_array(a);
+        GgF64Array b_arr = gg_obj_into_f64_array(b);
+        return (a_arr.len == b_arr.len)
+            && mem_eq(a_arr.items, b_arr.items, a_arr.len * sizeof(double));
+    }
+    case GG_TYPE_I64_ARRAY: {
+        GgI64Array a_arr = gg_obj_into_i64_array(a);
+        GgI64Array b_arr = gg_obj_into_i64_array(b);
+        return (a_arr.len == b_arr.len)
+            && mem_eq(a_arr.items, b_arr.items, a_arr.len * sizeof(int64_t));
+    }
+    case GG_TYPE_MAP: {
+        GgMap a_map = gg_obj_into_map(a);
+        GgMap b_map = gg_obj_into_map(b);
+        if ((a_map.len != b_map.len) || (depth_left == 0)) {
+            return false;
+        }
+        GG_MAP_FOREACH (pair, a_map) {
+            GgObject *b_val;
+            if (!gg_map_get(b_map, gg_kv_key(*pair), &b_val)
+                || !obj_eq(*gg_kv_val(pair), *b_val, depth_left - 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    }
+
+    return false;
+}
+
+bool gg_obj_eq(GgObject a, GgObject b) {
+    return obj_eq(a, b, gg_obj_get_limits().max_depth);
+}
+
+static bool merge_changes_map(GgMap old_map, GgMap new_map, size_t depth_left);
+
+/// Whether merging `new_val` over `old_val` (NULL if absent) changes it.
+// NOLINTNEXTLINE(misc-no-recursion)
+static bool merge_changes(
+    GgObject *old_val, GgObject new_val, size_t depth_left
+) {
+    if (old_val == NULL) {
+        return true;
+    }
+    if ((gg_obj_type(*old_val) == GG_TYPE_MAP)
+        && (gg_obj_type(new_val) == GG_TYPE_MAP)) {
+        return merge_changes_map(
+            gg_obj_into_map(*old_val), gg_obj_into_map(new_val), depth_left
+        );
+    }
+    return !obj_eq(*old_val, new_val, depth_left);
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+static bool merge_changes_map(GgMap old_map, GgMap new_map, size_t depth_left) {
+    if (depth_left == 0) {
+        return true;
+    }
+    GG_MAP_FOREACH (pair, new_map) {
+        GgObject *old_val = NULL;
+        (void) gg_map_get(old_map, gg_kv_key(*pair), &old_val);
+        if (merge_changes(old_val, *gg_kv_val(pair), depth_left - 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+static GgError map_diff(
+    GgMap old_map,
+    GgMap new_map,
+    GgArena *arena,
+    size_t depth_left,
+    GgMap *diff
+) {
+    if (depth_left == 0) {
+        GG_LOGE("Map exceeds maximum object depth when computing diff.");
+        return GG_ERR_RANGE;
+    }
+
+    size_t count = 0;
+    GG_MAP_FOREACH (pair, new_map) {
+        GgObject *old_val = NULL;
+        (void) gg_map_get(old_map, gg_kv_key(*pair), &old_val);
+        if (merge_changes(old_val, *gg_kv_val(pair), depth_left - 1)) {
+            count += 1;
+        }
+    }
+
+    *diff = (GgMap) { 0 };
+    if (count == 0) {
+        return GG_ERR_OK;
+    }
+
+    GgKV *pairs = GG_ARENA_ALLOCN(arena, GgKV, count);
+    if (pairs == NULL) {
+        GG_LOGE("Insufficient memory to compute object diff.");
+        return GG_ERR_NOMEM;
+    }
+
+    size_t idx = 0;
+    GG_MAP_FOREACH (pair, new_map) {
+        GgBuffer key = gg_kv_key(*pair);
+        GgObject new_val = *gg_kv_val(pair);
+        GgObject *old_val = NULL;
+        (void) gg_map_get(old_map, key, &old_val);
+
+        if ((old_val != NULL) && (gg_obj_type(*old_val) == GG_TYPE_MAP)
+            && (gg_obj_type(new_val) == GG_TYPE_MAP)) {
+            GgMap sub_diff;
+            GgError ret = map_diff(
+                gg_obj_into_map(*old_val),
+                gg_obj_into_map(new_val),
+                arena,
+                depth_left - 1,
+                &sub_diff
+            );
+            if (ret != GG_ERR_OK) {
+                return ret;
+            }
+            if (sub_diff.len != 0) {
+                pairs[idx] = gg_kv(key, gg_obj_map(sub_diff));
+                idx += 1;
+            }
+        } else if ((old_val == NULL)
+                   || !obj_eq(*old_val, new_val, depth_left - 1)) {
+            pairs[idx] = gg_kv(key, new_val);
+            idx += 1;
+        }
+    }
+
+    *diff = (GgMap) { .pairs = pairs, .len = idx };
+    return GG_ERR_OK;
+}
+
+GgError gg_obj_diff(
+    GgObject old_obj, GgObject new_obj, GgArena *arena, GgObject *diff
+) {
+    if (gg_obj_type(new_obj) != GG_TYPE_MAP) {
+        GG_LOGE("Object diff requires a map as the new object.");
+        return GG_ERR_INVALID;
+    }
+
+    GgMap old_map = { 0 };
+    if (gg_obj_type(old_obj) == GG_TYPE_MAP) {
+        old_map = gg_obj_into_map(old_obj);
+    }
+
+    GgMap result;
+    GgError ret = map_diff(
+        old_map,
+        gg_obj_into_map(new_obj),
+        arena,
+        gg_obj_get_limits().max_depth,
+        &result
+    );
+    if (ret != GG_ERR_OK) {
+        return ret;
+    }
+
+    *diff = gg_obj_map(result);
+    return GG_ERR_OK;
+}
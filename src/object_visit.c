@@ -4,7 +4,7 @@
 
 #include <assert.h>
 #include <gg/error.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <gg/object_iter.h>
@@ -14,12 +14,8 @@
 #include <stdint.h>
 
 static_assert(
-    GG_MAX_OBJECT_DEPTH <= UINT8_MAX,
-    "GG_MAX_OBJECT_DEPTH must fit in a uint8_t."
-);
-static_assert(
-    GG_MAX_OBJECT_SUBOBJECTS <= UINT8_MAX,
-    "GG_MAX_OBJECT_SUBOBJECTS must fit in a uint8_t."
+    GG_MAX_OBJECT_DEPTH <= UINT16_MAX,
+    "GG_MAX_OBJECT_DEPTH must fit in a uint16_t."
 );
 
 #define TRY_HANDLER(name, ...) \
@@ -36,6 +32,9 @@ GgError gg_obj_visit(
     void *ctx,
     GgObject obj[static 1]
 ) {
+    GgObjectLimits limits = gg_obj_get_limits();
+    assert(limits.max_depth <= GG_MAX_OBJECT_DEPTH);
+
     IterLevels state;
 
     state.index = 0;
@@ -43,12 +42,12 @@ GgError gg_obj_visit(
     state.state[0] = LEVEL_DEFAULT;
     state.elem_index[0] = 0;
 
-    uint8_t subobjects = 0;
+    size_t subobjects = 0;
 
     while (true) {
         GgObject *cur_obj = state.obj[state.index];
         IterLevelState cur_state = state.state[state.index];
-        uint8_t cur_index = state.elem_index[state.index];
+        size_t cur_index = state.elem_index[state.index];
 
         switch (cur_state) {
         case LEVEL_DEFAULT: {
@@ -70,11 +69,11 @@ GgError gg_obj_visit(
                 break;
             case GG_TYPE_LIST: {
                 GgList list = gg_obj_into_list(*cur_obj);
-                if (list.len > GG_MAX_OBJECT_SUBOBJECTS - subobjects) {
+                if (list.len > limits.max_subobjects - subobjects) {
                     GG_LOGE("Visited object's subobjects exceeds maximum.");
                     return GG_ERR_RANGE;
                 }
-                subobjects += (uint8_t) list.len;
+                subobjects += list.len;
 
                 TRY_HANDLER(on_list, ctx, list, cur_obj);
                 state.state[state.index] = LEVEL_LIST;
@@ -82,16 +81,32 @@ GgError gg_obj_visit(
             }
             case GG_TYPE_MAP: {
                 GgMap map = gg_obj_into_map(*cur_obj);
-                if (map.len > (GG_MAX_OBJECT_SUBOBJECTS - subobjects) / 2) {
+                if (map.len > (limits.max_subobjects - subobjects) / 2) {
                     GG_LOGE("Visited object's subobjects exceeds maximum.");
                     return GG_ERR_RANGE;
                 }
-                subobjects += (uint8_t) (map.len * 2);
+                subobjects += map.len * 2;
 
                 TRY_HANDLER(on_map, ctx, gg_obj_into_map(*cur_obj), cur_obj);
                 state.state[state.index] = LEVEL_MAP;
                 continue;
             }
+            case GG_TYPE_F64_ARRAY:
+                TRY_HANDLER(
+                    on_f64_array,
+                    ctx,
+                    gg_obj_into_f64_array(*cur_obj),
+                    cur_obj
+                );
+                break;
+            case GG_TYPE_I64_ARRAY:
+                TRY_HANDLER(
+                    on_i64_array,
+                    ctx,
+                    gg_obj_into_i64_array(*cur_obj),
+                    cur_obj
+                );
+                break;
             }
         } break;
         case LEVEL_LIST: {
@@ -106,7 +121,7 @@ GgError gg_obj_visit(
             }
 
             state.index += 1;
-            if (state.index == GG_MAX_OBJECT_DEPTH) {
+            if (state.index >= limits.max_depth) {
                 GG_LOGE("Visited object's depth exceeds maximum.");
                 return GG_ERR_RANGE;
             }
@@ -133,7 +148,7 @@ GgError gg_obj_visit(
             TRY_HANDLER(on_map_key, ctx, gg_kv_key(*kv), kv);
 
             state.index += 1;
-            if (state.index == GG_MAX_OBJECT_DEPTH) {
+            if (state.index >= limits.max_depth) {
                 GG_LOGE("Visited object's depth exceeds maximum.");
                 return GG_ERR_RANGE;
             }
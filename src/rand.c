@@ -8,7 +8,7 @@
 #include <gg/buffer.h>
 #include <gg/error.h>
 #include <gg/file.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <stdlib.h>
 
 static int random_fd;
@@ -4,7 +4,7 @@
 
 #include <errno.h>
 #include <gg/error.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/utils.h>
 #include <time.h>
 #include <stdint.h>
@@ -3,28 +3,132 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <errno.h>
+#include <fcntl.h>
 #include <gg/buffer.h>
 #include <gg/cleanup.h>
 #include <gg/error.h>
 #include <gg/file.h>
 #include <gg/io.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/socket.h>
+#include <poll.h>
 #include <string.h>
 #include <sys/socket.h>
-#include <sys/time.h>
 #include <sys/un.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// Time to wait for a socket to become ready before failing.
+/// To prevent deadlocking on hanged server.
+#define SOCKET_TIMEOUT_MS 5000
+
+/// Wait until `fd` is ready for `events`.
+static GgError socket_wait(int fd, short events) {
+    struct pollfd pfd = { .fd = fd, .events = events };
+    while (true) {
+        int ret = poll(&pfd, 1, SOCKET_TIMEOUT_MS);
+        if (ret > 0) {
+            // Errors and hangups are reported by the next read or write
+            return GG_ERR_OK;
+        }
+        if (ret == 0) {
+            GG_LOGE("Timed out waiting on socket %d.", fd);
+            return GG_ERR_TIMEOUT;
+        }
+        if (errno != EINTR) {
+            GG_LOGE("Failed to poll socket %d: %d.", fd, errno);
+            return GG_ERR_FAILURE;
+        }
+    }
+}
+
+/// Read into `buf` until it is full, the peer closes the socket, or the read
+/// would block. Returns GG_ERR_BUSY if the read would block.
+static GgError socket_read_available(int fd, GgBuffer *buf) {
+    while (buf->len > 0) {
+        ssize_t ret = read(fd, buf->data, buf->len);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+                return GG_ERR_BUSY;
+            }
+            if (errno == ECONNRESET) {
+                GG_LOGW("Peer closed %d with written data pending.", fd);
+                return GG_ERR_NODATA;
+            }
+            GG_LOGE("Failed to read fd %d: %d.", fd, errno);
+            return GG_ERR_FAILURE;
+        }
+        if (ret == 0) {
+            return GG_ERR_NODATA;
+        }
+        *buf = gg_buffer_substr(*buf, (size_t) ret, SIZE_MAX);
+    }
+    return GG_ERR_OK;
+}
+
+/// Read into `buf` until it is full or the peer closes the socket.
+/// On return, `buf` is the unfilled remainder.
+static GgError socket_read_fill(int fd, GgBuffer *buf) {
+    while (true) {
+        GgError ret = socket_read_available(fd, buf);
+        if (ret != GG_ERR_BUSY) {
+            return ret;
+        }
+        ret = socket_wait(fd, POLLIN);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+    }
+}
 
 GgError gg_socket_read(int fd, GgBuffer buf) {
-    GgError ret = gg_file_read_exact(fd, buf);
+    GgBuffer rest = buf;
+    GgError ret = socket_read_fill(fd, &rest);
     if (ret == GG_ERR_NODATA) {
         GG_LOGD("Socket %d closed by peer.", fd);
     }
     return ret;
 }
 
+GgError gg_socket_write_partial(int fd, GgBuffer *buf) {
+    while (buf->len > 0) {
+        ssize_t ret = write(fd, buf->data, buf->len);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+                return GG_ERR_OK;
+            }
+            if ((errno == EPIPE) || (errno == ECONNRESET)) {
+                GG_LOGE("Write failed to %d; peer closed connection.", fd);
+                return GG_ERR_NOCONN;
+            }
+            GG_LOGE("Failed to write to fd %d: %d.", fd, errno);
+            return GG_ERR_FAILURE;
+        }
+        *buf = gg_buffer_substr(*buf, (size_t) ret, SIZE_MAX);
+    }
+    return GG_ERR_OK;
+}
+
 GgError gg_socket_write(int fd, GgBuffer buf) {
-    return gg_file_write(fd, buf);
+    GgBuffer rest = buf;
+    while (true) {
+        GgError ret = gg_socket_write_partial(fd, &rest);
+        if ((ret != GG_ERR_OK) || (rest.len == 0)) {
+            return ret;
+        }
+        ret = socket_wait(fd, POLLOUT);
+        if (ret != GG_ERR_OK) {
+            return ret;
+        }
+    }
 }
 
 GgError gg_connect(GgBuffer path, int *fd) {
@@ -55,20 +159,10 @@ GgError gg_connect(GgBuffer path, int *fd) {
         return GG_ERR_FAILURE;
     }
 
-    // To prevent deadlocking on hanged server, add a timeout
-    struct timeval timeout = { .tv_sec = 5 };
-    int sys_ret = setsockopt(
-        sockfd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)
-    );
-    if (sys_ret == -1) {
-        GG_LOGE("Failed to set receive timeout on socket: %d.", errno);
-        return GG_ERR_FATAL;
-    }
-    sys_ret = setsockopt(
-        sockfd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)
-    );
-    if (sys_ret == -1) {
-        GG_LOGE("Failed to set send timeout on socket: %d.", errno);
+    // Blocking waits are bounded by SOCKET_TIMEOUT_MS in socket_wait
+    int flags = fcntl(sockfd, F_GETFL);
+    if ((flags == -1) || (fcntl(sockfd, F_SETFL, flags | O_NONBLOCK) == -1)) {
+        GG_LOGE("Failed to set socket non-blocking: %d.", errno);
         return GG_ERR_FATAL;
     }
 
@@ -79,7 +173,13 @@ GgError gg_connect(GgBuffer path, int *fd) {
 
 static GgError socket_reader_fn(void *ctx, GgBuffer *buf) {
     int *fd = ctx;
-    return gg_file_read(*fd, buf);
+    GgBuffer rest = *buf;
+    GgError ret = socket_read_fill(*fd, &rest);
+    if (ret == GG_ERR_NODATA) {
+        ret = GG_ERR_OK;
+    }
+    buf->len = (size_t) (rest.data - buf->data);
+    return ret;
 }
 
 GgReader gg_socket_reader(int *fd) {
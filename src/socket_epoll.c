@@ -5,7 +5,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <gg/error.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/socket_epoll.h>
 #include <sys/epoll.h>
 #include <unistd.h>
@@ -24,11 +24,13 @@ GgError gg_socket_epoll_create(int *epoll_fd) {
     return GG_ERR_OK;
 }
 
-GgError gg_socket_epoll_add(int epoll_fd, int target_fd, uint64_t data) {
+GgError gg_socket_epoll_add(
+    int epoll_fd, int target_fd, uint32_t events, uint64_t data
+) {
     assert(epoll_fd >= 0);
     assert(target_fd >= 0);
 
-    struct epoll_event event = { .events = EPOLLIN, .data = { .u64 = data } };
+    struct epoll_event event = { .events = events, .data = { .u64 = data } };
 
     int err = epoll_ctl(epoll_fd, EPOLL_CTL_ADD, target_fd, &event);
     if (err == -1) {
@@ -39,8 +41,27 @@ GgError gg_socket_epoll_add(int epoll_fd, int target_fd, uint64_t data) {
     return GG_ERR_OK;
 }
 
+GgError gg_socket_epoll_mod(
+    int epoll_fd, int target_fd, uint32_t events, uint64_t data
+) {
+    assert(epoll_fd >= 0);
+    assert(target_fd >= 0);
+
+    struct epoll_event event = { .events = events, .data = { .u64 = data } };
+
+    int err = epoll_ctl(epoll_fd, EPOLL_CTL_MOD, target_fd, &event);
+    if (err == -1) {
+        err = errno;
+        GG_LOGE("Failed to modify watch for %d: %d.", target_fd, err);
+        return GG_ERR_FAILURE;
+    }
+    return GG_ERR_OK;
+}
+
 GgError gg_socket_epoll_run(
-    int epoll_fd, GgError (*fd_ready)(void *ctx, uint64_t data), void *ctx
+    int epoll_fd,
+    GgError (*fd_ready)(void *ctx, uint64_t data, uint32_t events),
+    void *ctx
 ) {
     assert(epoll_fd >= 0);
     assert(fd_ready != NULL);
@@ -67,7 +88,7 @@ GgError gg_socket_epoll_run(
 
         for (int i = 0; i < ready; i++) {
             GG_LOGD("Calling epoll callback on thread %d.", tid);
-            GgError ret = fd_ready(ctx, events[i].data.u64);
+            GgError ret = fd_ready(ctx, events[i].data.u64, events[i].events);
             if (ret != GG_ERR_OK) {
                 return ret;
             }
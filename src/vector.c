@@ -6,7 +6,7 @@
 #include <gg/error.h>
 #include <gg/io.h>
 #include <gg/list.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/object.h>
 #include <gg/vector.h>
 #include <string.h>
@@ -0,0 +1,212 @@
+#include <gg/alloc.h>
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <gg/test.h>
+#include <stdlib.h>
+#include <unity.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+#define BLOCK_SIZE 64
+
+/// malloc-backed allocator counting live blocks.
+typedef struct {
+    size_t allocs;
+    size_t frees;
+    bool fail;
+} CountingAlloc;
+
+static void *counting_alloc(void *ctx, size_t size, size_t alignment) {
+    CountingAlloc *counts = ctx;
+    if (counts->fail) {
+        return NULL;
+    }
+    // aligned_alloc requires a multiple of the alignment
+    void *ptr = aligned_alloc(
+        alignment, (size + alignment - 1) & ~(alignment - 1)
+    );
+    TEST_ASSERT_NOT_NULL(ptr);
+    counts->allocs += 1;
+    return ptr;
+}
+
+static void counting_free(void *ctx, void *ptr) {
+    CountingAlloc *counts = ctx;
+    counts->frees += 1;
+    free(ptr);
+}
+
+static const GgAllocVtable COUNTING_VTABLE
+    = { .ALLOC = &counting_alloc, .FREE = &counting_free };
+
+static CountingAlloc counts;
+
+static GgArenaChain counting_chain(void) {
+    counts = (CountingAlloc) { 0 };
+    return gg_arena_chain_init(
+        (GgAlloc) { .VTABLE = &COUNTING_VTABLE, .ctx = &counts }, BLOCK_SIZE
+    );
+}
+
+static void free_chain(GgArenaChain *chain) {
+    gg_arena_chain_free(chain);
+    TEST_ASSERT_EQUAL(counts.allocs, counts.frees);
+    TEST_ASSERT_NULL(chain->first);
+}
+
+GG_TEST_DEFINE(arena_chain_grows_across_blocks) {
+    GgArenaChain chain = counting_chain();
+    GgArena arena = gg_arena_init_chained(&chain);
+    TEST_ASSERT_EQUAL(0, counts.allocs);
+
+    uint8_t *a = GG_ARENA_ALLOCN(&arena, uint8_t, BLOCK_SIZE);
+    uint8_t *b = GG_ARENA_ALLOCN(&arena, uint8_t, 1);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL(2, counts.allocs);
+    TEST_ASSERT_TRUE(gg_arena_owns(&arena, a));
+    TEST_ASSERT_TRUE(gg_arena_owns(&arena, &a[BLOCK_SIZE - 1]));
+    TEST_ASSERT_TRUE(gg_arena_owns(&arena, b));
+
+    // Larger than a block gets a block of its own size
+    uint8_t *big = GG_ARENA_ALLOCN(&arena, uint8_t, 4 * BLOCK_SIZE);
+    TEST_ASSERT_NOT_NULL(big);
+    TEST_ASSERT_EQUAL(3, counts.allocs);
+    TEST_ASSERT_TRUE(gg_arena_owns(&arena, &big[(4 * BLOCK_SIZE) - 1]));
+
+    // Alignment beyond the block alignment is padded
+    uint8_t *aligned = gg_arena_alloc(&arena, BLOCK_SIZE, 256);
+    TEST_ASSERT_NOT_NULL(aligned);
+    TEST_ASSERT_EQUAL(0, (uintptr_t) aligned % 256);
+
+    free_chain(&chain);
+}
+
+GG_TEST_DEFINE(arena_chain_restore_across_blocks) {
+    GgArenaChain chain = counting_chain();
+    GgArena arena = gg_arena_init_chained(&chain);
+
+    uint8_t *first = GG_ARENA_ALLOCN(&arena, uint8_t, BLOCK_SIZE / 2);
+    TEST_ASSERT_NOT_NULL(first);
+    GgArenaState in_first = gg_arena_save(&arena);
+
+    uint8_t *second = GG_ARENA_ALLOCN(&arena, uint8_t, BLOCK_SIZE);
+    GgArenaState in_second = gg_arena_save(&arena);
+    uint8_t *third = GG_ARENA_ALLOCN(&arena, uint8_t, BLOCK_SIZE);
+    TEST_ASSERT_NOT_NULL(second);
+    TEST_ASSERT_NOT_NULL(third);
+    TEST_ASSERT_EQUAL(3, counts.allocs);
+
+    // Restoring to a later block keeps earlier allocations
+    gg_arena_restore(&arena, in_second);
+    TEST_ASSERT_TRUE(gg_arena_owns(&arena, first));
+    TEST_ASSERT_TRUE(gg_arena_owns(&arena, second));
+    TEST_ASSERT_FALSE(gg_arena_owns(&arena, third));
+    TEST_ASSERT_EQUAL_PTR(third, GG_ARENA_ALLOCN(&arena, uint8_t, BLOCK_SIZE));
+    TEST_ASSERT_EQUAL(3, counts.allocs);
+
+    // Restoring to the first block releases the later blocks for reuse
+    gg_arena_restore(&arena, in_first);
+    TEST_ASSERT_TRUE(gg_arena_owns(&arena, first));
+    TEST_ASSERT_FALSE(gg_arena_owns(&arena, second));
+    TEST_ASSERT_FALSE(gg_arena_owns(&arena, third));
+
+    uint8_t *rest = GG_ARENA_ALLOCN(&arena, uint8_t, BLOCK_SIZE / 2);
+    TEST_ASSERT_EQUAL_PTR(&first[BLOCK_SIZE / 2], rest);
+    TEST_ASSERT_EQUAL_PTR(second, GG_ARENA_ALLOCN(&arena, uint8_t, 1));
+    TEST_ASSERT_EQUAL(3, counts.allocs);
+
+    free_chain(&chain);
+}
+
+GG_TEST_DEFINE(arena_chain_larger_alloc_after_restore) {
+    GgArenaChain chain = counting_chain();
+    GgArena arena = gg_arena_init_chained(&chain);
+
+    GgArenaState start = gg_arena_save(&arena);
+    uint8_t *small = GG_ARENA_ALLOCN(&arena, uint8_t, BLOCK_SIZE);
+    uint8_t *next = GG_ARENA_ALLOCN(&arena, uint8_t, BLOCK_SIZE);
+    TEST_ASSERT_NOT_NULL(small);
+    TEST_ASSERT_NOT_NULL(next);
+    TEST_ASSERT_EQUAL(2, counts.allocs);
+
+    // A retained block too small for an allocation is skipped, not freed
+    gg_arena_reset(&arena);
+    TEST_ASSERT_EQUAL_PTR(small, GG_ARENA_ALLOCN(&arena, uint8_t, 1));
+    uint8_t *big = GG_ARENA_ALLOCN(&arena, uint8_t, 2 * BLOCK_SIZE);
+    TEST_ASSERT_NOT_NULL(big);
+    TEST_ASSERT_EQUAL(3, counts.allocs);
+    TEST_ASSERT_EQUAL_PTR(next, GG_ARENA_ALLOCN(&arena, uint8_t, BLOCK_SIZE));
+    TEST_ASSERT_EQUAL(3, counts.allocs);
+
+    // Restoring a state saved before any block was allocated
+    gg_arena_restore(&arena, start);
+    TEST_ASSERT_FALSE(gg_arena_owns(&arena, small));
+    TEST_ASSERT_EQUAL_PTR(small, GG_ARENA_ALLOCN(&arena, uint8_t, 1));
+    TEST_ASSERT_EQUAL(3, counts.allocs);
+
+    free_chain(&chain);
+}
+
+GG_TEST_DEFINE(arena_chain_claim_obj_across_blocks) {
+    GgArenaChain chain = counting_chain();
+    GgArena arena = gg_arena_init_chained(&chain);
+    GgObject obj = gg_obj_map(GG_MAP(
+        gg_kv(
+            GG_STR("key"),
+            gg_obj_buf(GG_STR("a value that is longer than a single block "
+                              "of the chained arena"))
+        ),
+        gg_kv(GG_STR("list"), gg_obj_list(GG_LIST(gg_obj_i64(1))))
+    ));
+    GgObject expected = obj;
+
+    GgArenaState start = gg_arena_save(&arena);
+    GG_TEST_ASSERT_OK(gg_arena_claim_obj(&obj, &arena));
+    TEST_ASSERT_TRUE(counts.allocs > 1);
+    TEST_ASSERT_TRUE(gg_obj_eq(expected, obj));
+
+    // Already owned across blocks, so claiming again does not copy
+    size_t allocs = counts.allocs;
+    GgArenaState claimed = gg_arena_save(&arena);
+    GG_TEST_ASSERT_OK(gg_arena_claim_obj(&obj, &arena));
+    TEST_ASSERT_EQUAL(allocs, counts.allocs);
+    TEST_ASSERT_EQUAL_PTR(claimed.mem, arena.mem);
+    TEST_ASSERT_EQUAL(claimed.index, arena.index);
+
+    gg_arena_restore(&arena, start);
+    obj = expected;
+    GG_TEST_ASSERT_OK(gg_arena_claim_obj(&obj, &arena));
+    TEST_ASSERT_EQUAL(allocs, counts.allocs);
+
+    free_chain(&chain);
+}
+
+GG_TEST_DEFINE(arena_chain_alloc_failure) {
+    GgArenaChain chain = counting_chain();
+    GgArena arena = gg_arena_init_chained(&chain);
+    TEST_ASSERT_NOT_NULL(GG_ARENA_ALLOCN(&arena, uint8_t, BLOCK_SIZE));
+    GgArenaState full = gg_arena_save(&arena);
+
+    counts.fail = true;
+    TEST_ASSERT_NULL(GG_ARENA_ALLOCN(&arena, uint8_t, 1));
+    TEST_ASSERT_EQUAL_PTR(full.mem, arena.mem);
+    TEST_ASSERT_EQUAL(full.index, arena.index);
+
+    // Retained blocks are still usable
+    counts.fail = false;
+    TEST_ASSERT_NOT_NULL(GG_ARENA_ALLOCN(&arena, uint8_t, 1));
+    counts.fail = true;
+    gg_arena_restore(&arena, full);
+    TEST_ASSERT_NOT_NULL(GG_ARENA_ALLOCN(&arena, uint8_t, BLOCK_SIZE));
+    TEST_ASSERT_NULL(GG_ARENA_ALLOCN(&arena, uint8_t, 1));
+
+    counts.fail = false;
+    free_chain(&chain);
+}
@@ -0,0 +1,236 @@
+#include <gg/arena.h>
+#include <gg/base64.h>
+#include <gg/base64_decode.h>
+#include <gg/base64_encode.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/io.h>
+#include <gg/test.h>
+#include <string.h>
+#include <unity.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+// The SDK picks SSSE3 or scalar code at runtime depending on the CPU and on
+// the input length (blocks of 16 characters or 12 bytes, with scalar code
+// for the remainder). These tests compare every length across several blocks
+// with the plain scalar reference below, so both paths and the boundary
+// between them are covered.
+
+#define MAX_DATA_LEN 200
+
+static const char REF_TABLE[]
+    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static size_t ref_encode(const uint8_t *in, size_t len, uint8_t *out) {
+    size_t o = 0;
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t chunk = (uint32_t) in[i] << 16;
+        if (i + 1 < len) {
+            chunk |= (uint32_t) in[i + 1] << 8;
+        }
+        if (i + 2 < len) {
+            chunk |= in[i + 2];
+        }
+        out[o++] = (uint8_t) REF_TABLE[(chunk >> 18) & 0x3F];
+        out[o++] = (uint8_t) REF_TABLE[(chunk >> 12) & 0x3F];
+        out[o++] = (i + 1 < len) ? (uint8_t) REF_TABLE[(chunk >> 6) & 0x3F]
+                                 : '=';
+        out[o++] = (i + 2 < len) ? (uint8_t) REF_TABLE[chunk & 0x3F] : '=';
+    }
+    return o;
+}
+
+static uint8_t data[MAX_DATA_LEN];
+
+static void fill_data(void) {
+    uint32_t state = 0x12345678U;
+    for (size_t i = 0; i < sizeof(data); i++) {
+        state = (state * 1103515245U) + 12345U;
+        data[i] = (uint8_t) (state >> 24);
+    }
+}
+
+static GgBuffer collected;
+static size_t collected_len;
+
+static GgError collect_write(void *ctx, GgBuffer buf) {
+    (void) ctx;
+    TEST_ASSERT_TRUE(collected_len + buf.len <= collected.len);
+    memcpy(&collected.data[collected_len], buf.data, buf.len);
+    collected_len += buf.len;
+    return GG_ERR_OK;
+}
+
+GG_TEST_DEFINE(base64_encode_matches_reference) {
+    fill_data();
+    static uint8_t expected[((MAX_DATA_LEN + 2) / 3) * 4];
+    static uint8_t arena_mem[sizeof(expected)];
+
+    for (size_t len = 0; len <= MAX_DATA_LEN; len++) {
+        size_t expected_len = ref_encode(data, len, expected);
+        TEST_ASSERT_EQUAL(expected_len, gg_base64_encoded_len(len));
+
+        GgArena arena = gg_arena_init(GG_BUF(arena_mem));
+        GgBuffer in = { .data = data, .len = len };
+        GgBuffer result;
+        GG_TEST_ASSERT_OK(gg_base64_encode(in, &arena, &result));
+        TEST_ASSERT_EQUAL(expected_len, result.len);
+        TEST_ASSERT_EQUAL_MEMORY(expected, result.data, expected_len);
+    }
+}
+
+GG_TEST_DEFINE(base64_encoder_matches_reference) {
+    fill_data();
+    static uint8_t expected[((MAX_DATA_LEN + 2) / 3) * 4];
+    static uint8_t out[sizeof(expected)];
+    collected = GG_BUF(out);
+
+    // Split the input at every point to cover pending partial groups
+    for (size_t split = 0; split <= MAX_DATA_LEN; split++) {
+        size_t expected_len = ref_encode(data, MAX_DATA_LEN, expected);
+
+        collected_len = 0;
+        GgBase64Encoder encoder = gg_base64_encoder_init(
+            (GgWriter) { .ctx = NULL, .write = &collect_write }
+        );
+        GgWriter writer = gg_base64_encoder_writer(&encoder);
+        GgBuffer in = GG_BUF(data);
+        GG_TEST_ASSERT_OK(
+            gg_writer_call(writer, gg_buffer_substr(in, 0, split))
+        );
+        GG_TEST_ASSERT_OK(
+            gg_writer_call(writer, gg_buffer_substr(in, split, SIZE_MAX))
+        );
+        GG_TEST_ASSERT_OK(gg_base64_encoder_finish(&encoder));
+
+        TEST_ASSERT_EQUAL(expected_len, collected_len);
+        TEST_ASSERT_EQUAL_MEMORY(expected, out, expected_len);
+    }
+}
+
+GG_TEST_DEFINE(base64_decode_matches_reference) {
+    fill_data();
+    static uint8_t encoded[((MAX_DATA_LEN + 2) / 3) * 4];
+    static uint8_t decoded[sizeof(encoded)];
+
+    for (size_t len = 0; len <= MAX_DATA_LEN; len++) {
+        size_t encoded_len = ref_encode(data, len, encoded);
+        GgBuffer in = { .data = encoded, .len = encoded_len };
+
+        GgBuffer target = GG_BUF(decoded);
+        TEST_ASSERT_TRUE(gg_base64_decode(in, &target));
+        TEST_ASSERT_EQUAL(len, target.len);
+        TEST_ASSERT_EQUAL_MEMORY(data, decoded, len);
+
+        TEST_ASSERT_TRUE(gg_base64_decode_in_place(&in));
+        TEST_ASSERT_EQUAL(len, in.len);
+        TEST_ASSERT_EQUAL_MEMORY(data, encoded, len);
+    }
+}
+
+GG_TEST_DEFINE(base64_decoder_matches_reference) {
+    fill_data();
+    static uint8_t encoded[((MAX_DATA_LEN + 2) / 3) * 4];
+
+    for (size_t len = 0; len <= MAX_DATA_LEN; len += 7) {
+        size_t encoded_len = ref_encode(data, len, encoded);
+        GgBuffer in = { .data = encoded, .len = encoded_len };
+        for (size_t split = 0; split <= encoded_len; split++) {
+            // Decoding in place overwrites the input
+            ref_encode(data, len, encoded);
+
+            GgBase64Decoder decoder = gg_base64_decoder_init();
+            uint8_t *out = encoded;
+            TEST_ASSERT_TRUE(gg_base64_decoder_update(
+                &decoder, gg_buffer_substr(in, 0, split), &out
+            ));
+            TEST_ASSERT_TRUE(gg_base64_decoder_update(
+                &decoder, gg_buffer_substr(in, split, SIZE_MAX), &out
+            ));
+            TEST_ASSERT_TRUE(gg_base64_decoder_finish(&decoder, &out));
+
+            TEST_ASSERT_EQUAL(len, (size_t) (out - encoded));
+            TEST_ASSERT_EQUAL_MEMORY(data, encoded, len);
+        }
+    }
+}
+
+GG_TEST_DEFINE(base64_decode_rejects_invalid_char_anywhere) {
+    fill_data();
+    static uint8_t encoded[((MAX_DATA_LEN + 2) / 3) * 4];
+    static uint8_t decoded[sizeof(encoded)];
+    const uint8_t bad_chars[] = { '*', '-', '_', '=', ' ', 0x00, 0x80, 0xFF };
+
+    // 96 bytes -> 128 characters, several SIMD blocks
+    size_t encoded_len = ref_encode(data, 96, encoded);
+    GgBuffer in = { .data = encoded, .len = encoded_len };
+
+    for (size_t pos = 0; pos < encoded_len; pos++) {
+        for (size_t i = 0; i < sizeof(bad_chars); i++) {
+            uint8_t bad = bad_chars[i];
+            if ((bad == '=') && (pos >= encoded_len - 2)) {
+                // Valid padding positions are tested separately
+                continue;
+            }
+            ref_encode(data, 96, encoded);
+            encoded[pos] = bad;
+
+            GgBuffer target = GG_BUF(decoded);
+            TEST_ASSERT_FALSE(gg_base64_decode(in, &target));
+
+            GgBase64Decoder decoder = gg_base64_decoder_init();
+            uint8_t *out = encoded;
+            bool ok = gg_base64_decoder_update(&decoder, in, &out);
+            ok = ok && gg_base64_decoder_finish(&decoder, &out);
+            TEST_ASSERT_FALSE(ok);
+        }
+    }
+}
+
+static bool decode_str(const char *str, GgBuffer *result) {
+    static uint8_t in[64];
+    static uint8_t out[64];
+    size_t len = strlen(str);
+    TEST_ASSERT_TRUE(len <= sizeof(in));
+    memcpy(in, str, len);
+    *result = GG_BUF(out);
+    return gg_base64_decode((GgBuffer) { .data = in, .len = len }, result);
+}
+
+GG_TEST_DEFINE(base64_decode_padding) {
+    GgBuffer result;
+
+    TEST_ASSERT_TRUE(decode_str("", &result));
+    TEST_ASSERT_EQUAL(0, result.len);
+    TEST_ASSERT_TRUE(decode_str("QQ==", &result));
+    TEST_ASSERT_TRUE(gg_buffer_eq(GG_STR("A"), result));
+    TEST_ASSERT_TRUE(decode_str("QUI=", &result));
+    TEST_ASSERT_TRUE(gg_buffer_eq(GG_STR("AB"), result));
+    TEST_ASSERT_TRUE(decode_str("QUJD", &result));
+    TEST_ASSERT_TRUE(gg_buffer_eq(GG_STR("ABC"), result));
+    TEST_ASSERT_TRUE(
+        decode_str("QUJDREVGR0hJSktMTU5PUFFSU1RVVldYWVo=", &result)
+    );
+    TEST_ASSERT_TRUE(
+        gg_buffer_eq(GG_STR("ABCDEFGHIJKLMNOPQRSTUVWXYZ"), result)
+    );
+
+    // Unpadded or truncated
+    TEST_ASSERT_FALSE(decode_str("QQ", &result));
+    TEST_ASSERT_FALSE(decode_str("QUI", &result));
+    TEST_ASSERT_FALSE(decode_str("QUJDR", &result));
+    // Data after padding
+    TEST_ASSERT_FALSE(decode_str("QQ=A", &result));
+    TEST_ASSERT_FALSE(decode_str("Q===", &result));
+    TEST_ASSERT_FALSE(decode_str("====", &result));
+    // Padding before the final segment, including within a SIMD block
+    TEST_ASSERT_FALSE(decode_str("QQ==QUJD", &result));
+    TEST_ASSERT_FALSE(decode_str("QUJDQUJDQUJDQQ==QUJDQUJD", &result));
+    // Non-zero unused bits
+    TEST_ASSERT_FALSE(decode_str("QR==", &result));
+    TEST_ASSERT_FALSE(decode_str("QUJ=", &result));
+}
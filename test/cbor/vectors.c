@@ -0,0 +1,171 @@
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/cbor_decode.h>
+#include <gg/cbor_encode.h>
+#include <gg/error.h>
+#include <gg/io.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <gg/test.h>
+#include <unity.h>
+#include <stdint.h>
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+/// Literal CBOR bytes as a buffer.
+#define CBOR(...) \
+    (GgBuffer) { \
+        .data = (uint8_t[]) { __VA_ARGS__ }, \
+        .len = sizeof((uint8_t[]) { __VA_ARGS__ }) \
+    }
+
+/// Checks that obj encodes to exactly `expected`, and decodes back to obj.
+static void check_round_trip(GgObject obj, GgBuffer expected) {
+    static uint8_t encode_mem[256];
+    static uint8_t decode_mem[1024];
+
+    size_t len = 0;
+    GG_TEST_ASSERT_OK(gg_cbor_encoded_len(obj, &len));
+    TEST_ASSERT_EQUAL(expected.len, len);
+
+    GgBuffer remaining = GG_BUF(encode_mem);
+    GG_TEST_ASSERT_OK(gg_cbor_encode(obj, gg_buf_writer(&remaining)));
+    TEST_ASSERT_EQUAL(expected.len, sizeof(encode_mem) - remaining.len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected.data, encode_mem, expected.len);
+
+    GgArena arena = gg_arena_init(GG_BUF(decode_mem));
+    GgObject decoded;
+    GG_TEST_ASSERT_OK(gg_cbor_decode(expected, &arena, &decoded));
+    TEST_ASSERT_TRUE(gg_obj_eq(obj, decoded));
+}
+
+/// Checks that `cbor` decodes to obj.
+static void check_decode(GgBuffer cbor, GgObject obj) {
+    static uint8_t decode_mem[1024];
+
+    GgArena arena = gg_arena_init(GG_BUF(decode_mem));
+    GgObject decoded;
+    GG_TEST_ASSERT_OK(gg_cbor_decode(cbor, &arena, &decoded));
+    TEST_ASSERT_TRUE(gg_obj_eq(obj, decoded));
+}
+
+// Vectors from RFC 8949 Appendix A, except where the encoder differs from
+// preferred serialization (floats use at least single precision, and
+// buffers are byte strings).
+
+GG_TEST_DEFINE(cbor_vectors_integers) {
+    check_round_trip(gg_obj_i64(0), CBOR(0x00));
+    check_round_trip(gg_obj_i64(23), CBOR(0x17));
+    check_round_trip(gg_obj_i64(24), CBOR(0x18, 0x18));
+    check_round_trip(gg_obj_i64(100), CBOR(0x18, 0x64));
+    check_round_trip(gg_obj_i64(1000), CBOR(0x19, 0x03, 0xE8));
+    check_round_trip(gg_obj_i64(1000000), CBOR(0x1A, 0x00, 0x0F, 0x42, 0x40));
+    check_round_trip(
+        gg_obj_i64(1000000000000),
+        CBOR(0x1B, 0x00, 0x00, 0x00, 0xE8, 0xD4, 0xA5, 0x10, 0x00)
+    );
+    check_round_trip(gg_obj_i64(-1), CBOR(0x20));
+    check_round_trip(gg_obj_i64(-10), CBOR(0x29));
+    check_round_trip(gg_obj_i64(-100), CBOR(0x38, 0x63));
+    check_round_trip(gg_obj_i64(-1000), CBOR(0x39, 0x03, 0xE7));
+    check_round_trip(
+        gg_obj_i64(INT64_MIN),
+        CBOR(0x3B, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF)
+    );
+}
+
+GG_TEST_DEFINE(cbor_vectors_floats) {
+    check_round_trip(gg_obj_f64(1.5), CBOR(0xFA, 0x3F, 0xC0, 0x00, 0x00));
+    check_round_trip(gg_obj_f64(100000.0), CBOR(0xFA, 0x47, 0xC3, 0x50, 0x00));
+    check_round_trip(
+        gg_obj_f64(1.1),
+        CBOR(0xFB, 0x3F, 0xF1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9A)
+    );
+    check_round_trip(
+        gg_obj_f64(1.0e+300),
+        CBOR(0xFB, 0x7E, 0x37, 0xE4, 0x3C, 0x88, 0x00, 0x75, 0x9C)
+    );
+    check_decode(CBOR(0xF9, 0x3E, 0x00), gg_obj_f64(1.5));
+}
+
+GG_TEST_DEFINE(cbor_vectors_simple) {
+    check_round_trip(gg_obj_bool(false), CBOR(0xF4));
+    check_round_trip(gg_obj_bool(true), CBOR(0xF5));
+    check_round_trip(GG_OBJ_NULL, CBOR(0xF6));
+}
+
+GG_TEST_DEFINE(cbor_vectors_strings) {
+    check_round_trip(gg_obj_buf(GG_STR("")), CBOR(0x40));
+    check_round_trip(
+        gg_obj_buf(GG_BUF(((uint8_t[]) { 0x01, 0x02, 0x03, 0x04 }))),
+        CBOR(0x44, 0x01, 0x02, 0x03, 0x04)
+    );
+    // Text strings decode to buffers
+    check_decode(CBOR(0x60), gg_obj_buf(GG_STR("")));
+    check_decode(CBOR(0x61, 0x61), gg_obj_buf(GG_STR("a")));
+    check_decode(
+        CBOR(0x64, 0x49, 0x45, 0x54, 0x46), gg_obj_buf(GG_STR("IETF"))
+    );
+    check_decode(CBOR(0x62, 0xC3, 0xBC), gg_obj_buf(GG_STR("ü")));
+}
+
+GG_TEST_DEFINE(cbor_vectors_lists) {
+    check_round_trip(gg_obj_list((GgList) { 0 }), CBOR(0x80));
+    check_round_trip(
+        gg_obj_list(GG_LIST(gg_obj_i64(1), gg_obj_i64(2), gg_obj_i64(3))),
+        CBOR(0x83, 0x01, 0x02, 0x03)
+    );
+    check_round_trip(
+        gg_obj_list(GG_LIST(
+            gg_obj_i64(1),
+            gg_obj_list(GG_LIST(gg_obj_i64(2), gg_obj_i64(3))),
+            gg_obj_list(GG_LIST(gg_obj_i64(4), gg_obj_i64(5)))
+        )),
+        CBOR(0x83, 0x01, 0x82, 0x02, 0x03, 0x82, 0x04, 0x05)
+    );
+}
+
+GG_TEST_DEFINE(cbor_vectors_maps) {
+    check_round_trip(gg_obj_map((GgMap) { 0 }), CBOR(0xA0));
+    check_round_trip(
+        gg_obj_map(GG_MAP(
+            gg_kv(GG_STR("a"), gg_obj_i64(1)),
+            gg_kv(
+                GG_STR("b"),
+                gg_obj_list(GG_LIST(gg_obj_i64(2), gg_obj_i64(3)))
+            )
+        )),
+        CBOR(0xA2, 0x61, 0x61, 0x01, 0x61, 0x62, 0x82, 0x02, 0x03)
+    );
+    // Keys are text strings; buffer values are byte strings
+    check_round_trip(
+        gg_obj_map(GG_MAP(gg_kv(GG_STR("a"), gg_obj_buf(GG_STR("A"))))),
+        CBOR(0xA1, 0x61, 0x61, 0x41, 0x41)
+    );
+    check_round_trip(
+        gg_obj_list(GG_LIST(
+            gg_obj_buf(GG_STR("a")),
+            gg_obj_map(GG_MAP(gg_kv(GG_STR("b"), gg_obj_buf(GG_STR("c")))))
+        )),
+        CBOR(0x82, 0x41, 0x61, 0xA1, 0x61, 0x62, 0x41, 0x63)
+    );
+}
+
+GG_TEST_DEFINE(cbor_decode_accepts_byte_string_keys) {
+    check_decode(
+        CBOR(0xA2, 0x41, 0x61, 0x01, 0x61, 0x62, 0x02),
+        gg_obj_map(GG_MAP(
+            gg_kv(GG_STR("a"), gg_obj_i64(1)), gg_kv(GG_STR("b"), gg_obj_i64(2))
+        ))
+    );
+}
+
+GG_TEST_DEFINE(cbor_decode_rejects_non_string_keys) {
+    static uint8_t decode_mem[256];
+    GgArena arena = gg_arena_init(GG_BUF(decode_mem));
+    GgObject decoded;
+    TEST_ASSERT_NOT_EQUAL(
+        GG_ERR_OK,
+        gg_cbor_decode(CBOR(0xA1, 0x01, 0x02), &arena, &decoded)
+    );
+}
@@ -0,0 +1,145 @@
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/ipc/client.h>
+#include <gg/ipc/mock.h>
+#include <gg/ipc/packet_sequences.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <gg/process_wait.h>
+#include <gg/sdk.h>
+#include <gg/test.h>
+#include <unistd.h>
+#include <unity.h>
+#include <stdint.h>
+
+#define GG_MODULE "test_config"
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+/// More elements than fit in the default IPC decode memory.
+#define LARGE_LIST_LEN 300
+
+static GgObject large_list_items[LARGE_LIST_LEN];
+
+static GgObject large_list(void) {
+    for (size_t i = 0; i < LARGE_LIST_LEN; i++) {
+        large_list_items[i] = gg_obj_i64((int64_t) i);
+    }
+    return gg_obj_list(
+        (GgList) { .items = large_list_items, .len = LARGE_LIST_LEN }
+    );
+}
+
+static const GgObjectLimits LARGE_LIMITS
+    = { .max_depth = GG_MAX_OBJECT_DEPTH,
+        .max_subobjects = 2 * LARGE_LIST_LEN };
+
+GG_TEST_DEFINE(get_config_larger_than_default_decode_mem) {
+    GgObjectLimits prev_limits = gg_obj_get_limits();
+    GG_TEST_ASSERT_OK(gg_obj_set_limits(LARGE_LIMITS));
+
+    pid_t pid = fork();
+    TEST_ASSERT_TRUE_MESSAGE(pid >= 0, "fork failed");
+
+    if (pid == 0) {
+        static uint8_t decode_mem[2 * sizeof(GgObject[LARGE_LIST_LEN])];
+        static uint8_t result_mem[sizeof(GgObject[LARGE_LIST_LEN])];
+
+        gg_sdk_init();
+        GG_TEST_ASSERT_OK(ggipc_set_decode_mem(GG_BUF(decode_mem)));
+        GG_TEST_ASSERT_OK(ggipc_connect());
+        TEST_ASSERT_EQUAL(
+            GG_ERR_INVALID, ggipc_set_decode_mem(GG_BUF(decode_mem))
+        );
+
+        GgArena alloc = gg_arena_init(GG_BUF(result_mem));
+        GgObject value;
+        GG_TEST_ASSERT_OK(ggipc_get_config(
+            GG_BUF_LIST(GG_STR("big")), NULL, &alloc, &value
+        ));
+        TEST_ASSERT_EQUAL(GG_TYPE_LIST, gg_obj_type(value));
+        GgList list = gg_obj_into_list(value);
+        TEST_ASSERT_EQUAL(LARGE_LIST_LEN, list.len);
+        for (size_t i = 0; i < LARGE_LIST_LEN; i++) {
+            TEST_ASSERT_EQUAL(GG_TYPE_I64, gg_obj_type(list.items[i]));
+            TEST_ASSERT_EQUAL((int64_t) i, gg_obj_into_i64(list.items[i]));
+        }
+        TEST_PASS();
+    }
+
+    GgKV value_pairs[] = { gg_kv(GG_STR("big"), large_list()) };
+
+    GG_TEST_ASSERT_OK(gg_test_accept_client(1, server_handle));
+
+    GG_TEST_ASSERT_OK(gg_test_expect_packet_sequence(
+        gg_test_connect_accepted_sequence(gg_test_get_auth_token()),
+        5,
+        server_handle
+    ));
+
+    GG_TEST_ASSERT_OK(gg_test_expect_packet_sequence(
+        gg_test_config_get_accepted_sequence(
+            1,
+            GG_LIST(gg_obj_buf(GG_STR("big"))),
+            (GgMap) { .pairs = value_pairs, .len = 1 }
+        ),
+        5,
+        server_handle
+    ));
+
+    GG_TEST_ASSERT_OK(gg_test_wait_for_client_disconnect(1, server_handle));
+
+    GG_TEST_ASSERT_OK(gg_process_wait(pid));
+
+    GG_TEST_ASSERT_OK(gg_obj_set_limits(prev_limits));
+}
+
+GG_TEST_DEFINE(get_config_larger_than_default_decode_mem_fails) {
+    GgObjectLimits prev_limits = gg_obj_get_limits();
+    GG_TEST_ASSERT_OK(gg_obj_set_limits(LARGE_LIMITS));
+
+    pid_t pid = fork();
+    TEST_ASSERT_TRUE_MESSAGE(pid >= 0, "fork failed");
+
+    if (pid == 0) {
+        static uint8_t result_mem[sizeof(GgObject[LARGE_LIST_LEN])];
+
+        gg_sdk_init();
+        GG_TEST_ASSERT_OK(ggipc_connect());
+
+        GgArena alloc = gg_arena_init(GG_BUF(result_mem));
+        GgObject value;
+        TEST_ASSERT_NOT_EQUAL(
+            GG_ERR_OK,
+            ggipc_get_config(GG_BUF_LIST(GG_STR("big")), NULL, &alloc, &value)
+        );
+        TEST_PASS();
+    }
+
+    GgKV value_pairs[] = { gg_kv(GG_STR("big"), large_list()) };
+
+    GG_TEST_ASSERT_OK(gg_test_accept_client(1, server_handle));
+
+    GG_TEST_ASSERT_OK(gg_test_expect_packet_sequence(
+        gg_test_connect_accepted_sequence(gg_test_get_auth_token()),
+        5,
+        server_handle
+    ));
+
+    GG_TEST_ASSERT_OK(gg_test_expect_packet_sequence(
+        gg_test_config_get_accepted_sequence(
+            1,
+            GG_LIST(gg_obj_buf(GG_STR("big"))),
+            (GgMap) { .pairs = value_pairs, .len = 1 }
+        ),
+        5,
+        server_handle
+    ));
+
+    GG_TEST_ASSERT_OK(gg_test_wait_for_client_disconnect(5, server_handle));
+
+    GG_TEST_ASSERT_OK(gg_process_wait(pid));
+
+    GG_TEST_ASSERT_OK(gg_obj_set_limits(prev_limits));
+}
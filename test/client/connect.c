@@ -8,7 +8,7 @@
 #include <gg/ipc/client.h>
 #include <gg/ipc/mock.h>
 #include <gg/ipc/packet_sequences.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <gg/process_wait.h>
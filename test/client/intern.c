@@ -0,0 +1,124 @@
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/intern.h>
+#include <gg/ipc/client.h>
+#include <gg/ipc/mock.h>
+#include <gg/ipc/packet_sequences.h>
+#include <gg/object.h>
+#include <gg/process_wait.h>
+#include <gg/sdk.h>
+#include <gg/test.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <unity.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define GG_MODULE "test_intern"
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+#define MESSAGE_COUNT 3
+
+static uint8_t intern_mem[256];
+static GgArena intern_storage;
+static GgBuffer intern_slots[16];
+static GgInternTable intern_table;
+
+static pthread_mutex_t received_mtx = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t received_cond = PTHREAD_COND_INITIALIZER;
+static GgBuffer received_topics[MESSAGE_COUNT];
+static size_t received_count = 0;
+
+static void record_topic(
+    void *ctx, GgBuffer topic, GgBuffer payload, GgIpcSubscriptionHandle handle
+) {
+    (void) ctx;
+    (void) payload;
+    (void) handle;
+    pthread_mutex_lock(&received_mtx);
+    if (received_count < MESSAGE_COUNT) {
+        received_topics[received_count] = topic;
+        received_count += 1;
+    }
+    pthread_cond_signal(&received_cond);
+    pthread_mutex_unlock(&received_mtx);
+}
+
+GG_TEST_DEFINE(subscribe_to_iot_core_interns_topic) {
+    pid_t pid = fork();
+    TEST_ASSERT_TRUE_MESSAGE(pid >= 0, "fork failed");
+
+    if (pid == 0) {
+        intern_storage = gg_arena_init(GG_BUF(intern_mem));
+        intern_table = gg_intern_table_init(
+            &intern_storage, intern_slots, 16, sizeof(intern_mem)
+        );
+
+        gg_sdk_init();
+        GG_TEST_ASSERT_OK(ggipc_set_intern_table(&intern_table));
+        GG_TEST_ASSERT_OK(ggipc_connect());
+        TEST_ASSERT_EQUAL(
+            GG_ERR_INVALID, ggipc_set_intern_table(&intern_table)
+        );
+
+        GgIpcSubscriptionHandle handle;
+        GG_TEST_ASSERT_OK(ggipc_subscribe_to_iot_core(
+            GG_STR("my/topic"), 0, &record_topic, NULL, &handle
+        ));
+
+        struct timespec wait_until;
+        clock_gettime(CLOCK_REALTIME, &wait_until);
+        wait_until.tv_sec += 5;
+
+        pthread_mutex_lock(&received_mtx);
+        int pthread_ret = 0;
+        while ((received_count < MESSAGE_COUNT) && (pthread_ret == 0)) {
+            pthread_ret = pthread_cond_timedwait(
+                &received_cond, &received_mtx, &wait_until
+            );
+        }
+        size_t count = received_count;
+        pthread_mutex_unlock(&received_mtx);
+
+        TEST_ASSERT_EQUAL(MESSAGE_COUNT, count);
+        // Every message's topic is the single interned copy
+        TEST_ASSERT_TRUE(gg_buffer_eq(GG_STR("my/topic"), received_topics[0]));
+        TEST_ASSERT_TRUE(
+            gg_arena_owns(&intern_storage, received_topics[0].data)
+        );
+        for (size_t i = 1; i < MESSAGE_COUNT; i++) {
+            TEST_ASSERT_EQUAL_PTR(
+                received_topics[0].data, received_topics[i].data
+            );
+        }
+        TEST_ASSERT_EQUAL(1, intern_table.count);
+        TEST_PASS();
+    }
+
+    GG_TEST_ASSERT_OK(gg_test_accept_client(1, server_handle));
+
+    GG_TEST_ASSERT_OK(gg_test_expect_packet_sequence(
+        gg_test_connect_accepted_sequence(gg_test_get_auth_token()),
+        5,
+        server_handle
+    ));
+
+    GG_TEST_ASSERT_OK(gg_test_expect_packet_sequence(
+        gg_test_mqtt_subscribe_accepted_sequence(
+            1,
+            GG_STR("my/topic"),
+            GG_STR("SGVsbG8gd29ybGQh"),
+            GG_STR("0"),
+            MESSAGE_COUNT
+        ),
+        30,
+        server_handle
+    ));
+
+    GG_TEST_ASSERT_OK(gg_test_wait_for_client_disconnect(5, server_handle));
+
+    GG_TEST_ASSERT_OK(gg_process_wait(pid));
+}
@@ -11,7 +11,7 @@
 #include <gg/ipc/client.h>
 #include <gg/ipc/mock.h>
 #include <gg/ipc/packet_sequences.h>
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <gg/map.h>
 #include <gg/object.h>
 #include <gg/process_wait.h>
@@ -78,7 +78,7 @@ GG_TEST_DEFINE(publish_to_iot_core_okay) {
     GG_TEST_ASSERT_OK(gg_process_wait(pid));
 }
 
-GG_TEST_DEFINE(publish_to_iot_core_bad_alloc) {
+GG_TEST_DEFINE(publish_to_iot_core_oversize) {
     GgBuffer payload = payloads[1].payload;
 
     pid_t pid = fork();
@@ -88,7 +88,7 @@ GG_TEST_DEFINE(publish_to_iot_core_bad_alloc) {
         gg_sdk_init();
         GG_TEST_ASSERT_OK(ggipc_connect());
         TEST_ASSERT_EQUAL(
-            GG_ERR_NOMEM,
+            GG_ERR_RANGE,
             ggipc_publish_to_iot_core(GG_STR("my/topic"), payload, 0)
         );
         TEST_PASS();
@@ -190,9 +190,20 @@ GG_TEST_DEFINE(publish_to_iot_core_invalid_qos) {
     if (pid == 0) {
         gg_sdk_init();
         GG_TEST_ASSERT_OK(ggipc_connect());
-        GG_TEST_ASSERT_BAD(
+        TEST_ASSERT_EQUAL(
+            GG_ERR_INVALID,
             ggipc_publish_to_iot_core(GG_STR("my/topic"), payload, 10)
         );
+        TEST_ASSERT_EQUAL(
+            GG_ERR_INVALID,
+            ggipc_publish_to_iot_core(GG_STR("my/topic"), payload, 3)
+        );
+        TEST_ASSERT_EQUAL(
+            GG_ERR_INVALID,
+            ggipc_publish_to_iot_core_b64(
+                GG_STR("my/topic"), payloads[0].payload_base64, 3
+            )
+        );
         TEST_PASS();
     }
 
@@ -204,17 +215,7 @@ GG_TEST_DEFINE(publish_to_iot_core_invalid_qos) {
         server_handle
     ));
 
-    GG_TEST_ASSERT_OK(gg_test_expect_packet_sequence(
-        gg_test_mqtt_publish_error_sequence(
-            1,
-            GG_STR("my/topic"),
-            payloads[0].payload_base64,
-            GG_BUF((uint8_t[]) { '0' + 10 })
-        ),
-        5,
-        server_handle
-    ));
-
+    // Invalid QoS is rejected without sending a request
     GG_TEST_ASSERT_OK(gg_test_wait_for_client_disconnect(1, server_handle));
 
     GG_TEST_ASSERT_OK(gg_process_wait(pid));
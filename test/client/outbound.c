@@ -0,0 +1,172 @@
+#include <gg/arena.h>
+#include <gg/base64.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/ipc/client.h>
+#include <gg/ipc/limits.h>
+#include <gg/ipc/mock.h>
+#include <gg/ipc/packet_sequences.h>
+#include <gg/object.h>
+#include <gg/process_wait.h>
+#include <gg/sdk.h>
+#include <gg/test.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <unity.h>
+#include <stdint.h>
+
+#define GG_MODULE "test_outbound"
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+// Publishes of this size are larger than the shrunk socket send buffer, and
+// two of them do not fit in the outbound buffer at once.
+#define LARGE_PAYLOAD_LEN ((GG_IPC_MAX_MSG_LEN / 4) * 3 - 1024)
+
+static uint8_t large_payload[LARGE_PAYLOAD_LEN];
+static uint8_t large_payload_b64[((LARGE_PAYLOAD_LEN + 2) / 3) * 4];
+
+static GgBuffer large_payload_base64(void) {
+    memset(large_payload, 'x', sizeof(large_payload));
+    GgArena arena = gg_arena_init(GG_BUF(large_payload_b64));
+    GgBuffer encoded;
+    GG_TEST_ASSERT_OK(
+        gg_base64_encode(GG_BUF(large_payload), &arena, &encoded)
+    );
+    return encoded;
+}
+
+/// Shrinks the send buffer of the child's IPC connection, so that large
+/// packets only partially fit and the rest is queued.
+static void shrink_ipc_send_buffer(void) {
+    size_t shrunk = 0;
+    for (int fd = 3; fd < 256; fd++) {
+        struct sockaddr_storage addr;
+        socklen_t addr_len = sizeof(addr);
+        if ((getpeername(fd, (struct sockaddr *) &addr, &addr_len) != 0)
+            || (addr.ss_family != AF_UNIX)) {
+            continue;
+        }
+        int size = 1;
+        TEST_ASSERT_EQUAL(
+            0, setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size))
+        );
+        shrunk += 1;
+    }
+    TEST_ASSERT_EQUAL(1, shrunk);
+}
+
+static GgError publish_ret;
+
+static void *publish_thread(void *arg) {
+    (void) arg;
+    publish_ret = ggipc_publish_to_iot_core(
+        GG_STR("my/topic"), GG_BUF(large_payload), 0
+    );
+    return NULL;
+}
+
+GG_TEST_DEFINE(publish_queued_while_server_not_reading) {
+    GgBuffer payload_base64 = large_payload_base64();
+
+    pid_t pid = fork();
+    TEST_ASSERT_TRUE_MESSAGE(pid >= 0, "fork failed");
+
+    if (pid == 0) {
+        gg_sdk_init();
+        GG_TEST_ASSERT_OK(ggipc_connect());
+        shrink_ipc_send_buffer();
+
+        // The socket takes only part of each packet; the rest is sent by the
+        // receive thread once the server reads. The second publish queues
+        // behind the first.
+        pthread_t thread;
+        TEST_ASSERT_EQUAL(
+            0, pthread_create(&thread, NULL, &publish_thread, NULL)
+        );
+        GgError ret = ggipc_publish_to_iot_core(
+            GG_STR("my/topic"), GG_BUF(large_payload), 0
+        );
+        TEST_ASSERT_EQUAL(0, pthread_join(thread, NULL));
+        GG_TEST_ASSERT_OK(ret);
+        GG_TEST_ASSERT_OK(publish_ret);
+
+        GgIpcStats stats;
+        ggipc_get_stats(&stats);
+        TEST_ASSERT_EQUAL(0, stats.timeouts);
+        TEST_PASS();
+    }
+
+    GG_TEST_ASSERT_OK(gg_test_accept_client(1, server_handle));
+
+    GG_TEST_ASSERT_OK(gg_test_expect_packet_sequence(
+        gg_test_connect_accepted_sequence(gg_test_get_auth_token()),
+        5,
+        server_handle
+    ));
+
+    // Let the client fill its socket buffer before reading
+    sleep(1);
+
+    // Payloads are identical, so the order of the threads does not matter
+    for (int32_t stream_id = 1; stream_id <= 2; stream_id++) {
+        GG_TEST_ASSERT_OK(gg_test_expect_packet_sequence(
+            gg_test_mqtt_publish_accepted_sequence(
+                stream_id, GG_STR("my/topic"), payload_base64, GG_STR("0")
+            ),
+            5,
+            server_handle
+        ));
+    }
+
+    GG_TEST_ASSERT_OK(gg_test_wait_for_client_disconnect(5, server_handle));
+
+    GG_TEST_ASSERT_OK(gg_process_wait(pid));
+}
+
+GG_TEST_DEFINE(publish_times_out_when_outbound_buffer_full) {
+    (void) large_payload_base64();
+
+    pid_t pid = fork();
+    TEST_ASSERT_TRUE_MESSAGE(pid >= 0, "fork failed");
+
+    if (pid == 0) {
+        gg_sdk_init();
+        GG_TEST_ASSERT_OK(ggipc_connect());
+        shrink_ipc_send_buffer();
+
+        // The server never reads, so one publish waits for its response and
+        // the other for space in the outbound buffer. Both time out.
+        pthread_t thread;
+        TEST_ASSERT_EQUAL(
+            0, pthread_create(&thread, NULL, &publish_thread, NULL)
+        );
+        GgError ret = ggipc_publish_to_iot_core(
+            GG_STR("my/topic"), GG_BUF(large_payload), 0
+        );
+        TEST_ASSERT_EQUAL(0, pthread_join(thread, NULL));
+        TEST_ASSERT_EQUAL(GG_ERR_TIMEOUT, ret);
+        TEST_ASSERT_EQUAL(GG_ERR_TIMEOUT, publish_ret);
+
+        GgIpcStats stats;
+        ggipc_get_stats(&stats);
+        TEST_ASSERT_EQUAL(2, stats.timeouts);
+        // The connect packet and only one of the publishes
+        TEST_ASSERT_EQUAL(2, stats.frames_sent);
+        TEST_PASS();
+    }
+
+    GG_TEST_ASSERT_OK(gg_test_accept_client(1, server_handle));
+
+    GG_TEST_ASSERT_OK(gg_test_expect_packet_sequence(
+        gg_test_connect_accepted_sequence(gg_test_get_auth_token()),
+        5,
+        server_handle
+    ));
+
+    GG_TEST_ASSERT_OK(gg_process_wait(pid));
+
+    GG_TEST_ASSERT_OK(gg_test_disconnect(server_handle));
+}
@@ -0,0 +1,244 @@
+#include <fcntl.h>
+#include <gg/buffer.h>
+#include <gg/durable_writer.h>
+#include <gg/error.h>
+#include <gg/file.h>
+#include <gg/process_wait.h>
+#include <gg/test.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <unity.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+#define WRITER_THREADS 8
+#define RECORDS_PER_THREAD 64
+
+/// Fixed-size record, checkable for tearing and interleaving.
+typedef struct {
+    uint32_t thread;
+    uint32_t seq;
+    uint32_t check;
+} Record;
+
+static Record make_record(uint32_t thread, uint32_t seq) {
+    return (Record) { .thread = thread,
+                      .seq = seq,
+                      .check = ~(thread * 0x9E3779B9U ^ seq) };
+}
+
+static bool record_valid(Record rec) {
+    return rec.check == make_record(rec.thread, rec.seq).check;
+}
+
+static GgBuffer records_buf(Record *records, size_t count) {
+    return (GgBuffer) { .data = (uint8_t *) records,
+                        .len = count * sizeof(Record) };
+}
+
+static int dir_fd = -1;
+static char dir_path[] = "gg-durable-test-XXXXXX";
+
+/// Create a local temporary directory for the test.
+static void open_test_dir(void) {
+    TEST_ASSERT_NOT_NULL(mkdtemp(dir_path));
+    dir_fd = open(dir_path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    TEST_ASSERT_TRUE(dir_fd >= 0);
+}
+
+static void remove_test_dir(const char *subdir) {
+    if (subdir != NULL) {
+        (void) unlinkat(dir_fd, subdir, AT_REMOVEDIR);
+    }
+    (void) gg_close(dir_fd);
+    (void) rmdir(dir_path);
+}
+
+/// Read the file and return its length, which must fit in `buf`.
+static size_t read_test_file(const char *name, GgBuffer buf) {
+    GgBuffer content = buf;
+    GG_TEST_ASSERT_OK(gg_file_read_path_at(
+        dir_fd, gg_buffer_from_null_term((char *) name), &content
+    ));
+    (void) unlinkat(dir_fd, name, 0);
+    return content.len;
+}
+
+typedef struct {
+    GgDurableWriter *writer;
+    uint32_t thread;
+    int ack_fd;
+} WriterArgs;
+
+static void *writer_thread(void *ctx) {
+    WriterArgs *args = ctx;
+    for (uint32_t i = 0; i < RECORDS_PER_THREAD; i++) {
+        Record rec = make_record(args->thread, i);
+        GgError ret
+            = gg_durable_writer_write(args->writer, records_buf(&rec, 1));
+        if (ret != GG_ERR_OK) {
+            return (void *) 1;
+        }
+        if (args->ack_fd >= 0) {
+            (void) gg_file_write(args->ack_fd, records_buf(&rec, 1));
+        }
+    }
+    return NULL;
+}
+
+static void run_writers(GgDurableWriter *writer, int ack_fd) {
+    pthread_t threads[WRITER_THREADS];
+    WriterArgs args[WRITER_THREADS];
+    for (uint32_t i = 0; i < WRITER_THREADS; i++) {
+        args[i] = (WriterArgs) {
+            .writer = writer, .thread = i, .ack_fd = ack_fd
+        };
+        TEST_ASSERT_EQUAL(
+            0, pthread_create(&threads[i], NULL, writer_thread, &args[i])
+        );
+    }
+    for (size_t i = 0; i < WRITER_THREADS; i++) {
+        void *result;
+        pthread_join(threads[i], &result);
+        TEST_ASSERT_NULL(result);
+    }
+}
+
+GG_TEST_DEFINE(durable_writer_appends_records) {
+    open_test_dir();
+
+    GgDurableWriter writer;
+    GG_TEST_ASSERT_OK(
+        gg_durable_writer_open(dir_fd, GG_STR("sub/log"), 0600, 0, &writer)
+    );
+    GG_TEST_ASSERT_OK(gg_durable_writer_write(&writer, GG_STR("first,")));
+    uint64_t offset;
+    GG_TEST_ASSERT_OK(
+        gg_durable_writer_append(&writer, GG_STR("second"), &offset)
+    );
+    TEST_ASSERT_EQUAL_size_t(12, (size_t) offset);
+    GG_TEST_ASSERT_OK(gg_durable_writer_wait(&writer, offset));
+    gg_durable_writer_close(&writer);
+
+    // Reopening appends after existing contents
+    GG_TEST_ASSERT_OK(
+        gg_durable_writer_open(dir_fd, GG_STR("sub/log"), 0600, 0, &writer)
+    );
+    GG_TEST_ASSERT_OK(gg_durable_writer_append(&writer, GG_STR("!"), &offset));
+    TEST_ASSERT_EQUAL_size_t(13, (size_t) offset);
+    GG_TEST_ASSERT_OK(gg_durable_writer_wait(&writer, offset));
+    gg_durable_writer_close(&writer);
+
+    uint8_t mem[32];
+    size_t len = read_test_file("sub/log", GG_BUF(mem));
+    TEST_ASSERT_EQUAL_STRING_LEN("first,second!", mem, 13);
+    TEST_ASSERT_EQUAL_size_t(13, len);
+
+    remove_test_dir("sub");
+}
+
+GG_TEST_DEFINE(durable_writer_concurrent_records_intact) {
+    open_test_dir();
+
+    GgDurableWriter writer;
+    GG_TEST_ASSERT_OK(
+        gg_durable_writer_open(dir_fd, GG_STR("log"), 0600, 1, &writer)
+    );
+    run_writers(&writer, -1);
+    TEST_ASSERT_TRUE(writer.synced == writer.written);
+    gg_durable_writer_close(&writer);
+
+    static Record records[WRITER_THREADS * RECORDS_PER_THREAD + 1];
+    size_t len = read_test_file(
+        "log", records_buf(records, sizeof(records) / sizeof(Record))
+    );
+    TEST_ASSERT_EQUAL_size_t(
+        WRITER_THREADS * RECORDS_PER_THREAD * sizeof(Record), len
+    );
+
+    // Each thread's records are whole and in its order
+    uint32_t next_seq[WRITER_THREADS] = { 0 };
+    for (size_t i = 0; i < WRITER_THREADS * RECORDS_PER_THREAD; i++) {
+        TEST_ASSERT_TRUE(record_valid(records[i]));
+        TEST_ASSERT_TRUE(records[i].thread < WRITER_THREADS);
+        TEST_ASSERT_EQUAL_UINT32(
+            next_seq[records[i].thread], records[i].seq
+        );
+        next_seq[records[i].thread] += 1;
+    }
+
+    remove_test_dir(NULL);
+}
+
+GG_TEST_DEFINE(durable_writer_keeps_acked_records_after_crash) {
+    open_test_dir();
+
+    int ack_pipe[2];
+    TEST_ASSERT_EQUAL(0, pipe(ack_pipe));
+
+    pid_t pid = fork();
+    TEST_ASSERT_TRUE_MESSAGE(pid >= 0, "fork failed");
+
+    if (pid == 0) {
+        (void) gg_close(ack_pipe[0]);
+        GgDurableWriter writer;
+        GG_TEST_ASSERT_OK(
+            gg_durable_writer_open(dir_fd, GG_STR("log"), 0600, 0, &writer)
+        );
+        run_writers(&writer, ack_pipe[1]);
+        // Parent kills this process before it finishes
+        pause();
+        _Exit(1);
+    }
+    (void) gg_close(ack_pipe[1]);
+
+    // Crash the writer once some records have been acknowledged
+    static Record acked[WRITER_THREADS * RECORDS_PER_THREAD];
+    size_t acked_count = 0;
+    while (acked_count < (WRITER_THREADS * RECORDS_PER_THREAD) / 2) {
+        GG_TEST_ASSERT_OK(
+            gg_file_read_exact(ack_pipe[0], records_buf(&acked[acked_count], 1))
+        );
+        acked_count += 1;
+    }
+    TEST_ASSERT_EQUAL(0, kill(pid, SIGKILL));
+    (void) gg_process_wait(pid);
+
+    // Acks written before the kill may still be in the pipe
+    GgBuffer rest = records_buf(
+        &acked[acked_count],
+        (WRITER_THREADS * RECORDS_PER_THREAD) - acked_count
+    );
+    GG_TEST_ASSERT_OK(gg_file_read(ack_pipe[0], &rest));
+    acked_count += rest.len / sizeof(Record);
+    (void) gg_close(ack_pipe[0]);
+
+    static Record records[WRITER_THREADS * RECORDS_PER_THREAD + 1];
+    size_t len = read_test_file(
+        "log", records_buf(records, sizeof(records) / sizeof(Record))
+    );
+
+    // Every complete record is intact; only a torn tail may be partial
+    size_t count = len / sizeof(Record);
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT_TRUE(record_valid(records[i]));
+    }
+
+    // Every acknowledged record is present
+    for (size_t i = 0; i < acked_count; i++) {
+        bool found = false;
+        for (size_t j = 0; (j < count) && !found; j++) {
+            found = memcmp(&acked[i], &records[j], sizeof(Record)) == 0;
+        }
+        TEST_ASSERT_TRUE(found);
+    }
+
+    remove_test_dir(NULL);
+}
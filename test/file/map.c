@@ -0,0 +1,205 @@
+#include <fcntl.h>
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/cleanup.h>
+#include <gg/error.h>
+#include <gg/file.h>
+#include <gg/json_decode.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <gg/test.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unity.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+static int dir_fd = -1;
+static char dir_path[64];
+
+/// Create a local temporary directory for the test.
+static void open_test_dir(void) {
+    strcpy(dir_path, "gg-file-map-test-XXXXXX");
+    TEST_ASSERT_NOT_NULL(mkdtemp(dir_path));
+    dir_fd = open(dir_path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    TEST_ASSERT_TRUE(dir_fd >= 0);
+}
+
+static void remove_test_dir(const char *file) {
+    (void) unlinkat(dir_fd, file, 0);
+    (void) gg_close(dir_fd);
+    (void) rmdir(dir_path);
+}
+
+static void write_test_file(const char *name, GgBuffer content) {
+    int fd;
+    GG_TEST_ASSERT_OK(gg_file_openat(
+        dir_fd,
+        gg_buffer_from_null_term((char *) name),
+        O_WRONLY | O_CREAT | O_TRUNC,
+        0600,
+        &fd
+    ));
+    GG_TEST_ASSERT_OK(gg_file_write(fd, content));
+    GG_TEST_ASSERT_OK(gg_close(fd));
+}
+
+/// Whether the process has a mapping of `name` in the test directory.
+static bool is_mapped(const char *name) {
+    char path[128];
+    int len = snprintf(path, sizeof(path), "/%s/%s", dir_path, name);
+    TEST_ASSERT_TRUE((len > 0) && ((size_t) len < sizeof(path)));
+
+    FILE *maps = fopen("/proc/self/maps", "r");
+    TEST_ASSERT_NOT_NULL(maps);
+    char line[1024];
+    bool found = false;
+    while (!found && (fgets(line, sizeof(line), maps) != NULL)) {
+        found = strstr(line, path) != NULL;
+    }
+    (void) fclose(maps);
+    return found;
+}
+
+GG_TEST_DEFINE(file_map_reads_contents) {
+    open_test_dir();
+    // Several pages, ending partway through one
+    static uint8_t data[(3 * 4096) + 123];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t) (i * 31U);
+    }
+    write_test_file("data", GG_BUF(data));
+
+    GgBuffer content;
+    GG_TEST_ASSERT_OK(gg_file_map_at(
+        dir_fd,
+        GG_STR("data"),
+        (GgFileMapOptions) { .sequential = true, .willneed = true },
+        &content
+    ));
+    TEST_ASSERT_EQUAL(sizeof(data), content.len);
+    TEST_ASSERT_EQUAL_MEMORY(data, content.data, sizeof(data));
+    TEST_ASSERT_TRUE(is_mapped("data"));
+
+    gg_file_unmap(content);
+    TEST_ASSERT_FALSE(is_mapped("data"));
+
+    // Relative to the working directory
+    char rel_path[128];
+    (void) snprintf(rel_path, sizeof(rel_path), "%s/data", dir_path);
+    GG_TEST_ASSERT_OK(gg_file_map(
+        gg_buffer_from_null_term(rel_path), (GgFileMapOptions) { 0 }, &content
+    ));
+    TEST_ASSERT_EQUAL(sizeof(data), content.len);
+    TEST_ASSERT_EQUAL_MEMORY(data, content.data, sizeof(data));
+    gg_file_unmap(content);
+
+    // Absolute
+    char abs_path[PATH_MAX];
+    TEST_ASSERT_NOT_NULL(realpath(rel_path, abs_path));
+    {
+        GgBuffer mapped;
+        GG_TEST_ASSERT_OK(gg_file_map(
+            gg_buffer_from_null_term(abs_path),
+            (GgFileMapOptions) { 0 },
+            &mapped
+        ));
+        GG_CLEANUP(cleanup_file_unmap, mapped);
+        TEST_ASSERT_EQUAL(sizeof(data), mapped.len);
+        TEST_ASSERT_EQUAL_MEMORY(data, mapped.data, sizeof(data));
+    }
+    TEST_ASSERT_FALSE(is_mapped("data"));
+
+    remove_test_dir("data");
+}
+
+GG_TEST_DEFINE(file_map_writable_is_private) {
+    open_test_dir();
+    GgBuffer json = GG_STR("{\"key\":\"esc\\u0061ped\",\"list\":[1,2]}");
+    write_test_file("doc.json", json);
+
+    GgBuffer content;
+    GG_TEST_ASSERT_OK(gg_file_map_at(
+        dir_fd,
+        GG_STR("doc.json"),
+        (GgFileMapOptions) { .writable = true },
+        &content
+    ));
+
+    // Destructive decoding modifies the mapping in place
+    static uint8_t decode_mem[256];
+    GgArena arena = gg_arena_init(GG_BUF(decode_mem));
+    GgObject obj;
+    GG_TEST_ASSERT_OK(gg_json_decode_destructive(content, &arena, &obj));
+    GgObject *val;
+    TEST_ASSERT_TRUE(gg_map_get(gg_obj_into_map(obj), GG_STR("key"), &val));
+    TEST_ASSERT_TRUE(gg_buffer_eq(GG_STR("escaped"), gg_obj_into_buf(*val)));
+    uint8_t *val_data = gg_obj_into_buf(*val).data;
+    TEST_ASSERT_TRUE(
+        (val_data >= content.data) && (val_data < &content.data[content.len])
+    );
+    gg_file_unmap(content);
+
+    // The file is unchanged
+    static uint8_t read_mem[256];
+    GgBuffer read = GG_BUF(read_mem);
+    GG_TEST_ASSERT_OK(gg_file_read_path_at(dir_fd, GG_STR("doc.json"), &read));
+    TEST_ASSERT_TRUE(gg_buffer_eq(json, read));
+
+    remove_test_dir("doc.json");
+}
+
+GG_TEST_DEFINE(file_map_empty_file) {
+    open_test_dir();
+    write_test_file("empty", (GgBuffer) { 0 });
+
+    GgBuffer content = GG_STR("not empty");
+    GG_TEST_ASSERT_OK(gg_file_map_at(
+        dir_fd, GG_STR("empty"), (GgFileMapOptions) { 0 }, &content
+    ));
+    TEST_ASSERT_EQUAL(0, content.len);
+    TEST_ASSERT_FALSE(is_mapped("empty"));
+    gg_file_unmap(content);
+
+    remove_test_dir("empty");
+}
+
+GG_TEST_DEFINE(file_map_errors) {
+    open_test_dir();
+    GgBuffer content = { 0 };
+
+    TEST_ASSERT_EQUAL(
+        GG_ERR_INVALID,
+        gg_file_map((GgBuffer) { 0 }, (GgFileMapOptions) { 0 }, &content)
+    );
+    TEST_ASSERT_EQUAL(
+        GG_ERR_INVALID,
+        gg_file_map(GG_STR("/"), (GgFileMapOptions) { 0 }, &content)
+    );
+    TEST_ASSERT_NOT_EQUAL(
+        GG_ERR_OK,
+        gg_file_map_at(
+            dir_fd, GG_STR("missing"), (GgFileMapOptions) { 0 }, &content
+        )
+    );
+
+    // Directories are not regular files
+    TEST_ASSERT_EQUAL(0, mkdirat(dir_fd, "subdir", 0700));
+    TEST_ASSERT_EQUAL(
+        GG_ERR_INVALID,
+        gg_file_map_at(
+            dir_fd, GG_STR("subdir"), (GgFileMapOptions) { 0 }, &content
+        )
+    );
+    TEST_ASSERT_EQUAL(0, content.len);
+    (void) unlinkat(dir_fd, "subdir", AT_REMOVEDIR);
+
+    remove_test_dir("missing");
+}
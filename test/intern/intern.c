@@ -0,0 +1,178 @@
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/intern.h>
+#include <gg/json_decode.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <gg/test.h>
+#include <string.h>
+#include <unity.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+#define MAX_LEN 16
+
+static uint8_t storage_mem[256];
+static GgArena storage;
+static GgBuffer slots[16];
+
+static GgInternTable table_init(void) {
+    storage = gg_arena_init(GG_BUF(storage_mem));
+    return gg_intern_table_init(&storage, slots, 16, MAX_LEN);
+}
+
+/// Copy of a string in fresh memory, so pointers differ between copies.
+static GgBuffer copy_str(GgBuffer str) {
+    static uint8_t copies[512];
+    static size_t used = 0;
+    if (used + str.len > sizeof(copies)) {
+        used = 0;
+    }
+    memcpy(&copies[used], str.data, str.len);
+    GgBuffer copy = { .data = &copies[used], .len = str.len };
+    used += str.len;
+    return copy;
+}
+
+GG_TEST_DEFINE(intern_shares_equal_strings) {
+    GgInternTable table = table_init();
+
+    GgBuffer a = copy_str(GG_STR("topic"));
+    GgBuffer b = copy_str(GG_STR("topic"));
+    GgBuffer other = copy_str(GG_STR("payload"));
+    TEST_ASSERT_TRUE(gg_intern(&table, &a));
+    TEST_ASSERT_TRUE(gg_intern(&table, &b));
+    TEST_ASSERT_TRUE(gg_intern(&table, &other));
+
+    TEST_ASSERT_EQUAL_PTR(a.data, b.data);
+    TEST_ASSERT_NOT_EQUAL(a.data, other.data);
+    TEST_ASSERT_TRUE(gg_buffer_eq(GG_STR("topic"), a));
+    TEST_ASSERT_TRUE(gg_buffer_eq(GG_STR("payload"), other));
+    TEST_ASSERT_TRUE(gg_arena_owns(&storage, a.data));
+    TEST_ASSERT_EQUAL(2, table.count);
+}
+
+GG_TEST_DEFINE(intern_skips_empty_and_long_strings) {
+    GgInternTable table = table_init();
+
+    GgBuffer empty = { 0 };
+    TEST_ASSERT_FALSE(gg_intern(&table, &empty));
+
+    GgBuffer longest = copy_str(GG_STR("0123456789abcdef"));
+    GgBuffer too_long = copy_str(GG_STR("0123456789abcdefg"));
+    uint8_t *too_long_data = too_long.data;
+    TEST_ASSERT_TRUE(gg_intern(&table, &longest));
+    TEST_ASSERT_FALSE(gg_intern(&table, &too_long));
+    TEST_ASSERT_EQUAL_PTR(too_long_data, too_long.data);
+    TEST_ASSERT_EQUAL(1, table.count);
+}
+
+GG_TEST_DEFINE(intern_table_full) {
+    GgInternTable table = table_init();
+    GgBuffer keys[13];
+    for (size_t i = 0; i < 13; i++) {
+        uint8_t str[2] = { 'a', (uint8_t) ('a' + i) };
+        keys[i] = copy_str(GG_BUF(str));
+    }
+
+    // Load factor is kept at most 3/4
+    for (size_t i = 0; i < 12; i++) {
+        TEST_ASSERT_TRUE(gg_intern(&table, &keys[i]));
+    }
+    TEST_ASSERT_FALSE(gg_intern(&table, &keys[12]));
+
+    // Existing strings are still found
+    GgBuffer again = copy_str(GG_STR("aa"));
+    TEST_ASSERT_TRUE(gg_intern(&table, &again));
+    TEST_ASSERT_EQUAL_PTR(keys[0].data, again.data);
+}
+
+GG_TEST_DEFINE(intern_storage_full) {
+    static uint8_t small_mem[8];
+    GgArena small = gg_arena_init(GG_BUF(small_mem));
+    GgInternTable table = gg_intern_table_init(&small, slots, 16, MAX_LEN);
+
+    GgBuffer fits = copy_str(GG_STR("12345678"));
+    GgBuffer no_room = copy_str(GG_STR("9"));
+    TEST_ASSERT_TRUE(gg_intern(&table, &fits));
+    TEST_ASSERT_FALSE(gg_intern(&table, &no_room));
+    TEST_ASSERT_EQUAL(1, table.count);
+}
+
+static GgObject decode_json(GgBuffer json, GgArena *arena) {
+    static uint8_t json_mem[256];
+    TEST_ASSERT_TRUE(json.len <= sizeof(json_mem));
+    memcpy(json_mem, json.data, json.len);
+    GgObject obj;
+    GG_TEST_ASSERT_OK(gg_json_decode_destructive(
+        (GgBuffer) { .data = json_mem, .len = json.len }, arena, &obj
+    ));
+    TEST_ASSERT_EQUAL(GG_TYPE_MAP, gg_obj_type(obj));
+    return obj;
+}
+
+GG_TEST_DEFINE(intern_json_decode_interns_keys) {
+    static uint8_t decode_mem[2][256];
+    GgInternTable table = table_init();
+
+    GgBuffer json = GG_STR("{\"topic\":\"topic\",\"context\":{\"topic\":1}}");
+    GgMap maps[2];
+    for (size_t i = 0; i < 2; i++) {
+        GgArena arena = gg_arena_init(GG_BUF(decode_mem[i]));
+        arena.intern = &table;
+        maps[i] = gg_obj_into_map(decode_json(json, &arena));
+    }
+
+    GgBuffer topic_key = gg_kv_key(maps[0].pairs[0]);
+    TEST_ASSERT_TRUE(gg_arena_owns(&storage, topic_key.data));
+    TEST_ASSERT_EQUAL_PTR(topic_key.data, gg_kv_key(maps[1].pairs[0]).data);
+    TEST_ASSERT_EQUAL_PTR(
+        gg_kv_key(maps[0].pairs[1]).data, gg_kv_key(maps[1].pairs[1]).data
+    );
+    GgMap context = gg_obj_into_map(*gg_kv_val(&maps[0].pairs[1]));
+    TEST_ASSERT_EQUAL_PTR(topic_key.data, gg_kv_key(context.pairs[0]).data);
+
+    // String values are not interned
+    GgBuffer value = gg_obj_into_buf(*gg_kv_val(&maps[0].pairs[0]));
+    TEST_ASSERT_TRUE(gg_buffer_eq(GG_STR("topic"), value));
+    TEST_ASSERT_FALSE(gg_arena_owns(&storage, value.data));
+    TEST_ASSERT_EQUAL(2, table.count);
+}
+
+GG_TEST_DEFINE(intern_claim_interns_keys) {
+    static uint8_t claim_mem[256];
+    GgInternTable table = table_init();
+    GgArena arena = gg_arena_init(GG_BUF(claim_mem));
+    arena.intern = &table;
+
+    GgBuffer key = copy_str(GG_STR("key"));
+    GgBuffer value = copy_str(GG_STR("key"));
+    GgKV pairs[] = { gg_kv(key, gg_obj_buf(value)) };
+    GgObject obj = gg_obj_map((GgMap) { .pairs = pairs, .len = 1 });
+    GG_TEST_ASSERT_OK(gg_arena_claim_obj(&obj, &arena));
+
+    GgMap map = gg_obj_into_map(obj);
+    GgBuffer claimed_key = gg_kv_key(map.pairs[0]);
+    GgBuffer claimed_value = gg_obj_into_buf(*gg_kv_val(&map.pairs[0]));
+    TEST_ASSERT_TRUE(gg_arena_owns(&storage, claimed_key.data));
+    TEST_ASSERT_FALSE(gg_arena_owns(&arena, claimed_key.data));
+    TEST_ASSERT_TRUE(gg_arena_owns(&arena, claimed_value.data));
+    TEST_ASSERT_TRUE(gg_buffer_eq(GG_STR("key"), claimed_value));
+
+    // Keys interned elsewhere are not copied
+    GgArena bufs_arena = gg_arena_init(GG_BUF(claim_mem));
+    bufs_arena.intern = &table;
+    GgKV interned_pairs[] = { gg_kv(claimed_key, GG_OBJ_NULL) };
+    obj = gg_obj_map((GgMap) { .pairs = interned_pairs, .len = 1 });
+    GG_TEST_ASSERT_OK(gg_arena_claim_obj_bufs(&obj, &bufs_arena));
+    TEST_ASSERT_EQUAL_PTR(claimed_key.data, gg_kv_key(interned_pairs[0]).data);
+    TEST_ASSERT_EQUAL(0, bufs_arena.index);
+
+    // Without an intern table, keys are copied into the arena
+    GgArena plain = gg_arena_init(GG_BUF(claim_mem));
+    GG_TEST_ASSERT_OK(gg_arena_claim_obj_bufs(&obj, &plain));
+    TEST_ASSERT_TRUE(gg_arena_owns(&plain, gg_kv_key(interned_pairs[0]).data));
+}
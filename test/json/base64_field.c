@@ -0,0 +1,111 @@
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/flags.h>
+#include <gg/json_decode.h>
+#include <gg/test.h>
+#include <unity.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+// Base64 members are unescaped and decoded in place; escape sequences are
+// unescaped into their own tail and decoded from there.
+
+typedef struct {
+    GgBuffer payload;
+} Message;
+
+static const GgJsonField MESSAGE_FIELDS[] = {
+    { .key = GG_STR("payload"),
+      .required = GG_REQUIRED,
+      .type = GG_JSON_FIELD_BASE64,
+      .offset = offsetof(Message, payload) },
+};
+
+static const GgJsonSchema MESSAGE_SCHEMA
+    = GG_JSON_SCHEMA(MESSAGE_FIELDS, GG_JSON_NO_PRESENCE);
+
+/// Decodes `{"payload":"<content>"}`, where content is JSON string content.
+static GgError decode_payload(const char *content, GgBuffer *payload) {
+    static uint8_t json[256];
+    int len = snprintf(
+        (char *) json, sizeof(json), "{\"payload\":\"%s\"}", content
+    );
+    TEST_ASSERT_TRUE((len > 0) && ((size_t) len < sizeof(json)));
+
+    Message message = { 0 };
+    GgError ret = gg_json_decode_struct_destructive(
+        (GgBuffer) { .data = json, .len = (size_t) len },
+        &MESSAGE_SCHEMA,
+        NULL,
+        &message
+    );
+    *payload = message.payload;
+    return ret;
+}
+
+static void check_decode(const char *content, GgBuffer expected) {
+    GgBuffer payload = { 0 };
+    GG_TEST_ASSERT_OK(decode_payload(content, &payload));
+    TEST_ASSERT_EQUAL(expected.len, payload.len);
+    TEST_ASSERT_EQUAL_MEMORY(expected.data, payload.data, expected.len);
+}
+
+static void check_invalid(const char *content) {
+    GgBuffer payload = { 0 };
+    TEST_ASSERT_EQUAL(GG_ERR_PARSE, decode_payload(content, &payload));
+}
+
+GG_TEST_DEFINE(json_base64_field_unescaped) {
+    check_decode("", GG_STR(""));
+    check_decode("aGk=", GG_STR("hi"));
+    check_decode("aGVsbG8=", GG_STR("hello"));
+}
+
+GG_TEST_DEFINE(json_base64_field_escaped_slash) {
+    const uint8_t SLASHES[] = { 0xFF, 0xEF, 0xFF };
+    check_decode(
+        "\\/w==", (GgBuffer) { .data = (uint8_t *) SLASHES, .len = 1 }
+    );
+    check_decode("a\\/8=", GG_STR("k\xFF"));
+    check_decode(
+        "\\/+\\/\\/", (GgBuffer) { .data = (uint8_t *) SLASHES, .len = 3 }
+    );
+}
+
+GG_TEST_DEFINE(json_base64_field_unicode_escapes) {
+    check_decode("aGV\\u0073bG8=", GG_STR("hello"));
+    check_decode(
+        "\\u0061\\u0047\\u0056\\u0073\\u0062\\u0047\\u0038\\u003D",
+        GG_STR("hello")
+    );
+    check_decode("\\u0061\\u0047\\u0073\\u003d", GG_STR("hk"));
+}
+
+GG_TEST_DEFINE(json_base64_field_escape_next_to_padding) {
+    check_decode("aGk\\u003D", GG_STR("hi"));
+    check_decode("aA\\u003d=", GG_STR("h"));
+    check_decode("aA=\\u003D", GG_STR("h"));
+    check_decode("a\\u0041==", GG_STR("h"));
+}
+
+GG_TEST_DEFINE(json_base64_field_invalid) {
+    // Missing padding
+    check_invalid("aGk");
+    check_invalid("aG\\u006B");
+    // Data after padding
+    check_invalid("aGk=aGk=");
+    check_invalid("aA==\\u0041");
+    // Whitespace, literal or escaped
+    check_invalid("aG k=");
+    check_invalid("aGk\\n=");
+    check_invalid("aGk=\\n");
+    check_invalid("aGk\\u0020=");
+    // Non-ASCII escapes
+    check_invalid("\\u00E9Gk=");
+    check_invalid("aGk\\u20AC");
+    // Not a valid escape
+    check_invalid("aGk\\x=");
+}
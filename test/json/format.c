@@ -0,0 +1,141 @@
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/io.h>
+#include <gg/json_encode.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <gg/test.h>
+#include <math.h>
+#include <string.h>
+#include <unity.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+static uint8_t encoded_mem[256];
+
+/// Encodes obj, checking that gg_json_encoded_len matches the output.
+static GgBuffer encode(GgObject obj) {
+    GgBuffer remaining = GG_BUF(encoded_mem);
+    GG_TEST_ASSERT_OK(gg_json_encode(obj, gg_buf_writer(&remaining)));
+    GgBuffer encoded
+        = { .data = encoded_mem, .len = sizeof(encoded_mem) - remaining.len };
+
+    size_t len = 0;
+    GG_TEST_ASSERT_OK(gg_json_encoded_len(obj, &len));
+    TEST_ASSERT_EQUAL(encoded.len, len);
+    return encoded;
+}
+
+static void check_encode(GgObject obj, const char *expected) {
+    GgBuffer encoded = encode(obj);
+    TEST_ASSERT_EQUAL_STRING_LEN(expected, encoded.data, encoded.len);
+    TEST_ASSERT_EQUAL(strlen(expected), encoded.len);
+}
+
+GG_TEST_DEFINE(json_format_f64) {
+    check_encode(gg_obj_f64(0.1), "0.1");
+    check_encode(gg_obj_f64(100.0), "100.0");
+    check_encode(gg_obj_f64(1.5), "1.5");
+    check_encode(gg_obj_f64(0.0), "0.0");
+    check_encode(gg_obj_f64(-0.0), "-0.0");
+    check_encode(gg_obj_f64(2.0 / 3.0), "0.6666666666666666");
+    check_encode(gg_obj_f64(-2.5e-3), "-0.0025");
+    check_encode(
+        gg_obj_f64(1.7976931348623157e+308), "1.7976931348623157e+308"
+    );
+    check_encode(
+        gg_obj_f64(2.2250738585072014e-308), "2.2250738585072014e-308"
+    );
+    check_encode(gg_obj_f64(5e-324), "5e-324");
+    check_encode(gg_obj_f64(1e+21), "1e+21");
+    check_encode(gg_obj_f64(1e-7), "1e-7");
+    check_encode(gg_obj_f64(1.25e-7), "1.25e-7");
+
+    // Boundaries between fixed and exponent notation
+    check_encode(gg_obj_f64(1e+14), "100000000000000.0");
+    check_encode(gg_obj_f64(123456789012345.6), "123456789012345.6");
+    check_encode(gg_obj_f64(1e+15), "1e+15");
+    check_encode(gg_obj_f64(0.0001), "0.0001");
+    check_encode(gg_obj_f64(0.00001), "1e-5");
+}
+
+GG_TEST_DEFINE(json_format_f64_non_finite) {
+    const double VALUES[] = { NAN, INFINITY, -INFINITY };
+    for (size_t i = 0; i < sizeof(VALUES) / sizeof(VALUES[0]); i++) {
+        GgObject obj = gg_obj_f64(VALUES[i]);
+        GgBuffer remaining = GG_BUF(encoded_mem);
+        TEST_ASSERT_EQUAL(
+            GG_ERR_RANGE, gg_json_encode(obj, gg_buf_writer(&remaining))
+        );
+        size_t len = 0;
+        TEST_ASSERT_EQUAL(GG_ERR_RANGE, gg_json_encoded_len(obj, &len));
+    }
+}
+
+GG_TEST_DEFINE(json_format_f64_round_trip) {
+    uint64_t state = 0x9E3779B97F4A7C15U;
+    for (size_t i = 0; i < 100000; i++) {
+        // xorshift64
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        double val;
+        memcpy(&val, &state, sizeof(val));
+        if (!isfinite(val)) {
+            continue;
+        }
+
+        GgBuffer encoded = encode(gg_obj_f64(val));
+        char str[64];
+        TEST_ASSERT_TRUE(encoded.len < sizeof(str));
+        memcpy(str, encoded.data, encoded.len);
+        str[encoded.len] = '\0';
+
+        char *end = NULL;
+        double decoded = strtod(str, &end);
+        TEST_ASSERT_EQUAL_PTR(&str[encoded.len], end);
+        TEST_ASSERT_EQUAL_MEMORY(&val, &decoded, sizeof(val));
+    }
+}
+
+GG_TEST_DEFINE(json_format_i64) {
+    check_encode(gg_obj_i64(0), "0");
+    check_encode(gg_obj_i64(7), "7");
+    check_encode(gg_obj_i64(-7), "-7");
+    check_encode(gg_obj_i64(1000000), "1000000");
+    check_encode(gg_obj_i64(INT64_MAX), "9223372036854775807");
+    check_encode(gg_obj_i64(INT64_MIN), "-9223372036854775808");
+}
+
+GG_TEST_DEFINE(json_format_string_escapes) {
+    check_encode(gg_obj_buf(GG_STR("")), "\"\"");
+    check_encode(gg_obj_buf(GG_STR("plain")), "\"plain\"");
+    check_encode(gg_obj_buf(GG_STR("a\"b")), "\"a\\\"b\"");
+    check_encode(gg_obj_buf(GG_STR("a\\b")), "\"a\\\\b\"");
+    check_encode(gg_obj_buf(GG_STR("\"\\")), "\"\\\"\\\\\"");
+    check_encode(
+        gg_obj_buf(GG_STR("\n\t\r\b\f")),
+        "\"\\u000A\\u0009\\u000D\\u0008\\u000C\""
+    );
+    check_encode(
+        gg_obj_buf((GgBuffer) { .data = (uint8_t[]) { 0x00, 'x', 0x1F },
+                                .len = 3 }),
+        "\"\\u0000x\\u001F\""
+    );
+    // DEL and slash are not escaped
+    check_encode(gg_obj_buf(GG_STR("\x7F/")), "\"\x7F/\"");
+    // Multibyte UTF-8 passes through unchanged
+    check_encode(gg_obj_buf(GG_STR("ü€😀")), "\"ü€😀\"");
+    check_encode(gg_obj_buf(GG_STR("ü\n😀")), "\"ü\\u000A😀\"");
+}
+
+GG_TEST_DEFINE(json_format_map_key_escapes) {
+    check_encode(
+        gg_obj_map(GG_MAP(gg_kv(GG_STR("k\"\x01"), gg_obj_i64(-1)))),
+        "{\"k\\\"\\u0001\":-1}"
+    );
+}
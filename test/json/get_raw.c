@@ -0,0 +1,108 @@
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/json_decode.h>
+#include <gg/test.h>
+#include <unity.h>
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+#define ASSERT_BUF_EQ(expected, actual) \
+    TEST_ASSERT_EQUAL_STRING_LEN( \
+        (const char *) (expected).data, (const char *) (actual).data, \
+        (expected).len \
+    ); \
+    TEST_ASSERT_EQUAL((expected).len, (actual).len)
+
+GG_TEST_DEFINE(json_get_raw_empty_path_returns_doc) {
+    GgBuffer doc = GG_STR("  {\"a\": [1, 2]}  ");
+    GgBuffer value;
+    GG_TEST_ASSERT_OK(gg_json_get_raw(doc, (GgBufList) { 0 }, &value));
+    ASSERT_BUF_EQ(GG_STR("{\"a\": [1, 2]}"), value);
+}
+
+GG_TEST_DEFINE(json_get_raw_nested_path) {
+    GgBuffer doc = GG_STR(
+        "{\"x\": {\"b\": 1}, \"a\": { \"skip\": [{}], \"b\" : {\"c\": \"v\"} }}"
+    );
+    GgBuffer value;
+    GG_TEST_ASSERT_OK(gg_json_get_raw(
+        doc, GG_BUF_LIST(GG_STR("a"), GG_STR("b"), GG_STR("c")), &value
+    ));
+    ASSERT_BUF_EQ(GG_STR("\"v\""), value);
+
+    GG_TEST_ASSERT_OK(
+        gg_json_get_raw(doc, GG_BUF_LIST(GG_STR("a"), GG_STR("b")), &value)
+    );
+    ASSERT_BUF_EQ(GG_STR("{\"c\": \"v\"}"), value);
+}
+
+GG_TEST_DEFINE(json_get_raw_missing_key) {
+    GgBuffer doc = GG_STR("{\"a\": {\"b\": 1}, \"c\": {}}");
+    TEST_ASSERT_EQUAL(
+        GG_ERR_NOENTRY,
+        gg_json_get_raw(doc, GG_BUF_LIST(GG_STR("a"), GG_STR("c")), NULL)
+    );
+    TEST_ASSERT_EQUAL(
+        GG_ERR_NOENTRY,
+        gg_json_get_raw(doc, GG_BUF_LIST(GG_STR("c"), GG_STR("a")), NULL)
+    );
+    TEST_ASSERT_EQUAL(
+        GG_ERR_NOENTRY, gg_json_get_raw(doc, GG_BUF_LIST(GG_STR("d")), NULL)
+    );
+}
+
+GG_TEST_DEFINE(json_get_raw_non_object_in_path) {
+    GgBuffer doc = GG_STR("{\"a\": [{\"b\": 1}]}");
+    TEST_ASSERT_EQUAL(
+        GG_ERR_PARSE,
+        gg_json_get_raw(doc, GG_BUF_LIST(GG_STR("a"), GG_STR("b")), NULL)
+    );
+    TEST_ASSERT_EQUAL(
+        GG_ERR_PARSE,
+        gg_json_get_raw(GG_STR("[1]"), GG_BUF_LIST(GG_STR("a")), NULL)
+    );
+}
+
+GG_TEST_DEFINE(json_get_raw_first_duplicate_wins) {
+    GgBuffer doc = GG_STR("{\"a\": {\"b\": 1}, \"a\": {\"b\": 2}}");
+    GgBuffer value;
+    GG_TEST_ASSERT_OK(
+        gg_json_get_raw(doc, GG_BUF_LIST(GG_STR("a"), GG_STR("b")), &value)
+    );
+    ASSERT_BUF_EQ(GG_STR("1"), value);
+}
+
+GG_TEST_DEFINE(json_get_raw_rejects_invalid_doc) {
+    GgBuffer value;
+    // Rest of the document is validated after the value is found
+    TEST_ASSERT_EQUAL(
+        GG_ERR_PARSE,
+        gg_json_get_raw(
+            GG_STR("{\"a\": 1, \"b\": }"), GG_BUF_LIST(GG_STR("a")), &value
+        )
+    );
+    TEST_ASSERT_EQUAL(
+        GG_ERR_PARSE,
+        gg_json_get_raw(
+            GG_STR("{\"a\": 1} {}"), GG_BUF_LIST(GG_STR("a")), &value
+        )
+    );
+    TEST_ASSERT_EQUAL(
+        GG_ERR_PARSE,
+        gg_json_get_raw(
+            GG_STR("{\"a\": 1,}"), GG_BUF_LIST(GG_STR("a")), &value
+        )
+    );
+    TEST_ASSERT_EQUAL(
+        GG_ERR_PARSE,
+        gg_json_get_raw(GG_STR("{\"a\" 1}"), GG_BUF_LIST(GG_STR("a")), &value)
+    );
+    TEST_ASSERT_EQUAL(
+        GG_ERR_PARSE,
+        gg_json_get_raw(
+            GG_STR("{\"a\": {\"b\": 1}"),
+            GG_BUF_LIST(GG_STR("a"), GG_STR("b")),
+            &value
+        )
+    );
+}
@@ -0,0 +1,112 @@
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/io.h>
+#include <gg/json_decode.h>
+#include <gg/json_encode.h>
+#include <gg/object.h>
+#include <gg/test.h>
+#include <string.h>
+#include <unity.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+// Packed arrays are formatted through a 512 byte chunk. Arrays of the
+// longest elements, offset by varying numbers of short ones, fill the chunk
+// to every length around its end.
+
+#define ARRAY_LEN 64
+#define MAX_SHORT 24
+
+static const int64_t LONGEST_I64 = INT64_MIN;
+
+static const double LONGEST_F64[] = {
+    -2.2250738585072014e-308,
+    -1.7976931348623157e+308,
+    -1.2345678901234567e-5,
+    -1.2345678901234567e-300,
+};
+
+static uint8_t encoded_mem[ARRAY_LEN * 32];
+static uint8_t expected_mem[ARRAY_LEN * 32];
+
+static GgBuffer encode(GgObject obj, uint8_t *mem, size_t mem_len) {
+    GgBuffer remaining = { .data = mem, .len = mem_len };
+    GG_TEST_ASSERT_OK(gg_json_encode(obj, gg_buf_writer(&remaining)));
+    GgBuffer encoded = { .data = mem, .len = mem_len - remaining.len };
+
+    size_t len = 0;
+    GG_TEST_ASSERT_OK(gg_json_encoded_len(obj, &len));
+    TEST_ASSERT_EQUAL(encoded.len, len);
+    return encoded;
+}
+
+/// Checks that a packed array encodes as the equivalent list, and decodes
+/// back to it.
+static void check_packed(GgObject packed, GgList list) {
+    GgBuffer encoded = encode(packed, encoded_mem, sizeof(encoded_mem));
+    GgBuffer expected
+        = encode(gg_obj_list(list), expected_mem, sizeof(expected_mem));
+    TEST_ASSERT_EQUAL(expected.len, encoded.len);
+    TEST_ASSERT_EQUAL_MEMORY(expected.data, encoded.data, expected.len);
+
+    static uint8_t decode_mem[ARRAY_LEN * sizeof(GgObject)];
+    GgArena arena = gg_arena_init(GG_BUF(decode_mem));
+    GgObject decoded;
+    GG_TEST_ASSERT_OK(gg_json_decode_destructive(encoded, &arena, &decoded));
+    TEST_ASSERT_TRUE(gg_obj_eq(gg_obj_list(list), decoded));
+}
+
+GG_TEST_DEFINE(json_encode_i64_array_chunk_boundary) {
+    static int64_t items[ARRAY_LEN];
+    static GgObject list_items[ARRAY_LEN];
+
+    for (size_t short_count = 0; short_count <= MAX_SHORT; short_count++) {
+        for (size_t len = 0; len <= ARRAY_LEN; len++) {
+            for (size_t i = 0; i < len; i++) {
+                items[i] = (i < short_count) ? 0 : LONGEST_I64;
+                list_items[i] = gg_obj_i64(items[i]);
+            }
+            check_packed(
+                gg_obj_i64_array((GgI64Array) { .items = items, .len = len }),
+                (GgList) { .items = list_items, .len = len }
+            );
+        }
+    }
+
+    items[0] = LONGEST_I64;
+    items[1] = LONGEST_I64;
+    GgBuffer encoded = encode(
+        gg_obj_i64_array((GgI64Array) { .items = items, .len = 2 }),
+        encoded_mem,
+        sizeof(encoded_mem)
+    );
+    TEST_ASSERT_TRUE(gg_buffer_eq(
+        GG_STR("[-9223372036854775808,-9223372036854775808]"), encoded
+    ));
+}
+
+GG_TEST_DEFINE(json_encode_f64_array_chunk_boundary) {
+    static double items[ARRAY_LEN];
+    static GgObject list_items[ARRAY_LEN];
+    size_t longest_count = sizeof(LONGEST_F64) / sizeof(LONGEST_F64[0]);
+
+    for (size_t longest = 0; longest < longest_count; longest++) {
+        for (size_t short_count = 0; short_count <= MAX_SHORT; short_count++) {
+            for (size_t len = 0; len <= ARRAY_LEN; len++) {
+                for (size_t i = 0; i < len; i++) {
+                    items[i] = (i < short_count) ? 1.0 : LONGEST_F64[longest];
+                    list_items[i] = gg_obj_f64(items[i]);
+                }
+                check_packed(
+                    gg_obj_f64_array(
+                        (GgF64Array) { .items = items, .len = len }
+                    ),
+                    (GgList) { .items = list_items, .len = len }
+                );
+            }
+        }
+    }
+}
@@ -0,0 +1,162 @@
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <gg/test.h>
+#include <unity.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+static uint8_t index_mem[4096];
+
+static GgMapIndex build_index(GgMap map) {
+    GgArena arena = gg_arena_init(GG_BUF(index_mem));
+    GgMapIndex index;
+    GG_TEST_ASSERT_OK(gg_map_index_build(map, &arena, &index));
+    return index;
+}
+
+/// Asserts the index finds the same pair as a linear search of `map`.
+static void assert_find_matches(
+    const GgMapIndex *index, GgMap map, GgBuffer key
+) {
+    GgKV *expected = NULL;
+    GG_MAP_FOREACH (pair, map) {
+        if (gg_buffer_eq(gg_kv_key(*pair), key)) {
+            expected = pair;
+            break;
+        }
+    }
+    TEST_ASSERT_EQUAL_PTR(expected, gg_map_index_find(index, map, key));
+}
+
+GG_TEST_DEFINE(map_index_nested_maps) {
+    GgMap inner = GG_MAP(
+        gg_kv(GG_STR("c"), gg_obj_i64(3)), gg_kv(GG_STR("a"), gg_obj_i64(4))
+    );
+    GgMap middle = GG_MAP(gg_kv(GG_STR("inner"), gg_obj_map(inner)));
+    GgMap map = GG_MAP(
+        gg_kv(GG_STR("a"), gg_obj_i64(1)),
+        gg_kv(GG_STR("middle"), gg_obj_map(middle))
+    );
+    GgMapIndex index = build_index(map);
+
+    assert_find_matches(&index, map, GG_STR("a"));
+    assert_find_matches(&index, map, GG_STR("middle"));
+    assert_find_matches(&index, map, GG_STR("c"));
+    assert_find_matches(&index, middle, GG_STR("inner"));
+    assert_find_matches(&index, middle, GG_STR("a"));
+    assert_find_matches(&index, inner, GG_STR("a"));
+    assert_find_matches(&index, inner, GG_STR("c"));
+    assert_find_matches(&index, inner, GG_STR("inner"));
+
+    GgObject *result;
+    TEST_ASSERT_TRUE(gg_map_index_get_path(
+        &index,
+        GG_BUF_LIST(GG_STR("middle"), GG_STR("inner"), GG_STR("a")),
+        &result
+    ));
+    TEST_ASSERT_EQUAL(4, gg_obj_into_i64(*result));
+    TEST_ASSERT_FALSE(gg_map_index_get_path(
+        &index, GG_BUF_LIST(GG_STR("middle"), GG_STR("c")), &result
+    ));
+    TEST_ASSERT_NULL(result);
+    TEST_ASSERT_FALSE(gg_map_index_get_path(
+        &index, GG_BUF_LIST(GG_STR("a"), GG_STR("c")), NULL
+    ));
+}
+
+GG_TEST_DEFINE(map_index_maps_in_lists) {
+    GgMap in_list = GG_MAP(gg_kv(GG_STR("x"), gg_obj_i64(1)));
+    GgMap in_nested_list = GG_MAP(
+        gg_kv(GG_STR("y"), gg_obj_i64(2)), gg_kv(GG_STR("x"), gg_obj_i64(3))
+    );
+    GgMap in_list_map = GG_MAP(gg_kv(GG_STR("z"), gg_obj_i64(4)));
+    GgMap list_item_map
+        = GG_MAP(gg_kv(GG_STR("nested"), gg_obj_map(in_list_map)));
+    GgMap map = GG_MAP(gg_kv(
+        GG_STR("items"),
+        gg_obj_list(GG_LIST(
+            gg_obj_i64(0),
+            gg_obj_map(in_list),
+            gg_obj_list(GG_LIST(gg_obj_map(in_nested_list))),
+            gg_obj_map(list_item_map)
+        ))
+    ));
+    GgMapIndex index = build_index(map);
+
+    assert_find_matches(&index, map, GG_STR("items"));
+    assert_find_matches(&index, map, GG_STR("x"));
+    assert_find_matches(&index, in_list, GG_STR("x"));
+    assert_find_matches(&index, in_list, GG_STR("y"));
+    assert_find_matches(&index, in_nested_list, GG_STR("x"));
+    assert_find_matches(&index, in_nested_list, GG_STR("y"));
+    assert_find_matches(&index, list_item_map, GG_STR("nested"));
+    assert_find_matches(&index, in_list_map, GG_STR("z"));
+    TEST_ASSERT_NOT_NULL(gg_map_index_find(&index, in_list, GG_STR("x")));
+    TEST_ASSERT_NOT_NULL(
+        gg_map_index_find(&index, in_nested_list, GG_STR("x"))
+    );
+    TEST_ASSERT_NOT_NULL(gg_map_index_find(&index, in_list_map, GG_STR("z")));
+}
+
+GG_TEST_DEFINE(map_index_duplicate_keys) {
+    GgMap inner = GG_MAP(
+        gg_kv(GG_STR("k"), gg_obj_i64(10)),
+        gg_kv(GG_STR("k"), gg_obj_i64(11))
+    );
+    GgMap map = GG_MAP(
+        gg_kv(GG_STR("k"), gg_obj_i64(1)),
+        gg_kv(GG_STR("list"), gg_obj_list(GG_LIST(gg_obj_map(inner)))),
+        gg_kv(GG_STR("k"), gg_obj_i64(2))
+    );
+    GgMapIndex index = build_index(map);
+
+    // First pair wins, as with gg_map_get
+    assert_find_matches(&index, map, GG_STR("k"));
+    assert_find_matches(&index, inner, GG_STR("k"));
+
+    GgObject *result;
+    TEST_ASSERT_TRUE(gg_map_index_get(&index, GG_STR("k"), &result));
+    TEST_ASSERT_EQUAL(1, gg_obj_into_i64(*result));
+    GgKV *inner_kv = gg_map_index_find(&index, inner, GG_STR("k"));
+    TEST_ASSERT_EQUAL(10, gg_obj_into_i64(*gg_kv_val(inner_kv)));
+}
+
+GG_TEST_DEFINE(map_index_prefix_of_indexed_map) {
+    GgMap map = GG_MAP(
+        gg_kv(GG_STR("a"), gg_obj_i64(1)), gg_kv(GG_STR("b"), gg_obj_i64(2))
+    );
+    GgMapIndex index = build_index(map);
+
+    GgMap prefix = { .pairs = map.pairs, .len = 1 };
+    assert_find_matches(&index, prefix, GG_STR("a"));
+    assert_find_matches(&index, prefix, GG_STR("b"));
+}
+
+GG_TEST_DEFINE(map_index_depth_limit) {
+    GgObjectLimits prev_limits = gg_obj_get_limits();
+    GG_TEST_ASSERT_OK(gg_obj_set_limits(
+        (GgObjectLimits) { .max_depth = 2,
+                           .max_subobjects = prev_limits.max_subobjects }
+    ));
+
+    GgMap inner = GG_MAP(gg_kv(GG_STR("a"), gg_obj_i64(1)));
+    GgMap ok = GG_MAP(gg_kv(GG_STR("inner"), gg_obj_map(inner)));
+    GgMap too_deep = GG_MAP(
+        gg_kv(GG_STR("list"), gg_obj_list(GG_LIST(gg_obj_map(inner))))
+    );
+
+    GgArena arena = gg_arena_init(GG_BUF(index_mem));
+    GgMapIndex index;
+    GgError ok_ret = gg_map_index_build(ok, &arena, &index);
+    GgError too_deep_ret = gg_map_index_build(too_deep, &arena, &index);
+
+    GG_TEST_ASSERT_OK(gg_obj_set_limits(prev_limits));
+    GG_TEST_ASSERT_OK(ok_ret);
+    TEST_ASSERT_EQUAL(GG_ERR_RANGE, too_deep_ret);
+}
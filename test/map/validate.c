@@ -0,0 +1,164 @@
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/flags.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <gg/test.h>
+#include <unity.h>
+#include <stddef.h>
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+static GgObject *name_obj;
+static GgObject *count_obj;
+static GgObject *extra_obj;
+
+/// Validates with the uncached, cached, and compiled APIs, asserting that
+/// they agree, and returns the result.
+static GgError validate_all(GgMap map) {
+    GgMapSchema schema = GG_MAP_SCHEMA(
+        { GG_STR("name"), GG_REQUIRED, GG_TYPE_BUF, &name_obj },
+        { GG_STR("count"), GG_OPTIONAL, GG_TYPE_I64, &count_obj },
+        { GG_STR("extra"), GG_MISSING, GG_TYPE_NULL, &extra_obj },
+    );
+
+    GgError ret = gg_map_validate(map, schema);
+    GgObject *name = name_obj;
+    GgObject *count = count_obj;
+
+    // Twice, to use both the compiling and the cached path
+    for (int i = 0; i < 2; i++) {
+        name_obj = NULL;
+        count_obj = NULL;
+        GgError cached_ret;
+        GG_MAP_VALIDATE(
+            cached_ret,
+            map,
+            { GG_STR("name"), GG_REQUIRED, GG_TYPE_BUF, &name_obj },
+            { GG_STR("count"), GG_OPTIONAL, GG_TYPE_I64, &count_obj },
+            { GG_STR("extra"), GG_MISSING, GG_TYPE_NULL, &extra_obj },
+        );
+        TEST_ASSERT_EQUAL(ret, cached_ret);
+        if (ret == GG_ERR_OK) {
+            TEST_ASSERT_EQUAL_PTR(name, name_obj);
+            TEST_ASSERT_EQUAL_PTR(count, count_obj);
+        }
+    }
+
+    GgMapCompiledSchema compiled;
+    GG_TEST_ASSERT_OK(gg_map_schema_compile(schema, &compiled));
+    GgObject *values[3];
+    TEST_ASSERT_EQUAL(ret, gg_map_validate_compiled(map, &compiled, values));
+    if (ret == GG_ERR_OK) {
+        TEST_ASSERT_EQUAL_PTR(name, values[0]);
+        TEST_ASSERT_EQUAL_PTR(count, values[1]);
+    }
+
+    name_obj = name;
+    count_obj = count;
+    return ret;
+}
+
+GG_TEST_DEFINE(map_validate_extracts_values) {
+    GgMap map = GG_MAP(
+        gg_kv(GG_STR("other"), gg_obj_i64(0)),
+        gg_kv(GG_STR("count"), gg_obj_i64(5)),
+        gg_kv(GG_STR("name"), gg_obj_buf(GG_STR("abc")))
+    );
+    GG_TEST_ASSERT_OK(validate_all(map));
+    TEST_ASSERT_EQUAL_PTR(gg_kv_val(&map.pairs[2]), name_obj);
+    TEST_ASSERT_EQUAL_PTR(gg_kv_val(&map.pairs[1]), count_obj);
+
+    GgMap without_optional
+        = GG_MAP(gg_kv(GG_STR("name"), gg_obj_buf(GG_STR("abc"))));
+    GG_TEST_ASSERT_OK(validate_all(without_optional));
+    TEST_ASSERT_NULL(count_obj);
+}
+
+GG_TEST_DEFINE(map_validate_first_match_wins) {
+    GgMap map = GG_MAP(
+        gg_kv(GG_STR("name"), gg_obj_buf(GG_STR("first"))),
+        gg_kv(GG_STR("count"), gg_obj_i64(1)),
+        gg_kv(GG_STR("name"), gg_obj_buf(GG_STR("second"))),
+        gg_kv(GG_STR("count"), gg_obj_buf(GG_STR("not checked")))
+    );
+    GG_TEST_ASSERT_OK(validate_all(map));
+    TEST_ASSERT_EQUAL_PTR(gg_kv_val(&map.pairs[0]), name_obj);
+    TEST_ASSERT_EQUAL_PTR(gg_kv_val(&map.pairs[1]), count_obj);
+}
+
+GG_TEST_DEFINE(map_validate_type_mismatch) {
+    GgMap wrong_required = GG_MAP(gg_kv(GG_STR("name"), gg_obj_i64(1)));
+    TEST_ASSERT_EQUAL(GG_ERR_PARSE, validate_all(wrong_required));
+
+    GgMap wrong_optional = GG_MAP(
+        gg_kv(GG_STR("name"), gg_obj_buf(GG_STR("abc"))),
+        gg_kv(GG_STR("count"), gg_obj_f64(1.0))
+    );
+    TEST_ASSERT_EQUAL(GG_ERR_PARSE, validate_all(wrong_optional));
+
+    // Type of the first duplicate is checked
+    GgMap wrong_first = GG_MAP(
+        gg_kv(GG_STR("name"), gg_obj_bool(true)),
+        gg_kv(GG_STR("name"), gg_obj_buf(GG_STR("abc")))
+    );
+    TEST_ASSERT_EQUAL(GG_ERR_PARSE, validate_all(wrong_first));
+}
+
+GG_TEST_DEFINE(map_validate_missing_required_key) {
+    GgMap empty = { 0 };
+    TEST_ASSERT_EQUAL(GG_ERR_NOENTRY, validate_all(empty));
+
+    GgMap other_keys = GG_MAP(
+        gg_kv(GG_STR("count"), gg_obj_i64(1)),
+        gg_kv(GG_STR("Name"), gg_obj_buf(GG_STR("abc"))),
+        gg_kv(GG_STR("nam"), gg_obj_buf(GG_STR("abc")))
+    );
+    TEST_ASSERT_EQUAL(GG_ERR_NOENTRY, validate_all(other_keys));
+}
+
+GG_TEST_DEFINE(map_validate_present_missing_key) {
+    GgMap map = GG_MAP(
+        gg_kv(GG_STR("name"), gg_obj_buf(GG_STR("abc"))),
+        gg_kv(GG_STR("extra"), GG_OBJ_NULL)
+    );
+    TEST_ASSERT_EQUAL(GG_ERR_PARSE, validate_all(map));
+}
+
+GG_TEST_DEFINE(map_validate_large_schema) {
+    // Schemas too large to compile fall back to per-key lookups
+    static GgMapSchemaEntry entries[GG_MAP_SCHEMA_MAX_ENTRIES + 1];
+    static GgObject *values[GG_MAP_SCHEMA_MAX_ENTRIES + 1];
+    for (size_t i = 0; i < GG_MAP_SCHEMA_MAX_ENTRIES + 1; i++) {
+        entries[i] = (GgMapSchemaEntry) {
+            .key = GG_STR("name"),
+            .required = GG_OPTIONAL,
+            .type = GG_TYPE_BUF,
+            .value = &values[i],
+        };
+    }
+    entries[GG_MAP_SCHEMA_MAX_ENTRIES].key = GG_STR("count");
+    entries[GG_MAP_SCHEMA_MAX_ENTRIES].required = GG_REQUIRED;
+    GgMapSchema schema
+        = { .entries = entries, .entry_count = GG_MAP_SCHEMA_MAX_ENTRIES + 1 };
+
+    GgMapCompiledSchema compiled;
+    TEST_ASSERT_EQUAL(GG_ERR_RANGE, gg_map_schema_compile(schema, &compiled));
+
+    GgMap map = GG_MAP(
+        gg_kv(GG_STR("name"), gg_obj_buf(GG_STR("abc"))),
+        gg_kv(GG_STR("name"), gg_obj_buf(GG_STR("def")))
+    );
+    static GgMapSchemaCache cache = { 0 };
+    TEST_ASSERT_EQUAL(GG_ERR_NOENTRY, gg_map_validate(map, schema));
+    TEST_ASSERT_EQUAL(
+        GG_ERR_NOENTRY, gg_map_validate_cached(&cache, map, schema)
+    );
+
+    entries[GG_MAP_SCHEMA_MAX_ENTRIES].required = GG_OPTIONAL;
+    GG_TEST_ASSERT_OK(gg_map_validate_cached(&cache, map, schema));
+    for (size_t i = 0; i < GG_MAP_SCHEMA_MAX_ENTRIES; i++) {
+        TEST_ASSERT_EQUAL_PTR(gg_kv_val(&map.pairs[0]), values[i]);
+    }
+    TEST_ASSERT_NULL(values[GG_MAP_SCHEMA_MAX_ENTRIES]);
+}
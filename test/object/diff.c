@@ -0,0 +1,266 @@
+#include <gg/arena.h>
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/map.h>
+#include <gg/object.h>
+#include <gg/test.h>
+#include <unity.h>
+#include <stdint.h>
+
+#define GG_TEST_ASSERT_OK(expr) TEST_ASSERT_EQUAL(GG_ERR_OK, (expr))
+
+static uint8_t diff_mem[1024];
+
+/// Asserts that the diff of old_obj to new_obj equals `expected`.
+static void check_diff(GgObject old_obj, GgObject new_obj, GgMap expected) {
+    GgArena arena = gg_arena_init(GG_BUF(diff_mem));
+    GgObject diff;
+    GG_TEST_ASSERT_OK(gg_obj_diff(old_obj, new_obj, &arena, &diff));
+    TEST_ASSERT_EQUAL(GG_TYPE_MAP, gg_obj_type(diff));
+    TEST_ASSERT_TRUE(gg_obj_eq(gg_obj_map(expected), diff));
+}
+
+GG_TEST_DEFINE(obj_diff_nested_delta) {
+    GgMap old_inner = GG_MAP(
+        gg_kv(GG_STR("a"), gg_obj_i64(1)), gg_kv(GG_STR("b"), gg_obj_i64(2))
+    );
+    GgMap new_inner = GG_MAP(
+        gg_kv(GG_STR("a"), gg_obj_i64(1)), gg_kv(GG_STR("b"), gg_obj_i64(3))
+    );
+    GgMap old_map = GG_MAP(
+        gg_kv(GG_STR("same"), gg_obj_buf(GG_STR("x"))),
+        gg_kv(GG_STR("inner"), gg_obj_map(old_inner))
+    );
+    GgMap new_map = GG_MAP(
+        gg_kv(GG_STR("same"), gg_obj_buf(GG_STR("x"))),
+        gg_kv(GG_STR("inner"), gg_obj_map(new_inner)),
+        gg_kv(GG_STR("added"), gg_obj_bool(true))
+    );
+
+    // Only the changed key of the nested map, and the added key
+    check_diff(
+        gg_obj_map(old_map),
+        gg_obj_map(new_map),
+        GG_MAP(
+            gg_kv(
+                GG_STR("inner"),
+                gg_obj_map(GG_MAP(gg_kv(GG_STR("b"), gg_obj_i64(3))))
+            ),
+            gg_kv(GG_STR("added"), gg_obj_bool(true))
+        )
+    );
+}
+
+GG_TEST_DEFINE(obj_diff_unchanged_nested_map_omitted) {
+    GgMap inner = GG_MAP(gg_kv(GG_STR("a"), gg_obj_i64(1)));
+    GgMap old_map = GG_MAP(
+        gg_kv(GG_STR("inner"), gg_obj_map(inner)),
+        gg_kv(GG_STR("n"), gg_obj_i64(1))
+    );
+    GgMap new_map = GG_MAP(
+        gg_kv(GG_STR("inner"), gg_obj_map(inner)),
+        gg_kv(GG_STR("n"), gg_obj_i64(2))
+    );
+    check_diff(
+        gg_obj_map(old_map),
+        gg_obj_map(new_map),
+        GG_MAP(gg_kv(GG_STR("n"), gg_obj_i64(2)))
+    );
+}
+
+GG_TEST_DEFINE(obj_diff_key_reorder) {
+    GgMap old_map = GG_MAP(
+        gg_kv(GG_STR("a"), gg_obj_i64(1)),
+        gg_kv(GG_STR("b"), gg_obj_buf(GG_STR("two"))),
+        gg_kv(
+            GG_STR("c"),
+            gg_obj_map(GG_MAP(
+                gg_kv(GG_STR("x"), gg_obj_i64(1)),
+                gg_kv(GG_STR("y"), gg_obj_i64(2))
+            ))
+        )
+    );
+    GgMap new_map = GG_MAP(
+        gg_kv(
+            GG_STR("c"),
+            gg_obj_map(GG_MAP(
+                gg_kv(GG_STR("y"), gg_obj_i64(2)),
+                gg_kv(GG_STR("x"), gg_obj_i64(1))
+            ))
+        ),
+        gg_kv(GG_STR("b"), gg_obj_buf(GG_STR("two"))),
+        gg_kv(GG_STR("a"), gg_obj_i64(1))
+    );
+    check_diff(gg_obj_map(old_map), gg_obj_map(new_map), (GgMap) { 0 });
+}
+
+GG_TEST_DEFINE(obj_diff_empty_and_non_empty_maps) {
+    GgMap map = GG_MAP(
+        gg_kv(GG_STR("a"), gg_obj_i64(1)),
+        gg_kv(
+            GG_STR("b"),
+            gg_obj_map(GG_MAP(gg_kv(GG_STR("c"), gg_obj_i64(2))))
+        )
+    );
+
+    // Everything is new
+    check_diff(gg_obj_map((GgMap) { 0 }), gg_obj_map(map), map);
+    // Removed keys are not represented
+    check_diff(gg_obj_map(map), gg_obj_map((GgMap) { 0 }), (GgMap) { 0 });
+    check_diff(
+        gg_obj_map((GgMap) { 0 }), gg_obj_map((GgMap) { 0 }), (GgMap) { 0 }
+    );
+
+    // An empty nested map does not change a non-empty one when merged
+    GgMap empty_inner
+        = GG_MAP(gg_kv(GG_STR("b"), gg_obj_map((GgMap) { 0 })));
+    check_diff(gg_obj_map(map), gg_obj_map(empty_inner), (GgMap) { 0 });
+    // But is added where the key is absent
+    check_diff(
+        gg_obj_map((GgMap) { 0 }), gg_obj_map(empty_inner), empty_inner
+    );
+}
+
+GG_TEST_DEFINE(obj_diff_list_changes) {
+    GgMap old_map = GG_MAP(gg_kv(
+        GG_STR("list"),
+        gg_obj_list(GG_LIST(gg_obj_i64(1), gg_obj_i64(2), gg_obj_i64(3)))
+    ));
+
+    // Lists are replaced as a whole
+    GgMap changed_item = GG_MAP(gg_kv(
+        GG_STR("list"),
+        gg_obj_list(GG_LIST(gg_obj_i64(1), gg_obj_i64(5), gg_obj_i64(3)))
+    ));
+    check_diff(gg_obj_map(old_map), gg_obj_map(changed_item), changed_item);
+
+    GgMap shorter = GG_MAP(gg_kv(
+        GG_STR("list"), gg_obj_list(GG_LIST(gg_obj_i64(1), gg_obj_i64(2)))
+    ));
+    check_diff(gg_obj_map(old_map), gg_obj_map(shorter), shorter);
+
+    GgMap emptied
+        = GG_MAP(gg_kv(GG_STR("list"), gg_obj_list((GgList) { 0 })));
+    check_diff(gg_obj_map(old_map), gg_obj_map(emptied), emptied);
+
+    // Maps inside lists are compared, not merged
+    GgMap old_nested = GG_MAP(gg_kv(
+        GG_STR("list"),
+        gg_obj_list(
+            GG_LIST(gg_obj_map(GG_MAP(gg_kv(GG_STR("a"), gg_obj_i64(1)))))
+        )
+    ));
+    GgMap new_nested = GG_MAP(gg_kv(
+        GG_STR("list"),
+        gg_obj_list(
+            GG_LIST(gg_obj_map(GG_MAP(gg_kv(GG_STR("a"), gg_obj_i64(2)))))
+        )
+    ));
+    check_diff(gg_obj_map(old_nested), gg_obj_map(new_nested), new_nested);
+    check_diff(
+        gg_obj_map(new_nested), gg_obj_map(new_nested), (GgMap) { 0 }
+    );
+}
+
+GG_TEST_DEFINE(obj_diff_type_changes) {
+    GgMap as_map = GG_MAP(gg_kv(
+        GG_STR("v"), gg_obj_map(GG_MAP(gg_kv(GG_STR("a"), gg_obj_i64(1))))
+    ));
+    GgMap as_i64 = GG_MAP(gg_kv(GG_STR("v"), gg_obj_i64(1)));
+    GgMap as_f64 = GG_MAP(gg_kv(GG_STR("v"), gg_obj_f64(1.0)));
+    GgMap as_buf = GG_MAP(gg_kv(GG_STR("v"), gg_obj_buf(GG_STR("1"))));
+    GgMap as_null = GG_MAP(gg_kv(GG_STR("v"), GG_OBJ_NULL));
+    GgMap as_list
+        = GG_MAP(gg_kv(GG_STR("v"), gg_obj_list(GG_LIST(gg_obj_i64(1)))));
+
+    check_diff(gg_obj_map(as_map), gg_obj_map(as_i64), as_i64);
+    check_diff(gg_obj_map(as_i64), gg_obj_map(as_map), as_map);
+    check_diff(gg_obj_map(as_i64), gg_obj_map(as_f64), as_f64);
+    check_diff(gg_obj_map(as_i64), gg_obj_map(as_buf), as_buf);
+    check_diff(gg_obj_map(as_buf), gg_obj_map(as_null), as_null);
+    check_diff(gg_obj_map(as_null), gg_obj_map(as_list), as_list);
+    check_diff(gg_obj_map(as_list), gg_obj_map(as_map), as_map);
+}
+
+GG_TEST_DEFINE(obj_diff_non_map_objects) {
+    GgMap map = GG_MAP(gg_kv(GG_STR("a"), gg_obj_i64(1)));
+
+    // Old non-map values are fully replaced
+    check_diff(gg_obj_i64(1), gg_obj_map(map), map);
+    check_diff(GG_OBJ_NULL, gg_obj_map(map), map);
+
+    GgArena arena = gg_arena_init(GG_BUF(diff_mem));
+    GgObject diff;
+    TEST_ASSERT_EQUAL(
+        GG_ERR_INVALID,
+        gg_obj_diff(gg_obj_map(map), gg_obj_i64(1), &arena, &diff)
+    );
+    TEST_ASSERT_EQUAL(
+        GG_ERR_INVALID,
+        gg_obj_diff(gg_obj_map(map), GG_OBJ_NULL, &arena, &diff)
+    );
+}
+
+GG_TEST_DEFINE(obj_diff_insufficient_memory) {
+    GgMap inner = GG_MAP(
+        gg_kv(GG_STR("a"), gg_obj_i64(1)), gg_kv(GG_STR("b"), gg_obj_i64(2))
+    );
+    GgMap new_map = GG_MAP(
+        gg_kv(GG_STR("x"), gg_obj_i64(1)),
+        gg_kv(GG_STR("inner"), gg_obj_map(inner))
+    );
+    GgMap old_map
+        = GG_MAP(gg_kv(GG_STR("inner"), gg_obj_map((GgMap) { 0 })));
+
+    // Room for the top-level pairs, but not the nested ones
+    static uint8_t small_mem[sizeof(GgKV[2])];
+    GgArena arena = gg_arena_init(GG_BUF(small_mem));
+    GgObject diff;
+    TEST_ASSERT_EQUAL(
+        GG_ERR_NOMEM,
+        gg_obj_diff(gg_obj_map(old_map), gg_obj_map(new_map), &arena, &diff)
+    );
+
+    arena = gg_arena_init((GgBuffer) { 0 });
+    TEST_ASSERT_EQUAL(
+        GG_ERR_NOMEM,
+        gg_obj_diff(GG_OBJ_NULL, gg_obj_map(new_map), &arena, &diff)
+    );
+    // No allocation is needed when nothing changed
+    GG_TEST_ASSERT_OK(
+        gg_obj_diff(gg_obj_map(new_map), gg_obj_map(new_map), &arena, &diff)
+    );
+    TEST_ASSERT_EQUAL(0, gg_obj_into_map(diff).len);
+}
+
+GG_TEST_DEFINE(obj_diff_depth_limit) {
+    GgObjectLimits prev_limits = gg_obj_get_limits();
+    GG_TEST_ASSERT_OK(gg_obj_set_limits(
+        (GgObjectLimits) { .max_depth = 2,
+                           .max_subobjects = prev_limits.max_subobjects }
+    ));
+
+    GgMap deep = GG_MAP(gg_kv(
+        GG_STR("a"),
+        gg_obj_map(GG_MAP(gg_kv(
+            GG_STR("b"),
+            gg_obj_map(GG_MAP(gg_kv(GG_STR("c"), gg_obj_i64(1))))
+        )))
+    ));
+    GgMap deep_changed = GG_MAP(gg_kv(
+        GG_STR("a"),
+        gg_obj_map(GG_MAP(gg_kv(
+            GG_STR("b"),
+            gg_obj_map(GG_MAP(gg_kv(GG_STR("c"), gg_obj_i64(2))))
+        )))
+    ));
+
+    GgArena arena = gg_arena_init(GG_BUF(diff_mem));
+    GgObject diff;
+    GgError ret = gg_obj_diff(
+        gg_obj_map(deep), gg_obj_map(deep_changed), &arena, &diff
+    );
+
+    GG_TEST_ASSERT_OK(gg_obj_set_limits(prev_limits));
+    TEST_ASSERT_EQUAL(GG_ERR_RANGE, ret);
+}
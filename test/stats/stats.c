@@ -0,0 +1,180 @@
+#include <gg/buffer.h>
+#include <gg/error.h>
+#include <gg/ipc/client.h>
+#include <gg/ipc/client_stats.h>
+#include <gg/test.h>
+#include <pthread.h>
+#include <unity.h>
+#include <stddef.h>
+#include <stdint.h>
+
+static GgIpcStats before;
+static GgIpcStats after;
+
+/// Start time for a request that has been running for `us` microseconds.
+static uint64_t started_ago(uint64_t us) {
+    return ggipc_stats_now_ns() - (us * 1000);
+}
+
+static const GgIpcOperationStats *find_operation(
+    const GgIpcStats *stats, GgBuffer operation
+) {
+    for (size_t i = 0; i < stats->operation_count; i++) {
+        if (gg_buffer_eq(stats->operations[i].operation, operation)) {
+            return &stats->operations[i];
+        }
+    }
+    return NULL;
+}
+
+GG_TEST_DEFINE(stats_counters) {
+    ggipc_get_stats(&before);
+
+    ggipc_stat_add(GGIPC_STAT_REQUESTS_IN_FLIGHT, 3);
+    ggipc_stat_sub(GGIPC_STAT_REQUESTS_IN_FLIGHT, 1);
+    ggipc_stat_add(GGIPC_STAT_STREAM_SLOT_FAILURES, 1);
+    ggipc_stat_add(GGIPC_STAT_FRAMES_SENT, 2);
+    ggipc_stat_add(GGIPC_STAT_BYTES_SENT, 300);
+    ggipc_stat_add(GGIPC_STAT_FRAMES_RECEIVED, 4);
+    ggipc_stat_add(GGIPC_STAT_BYTES_RECEIVED, 500);
+    ggipc_stat_add(GGIPC_STAT_DECODE_FAILURES, 5);
+    ggipc_stat_add(GGIPC_STAT_DROPPED_FRAMES, 6);
+    ggipc_stat_add(GGIPC_STAT_TIMEOUTS, 7);
+
+    ggipc_get_stats(&after);
+
+    TEST_ASSERT_EQUAL(2, after.requests_in_flight - before.requests_in_flight);
+    TEST_ASSERT_EQUAL(
+        1, after.stream_slot_failures - before.stream_slot_failures
+    );
+    TEST_ASSERT_EQUAL(2, after.frames_sent - before.frames_sent);
+    TEST_ASSERT_EQUAL(300, after.bytes_sent - before.bytes_sent);
+    TEST_ASSERT_EQUAL(4, after.frames_received - before.frames_received);
+    TEST_ASSERT_EQUAL(500, after.bytes_received - before.bytes_received);
+    TEST_ASSERT_EQUAL(5, after.decode_failures - before.decode_failures);
+    TEST_ASSERT_EQUAL(6, after.dropped_frames - before.dropped_frames);
+    TEST_ASSERT_EQUAL(7, after.timeouts - before.timeouts);
+    TEST_ASSERT_EQUAL(GG_IPC_MAX_STREAMS, after.streams_max);
+}
+
+GG_TEST_DEFINE(stats_lock_counters) {
+    static pthread_mutex_t mtx = PTHREAD_MUTEX_INITIALIZER;
+
+    ggipc_get_stats(&before);
+    pthread_mutex_unlock(ggipc_stats_lock(&mtx));
+    pthread_mutex_unlock(ggipc_stats_lock(&mtx));
+    ggipc_get_stats(&after);
+
+    TEST_ASSERT_EQUAL(2, after.lock_acquisitions - before.lock_acquisitions);
+    TEST_ASSERT_EQUAL(0, after.lock_contended - before.lock_contended);
+    TEST_ASSERT_EQUAL(0, after.lock_wait_ns - before.lock_wait_ns);
+}
+
+GG_TEST_DEFINE(stats_streams_in_use_peak) {
+    ggipc_stats_set_streams_in_use(5);
+    ggipc_stats_set_streams_in_use(2);
+    ggipc_get_stats(&after);
+    TEST_ASSERT_EQUAL(2, after.streams_in_use);
+    TEST_ASSERT_EQUAL(5, after.streams_in_use_peak);
+}
+
+GG_TEST_DEFINE(stats_latency_bucket_boundaries) {
+    TEST_ASSERT_EQUAL(0, ggipc_stats_latency_bucket(0));
+    TEST_ASSERT_EQUAL(1, ggipc_stats_latency_bucket(1));
+    TEST_ASSERT_EQUAL(2, ggipc_stats_latency_bucket(2));
+    TEST_ASSERT_EQUAL(2, ggipc_stats_latency_bucket(3));
+    TEST_ASSERT_EQUAL(3, ggipc_stats_latency_bucket(4));
+
+    // Bucket i holds [2^(i-1), 2^i)
+    for (size_t i = 2; i < GG_IPC_STATS_LATENCY_BUCKETS - 1; i++) {
+        uint64_t low = UINT64_C(1) << (i - 1);
+        TEST_ASSERT_EQUAL(i - 1, ggipc_stats_latency_bucket(low - 1));
+        TEST_ASSERT_EQUAL(i, ggipc_stats_latency_bucket(low));
+        TEST_ASSERT_EQUAL(i, ggipc_stats_latency_bucket((low * 2) - 1));
+    }
+
+    // Last bucket also holds everything longer
+    size_t last = GG_IPC_STATS_LATENCY_BUCKETS - 1;
+    uint64_t last_low = UINT64_C(1) << (last - 1);
+    TEST_ASSERT_EQUAL(last - 1, ggipc_stats_latency_bucket(last_low - 1));
+    TEST_ASSERT_EQUAL(last, ggipc_stats_latency_bucket(last_low));
+    TEST_ASSERT_EQUAL(last, ggipc_stats_latency_bucket(last_low * 2));
+    TEST_ASSERT_EQUAL(last, ggipc_stats_latency_bucket(UINT64_MAX));
+}
+
+GG_TEST_DEFINE(stats_request_histogram) {
+    GgBuffer name = GG_STR("test#HistogramOperation");
+    GgIpcOperationStatsEntry *operation = ggipc_stats_operation(name);
+    TEST_ASSERT_EQUAL_PTR(operation, ggipc_stats_operation(name));
+    TEST_ASSERT_TRUE(
+        gg_buffer_eq(name, ggipc_stats_operation_name(operation))
+    );
+
+    // Durations are well inside their buckets, so the time taken by the
+    // test does not move them across a boundary.
+    ggipc_stats_request_done(operation, GG_ERR_OK, started_ago(5000));
+    ggipc_stats_request_done(operation, GG_ERR_TIMEOUT, started_ago(100000));
+    ggipc_stats_request_done(
+        operation, GG_ERR_REMOTE, started_ago(UINT64_C(1) << 30)
+    );
+
+    ggipc_get_stats(&after);
+    const GgIpcOperationStats *stats = find_operation(&after, name);
+    TEST_ASSERT_NOT_NULL(stats);
+    TEST_ASSERT_EQUAL(3, stats->requests);
+    TEST_ASSERT_EQUAL(2, stats->errors);
+    TEST_ASSERT_EQUAL(1, stats->timeouts);
+
+    const GgIpcLatencyStats *latency = &stats->latency;
+    TEST_ASSERT_EQUAL(3, latency->count);
+    TEST_ASSERT_TRUE(latency->max_us >= (UINT64_C(1) << 30));
+    TEST_ASSERT_TRUE(
+        latency->total_us >= 5000 + 100000 + (UINT64_C(1) << 30)
+    );
+    uint64_t expected[GG_IPC_STATS_LATENCY_BUCKETS] = { 0 };
+    expected[13] = 1; // [4096, 8192) us
+    expected[17] = 1; // [65536, 131072) us
+    expected[GG_IPC_STATS_LATENCY_BUCKETS - 1] = 1;
+    for (size_t i = 0; i < GG_IPC_STATS_LATENCY_BUCKETS; i++) {
+        TEST_ASSERT_EQUAL(expected[i], latency->buckets[i]);
+    }
+}
+
+GG_TEST_DEFINE(stats_callback_histogram) {
+    ggipc_get_stats(&before);
+    ggipc_stats_callback_done(started_ago(3000));
+    ggipc_get_stats(&after);
+
+    TEST_ASSERT_EQUAL(1, after.callbacks.count - before.callbacks.count);
+    TEST_ASSERT_EQUAL(
+        1, after.callbacks.buckets[12] - before.callbacks.buckets[12]
+    );
+    TEST_ASSERT_TRUE(after.callbacks.max_us >= 3000);
+}
+
+GG_TEST_DEFINE(stats_operation_table_full) {
+    static uint8_t names[GG_IPC_STATS_MAX_OPERATIONS][16];
+
+    // Fill the table; later operations share the last entry
+    GgIpcOperationStatsEntry *entries[GG_IPC_STATS_MAX_OPERATIONS];
+    for (size_t i = 0; i < GG_IPC_STATS_MAX_OPERATIONS; i++) {
+        names[i][0] = 'a' + (uint8_t) i;
+        GgBuffer name = { .data = names[i], .len = 1 };
+        entries[i] = ggipc_stats_operation(name);
+    }
+    GgIpcOperationStatsEntry *other
+        = entries[GG_IPC_STATS_MAX_OPERATIONS - 1];
+    TEST_ASSERT_EQUAL(0, ggipc_stats_operation_name(other).len);
+    TEST_ASSERT_EQUAL_PTR(other, ggipc_stats_operation(GG_STR("new")));
+
+    ggipc_get_stats(&after);
+    TEST_ASSERT_EQUAL(GG_IPC_STATS_MAX_OPERATIONS - 1, after.operation_count);
+
+    ggipc_stats_request_done(other, GG_ERR_OK, started_ago(0));
+    ggipc_get_stats(&after);
+    TEST_ASSERT_EQUAL(GG_IPC_STATS_MAX_OPERATIONS, after.operation_count);
+    const GgIpcOperationStats *last
+        = &after.operations[GG_IPC_STATS_MAX_OPERATIONS - 1];
+    TEST_ASSERT_EQUAL(0, last->operation.len);
+    TEST_ASSERT_EQUAL(1, last->requests);
+}
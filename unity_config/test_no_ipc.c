@@ -0,0 +1,22 @@
+#include <gg/test.h>
+#include <unity.h>
+
+// Hooks for test suites that do not use the IPC mock server, overriding the
+// weak defaults in test.c. Linked into those suites instead of a main.c.
+
+void suiteSetUp(void) {
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int suiteTearDown(int num_failures) {
+    return num_failures;
+}
+
+int main(void) {
+    return gg_test_run_suite();
+}
@@ -1,5 +1,5 @@
 #include "unity_handlers.h"
-#include <gg/log.h>
+#include <gg/log_priv.h>
 #include <setjmp.h>
 #include <unistd.h>
 #include <unity.h>